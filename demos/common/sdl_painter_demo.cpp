@@ -169,6 +169,11 @@ sdl_painter_demo(const std::string &about_text,
                                *this),
   m_painter_number_pools(m_painter_params.number_pools(), "painter_number_pools",
                          "Number of GL object pools used by the painter", *this),
+  m_painter_number_buffer_size_classes(m_painter_params.number_buffer_size_classes(),
+                                       "painter_number_buffer_size_classes",
+                                       "Number of size classes of the GL buffers used by the painter, "
+                                       "each class is half the size of the class before it",
+                                       *this),
   m_painter_break_on_shader_change(m_painter_params.break_on_shader_change(),
                                    "painter_break_on_shader_change",
                                    "If true, different shadings are placed into different "
@@ -370,6 +375,7 @@ init_gl(int w, int h)
     .indices_per_buffer(m_painter_indices_per_buffer.m_value)
     .data_blocks_per_store_buffer(m_painter_data_blocks_per_buffer.m_value)
     .number_pools(m_painter_number_pools.m_value)
+    .number_buffer_size_classes(m_painter_number_buffer_size_classes.m_value)
     .break_on_shader_change(m_painter_break_on_shader_change.m_value)
     .use_hw_clip_planes(m_use_hw_clip_planes.m_value)
     .vert_shader_use_switch(m_uber_vert_use_switch.m_value)
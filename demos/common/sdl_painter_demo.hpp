@@ -94,6 +94,7 @@ private:
   command_line_argument_value<int> m_painter_attributes_per_buffer;
   command_line_argument_value<int> m_painter_indices_per_buffer;
   command_line_argument_value<int> m_painter_number_pools;
+  command_line_argument_value<int> m_painter_number_buffer_size_classes;
   command_line_argument_value<bool> m_painter_break_on_shader_change;
   command_line_argument_value<bool> m_uber_vert_use_switch;
   command_line_argument_value<bool> m_uber_frag_use_switch;
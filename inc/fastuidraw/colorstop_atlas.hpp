@@ -238,6 +238,14 @@ namespace fastuidraw
     void
     flush(void) const;
 
+    /*!
+      Returns the total number of bytes of data passed
+      to the backing store of this ColorStopAtlas since
+      its construction.
+     */
+    uint64_t
+    bytes_uploaded(void) const;
+
   private:
     void *m_d;
   };
@@ -192,6 +192,30 @@ namespace fastuidraw
         ConfigurationGL&
         data_blocks_per_store_buffer(unsigned int v);
 
+        /*!
+          Specifies the number of size classes of the
+          buffers of the PainterDraw objects. The largest
+          class is given by attributes_per_buffer(),
+          indices_per_buffer() and data_blocks_per_store_buffer()
+          and each following class is half the size of the
+          class before it; when data_store_backing() is
+          \ref data_store_ubo, the store of every class is
+          the size of the largest class since the size of
+          the UBO is fixed by the shader. The
+          map_draw(unsigned int, unsigned int, unsigned int)
+          overload returns a PainterDraw of the smallest class
+          that holds the requested sizes. Initial value is 1,
+          i.e. all PainterDraw objects are of the largest size.
+         */
+        unsigned int
+        number_buffer_size_classes(void) const;
+
+        /*!
+          Set the value for number_buffer_size_classes(void) const
+        */
+        ConfigurationGL&
+        number_buffer_size_classes(unsigned int v);
+
         /*!
           Returns how the data store is realized. The GL implementation
           may impose size limits that will force that the size of the
@@ -269,7 +293,9 @@ namespace fastuidraw
           is the number of times Painter::begin() - Painter::end()
           pairs are within a frame and L is the latency in
           frames from ending a frame to the GPU finishes
-          rendering the results of the frame.
+          rendering the results of the frame. Buffer objects
+          of a pool that go unused for several uses of the
+          pool in a row are released.
           Initial value is 3.
          */
         unsigned int
@@ -480,6 +506,12 @@ namespace fastuidraw
       reference_counted_ptr<const PainterDraw>
       map_draw(void);
 
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(unsigned int attributes_requested,
+               unsigned int indices_requested,
+               unsigned int store_requested);
+
       virtual
       void
       target_resolution(int w, int h);
@@ -0,0 +1,370 @@
+/*!
+ * \file painter_backend_null.hpp
+ * \brief file painter_backend_null.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/glsl/painter_backend_glsl.hpp>
+
+namespace fastuidraw
+{
+  namespace glsl
+  {
+/*!\addtogroup GLSL
+  @{
+ */
+    /*!
+      \brief
+      A PainterBackendNull implements PainterBackend against
+      plain host memory; it does not issue any 3D API calls and
+      thus does not need a 3D API context to exist.
+
+      The purpose of PainterBackendNull is to allow running (and
+      profiling) all of the CPU work of Painter and PainterPacker
+      without a GPU, and optionally to record the contents of each
+      PainterDraw for later inspection. The shaders are the same
+      as those of PainterBackendGLSL, so the uber-shader source
+      can still be queried via PainterBackendGLSL::construct_shader().
+     */
+    class PainterBackendNull:public PainterBackendGLSL
+    {
+    public:
+      /*!
+        \brief
+        A ConfigurationNull gives parameters how to contruct
+        a PainterBackendNull.
+       */
+      class ConfigurationNull
+      {
+      public:
+        /*!
+          Ctor.
+         */
+        ConfigurationNull(void);
+
+        /*!
+          Copy ctor.
+          \param obj value from which to copy
+         */
+        ConfigurationNull(const ConfigurationNull &obj);
+
+        ~ConfigurationNull();
+
+        /*!
+          Assignment operator
+          \param rhs value from which to copy
+         */
+        ConfigurationNull&
+        operator=(const ConfigurationNull &rhs);
+
+        /*!
+          Swap operation
+          \param obj object with which to swap
+        */
+        void
+        swap(ConfigurationNull &obj);
+
+        /*!
+          The ImageAtlas to be used by the painter. If the
+          value is nullptr, the PainterBackendNull will create
+          an ImageAtlas whose backing stores discard all data.
+         */
+        const reference_counted_ptr<ImageAtlas>&
+        image_atlas(void) const;
+
+        /*!
+          Set the value returned by image_atlas(void) const.
+          Default value is nullptr.
+         */
+        ConfigurationNull&
+        image_atlas(const reference_counted_ptr<ImageAtlas> &v);
+
+        /*!
+          The ColorStopAtlas to be used by the painter. If the
+          value is nullptr, the PainterBackendNull will create
+          a ColorStopAtlas whose backing store discards all data.
+         */
+        const reference_counted_ptr<ColorStopAtlas>&
+        colorstop_atlas(void) const;
+
+        /*!
+          Set the value returned by colorstop_atlas(void) const.
+          Default value is nullptr.
+         */
+        ConfigurationNull&
+        colorstop_atlas(const reference_counted_ptr<ColorStopAtlas> &v);
+
+        /*!
+          The GlyphAtlas to be used by the painter. If the
+          value is nullptr, the PainterBackendNull will create
+          a GlyphAtlas whose backing stores discard all data.
+         */
+        const reference_counted_ptr<GlyphAtlas>&
+        glyph_atlas(void) const;
+
+        /*!
+          Set the value returned by glyph_atlas(void) const.
+          Default value is nullptr.
+         */
+        ConfigurationNull&
+        glyph_atlas(const reference_counted_ptr<GlyphAtlas> &v);
+
+        /*!
+          Specifies the maximum number of attributes
+          a PainterDraw returned by map_draw() may
+          store, i.e. the size of PainterDraw::m_attributes.
+          Initial value is 512 * 512.
+         */
+        unsigned int
+        attributes_per_buffer(void) const;
+
+        /*!
+          Set the value for attributes_per_buffer(void) const
+        */
+        ConfigurationNull&
+        attributes_per_buffer(unsigned int v);
+
+        /*!
+          Specifies the maximum number of indices
+          a PainterDraw returned by map_draw() may
+          store, i.e. the size of PainterDraw::m_indices.
+          Initial value is 1.5 times the initial value
+          for attributes_per_buffer(void) const.
+         */
+        unsigned int
+        indices_per_buffer(void) const;
+
+        /*!
+          Set the value for indices_per_buffer(void) const
+        */
+        ConfigurationNull&
+        indices_per_buffer(unsigned int v);
+
+        /*!
+          Specifies the maximum number of blocks of
+          data a PainterDraw returned by map_draw()
+          may store. The size of PainterDraw::m_store
+          is given by data_blocks_per_store_buffer() *
+          PainterBackend::ConfigurationBase::alignment(),
+          Initial value is 1024 * 64.
+         */
+        unsigned int
+        data_blocks_per_store_buffer(void) const;
+
+        /*!
+          Set the value for data_blocks_per_store_buffer(void) const
+        */
+        ConfigurationNull&
+        data_blocks_per_store_buffer(unsigned int v);
+
+        /*!
+          Specifies the number of size classes of the
+          buffers of the PainterDraw objects. The largest
+          class is given by attributes_per_buffer(),
+          indices_per_buffer() and data_blocks_per_store_buffer()
+          and each following class is half the size of the
+          class before it. The map_draw(unsigned int, unsigned int, unsigned int)
+          overload returns a PainterDraw of the smallest class
+          that holds the requested sizes. Initial value is 1,
+          i.e. all PainterDraw objects are of the largest size.
+         */
+        unsigned int
+        number_buffer_size_classes(void) const;
+
+        /*!
+          Set the value for number_buffer_size_classes(void) const
+        */
+        ConfigurationNull&
+        number_buffer_size_classes(unsigned int v);
+
+        /*!
+          If true, the contents of each PainterDraw drawn
+          are copied into a DrawRecord and retained by the
+          PainterBackendNull until clear_recorded_draws()
+          is called.
+         */
+        bool
+        record_draws(void) const;
+
+        /*!
+          Set the value for record_draws(void) const.
+          Default value is false.
+         */
+        ConfigurationNull&
+        record_draws(bool v);
+
+        /*!
+          Returns the value to feed to
+          PainterBackendGLSL::ConfigurationGLSL::use_hw_clip_planes().
+         */
+        bool
+        use_hw_clip_planes(void) const;
+
+        /*!
+          Set the value returned by use_hw_clip_planes(void) const.
+          Default value is true.
+         */
+        ConfigurationNull&
+        use_hw_clip_planes(bool v);
+
+      private:
+        void *m_d;
+      };
+
+      /*!
+        \brief
+        A DrawRecord holds a copy of the data written to
+        a PainterDraw returned by map_draw() of a
+        PainterBackendNull. Only the portions of the
+        buffers that were written to are stored.
+       */
+      class DrawRecord:public reference_counted<DrawRecord>::default_base
+      {
+      public:
+        virtual
+        ~DrawRecord()
+        {}
+
+        /*!
+          To be implemented by a derived class to return the
+          attributes written to PainterDraw::m_attributes.
+         */
+        virtual
+        c_array<const PainterAttribute>
+        attributes(void) const = 0;
+
+        /*!
+          To be implemented by a derived class to return the
+          values written to PainterDraw::m_header_attributes.
+         */
+        virtual
+        c_array<const uint32_t>
+        header_attributes(void) const = 0;
+
+        /*!
+          To be implemented by a derived class to return the
+          indices written to PainterDraw::m_indices.
+         */
+        virtual
+        c_array<const PainterIndex>
+        indices(void) const = 0;
+
+        /*!
+          To be implemented by a derived class to return the
+          data written to PainterDraw::m_store.
+         */
+        virtual
+        c_array<const generic_data>
+        store(void) const = 0;
+
+        /*!
+          To be implemented by a derived class to return,
+          for each call to PainterDraw::draw_break(), the
+          number of indices that had been written when
+          the draw break was issued.
+         */
+        virtual
+        c_array<const unsigned int>
+        draw_breaks(void) const = 0;
+      };
+
+      /*!
+        Ctor.
+        \param config_null ConfigurationNull providing configuration parameters
+        \param config_base ConfigurationBase parameters inherited from PainterBackend
+       */
+      explicit
+      PainterBackendNull(const ConfigurationNull &config_null = ConfigurationNull(),
+                         const ConfigurationBase &config_base = ConfigurationBase());
+
+      ~PainterBackendNull();
+
+      /*!
+        Returns the ConfigurationNull passed in the ctor.
+       */
+      const ConfigurationNull&
+      configuration_null(void) const;
+
+      /*!
+        Returns the number of PainterDraw objects that
+        have been drawn, i.e. had PainterDraw::draw()
+        called, since construction or the last call to
+        clear_recorded_draws().
+       */
+      unsigned int
+      number_draws(void) const;
+
+      /*!
+        Returns the number of DrawRecord objects held;
+        if ConfigurationNull::record_draws() is false,
+        returns 0.
+       */
+      unsigned int
+      number_recorded_draws(void) const;
+
+      /*!
+        Returns the named DrawRecord; records are
+        stored in the order the PainterDraw objects
+        were drawn.
+        \param I which record with 0 <= I < number_recorded_draws()
+       */
+      const reference_counted_ptr<const DrawRecord>&
+      recorded_draw(unsigned int I) const;
+
+      /*!
+        Release all DrawRecord objects held and reset
+        the value returned by number_draws() to 0.
+       */
+      void
+      clear_recorded_draws(void);
+
+      //////////////////////////////////////////////////////////////
+      // virtual methods from PainterBackend
+      virtual
+      unsigned int
+      attribs_per_mapping(void) const;
+
+      virtual
+      unsigned int
+      indices_per_mapping(void) const;
+
+      virtual
+      void
+      on_pre_draw(void);
+
+      virtual
+      void
+      on_post_draw(void);
+
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(void);
+
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(unsigned int attributes_requested,
+               unsigned int indices_requested,
+               unsigned int store_requested);
+
+    private:
+      void *m_d;
+    };
+/*! @} */
+
+  }
+}
@@ -311,6 +311,14 @@ class Image;
     void
     flush(void) const;
 
+    /*!
+      Returns the total number of bytes of data passed
+      to the index and color backing stores of this
+      ImageAtlas since its construction.
+     */
+    uint64_t
+    bytes_uploaded(void) const;
+
     /*!
       Returns a handle to the backing store for the image data.
      */
@@ -47,7 +47,7 @@ class Path;
   the fill rule.
  */
 class FilledPath:
-    public reference_counted<FilledPath>::non_concurrent
+    public reference_counted<FilledPath>::default_base
 {
 public:
   /*!
@@ -170,9 +170,15 @@ public:
     Ctor. Construct a FilledPath from the data
     of a TessellatedPath.
     \param P source TessellatedPath
+    \param parallel_build if true, the hierarchy of \ref Subset
+                          objects is built by several threads and
+                          select_subsets() triangulates the \ref
+                          Subset objects it needs with several
+                          threads. The resulting FilledPath is
+                          the same regardless of the value.
    */
   explicit
-  FilledPath(const TessellatedPath &P);
+  FilledPath(const TessellatedPath &P, bool parallel_build = false);
 
   ~FilledPath();
 
@@ -184,6 +190,11 @@ public:
 
   /*!
     Return the named Subset object of the FilledPath.
+    If the Subset is not yet triangulated, it is
+    triangulated before this returns; doing so is
+    thread safe, i.e. several threads may call subset()
+    at the same time and a triangulation scheduled by
+    select_subsets_no_wait() is waited on.
    */
   Subset
   subset(unsigned int I) const;
@@ -213,6 +224,39 @@ public:
                  unsigned int max_attribute_cnt,
                  unsigned int max_index_cnt,
                  c_array<unsigned int> dst) const;
+
+  /*!
+    Similar to select_subsets(), except that no triangulation
+    is performed on the calling thread. If all of the \ref Subset
+    objects that select_subsets() would need are triangulated,
+    then writes the same values as select_subsets() and returns
+    true. Otherwise, nothing is written to dst, the triangulation
+    of the \ref Subset objects that are not ready is (optionally)
+    handed to background threads and the method returns false;
+    a later call returns true once those triangulations complete.
+    \param scratch_space scratch space for computations.
+    \param clip_equations array of clip equations
+    \param clip_matrix_local 3x3 transformation from local (x, y, 1)
+                             coordinates to clip coordinates.
+    \param max_attribute_cnt see select_subsets()
+    \param max_index_cnt see select_subsets()
+    \param[out] dst location to which to write the \ref Subset object values
+    \param[out] out_number_subsets location to which to write the number
+                                   of \ref Subset objects selected, written
+                                   only if the return value is true
+    \param schedule_triangulation if true, triangulations that are not
+                                  ready are scheduled to run on background
+                                  threads.
+   */
+  bool
+  select_subsets_no_wait(ScratchSpace &scratch_space,
+                         c_array<const vec3> clip_equations,
+                         const float3x3 &clip_matrix_local,
+                         unsigned int max_attribute_cnt,
+                         unsigned int max_index_cnt,
+                         c_array<unsigned int> dst,
+                         unsigned int *out_number_subsets,
+                         bool schedule_triangulation = true) const;
 private:
   void *m_d;
 };
@@ -124,6 +124,27 @@ namespace fastuidraw
       ConfigurationBase&
       blend_type(enum PainterBlendShader::shader_type tp);
 
+      /*!
+        If true, the PainterPacker tracks by their packed contents
+        the state values (PainterBrush, PainterClipEquations,
+        PainterItemMatrix, PainterItemShaderData and
+        PainterBlendShaderData) that are passed as raw values (i.e.
+        not as PainterPackedValue) and written to PainterDraw::m_store;
+        when an identical value was already written to the store of
+        the current PainterDraw, its location is reused instead of
+        writing the value again.
+       */
+      bool
+      hash_packed_state(void) const;
+
+      /*!
+        Specify the return value to hash_packed_state() const.
+        Default value is false.
+        \param v value
+       */
+      ConfigurationBase&
+      hash_packed_state(bool v);
+
     private:
       void *m_d;
     };
@@ -265,6 +286,26 @@ namespace fastuidraw
     reference_counted_ptr<const PainterDraw>
     map_draw(void) = 0;
 
+    /*!
+      "Map" a PainterDraw for filling of data, requesting
+      the sizes of its buffers. A backend may return a
+      PainterDraw with larger buffers than requested and
+      may return smaller buffers only when the request
+      exceeds what a PainterDraw returned by map_draw(void)
+      can hold. This allows a backend to keep buffers of
+      different sizes so that small amounts of drawing
+      do not need to use the largest buffers. Default
+      implementation returns map_draw(void).
+      \param attributes_requested requested size of PainterDraw::m_attributes
+      \param indices_requested requested size of PainterDraw::m_indices
+      \param store_requested requested size of PainterDraw::m_store
+     */
+    virtual
+    reference_counted_ptr<const PainterDraw>
+    map_draw(unsigned int attributes_requested,
+             unsigned int indices_requested,
+             unsigned int store_requested);
+
     /*!
       Registers a vertex shader for use. Must not be called within a
       on_pre_draw()/on_post_draw() pair.
@@ -196,6 +196,62 @@ namespace fastuidraw
         */
         num_headers,
 
+        /*!
+          Offset to how many PainterDraw objects were ended
+          because the attribute buffer was full.
+         */
+        num_draws_attributes_full,
+
+        /*!
+          Offset to how many PainterDraw objects were ended
+          because the index buffer was full.
+         */
+        num_draws_indices_full,
+
+        /*!
+          Offset to how many PainterDraw objects were ended
+          because the store buffer was full.
+         */
+        num_draws_store_full,
+
+        /*!
+          Offset to how many calls to PainterDraw::draw_break()
+          were made because the item or brush shader changed.
+         */
+        num_draw_breaks_shader,
+
+        /*!
+          Offset to how many calls to PainterDraw::draw_break()
+          were made because the blend shader or blend mode
+          changed. A call made because both the shaders and
+          the blending changed is counted in both this and
+          \ref num_draw_breaks_shader.
+         */
+        num_draw_breaks_blend,
+
+        /*!
+          Offset to how many calls to PainterDraw::draw_break()
+          were made passing a PainterDraw::Action.
+         */
+        num_draw_breaks_action,
+
+        /*!
+          Offset to how many times the data of state (brush,
+          transformation, clipping, shader data) did not need
+          to be written to the store buffer because it was
+          already present, either from a PainterPackedValue
+          already packed into the current PainterDraw or from
+          PainterBackend::ConfigurationBase::hash_packed_state().
+         */
+        num_packed_state_hits,
+
+        /*!
+          Offset to how many times the data of state (brush,
+          transformation, clipping, shader data) was written
+          to the store buffer.
+         */
+        num_packed_state_misses,
+
         /*!
           Number of stats.
          */
@@ -360,6 +416,15 @@ namespace fastuidraw
     unsigned int
     query_stat(enum stats_t st) const;
 
+    /*!
+      Returns a string naming a stats_t value, for
+      example num_draws gives "num_draws".
+      \param st stat to name
+     */
+    static
+    c_string
+    stat_name(enum stats_t st);
+
     /*!
       Returns the PainterBackend::PerformanceHints of the underlying
       PainterBackend of this PainterPacker.
@@ -428,7 +493,80 @@ namespace fastuidraw
     void
     target_resolution(int w, int h);
 
+    /*!
+      Create a recording stream for this PainterPacker. A recording
+      stream is a PainterPacker that does not map or draw any
+      PainterDraw objects of the PainterBackend; instead its
+      begin() / end() pair records the packed attribute, index,
+      header and state data into host memory. The recorded data is
+      later added to the command stream of this PainterPacker with
+      splice_recording_stream(). Because a recording stream does
+      not modify any state of the PainterBackend, different recording
+      streams may be filled by different threads concurrently. The
+      following restrictions apply to a recording stream:
+       - all shaders used must already be registered to the
+         PainterBackend; register_shader() of a recording stream
+         is not thread safe
+       - a PainterPackedValue used on a recording stream must
+         come from a PainterPackedValuePool that is not used
+         by any other PainterPacker concurrently
+       - flush() on a recording stream does nothing
+       - the data recorded is discarded on the next call to begin()
+         of the recording stream.
+
+      This PainterPacker must have had begin() called at least once
+      before creating a recording stream; the buffer sizes of the
+      recording stream are the buffer sizes of the PainterDraw objects
+      returned by PainterBackend::map_draw() so that each recorded
+      PainterDraw will fit within a PainterDraw of the PainterBackend.
+     */
+    reference_counted_ptr<PainterPacker>
+    create_recording_stream(void);
+
+    /*!
+      Returns true if and only if this PainterPacker was created
+      by create_recording_stream().
+     */
+    bool
+    is_recording_stream(void) const;
+
+    /*!
+      Add the data recorded by a recording stream to this PainterPacker
+      as if it were drawn at this point in the command stream. The
+      recording stream must have been created by create_recording_stream()
+      of this PainterPacker and end() must have been called on it
+      since its last begin(). May only be called within a begin() / end()
+      pair of this PainterPacker. The recorded data is copied, so the
+      stream can be reused once this call returns.
+      \param stream recording stream from which to copy data
+      \param z_offset value added to the z-value of each header recorded
+     */
+    void
+    splice_recording_stream(const reference_counted_ptr<const PainterPacker> &stream,
+                            int z_offset);
+
+    /*!
+      Add the data recorded by a recording stream to this PainterPacker
+      with a new transformation and clipping. Each PainterItemMatrix
+      referenced by the recorded data is replaced by the product of
+      transformation with the recorded matrix, and the clip equations
+      of each recorded header are replaced by clip. Otherwise, the same
+      as splice_recording_stream(const reference_counted_ptr<const PainterPacker>&, int).
+      \param stream recording stream from which to copy data
+      \param z_offset value added to the z-value of each header recorded
+      \param transformation matrix by which to left-multiply each recorded
+                            item matrix
+      \param clip clip equations to use for all of the recorded data
+     */
+    void
+    splice_recording_stream(const reference_counted_ptr<const PainterPacker> &stream,
+                            int z_offset, const float3x3 &transformation,
+                            const PainterClipEquations &clip);
+
   private:
+    PainterPacker(reference_counted_ptr<PainterBackend> backend,
+                  const PainterPacker *recording_target);
+
     void *m_d;
   };
 /*! @} */
@@ -28,10 +28,13 @@
 #include <fastuidraw/painter/painter_stroke_params.hpp>
 #include <fastuidraw/painter/painter_dashed_stroke_params.hpp>
 #include <fastuidraw/painter/painter_data.hpp>
+#include <fastuidraw/painter/painter_trace.hpp>
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 
 namespace fastuidraw
 {
+  class PainterDisplayList;
+
 /*!\addtogroup Painter
   @{
  */
@@ -64,6 +67,97 @@ namespace fastuidraw
   class Painter:public reference_counted<Painter>::default_base
   {
   public:
+    /*!
+      \brief
+      A BatchedRect specifies a single rect of
+      a batch of rects drawn by draw_rects().
+     */
+    class BatchedRect
+    {
+    public:
+      /*!
+        Ctor.
+        \param pmin value with which to initialize \ref m_min_point
+        \param wh value with which to initialize \ref m_size
+        \param draw value with which to initialize \ref m_draw
+        \param transformation value with which to initialize \ref m_transformation
+       */
+      BatchedRect(const vec2 &pmin = vec2(0.0f, 0.0f),
+                  const vec2 &wh = vec2(0.0f, 0.0f),
+                  unsigned int draw = 0, int transformation = -1):
+        m_min_point(pmin),
+        m_size(wh),
+        m_draw(draw),
+        m_transformation(transformation)
+      {}
+
+      /*!
+        Min-corner of the rect.
+       */
+      vec2 m_min_point;
+
+      /*!
+        Width and height of the rect.
+       */
+      vec2 m_size;
+
+      /*!
+        Index into the array of PainterData passed
+        to draw_rects() with which to draw the rect.
+       */
+      unsigned int m_draw;
+
+      /*!
+        Index into the array of transformations passed
+        to draw_rects() applied to the rect after the
+        current transformation; a negative value
+        indicates to only apply the current transformation.
+       */
+      int m_transformation;
+    };
+
+    /*!
+      \brief
+      A BatchedGlyphRun specifies a single run of glyphs
+      of a batch of glyph runs drawn by draw_glyph_runs().
+     */
+    class BatchedGlyphRun
+    {
+    public:
+      /*!
+        Ctor.
+        \param data value with which to initialize \ref m_data
+        \param draw value with which to initialize \ref m_draw
+        \param transformation value with which to initialize \ref m_transformation
+       */
+      BatchedGlyphRun(const PainterAttributeData *data = nullptr,
+                      unsigned int draw = 0, int transformation = -1):
+        m_data(data),
+        m_draw(draw),
+        m_transformation(transformation)
+      {}
+
+      /*!
+        Attribute and index data of the glyphs of the
+        run, a nullptr value indicates an empty run.
+       */
+      const PainterAttributeData *m_data;
+
+      /*!
+        Index into the array of PainterData passed to
+        draw_glyph_runs() with which to draw the run.
+       */
+      unsigned int m_draw;
+
+      /*!
+        Index into the array of transformations passed to
+        draw_glyph_runs() applied to the run after the
+        current transformation; a negative value indicates
+        to only apply the current transformation.
+       */
+      int m_transformation;
+    };
+
     /*!
       Ctor.
      */
@@ -200,6 +294,51 @@ namespace fastuidraw
     void
     end(void);
 
+    /*!
+      Create a recording stream Painter for this Painter. A recording
+      stream is a Painter that records its drawing commands into host
+      memory (see PainterPacker::create_recording_stream()) so that
+      different threads can each draw to their own recording stream
+      concurrently. A recording stream has its own z-range, clipping
+      state and PainterPackedValuePool; its drawing is added to this
+      Painter with submit_recording_stream(). Objects that are lazily
+      computed on use (for example Path, Glyph and Image objects) must
+      not be used by multiple recording streams concurrently, and all
+      shaders used must already be registered. This Painter must have
+      had begin() called at least once before creating a recording
+      stream.
+     */
+    reference_counted_ptr<Painter>
+    create_recording_stream(void);
+
+    /*!
+      Queue the commands recorded by a recording stream to be added
+      to this Painter. Within end(), after this Painter's own
+      commands, the queued recording streams are added in the order
+      in which they were submitted; each is drawn with z-values above
+      everything drawn before it. end() must have been called on the
+      stream before end() is called on this Painter, and the stream
+      must not have begin() called on it until end() of this Painter
+      returns. May only be called within a begin() / end() pair.
+      \param stream recording stream, created by create_recording_stream()
+                    of this Painter, to add
+     */
+    void
+    submit_recording_stream(const reference_counted_ptr<Painter> &stream);
+
+    /*!
+      Add the contents of a PainterDisplayList, the coordinates
+      of the display list are the current item coordinates of this
+      Painter and the recorded content is clipped by the current
+      clipping of this Painter. The contents are added immediately,
+      with z-values above everything drawn before. May only be
+      called within a begin() / end() pair.
+      \param list PainterDisplayList, created against this Painter
+                  and not recording, to draw
+     */
+    void
+    draw_display_list(const PainterDisplayList &list);
+
     /*!
       Concats the current transformation matrix
       by a given matrix.
@@ -348,6 +487,104 @@ namespace fastuidraw
     float
     curveFlatness(void);
 
+    /*!
+      Set the hysteresis of the selection of the TessellatedPath
+      of a Path when stroking or filling (or clipping against)
+      a Path. A level of detail of the Path that is already
+      constructed is used as long as its
+      TessellatedPath::effective_curve_distance_threshhold() is
+      no more than the hysteresis times the threshold derived
+      from curveFlatness(float) and the current transformation;
+      a finer level of detail is only constructed beyond that.
+      This avoids constructing a new TessellatedPath each time
+      the threshold crosses to a finer level of detail during
+      a smooth zoom. See also Path::tessellation_no_wait().
+      Values less than 1.0 are clamped to 1.0. Default value
+      is 1.0, i.e. no hysteresis.
+     */
+    void
+    tessellation_hysteresis(float v);
+
+    /*!
+      Returns the value set by tessellation_hysteresis(float).
+     */
+    float
+    tessellation_hysteresis(void) const;
+
+    /*!
+      If true, when stroking or filling (or clipping against)
+      a Path, a level of detail of the Path that is not yet
+      constructed is not waited on; instead it is constructed
+      by a background thread (see Path::tessellation_no_wait())
+      and the finest level of detail already constructed is
+      used until it is ready. Default value is false.
+     */
+    void
+    async_path_tessellation(bool v);
+
+    /*!
+      Returns the value set by async_path_tessellation(bool).
+     */
+    bool
+    async_path_tessellation(void) const;
+
+    /*!
+      If true, when filling (or clipping against) a Path,
+      the triangulation of the FilledPath of the level of
+      detail chosen by curveFlatness(float) is not waited on;
+      instead it is performed by background threads (see
+      FilledPath::select_subsets_no_wait()) and the path is
+      drawn with the finest coarser level of detail whose
+      triangulation is ready. If no level of detail is ready,
+      the coarsest one is triangulated and drawn. Default
+      value is false.
+     */
+    void
+    async_fill_triangulation(bool v);
+
+    /*!
+      Returns the value set by async_fill_triangulation(bool).
+     */
+    bool
+    async_fill_triangulation(void) const;
+
+    /*!
+      If true, the FilledPath and StrokedPath objects that
+      this Painter constructs when filling (or clipping against)
+      and stroking a Path are constructed with several threads,
+      see TessellatedPath::filled(bool) and TessellatedPath::stroked(bool).
+      Default value is false.
+     */
+    void
+    parallel_path_construction(bool v);
+
+    /*!
+      Returns the value set by parallel_path_construction(bool).
+     */
+    bool
+    parallel_path_construction(void) const;
+
+    /*!
+      If true, begin() advances the frame counter of the
+      GlyphAtlas of this Painter, see GlyphAtlas::advance_frame().
+      When several Painter objects share a GlyphAtlas, only one
+      of them should advance the frame (or the application sets
+      this to false on all of them and calls GlyphAtlas::advance_frame()
+      itself once per frame); otherwise the frame counter advances
+      several times per frame and glyphs are evicted sooner than
+      GlyphCache::pinned_frames(unsigned int) asks for. Default value
+      is true, except for the Painter objects returned by
+      create_recording_stream() for which it is false.
+     */
+    void
+    advance_glyph_atlas_frame(bool v);
+
+    /*!
+      Returns the value set by advance_glyph_atlas_frame(bool).
+     */
+    bool
+    advance_glyph_atlas_frame(void) const;
+
     /*!
       Save the current state of this Painter onto the save state stack.
       The state is restored (and the stack popped) by called restore().
@@ -401,6 +638,48 @@ namespace fastuidraw
                 const PainterAttributeData &data, bool use_anistopic_antialias = false,
                 const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+      Draw a batch of glyph runs. Consecutive runs that use the
+      same PainterData and transformation are packed together
+      sharing the same header for each glyph_type. Drawing a batch
+      is equivalent to calling draw_glyphs() on each run except
+      that within a sequence of runs that share a header, the
+      glyphs are drawn ordered first by glyph_type and then by run.
+      \param shader with which to draw the glyphs
+      \param draws array of PainterData indexed by BatchedGlyphRun::m_draw
+      \param transformations array of transformations indexed by
+                             BatchedGlyphRun::m_transformation
+      \param runs glyph runs to draw
+      \param call_back if non-nullptr handle, call back called when attribute data
+                       is added.
+     */
+    void
+    draw_glyph_runs(const PainterGlyphShader &shader,
+                    c_array<const PainterData> draws,
+                    c_array<const float3x3> transformations,
+                    c_array<const BatchedGlyphRun> runs,
+                    const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
+    /*!
+      Draw a batch of glyph runs, see draw_glyph_runs(const PainterGlyphShader&,
+      c_array<const PainterData>, c_array<const float3x3>, c_array<const BatchedGlyphRun>,
+      const reference_counted_ptr<PainterPacker::DataCallBack>&).
+      \param draws array of PainterData indexed by BatchedGlyphRun::m_draw
+      \param transformations array of transformations indexed by
+                             BatchedGlyphRun::m_transformation
+      \param runs glyph runs to draw
+      \param use_anistopic_antialias if true, use default_shaders().glyph_shader_anisotropic()
+                                     otherwise use default_shaders().glyph_shader()
+      \param call_back if non-nullptr handle, call back called when attribute data
+                       is added.
+     */
+    void
+    draw_glyph_runs(c_array<const PainterData> draws,
+                    c_array<const float3x3> transformations,
+                    c_array<const BatchedGlyphRun> runs,
+                    bool use_anistopic_antialias = false,
+                    const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
     /*!
       Stroke a path.
       \param shader shader with which to stroke the attribute data
@@ -762,6 +1041,47 @@ namespace fastuidraw
     draw_rect(const PainterData &draw, const vec2 &p, const vec2 &wh, bool with_anti_aliasing,
               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+      Draw a batch of rects, without anti-aliasing, using a
+      custom shader. Rects that are entirely clipped are
+      skipped and consecutive rects that use the same
+      PainterData and transformation are packed together
+      sharing a single header. Drawing a batch is equivalent
+      to calling draw_rect() on each rect without anti-aliasing
+      but with far less overhead per rect.
+      \param shader shader with which to draw the rects
+      \param draws array of PainterData indexed by BatchedRect::m_draw
+      \param transformations array of transformations indexed by
+                             BatchedRect::m_transformation
+      \param rects rects to draw
+      \param call_back if non-nullptr handle, call back called when attribute data
+                       is added.
+     */
+    void
+    draw_rects(const PainterFillShader &shader,
+               c_array<const PainterData> draws,
+               c_array<const float3x3> transformations,
+               c_array<const BatchedRect> rects,
+               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
+    /*!
+      Draw a batch of rects, without anti-aliasing, using the
+      default fill shader, see draw_rects(const PainterFillShader&,
+      c_array<const PainterData>, c_array<const float3x3>,
+      c_array<const BatchedRect>, const reference_counted_ptr<PainterPacker::DataCallBack>&).
+      \param draws array of PainterData indexed by BatchedRect::m_draw
+      \param transformations array of transformations indexed by
+                             BatchedRect::m_transformation
+      \param rects rects to draw
+      \param call_back if non-nullptr handle, call back called when attribute data
+                       is added.
+     */
+    void
+    draw_rects(c_array<const PainterData> draws,
+               c_array<const float3x3> transformations,
+               c_array<const BatchedRect> rects,
+               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
     /*!
       Draw generic attribute data.
       \param shader shader with which to draw data
@@ -846,6 +1166,26 @@ namespace fastuidraw
     unsigned int
     query_stat(enum PainterPacker::stats_t st) const;
 
+    /*!
+      Set the PainterTrace to which this Painter records its
+      events. When set, the Painter records the time spent
+      in FilledPath::select_subsets(), StrokedPath::compute_chunks()
+      and in the clipping methods, and at end() records the
+      duration of the frame, the values of query_stat() for
+      each PainterPacker::stats_t and the bytes uploaded to
+      each atlas between begin() and end(). Default value
+      is nullptr, i.e. no tracing.
+      \param v PainterTrace to use, a value of nullptr disables tracing
+     */
+    void
+    trace(const reference_counted_ptr<PainterTrace> &v);
+
+    /*!
+      Returns the value set by trace(const reference_counted_ptr<PainterTrace>&).
+     */
+    const reference_counted_ptr<PainterTrace>&
+    trace(void) const;
+
     /*!
       Return the z-depth value that the next item will have.
      */
@@ -912,6 +1252,10 @@ namespace fastuidraw
     register_shader(const PainterShaderSet &p);
 
   private:
+    explicit
+    Painter(reference_counted_ptr<PainterBackend> backend,
+            reference_counted_ptr<PainterPacker> recording_stream);
+
     void
     stroke_path_common(const PainterStrokeShader &shader, const PainterData &draw,
                        const DashEvaluatorBase *dash_evaluator,
@@ -136,6 +136,16 @@ namespace fastuidraw
     range_type<int>
     z_range(unsigned int i) const;
 
+    /*!
+      Returns the glyphs whose locations in a GlyphAtlas the
+      data refers to, as given by PainterAttributeDataFiller::fill_glyphs().
+      Painter::draw_glyphs() marks these glyphs as used (see
+      Glyph::mark_used()) so that they are not evicted from the
+      GlyphAtlas while the data is drawn.
+     */
+    c_array<const Glyph>
+    glyphs(void) const;
+
   private:
     void *m_d;
   };
@@ -25,6 +25,8 @@
 
 namespace fastuidraw
 {
+  class Glyph;
+
 /*!\addtogroup Painter
   @{
  */
@@ -90,6 +92,36 @@ namespace fastuidraw
               c_array<c_array<const PainterIndex> > index_chunks,
               c_array<range_type<int> > zranges,
               c_array<int> index_adjusts) const = 0;
+
+    /*!
+      To be optionally implemented by a derived class to give
+      the number of glyphs whose locations in a GlyphAtlas are
+      referred to by the filled data, see fill_glyphs().
+      Called after fill_data(). Default implementation
+      returns 0.
+     */
+    virtual
+    unsigned int
+    number_glyphs_referenced(void) const
+    {
+      return 0;
+    }
+
+    /*!
+      To be optionally implemented by a derived class to give
+      the glyphs whose locations in a GlyphAtlas are referred
+      to by the filled data (PainterAttributeData::glyphs()).
+      Called after fill_data(). Default implementation does
+      nothing.
+      \param glyphs location to which to write the glyphs, the
+                    size is number_glyphs_referenced()
+     */
+    virtual
+    void
+    fill_glyphs(c_array<Glyph> glyphs) const
+    {
+      FASTUIDRAWunused(glyphs);
+    }
   };
 /*! @} */
 }
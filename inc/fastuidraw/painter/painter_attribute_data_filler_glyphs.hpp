@@ -38,7 +38,10 @@ namespace fastuidraw
     The enumeration glyph_type provide the indices into
     PainterAttributeData::attribute_data_chunks() and
     PainterAttributeData::index_data_chunks() for the different
-    glyph types. If a glyph is not uploaded to its GlyphCache and
+    glyph types. A glyph that is not ready (see Glyph::ready()) is
+    filled with its fallback glyph (see Glyph::fallback()), which
+    may be of a different glyph_type, or skipped if it has no
+    fallback glyph. If a glyph is not uploaded to its GlyphCache and
     failed to be uploaded to its GlyphCache, then filling will
     only fill the PainterAttrributeData to the last glyph that
     successfully uploaded to its GlyphCache. That value can be
@@ -120,6 +123,17 @@ namespace fastuidraw
     unsigned int
     number_glyphs(void) const;
 
+    /*!
+      After calling PainterAttributeData::set_data() with this object,
+      returns the number of glyphs that were not ready (see
+      Glyph::ready()) when the data was filled; such a glyph is
+      filled with its fallback glyph (Glyph::fallback()) or, if it
+      has none, is not filled at all. A caller should fill the data
+      again once these glyphs are ready to draw them properly.
+     */
+    unsigned int
+    number_pending_glyphs(void) const;
+
     virtual
     void
     compute_sizes(unsigned int &number_attributes,
@@ -136,6 +150,14 @@ namespace fastuidraw
               c_array<range_type<int> > zranges,
               c_array<int> index_adjusts) const;
 
+    virtual
+    unsigned int
+    number_glyphs_referenced(void) const;
+
+    virtual
+    void
+    fill_glyphs(c_array<Glyph> glyphs) const;
+
   private:
     void *m_d;
   };
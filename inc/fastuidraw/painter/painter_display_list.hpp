@@ -0,0 +1,146 @@
+/*!
+ * \file painter_display_list.hpp
+ * \brief file painter_display_list.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/matrix.hpp>
+#include <fastuidraw/painter/painter.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Painter
+  @{
+ */
+
+  /*!
+    \brief
+    A PainterDisplayList records drawing commands once so that
+    they can be added to a Painter any number of times, each
+    time with a different transformation and clipping, via
+    Painter::draw_display_list().
+
+    Recording is done with a recording stream (see
+    Painter::create_recording_stream()) of the Painter passed
+    at construction; the attribute, index and data store
+    values of the recording are copied directly on each
+    replay, so replaying does not re-pack any state, re-run
+    any clipping or re-select any tessellation. The drawing
+    commands are given in the coordinate system of the
+    display list, which is the coordinate system of the
+    Painter at the time Painter::draw_display_list() is called.
+    Limitations are:
+     - content recorded outside of the bounding box passed
+       to begin() is culled,
+     - clipIn() within the recording only applies its
+       rectangle clipping to later content within the recording
+       and the clip equations of the recording are replaced by
+       those of the Painter replaying it; clipOut() within the
+       recording is retained,
+     - tessellation of paths is selected at recording time
+       as if the bounding box passed to begin() covered the
+       entire target resolution of the Painter, thus replaying
+       with a large magnification may show faceting,
+     - the recorded data is only valid for the Painter passed
+       at construction and only as long as the atlas locations
+       of the images, glyphs and color stops used remain valid;
+       the glyphs drawn with Painter::draw_glyphs() or
+       Painter::draw_glyph_runs() while recording are marked
+       as used (see Glyph::mark_used()) on each replay so that
+       a GlyphCache does not evict them.
+   */
+  class PainterDisplayList:
+    public reference_counted<PainterDisplayList>::default_base
+  {
+  public:
+    /*!
+      Ctor. The Painter must have had Painter::begin()
+      called at least once before constructing a
+      PainterDisplayList for it.
+      \param target Painter to which the display list will be added
+     */
+    explicit
+    PainterDisplayList(const reference_counted_ptr<Painter> &target);
+
+    ~PainterDisplayList();
+
+    /*!
+      Begin recording, any previously recorded content is
+      discarded. Returns the Painter to which to issue the
+      drawing commands to record; the transformation of
+      the returned Painter is set so that the coordinates
+      of the display list are the item coordinates; drawing
+      is to be done in coordinates of the display list
+      and content outside of the named bounding box
+      is culled.
+      \param min_bb min-corner of the bounding box of the content
+      \param max_bb max-corner of the bounding box of the content
+     */
+    const reference_counted_ptr<Painter>&
+    begin(const vec2 &min_bb, const vec2 &max_bb);
+
+    /*!
+      End recording. Once end() is called, the display list
+      may be added to the Painter passed at construction
+      with Painter::draw_display_list().
+     */
+    void
+    end(void);
+
+    /*!
+      Returns true if and only if begin() has been called
+      without a matching end().
+     */
+    bool
+    recording(void) const;
+
+    /*!
+      Returns the Painter to which drawing commands are issued
+      for recording, i.e. the same value as returned by begin().
+     */
+    const reference_counted_ptr<Painter>&
+    painter(void) const;
+
+    /*!
+      Returns the min-corner of the bounding box passed to begin().
+     */
+    const vec2&
+    min_bb(void) const;
+
+    /*!
+      Returns the max-corner of the bounding box passed to begin().
+     */
+    const vec2&
+    max_bb(void) const;
+
+    /*!
+      Returns the inverse of the transformation applied to
+      the recording Painter by begin(), i.e. the transformation
+      from the clip-coordinates of the recording to the
+      coordinates of the display list.
+     */
+    const float3x3&
+    inverse_transformation(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
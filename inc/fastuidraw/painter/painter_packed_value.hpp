@@ -78,10 +78,16 @@ namespace fastuidraw
     already copied to PainterDraw::m_store.
 
     If already on a store, then rather than copying the data again, the data
-    is reused. The object behind the handle is NOT thread safe. In addition
-    the underlying reference count is not either. Hence any access
-    (even dtor, copy ctor and equality operator) on a fixed object cannot
-    be done from multiple threads simutaneously. A fixed
+    is reused. The object behind the handle is NOT thread safe. In addition,
+    unless the PainterPackedValue was created by a PainterPackedValuePool
+    that is thread safe (see PainterPackedValuePool::thread_safe()), the
+    underlying reference count is not either. Hence any access (even dtor,
+    copy ctor and equality operator) on a fixed object cannot be done from
+    multiple threads simutaneously unless it comes from a thread safe
+    PainterPackedValuePool, in which case the dtor, copy ctor, assignment
+    and value() can be called from multiple threads simutaneously. Packing
+    the same object from multiple threads (i.e. using it on different Painter
+    objects from different threads simutaneously) is never thread safe. A fixed
     PainterPackedValue can be used by different Painter (and PainterPacker)
     objects subject to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of these
@@ -206,10 +212,15 @@ namespace fastuidraw
     A PainterPackedValuePool can be used to create PainterPackedValue
     objects.
 
-    Just like PainterPackedValue, PainterPackedValuePool is
-    NOT thread safe, as such it is not a safe operation to use the
+    By default, just like PainterPackedValue, PainterPackedValuePool
+    is NOT thread safe, as such it is not a safe operation to use the
     same PainterPackedValuePool object from multiple threads at the
-    same time. A fixed PainterPackedValuePool can create PainterPackedValue
+    same time. A PainterPackedValuePool constructed with thread_safe
+    as true can have create_packed_value() called from multiple threads
+    simutaneously, with the allocation of PainterPackedValue objects
+    being lock free (except when the pool needs to grow), and the
+    PainterPackedValue objects it creates have a thread safe reference
+    count. A fixed PainterPackedValuePool can create PainterPackedValue
     objects used by different Painter (and PainterPacker) objects subject
     to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of
@@ -222,12 +233,22 @@ namespace fastuidraw
       Ctor.
       \param painter_alignment the alignment to create packed data, see
                                 PainterPacker::Configuration::alignment()
+      \param thread_safe if true, the created PainterPackedValuePool can
+                         be used from multiple threads simutaneously and
+                         the PainterPackedValue objects it creates have
+                         a thread safe reference count
      */
     explicit
-    PainterPackedValuePool(int painter_alignment);
+    PainterPackedValuePool(int painter_alignment, bool thread_safe = false);
 
     ~PainterPackedValuePool();
 
+    /*!
+      Returns the value of thread_safe passed to the ctor.
+     */
+    bool
+    thread_safe(void) const;
+
     /*!
       Create and return a PainterPackedValue<PainterBrush>
       object for the value of a PainterBrush object.
@@ -0,0 +1,137 @@
+/*!
+ * \file painter_trace.hpp
+ * \brief file painter_trace.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Painter
+  @{
+ */
+
+  /*!
+    \brief
+    A PainterTrace records timed events and counters so
+    that the work of a Painter can be inspected, for
+    example in the trace viewer of Chrome (chrome://tracing)
+    via chrome_trace_json(). When a PainterTrace is set on a
+    Painter (see Painter::trace()), the Painter records the
+    time spent in selecting the chunks of paths to draw (as
+    one event for all the selections made while the same
+    PainterDraw is current), the time spent in clipping and,
+    at Painter::end(),
+    the values of all PainterPacker::stats_t for the frame
+    and the bytes uploaded to each atlas during the frame.
+    The methods of PainterTrace are thread safe.
+   */
+  class PainterTrace:public reference_counted<PainterTrace>::default_base
+  {
+  public:
+    /*!
+      Ctor.
+     */
+    PainterTrace(void);
+
+    ~PainterTrace();
+
+    /*!
+      Returns the current time, in microseconds, of
+      the clock used to time events.
+     */
+    static
+    uint64_t
+    time_stamp(void);
+
+    /*!
+      Add an event with a duration; the thread
+      of the event is the calling thread.
+      \param name name of the event
+      \param category category of the event
+      \param start value of time_stamp() at the start of the event
+      \param end value of time_stamp() at the end of the event
+     */
+    void
+    add_duration_event(c_string name, c_string category,
+                       uint64_t start, uint64_t end);
+
+    /*!
+      Add an event with a duration and a named set of
+      values attached to it; the thread of the event is
+      the calling thread.
+      \param name name of the event
+      \param category category of the event
+      \param start value of time_stamp() at the start of the event
+      \param end value of time_stamp() at the end of the event
+      \param labels label of each value
+      \param values value attached to the event, must be the
+                    same size as labels
+     */
+    void
+    add_duration_event(c_string name, c_string category,
+                       uint64_t start, uint64_t end,
+                       c_array<const c_string> labels,
+                       c_array<const uint64_t> values);
+
+    /*!
+      Add a counter event, i.e. named set of values
+      at a point in time.
+      \param name name of the counter
+      \param labels label of each value
+      \param values value of each counter, must be the same
+                    size as labels
+      \param time value of time_stamp() of the counter values
+     */
+    void
+    add_counter_event(c_string name,
+                      c_array<const c_string> labels,
+                      c_array<const uint64_t> values,
+                      uint64_t time);
+
+    /*!
+      Returns the number of events added since
+      construction or the last call to clear().
+     */
+    unsigned int
+    number_events(void) const;
+
+    /*!
+      Remove all events.
+     */
+    void
+    clear(void);
+
+    /*!
+      Returns the events added since construction or
+      the last call to clear() formatted as a JSON object
+      in the Chrome trace event format.
+     */
+    std::string
+    chrome_trace_json(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
@@ -56,7 +56,7 @@ class DashEvaluatorBase;
   the cap and join type.
  */
 class StrokedPath:
-    public reference_counted<StrokedPath>::non_concurrent
+    public reference_counted<StrokedPath>::default_base
 {
 public:
   /*!
@@ -669,9 +669,13 @@ public:
     Ctor. Construct a StrokedPath from the data
     of a TessellatedPath.
     \param P source TessellatedPath
+    \param parallel_build if true, the culling hierarchy and the
+                          attribute data of the edges, joins and caps
+                          are created by several threads. The resulting
+                          StrokedPath is the same regardless of the value.
    */
   explicit
-  StrokedPath(const TessellatedPath &P);
+  StrokedPath(const TessellatedPath &P, bool parallel_build = false);
 
   ~StrokedPath();
 
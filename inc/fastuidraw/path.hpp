@@ -43,7 +43,7 @@ namespace fastuidraw  {
   to the first point.
  */
 class PathContour:
-    public reference_counted<PathContour>::non_concurrent
+    public reference_counted<PathContour>::default_base
 {
 public:
 
@@ -143,6 +143,23 @@ public:
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const = 0;
 
+    /*!
+      To be optionally implemented by a derived class to give the
+      values that, together with the type of the interpolator,
+      start_pt() and end_pt(), determine the edge of the interpolator.
+      Path objects using Path::share_tessellation(bool) share their
+      tessellations when their interpolators agree in all of these.
+      Returns false if the edge cannot be described by such values,
+      in which case a Path with the interpolator never shares its
+      tessellation. Default implementation returns false.
+      \param out_values (output) location to which to write the values;
+                                 the values must stay valid for the
+                                 lifetime of the interpolator
+     */
+    virtual
+    bool
+    geometry_values(c_array<const float> *out_values) const;
+
   private:
     friend class PathContour;
     void *m_d;
@@ -183,6 +200,10 @@ public:
     virtual
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
+
+    virtual
+    bool
+    geometry_values(c_array<const float> *out_values) const;
   };
 
   /*!
@@ -327,6 +348,24 @@ public:
     interpolator_base*
     deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const;
 
+    virtual
+    bool
+    geometry_values(c_array<const float> *out_values) const;
+
+    /*!
+      Overrides interpolator_generic::produce_tessellation(). For
+      quadratic and cubic curves with TessellatedPath::TessellationParams::m_curvature_tessellation
+      false, the number of segments is computed directly from the
+      control points and the curve is evaluated at uniformly spaced
+      times; otherwise falls back to interpolator_generic::produce_tessellation().
+     */
+    virtual
+    unsigned int
+    produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
+                         c_array<TessellatedPath::point> out_data,
+                         float *out_effective_curve_distance,
+                         float *out_effective_curvature) const;
+
   private:
     bezier(const bezier &q,
            const reference_counted_ptr<const interpolator_base> &prev);
@@ -376,6 +415,10 @@ public:
                          float *out_effective_curve_distance,
                          float *out_effective_curvature) const;
 
+    virtual
+    bool
+    geometry_values(c_array<const float> *out_values) const;
+
   private:
     arc(const arc &q, const reference_counted_ptr<const interpolator_base> &prev);
 
@@ -538,6 +581,13 @@ private:
   and \ref contour_end) means to specify
   the edge from the last point of the current
   contour to the first point of it.
+
+  The const methods of a Path (and of the TessellatedPath,
+  StrokedPath and FilledPath objects it lazily creates) may
+  be called from several threads at the same time, for
+  example to create the tessellations needed later on a
+  background thread. Modifying a Path while another thread
+  accesses it is not supported.
  */
 class Path
 {
@@ -915,7 +965,10 @@ public:
     level of detail. The TessellatedPath is constructed
     lazily. Additionally, if this Path changes its geometry,
     then a new TessellatedPath will be contructed on the
-    next call to tessellation().
+    next call to tessellation(). The levels of detail other
+    than the coarsest one are held by the TessellatedPathCache
+    which may drop them (to be constructed again when needed)
+    to stay within its byte budget.
     \param thresh the returned tessellated path will be so that
                   TessellatedPath::effective_curve_distance_threshhold()
                   is no more than thresh. A non-positive value
@@ -923,7 +976,7 @@ public:
                   is created with default values of
                   TessellatedPath::TessellationParams.
    */
-  const reference_counted_ptr<const TessellatedPath>&
+  reference_counted_ptr<const TessellatedPath>
   tessellation(float thresh) const;
 
   /*!
@@ -933,9 +986,103 @@ public:
     If this Path changes its geometry, then a new TessellatedPath
     will be contructed on the next call to tessellation().
    */
-  const reference_counted_ptr<const TessellatedPath>&
+  reference_counted_ptr<const TessellatedPath>
   tessellation(void) const;
 
+  /*!
+    Return a tessellation of this Path for the threshold thresh
+    without constructing one, other than the coarsest level of
+    detail, on the calling thread. If tessellation(float) would
+    return a TessellatedPath already constructed, returns it.
+    Otherwise, if the TessellatedPath::effective_curve_distance_threshhold()
+    of the finest level of detail already constructed is no more
+    than slack * thresh, returns that level of detail. Otherwise
+    returns nullptr and, if schedule is true, constructs the level
+    of detail of tessellation(thresh) on a background thread (unless
+    one is already pending), so that a later call finds it ready.
+    Passing a large value for slack returns the finest level of
+    detail already constructed. Nothing is scheduled while the
+    last contour of this Path is not ended.
+    \param thresh as in tessellation(float)
+    \param slack factor (at least 1.0) by which a level of detail
+                 already constructed may be coarser than thresh
+                 and still be returned
+    \param schedule if true, schedule the construction of the level
+                    of detail when nullptr is returned
+   */
+  reference_counted_ptr<const TessellatedPath>
+  tessellation_no_wait(float thresh, float slack, bool schedule) const;
+
+  /*!
+    Set if the TessellatedPath objects constructed by tessellation()
+    and tessellation(float) are constructed with
+    TessellatedPath::TessellationParams::m_compact_storage true.
+    Changing the value drops the TessellatedPath objects
+    already constructed. Default value is false.
+    \param v value to use
+   */
+  Path&
+  compact_tessellation_storage(bool v);
+
+  /*!
+    Returns the value set by compact_tessellation_storage(bool).
+   */
+  bool
+  compact_tessellation_storage(void) const;
+
+  /*!
+    Returns the number of TessellatedPath objects of this
+    Path that have been constructed by tessellation(float)
+    (and are still valid, i.e. the Path has not changed
+    geometry since), including those that have been dropped
+    by the TessellatedPathCache but not yet noticed by
+    tessellation(float).
+   */
+  unsigned int
+  number_tessellation_lods(void) const;
+
+  /*!
+    Returns one of the TessellatedPath objects already
+    constructed by tessellation(float); they are sorted
+    from lowest to highest level of detail, i.e. the
+    TessellatedPath::effective_curve_distance_threshhold()
+    decreases with I. Unlike tessellation(float), never
+    constructs a TessellatedPath; returns nullptr if the
+    TessellatedPath was dropped by the TessellatedPathCache.
+    The value for I = 0 is never nullptr.
+    \param I which TessellatedPath with 0 <= I < number_tessellation_lods()
+   */
+  reference_counted_ptr<const TessellatedPath>
+  tessellation_lod(unsigned int I) const;
+
+  /*!
+    Set if this Path shares its TessellatedPath objects (and
+    with them the StrokedPath and FilledPath objects) with the
+    other Path objects that have the same geometry and that
+    also share their tessellations. Path objects have the
+    same geometry if their contours are made of the same
+    kinds of interpolators with the same points and values
+    (see PathContour::interpolator_base::geometry_values())
+    and they have the same value for
+    compact_tessellation_storage(). The shared tessellations
+    are found through a process wide registry that does not
+    keep them alive, i.e. they are freed once the last Path
+    (or caller) using them drops them. A Path that has a
+    contour that is not ended or that has an interpolator
+    for which PathContour::interpolator_base::geometry_values()
+    returns false does not share its tessellations. Default
+    value is false.
+    \param v value to use
+   */
+  Path&
+  share_tessellation(bool v);
+
+  /*!
+    Returns the value set by share_tessellation(bool).
+   */
+  bool
+  share_tessellation(void) const;
+
 private:
   void *m_d;
 };
@@ -54,7 +54,7 @@ class FilledPath;
   of a TessellatedPath, the closing edge is the last edge.
  */
 class TessellatedPath:
-    public reference_counted<TessellatedPath>::non_concurrent
+    public reference_counted<TessellatedPath>::default_base
 {
 public:
   /*!
@@ -71,7 +71,8 @@ public:
     TessellationParams(void):
       m_curvature_tessellation(true),
       m_threshhold(float(M_PI)/30.0f),
-      m_max_segments(32)
+      m_max_segments(32),
+      m_compact_storage(false)
     {}
 
     /*!
@@ -83,7 +84,8 @@ public:
     {
       return m_curvature_tessellation != rhs.m_curvature_tessellation
         || m_threshhold != rhs.m_threshhold
-        || m_max_segments != rhs.m_max_segments;
+        || m_max_segments != rhs.m_max_segments
+        || m_compact_storage != rhs.m_compact_storage;
     }
 
     /*!
@@ -145,6 +147,17 @@ public:
       return *this;
     }
 
+    /*!
+      Set the value of \ref m_compact_storage.
+      \param v value to which to assign to \ref m_compact_storage
+     */
+    TessellationParams&
+    compact_storage(bool v)
+    {
+      m_compact_storage = v;
+      return *this;
+    }
+
     /*!
       Specifies the meaning of \ref m_threshhold.
      */
@@ -171,6 +184,22 @@ public:
       PathContour of a Path.
      */
     unsigned int m_max_segments;
+
+    /*!
+      If true, the TessellatedPath does not store an array of
+      \ref point values. Instead it stores the positions, the
+      derivatives (in half precision, relative to a per-edge
+      scale) and the distances from the edge start as separate
+      arrays, and stores the edge and contour lengths once per
+      edge and once per contour. The data is then read with
+      number_points(), point_position(), point_derivative(),
+      point_distance_from_edge_start() and point_value(). Calling
+      point_data() (or the other methods returning arrays of
+      \ref point) on such a TessellatedPath builds (once) the
+      full array of \ref point values, giving up the savings.
+      Default value is false.
+     */
+    bool m_compact_storage;
   };
 
   /*!
@@ -269,6 +298,85 @@ public:
   c_array<const point>
   point_data(void) const;
 
+  /*!
+    Returns the number of points of the tessellation, i.e.
+    the size of point_data(). Does not build the array of
+    \ref point values if \ref TessellationParams::m_compact_storage
+    is true.
+   */
+  unsigned int
+  number_points(void) const;
+
+  /*!
+    Returns the value of \ref point::m_p of the named point,
+    i.e. of point_data()[I]. Does not build the array of
+    \ref point values if \ref TessellationParams::m_compact_storage
+    is true.
+    \param I index of the point, must have that 0 <= I < number_points()
+   */
+  vec2
+  point_position(unsigned int I) const;
+
+  /*!
+    Returns the value of \ref point::m_p_t of the named point,
+    i.e. of point_data()[I]. If \ref TessellationParams::m_compact_storage
+    is true, the value is stored in half precision.
+    \param I index of the point, must have that 0 <= I < number_points()
+   */
+  vec2
+  point_derivative(unsigned int I) const;
+
+  /*!
+    Returns the value of \ref point::m_distance_from_edge_start
+    of the named point, i.e. of point_data()[I].
+    \param I index of the point, must have that 0 <= I < number_points()
+   */
+  float
+  point_distance_from_edge_start(unsigned int I) const;
+
+  /*!
+    Returns the named point as a \ref point value, i.e. the
+    value of point_data()[I]. Does not build the array of
+    \ref point values if \ref TessellationParams::m_compact_storage
+    is true.
+    \param contour contour on which the point resides
+    \param edge edge on which the point resides
+    \param I index of the point, must be within edge_range(contour, edge)
+   */
+  point
+  point_value(unsigned int contour, unsigned int edge, unsigned int I) const;
+
+  /*!
+    Returns the length of the named edge, i.e. the value
+    of \ref point::m_edge_length of the points of the edge.
+    \param contour which path contour to query, must have
+                   that 0 <= contour < number_contours()
+    \param edge which edge of the contour to query, must
+                have that 0 <= edge < number_edges(contour)
+   */
+  float
+  edge_length(unsigned int contour, unsigned int edge) const;
+
+  /*!
+    Returns the length of the named contour without its
+    closing edge, i.e. the value of \ref point::m_open_contour_length
+    of the points of the contour.
+    \param contour which path contour to query, must have
+                   that 0 <= contour < number_contours()
+   */
+  float
+  open_contour_length(unsigned int contour) const;
+
+  /*!
+    Returns the length of the named contour with its
+    closing edge, i.e. the value of \ref point::m_closed_contour_length
+    of the points of the contour.
+    \param contour which path contour to query, must have
+                   that 0 <= contour < number_contours()
+   */
+  float
+  closed_contour_length(unsigned int contour) const;
+
   /*!
     Returns the number of contours
    */
@@ -396,6 +504,14 @@ public:
   vec2
   bounding_box_size(void) const;
 
+  /*!
+    Returns an approximation of the number of bytes used by this
+    TessellatedPath, including its StrokedPath (its edges only)
+    and FilledPath (estimated) if those have been constructed.
+   */
+  size_t
+  approximate_memory_usage(void) const;
+
   /*!
     Returns this TessellatedPath stroked. The StrokedPath object
     is constructed lazily.
@@ -403,6 +519,17 @@ public:
   const reference_counted_ptr<const StrokedPath>&
   stroked(void) const;
 
+  /*!
+    Returns this TessellatedPath stroked. The StrokedPath object
+    is constructed lazily; if it is constructed by this call,
+    it is constructed with StrokedPath::StrokedPath(const TessellatedPath&, bool)
+    passing parallel_build.
+    \param parallel_build if the StrokedPath is constructed,
+                          construct it using several threads
+   */
+  const reference_counted_ptr<const StrokedPath>&
+  stroked(bool parallel_build) const;
+
   /*!
     Returns this TessellatedPath filled. The FilledPath object
     is constructed lazily.
@@ -410,6 +537,17 @@ public:
   const reference_counted_ptr<const FilledPath>&
   filled(void) const;
 
+  /*!
+    Returns this TessellatedPath filled. The FilledPath object
+    is constructed lazily; if it is constructed by this call,
+    it is constructed with FilledPath::FilledPath(const TessellatedPath&, bool)
+    passing parallel_build.
+    \param parallel_build if the FilledPath is constructed,
+                          construct it using several threads
+   */
+  const reference_counted_ptr<const FilledPath>&
+  filled(bool parallel_build) const;
+
 private:
   void *m_d;
 };
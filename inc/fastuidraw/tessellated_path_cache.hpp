@@ -0,0 +1,141 @@
+/*!
+ * \file tessellated_path_cache.hpp
+ * \brief file tessellated_path_cache.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stddef.h>
+
+namespace fastuidraw  {
+
+/*!\addtogroup Paths
+  @{
+ */
+
+/*!
+  \brief
+  TessellatedPathCache is the process wide cache holding the
+  TessellatedPath objects that Path::tessellation(float) constructs
+  for the finer levels of detail of each Path.
+
+  The cache has a byte budget; when the memory used by the cached
+  TessellatedPath objects (including their StrokedPath and FilledPath
+  objects once those are constructed) exceeds the budget, the least
+  recently used TessellatedPath objects across all Path objects are
+  dropped from the cache. A dropped level of detail is constructed
+  again by Path::tessellation(float) when it is needed. A
+  TessellatedPath is only freed once it is no longer referenced,
+  so dropping it from the cache never invalidates a
+  reference_counted_ptr held by a caller. The coarsest level of
+  detail of a Path (that of Path::tessellation(void)) is not part of
+  the cache and lives as long as the geometry of the Path is unchanged.
+
+  The methods of TessellatedPathCache are thread safe.
+ */
+class TessellatedPathCache
+{
+public:
+  /*!
+    \brief
+    Statistics of the TessellatedPathCache.
+   */
+  class statistics
+  {
+  public:
+    statistics(void):
+      m_hits(0),
+      m_misses(0),
+      m_evictions(0),
+      m_bytes(0),
+      m_number_entries(0)
+    {}
+
+    /*!
+      Number of times Path::tessellation(float) or
+      Path::tessellation_lod(unsigned int) found a level
+      of detail in the cache.
+     */
+    unsigned int m_hits;
+
+    /*!
+      Number of times Path::tessellation(float) needed
+      to construct a level of detail.
+     */
+    unsigned int m_misses;
+
+    /*!
+      Number of levels of detail dropped from the cache
+      to stay under the byte budget.
+     */
+    unsigned int m_evictions;
+
+    /*!
+      The (approximate) number of bytes used by the levels
+      of detail in the cache.
+     */
+    size_t m_bytes;
+
+    /*!
+      The number of levels of detail in the cache.
+     */
+    unsigned int m_number_entries;
+  };
+
+  /*!
+    Set the byte budget of the cache. A value of 0 indicates
+    no budget, i.e. levels of detail are never evicted. Setting
+    a smaller budget evicts immediately. Default value is 0.
+    \param v byte budget
+   */
+  static
+  void
+  byte_budget(size_t v);
+
+  /*!
+    Returns the value set by byte_budget(size_t).
+   */
+  static
+  size_t
+  byte_budget(void);
+
+  /*!
+    Returns the current statistics of the cache.
+   */
+  static
+  statistics
+  current_statistics(void);
+
+  /*!
+    Reset the values of statistics::m_hits, statistics::m_misses
+    and statistics::m_evictions to zero.
+   */
+  static
+  void
+  reset_statistics(void);
+
+  /*!
+    Drop all levels of detail from the cache.
+   */
+  static
+  void
+  clear(void);
+};
+
+/*! @} */
+
+}
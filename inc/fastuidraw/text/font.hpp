@@ -101,6 +101,25 @@ namespace fastuidraw
     compute_rendering_data(GlyphRender render, uint32_t glyph_code,
                            GlyphLayoutData &layout, Path &path) const = 0;
 
+    /*!
+      To be optionally implemented by a derived class to give
+      a value that identifies, across processes, the data the
+      font generates: two fonts with the same value must return
+      the same data from compute_rendering_data() for the same
+      glyph code and GlyphRender. The value is used by
+      GlyphDiskCache to key the glyph data it stores. Default
+      implementation returns false to indicate that the font
+      has no such value.
+      \param[out] out_key location to which to write the value
+     */
+    virtual
+    bool
+    persistent_key(uint64_t *out_key) const
+    {
+      FASTUIDRAWunused(out_key);
+      return false;
+    }
+
   private:
     FontProperties m_props;
   };
@@ -212,6 +212,17 @@ namespace fastuidraw
     compute_rendering_data(GlyphRender render, uint32_t glyph_code,
                            GlyphLayoutData &layout, Path &path) const;
 
+    /*!
+      Implements FontBase::persistent_key() from a hash of the
+      font data (as loaded by FreeType), the face index and the
+      RenderParams of the FontFreeType. Returns false for fonts
+      whose data FreeType cannot load as a whole, i.e. fonts
+      that are not TrueType or OpenType.
+     */
+    virtual
+    bool
+    persistent_key(uint64_t *out_key) const;
+
   private:
     void *m_d;
   };
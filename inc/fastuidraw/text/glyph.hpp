@@ -81,11 +81,36 @@ namespace fastuidraw
     /*!
       Returns the glyph's layout data, valid()
       must return true. If not, debug builds FASTUIDRAWassert
-      and release builds crash.
+      and release builds crash. If ready() returns false,
+      blocks until the data of the glyph is computed.
      */
     const GlyphLayoutData&
     layout(void) const;
 
+    /*!
+      Returns false while the rendering data of a Glyph
+      fetched with GlyphCache::fetch_glyph_no_wait() is
+      computed on a background thread. While not ready, a
+      Glyph is not uploaded to the GlyphAtlas (upload_to_atlas()
+      returns \ref routine_fail) and layout() and path() block
+      until it is ready. The return value of valid() must be
+      true. If not, debug builds FASTUIDRAWassert and release
+      builds crash.
+     */
+    bool
+    ready(void) const;
+
+    /*!
+      While ready() returns false, returns the Glyph requested
+      by GlyphCache::fetch_glyph_no_wait() to be drawn in place
+      of this Glyph; returns an invalid Glyph if there is no such
+      Glyph or if ready() returns true. The return value of
+      valid() must be true. If not, debug builds FASTUIDRAWassert
+      and release builds crash.
+     */
+    Glyph
+    fallback(void) const;
+
     /*!
       Returns the glyph's location within the a
       GlyphAtlas. The size in the glyph atlas can be
@@ -143,6 +168,22 @@ namespace fastuidraw
     enum return_code
     upload_to_atlas(void) const;
 
+    /*!
+      Marks the Glyph as used in the current frame of the
+      GlyphAtlas of its GlyphCache (see GlyphAtlas::frame()
+      and GlyphCache::lru_eviction(bool)) so that it is not
+      evicted from the GlyphAtlas while that frame is in flight.
+      Does nothing if the Glyph is not uploaded to the GlyphAtlas;
+      unlike upload_to_atlas(), never uploads the Glyph. Called
+      by Painter::draw_glyphs() on the glyphs of the data drawn
+      (PainterAttributeData::glyphs()). May be called from
+      several threads at the same time. The return value of
+      valid() must be true. If not, debug builds FASTUIDRAWassert
+      and release builds crash.
+     */
+    void
+    mark_used(void) const;
+
     /*!
       Returns the path of the Glyph; the path is in
       coordinates of the glyph with the convention
@@ -154,6 +195,8 @@ namespace fastuidraw
       glyphs are rendered with data packed by
       \ref PainterAttributeDataFillerGlyphs with
       \ref PainterEnums::y_increases_downwards.
+      If ready() returns false, blocks until the data of
+      the glyph is computed.
      */
     const Path&
     path(void) const;
@@ -327,6 +327,34 @@ namespace fastuidraw
     void
     flush(void) const;
 
+    /*!
+      Returns the total number of bytes of data passed
+      to the texel and geometry backing stores of this
+      GlyphAtlas since its construction.
+     */
+    uint64_t
+    bytes_uploaded(void) const;
+
+    /*!
+      Advance the frame counter of this GlyphAtlas by one;
+      Painter::begin() calls this on the GlyphAtlas of the
+      Painter unless disabled with Painter::advance_glyph_atlas_frame(bool).
+      The counter should advance exactly once per frame, so when
+      several Painter objects share a GlyphAtlas only one of them
+      (or the application) should advance it. A GlyphCache uses the frame counter of its
+      GlyphAtlas to know which glyphs are used by the frame
+      being drawn, see GlyphCache::lru_eviction(bool).
+     */
+    void
+    advance_frame(void);
+
+    /*!
+      Returns the number of times advance_frame() has been
+      called.
+     */
+    uint64_t
+    frame(void) const;
+
     /*!
       Returns the texel store for this GlyphAtlas.
      */
@@ -24,6 +24,7 @@
 #include <fastuidraw/text/font.hpp>
 #include <fastuidraw/text/glyph_layout_data.hpp>
 #include <fastuidraw/text/glyph.hpp>
+#include <fastuidraw/text/glyph_disk_cache.hpp>
 
 namespace fastuidraw
 {
@@ -34,8 +35,10 @@ namespace fastuidraw
   /*!
     \brief
     A GlyphCache represents a cache of glyphs and manages the uploading
-    of the data to a GlyphAtlas. Methods are reentrant but NOT thread
-    safe.
+    of the data to a GlyphAtlas. The methods fetch_glyph() and
+    fetch_glyph_no_wait() are thread safe (and may be called
+    concurrently with add_glyph() and delete_glyph() on different
+    glyphs); the other methods are reentrant but NOT thread safe.
    */
   class GlyphCache:public reference_counted<GlyphCache>::default_base
   {
@@ -52,13 +55,67 @@ namespace fastuidraw
     /*!
       Fetch, and if necessay create and store, a glyph given a
       glyph code of a font and a GlyphRender specifying how
-      to render the glyph.
+      to render the glyph. Fetching a glyph already in the
+      GlyphCache is a lookup in a hash table, which is split
+      into shards with their own locks so that threads fetching
+      different glyphs rarely wait on each other.
      */
     Glyph
     fetch_glyph(GlyphRender render,
                 const reference_counted_ptr<const FontBase> &font,
                 uint32_t glyph_code);
 
+    /*!
+      Fetch a glyph as in fetch_glyph() except that if the
+      glyph is not yet in the GlyphCache, its rendering data
+      is computed on a background thread and the returned
+      Glyph is not ready (see Glyph::ready()) until the data
+      is computed. Data packed by PainterAttributeDataFillerGlyphs
+      for a Glyph that is not ready draws the fallback glyph in
+      its place (or nothing if there is no fallback glyph);
+      see also PainterAttributeDataFillerGlyphs::number_pending_glyphs().
+      \param render specifies how to render the glyph
+      \param font font of the glyph
+      \param glyph_code glyph code of the glyph
+      \param fallback if valid (see GlyphRender::valid()) and
+                      the glyph is not yet in the GlyphCache,
+                      the glyph with this renderer is fetched
+                      with fetch_glyph() and is returned by
+                      Glyph::fallback() until the glyph is ready;
+                      a coverage glyph of a small pixel size is
+                      much cheaper to compute than distance field
+                      or curve pair glyphs.
+     */
+    Glyph
+    fetch_glyph_no_wait(GlyphRender render,
+                        const reference_counted_ptr<const FontBase> &font,
+                        uint32_t glyph_code,
+                        GlyphRender fallback = GlyphRender());
+
+    /*!
+      Set the GlyphDiskCache of this GlyphCache. Before computing
+      the rendering data of a glyph with FontBase::compute_rendering_data(),
+      the GlyphCache fetches it from its GlyphDiskCache; data
+      that is computed is stored in the GlyphDiskCache. Glyphs
+      already in the GlyphCache are not affected. Default value
+      is a null reference, i.e. no GlyphDiskCache.
+     */
+    void
+    disk_cache(const reference_counted_ptr<GlyphDiskCache> &v);
+
+    /*!
+      Returns the value set by disk_cache(const reference_counted_ptr<GlyphDiskCache>&).
+     */
+    const reference_counted_ptr<GlyphDiskCache>&
+    disk_cache(void) const;
+
+    /*!
+      Returns the number of glyphs fetched by fetch_glyph_no_wait()
+      whose rendering data is still being computed.
+     */
+    unsigned int
+    number_pending_glyphs(void) const;
+
     /*!
       Add a Glyph created with Glyph::create_glyph() to
       this GlyphCache. Will fail if a Glyph with the
@@ -100,6 +157,64 @@ namespace fastuidraw
     void
     clear_cache(void);
 
+    /*!
+      If true, when a Glyph of this GlyphCache fails to upload
+      to the GlyphAtlas (see Glyph::upload_to_atlas()), the least
+      recently used glyphs of this GlyphCache are removed from
+      the GlyphAtlas until the Glyph fits. As with clear_atlas(),
+      the removed glyphs stay in this GlyphCache and are uploaded
+      again by Glyph::upload_to_atlas(). A glyph is used in the
+      current frame of the GlyphAtlas (see GlyphAtlas::frame(),
+      advanced by Painter::begin()) when Glyph::upload_to_atlas()
+      or Glyph::mark_used() is called on it; Painter::draw_glyphs()
+      and Painter::draw_glyph_runs() call Glyph::mark_used() on
+      the glyphs of the data they draw (PainterAttributeData::glyphs())
+      and Painter::draw_display_list() calls it on the glyphs that
+      were drawn when the PainterDisplayList was recorded. The
+      glyphs used within the last pinned_frames() frames are
+      never removed. With pinned_frames() at least 2 (the minimum),
+      the glyphs used in the previous frame are pinned through the
+      whole current frame, so data that is kept across frames
+      stays valid as long as it is drawn in every frame, even if
+      other glyphs are uploaded in the current frame before the
+      data is drawn again. Glyph data drawn in other ways (for
+      example with Painter::draw_generic()) stays valid only if
+      Glyph::mark_used() is called on its glyphs in each frame
+      that draws the data. Default value is false.
+     */
+    void
+    lru_eviction(bool v);
+
+    /*!
+      Returns the value set by lru_eviction(bool).
+     */
+    bool
+    lru_eviction(void) const;
+
+    /*!
+      Set the number of frames of the GlyphAtlas, counting the
+      current frame, during which a glyph stays pinned in the
+      GlyphAtlas after it is used, see lru_eviction(bool). The
+      value is clamped to be at least 2 so that the glyphs used
+      in the current frame and in the previous frame are always
+      pinned. Default value is 2.
+     */
+    void
+    pinned_frames(unsigned int v);
+
+    /*!
+      Returns the value set by pinned_frames(unsigned int).
+     */
+    unsigned int
+    pinned_frames(void) const;
+
+    /*!
+      Returns the number of times a glyph was removed from
+      the GlyphAtlas by lru_eviction(bool).
+     */
+    unsigned int
+    number_evictions(void) const;
+
   private:
     void *m_d;
   };
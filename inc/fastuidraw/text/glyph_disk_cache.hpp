@@ -0,0 +1,124 @@
+/*!
+ * \file glyph_disk_cache.hpp
+ * \brief file glyph_disk_cache.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/text/font.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+  @{
+*/
+
+  /*!
+    \brief
+    A GlyphDiskCache stores the glyph data generated by fonts
+    (i.e. the return values of FontBase::compute_rendering_data())
+    in a file so that the data need not be generated again by
+    later processes. A GlyphCache consults its GlyphDiskCache
+    (see GlyphCache::disk_cache()) before generating the data
+    of a glyph and stores in it the data it generates.
+
+    The data of a glyph is keyed by the value of
+    FontBase::persistent_key() of its font, its glyph code and
+    its GlyphRender; glyphs of fonts without a persistent key
+    are not stored. The data that can be stored is that of
+    GlyphRenderDataCoverage, GlyphRenderDataDistanceField and
+    GlyphRenderDataCurvePair objects whose Path is made of
+    line segments, Bezier curves and arcs.
+
+    The file is memory mapped when the GlyphDiskCache is created;
+    glyphs stored afterwards are appended to the file (and kept
+    in memory). Entries appended by other processes after the
+    file is opened are seen only by GlyphDiskCache objects
+    created later. The file is not portable between machines
+    of different byte order. Methods are thread safe.
+   */
+  class GlyphDiskCache:public reference_counted<GlyphDiskCache>::default_base
+  {
+  public:
+    /*!
+      Ctor. Opens, or creates if it does not exist, the file
+      of the cache. If the file exists but is not a cache file
+      of the same format, it is replaced.
+      \param filename name of the file of the cache
+     */
+    explicit
+    GlyphDiskCache(c_string filename);
+
+    ~GlyphDiskCache();
+
+    /*!
+      Returns true if the file of the cache could be opened.
+      If false, fetch() never finds a glyph and store() always
+      fails.
+     */
+    bool
+    is_open(void) const;
+
+    /*!
+      Fetch the data of a glyph. Returns nullptr if the data
+      is not in the cache. The return value is created with
+      FASTUIDRAWnew as if returned by FontBase::compute_rendering_data().
+      \param font font of the glyph
+      \param render GlyphRender of the glyph
+      \param glyph_code glyph code of the glyph
+      \param[out] layout location to which to write the layout of
+                         the glyph, GlyphLayoutData::m_font is set to font
+      \param[out] path location to which to write the path of the glyph
+     */
+    GlyphRenderData*
+    fetch(const reference_counted_ptr<const FontBase> &font,
+          GlyphRender render, uint32_t glyph_code,
+          GlyphLayoutData &layout, Path &path) const;
+
+    /*!
+      Store the data of a glyph. Fails if the font has no
+      persistent key, if the glyph is already stored, if
+      the data cannot be stored or if writing the file fails.
+      \param font font of the glyph
+      \param render GlyphRender of the glyph
+      \param glyph_code glyph code of the glyph
+      \param data rendering data of the glyph
+      \param layout layout of the glyph
+      \param path path of the glyph
+     */
+    enum return_code
+    store(const reference_counted_ptr<const FontBase> &font,
+          GlyphRender render, uint32_t glyph_code,
+          const GlyphRenderData *data,
+          const GlyphLayoutData &layout, const Path &path);
+
+    /*!
+      Returns the number of glyphs in the cache.
+     */
+    unsigned int
+    number_entries(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
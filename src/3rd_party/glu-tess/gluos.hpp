@@ -1,6 +0,0 @@
-
-#include <stdlib.h>
-#include <stdio.h>
-
-
-#define REGALFASTUIDRAW_GLU_CALL
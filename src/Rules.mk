@@ -8,9 +8,6 @@ d		:= $(dir)
 dir := $(d)/fastuidraw
 include $(dir)/Rules.mk
 
-dir := $(d)/3rd_party
-include $(dir)/Rules.mk
-
 # Begin standard footer
 d		:= $(dirstack_$(sp))
 sp		:= $(basename $(sp))
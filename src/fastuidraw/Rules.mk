@@ -28,7 +28,7 @@ include $(dir)/Rules.mk
 dir := $(d)/gl_backend
 include $(dir)/Rules.mk
 
-FASTUIDRAW_SOURCES += $(call filelist, image.cpp colorstop.cpp colorstop_atlas.cpp path.cpp tessellated_path.cpp)
+FASTUIDRAW_SOURCES += $(call filelist, image.cpp colorstop.cpp colorstop_atlas.cpp path.cpp tessellated_path.cpp tessellated_path_cache.cpp)
 NEGL_SRCS += $(call filelist, egl_binding.cpp)
 
 # Begin standard footer
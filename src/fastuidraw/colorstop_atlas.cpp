@@ -76,6 +76,7 @@ namespace
 
     fastuidraw::reference_counted_ptr<fastuidraw::ColorStopBackingStore> m_backing_store;
     int m_allocated;
+    uint64_t m_bytes_uploaded;
 
     /* Each layer has an interval allocator to allocate
        and free "color stop arrays"
@@ -119,7 +120,8 @@ ColorStopAtlasPrivate::
 ColorStopAtlasPrivate(fastuidraw::reference_counted_ptr<fastuidraw::ColorStopBackingStore> pbacking_store):
   m_delayed_interval_freeing_counter(0),
   m_backing_store(pbacking_store),
-  m_allocated(0)
+  m_allocated(0),
+  m_bytes_uploaded(0)
 {
   FASTUIDRAWassert(m_backing_store);
   add_bookkeeping(m_backing_store->dimensions().y());
@@ -331,6 +333,17 @@ flush(void) const
   d->m_backing_store->flush();
 }
 
+uint64_t
+fastuidraw::ColorStopAtlas::
+bytes_uploaded(void) const
+{
+  ColorStopAtlasPrivate *d;
+  d = static_cast<ColorStopAtlasPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_bytes_uploaded;
+}
+
 int
 fastuidraw::ColorStopAtlas::
 total_available(void) const
@@ -418,6 +431,7 @@ allocate(c_array<const u8vec4> data)
 
   d->m_backing_store->set_data(return_value.x(), return_value.y(),
                                width, data);
+  d->m_bytes_uploaded += data.size() * sizeof(u8vec4);
   d->m_allocated += width;
   return return_value;
 }
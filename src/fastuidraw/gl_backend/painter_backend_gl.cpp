@@ -33,6 +33,7 @@
 
 #include "private/tex_buffer.hpp"
 #include "private/texture_gl.hpp"
+#include "../private/painter_draw_size_classes.hpp"
 
 #ifdef FASTUIDRAW_GL_USE_GLES
 #define GL_SRC1_COLOR GL_SRC1_COLOR_EXT
@@ -67,7 +68,10 @@ namespace
       m_header_bo(0),
       m_index_bo(0),
       m_data_bo(0),
-      m_data_tbo(0)
+      m_data_tbo(0),
+      m_num_attributes(0),
+      m_num_indices(0),
+      m_num_data(0)
     {}
 
     GLuint m_vao;
@@ -75,6 +79,11 @@ namespace
     GLuint m_data_tbo;
     enum fastuidraw::gl::PainterBackendGL::data_store_backing_t m_data_store_backing;
     unsigned int m_data_store_binding_point;
+
+    /* sizes of the buffers in number of elements
+       (PainterAttribute, PainterIndex and generic_data).
+     */
+    unsigned int m_num_attributes, m_num_indices, m_num_data;
   };
 
   class painter_vao_pool:fastuidraw::noncopyable
@@ -88,32 +97,20 @@ namespace
 
     ~painter_vao_pool();
 
+    /* returns the size class for a painter_vao whose
+       buffers hold the requested amounts
+     */
     unsigned int
-    attribute_buffer_size(void) const
-    {
-      return m_attribute_buffer_size;
-    }
-
-    unsigned int
-    header_buffer_size(void) const
-    {
-      return m_header_buffer_size;
-    }
-
-    unsigned int
-    index_buffer_size(void) const
-    {
-      return m_index_buffer_size;
-    }
-
-    unsigned int
-    data_buffer_size(void) const
+    choose_size_class(unsigned int num_attributes,
+                      unsigned int num_indices,
+                      unsigned int num_data) const
     {
-      return m_data_buffer_size;
+      return m_classes.choose(num_attributes, num_indices,
+                              (num_data + m_alignment - 1) / m_alignment);
     }
 
     painter_vao
-    request_vao(void);
+    request_vao(unsigned int size_class);
 
     void
     next_pool(void);
@@ -122,6 +119,46 @@ namespace
     request_uniform_ubo(unsigned int ubo_size, GLenum target);
 
   private:
+    /* the painter_vao objects of a size class within
+       one pool
+     */
+    class size_class_vaos
+    {
+    public:
+      size_class_vaos(void):
+        m_current(0),
+        m_idle_frames(0)
+      {}
+
+      /* number of m_vaos used since the pool was last
+         made current
+       */
+      unsigned int m_current;
+
+      /* number of times in a row the pool was finished
+         without using all of m_vaos
+       */
+      unsigned int m_idle_frames;
+
+      std::vector<painter_vao> m_vaos;
+    };
+
+    /* number of times in a row the pool is finished without
+       using some of the painter_vao's of a size class before
+       those painter_vao's are released
+     */
+    enum
+      {
+        max_idle_frames = 16
+      };
+
+    painter_vao
+    create_vao(unsigned int size_class);
+
+    static
+    void
+    release_vao(painter_vao &vao);
+
     void
     generate_tbos(painter_vao &vao);
 
@@ -131,16 +168,15 @@ namespace
     GLuint
     generate_bo(GLenum bind_target, GLsizei psize);
 
-    unsigned int m_attribute_buffer_size, m_header_buffer_size;
-    unsigned int m_index_buffer_size;
-    int m_alignment, m_blocks_per_data_buffer;
-    unsigned int m_data_buffer_size;
+    int m_alignment;
     enum fastuidraw::gl::PainterBackendGL::data_store_backing_t m_data_store_backing;
     enum fastuidraw::gl::detail::tex_buffer_support_t m_tex_buffer_support;
     fastuidraw::glsl::PainterBackendGLSL::BindingPoints m_binding_points;
+    fastuidraw::detail::PainterDrawSizeClasses m_classes;
 
-    unsigned int m_current, m_pool;
-    std::vector<std::vector<painter_vao> > m_vaos;
+    /* m_vaos[P][C] are the painter_vao's of size class C of pool P */
+    unsigned int m_pool;
+    std::vector<std::vector<size_class_vaos> > m_vaos;
     std::vector<GLuint> m_ubos;
   };
 
@@ -288,9 +324,8 @@ namespace
   class DrawCommand:public fastuidraw::PainterDraw
   {
   public:
-    explicit
     DrawCommand(painter_vao_pool *hnd,
-                const fastuidraw::gl::PainterBackendGL::ConfigurationGL &params,
+                unsigned int size_class,
                 PainterBackendGLPrivate *pr);
 
     virtual
@@ -340,6 +375,7 @@ namespace
       m_data_blocks_per_store_buffer(1024 * 64),
       m_data_store_backing(fastuidraw::gl::PainterBackendGL::data_store_tbo),
       m_number_pools(3),
+      m_number_buffer_size_classes(1),
       m_break_on_shader_change(false),
       m_use_hw_clip_planes(true),
       /* on Mesa/i965 using switch statement gives much slower
@@ -364,6 +400,7 @@ namespace
     unsigned int m_data_blocks_per_store_buffer;
     enum fastuidraw::gl::PainterBackendGL::data_store_backing_t m_data_store_backing;
     unsigned int m_number_pools;
+    unsigned int m_number_buffer_size_classes;
     bool m_break_on_shader_change;
     fastuidraw::reference_counted_ptr<fastuidraw::gl::ImageAtlasGL> m_image_atlas;
     fastuidraw::reference_counted_ptr<fastuidraw::gl::ColorStopAtlasGL> m_colorstop_atlas;
@@ -392,18 +429,21 @@ painter_vao_pool(const fastuidraw::gl::PainterBackendGL::ConfigurationGL &params
                  const fastuidraw::PainterBackend::ConfigurationBase &params_base,
                  enum fastuidraw::gl::detail::tex_buffer_support_t tex_buffer_support,
                  const fastuidraw::glsl::PainterBackendGLSL::BindingPoints &binding_points):
-  m_attribute_buffer_size(params.attributes_per_buffer() * sizeof(fastuidraw::PainterAttribute)),
-  m_header_buffer_size(params.attributes_per_buffer() * sizeof(uint32_t)),
-  m_index_buffer_size(params.indices_per_buffer() * sizeof(fastuidraw::PainterIndex)),
   m_alignment(params_base.alignment()),
-  m_blocks_per_data_buffer(params.data_blocks_per_store_buffer()),
-  m_data_buffer_size(m_blocks_per_data_buffer * m_alignment * sizeof(fastuidraw::generic_data)),
   m_data_store_backing(params.data_store_backing()),
   m_tex_buffer_support(tex_buffer_support),
   m_binding_points(binding_points),
-  m_current(0),
+  /* the size of the UBO backing the data store is fixed
+     by the shader, so it cannot get smaller with the
+     size class.
+   */
+  m_classes(params.attributes_per_buffer(),
+            params.indices_per_buffer(),
+            params.data_blocks_per_store_buffer(),
+            params.number_buffer_size_classes(),
+            m_data_store_backing != fastuidraw::gl::PainterBackendGL::data_store_ubo),
   m_pool(0),
-  m_vaos(params.number_pools()),
+  m_vaos(params.number_pools(), std::vector<size_class_vaos>(m_classes.number_classes())),
   m_ubos(params.number_pools(), 0)
 {}
 
@@ -413,17 +453,12 @@ painter_vao_pool::
   FASTUIDRAWassert(m_ubos.size() == m_vaos.size());
   for(unsigned int p = 0, endp = m_vaos.size(); p < endp; ++p)
     {
-      for(unsigned int i = 0, endi = m_vaos[p].size(); i < endi; ++i)
+      for(size_class_vaos &c : m_vaos[p])
         {
-          if(m_vaos[p][i].m_data_tbo != 0)
+          for(painter_vao &vao : c.m_vaos)
             {
-              glDeleteTextures(1, &m_vaos[p][i].m_data_tbo);
+              release_vao(vao);
             }
-          glDeleteBuffers(1, &m_vaos[p][i].m_attribute_bo);
-          glDeleteBuffers(1, &m_vaos[p][i].m_header_bo);
-          glDeleteBuffers(1, &m_vaos[p][i].m_index_bo);
-          glDeleteBuffers(1, &m_vaos[p][i].m_data_bo);
-          glDeleteVertexArrays(1, &m_vaos[p][i].m_vao);
         }
 
       if(m_ubos[p] != 0)
@@ -459,89 +494,138 @@ request_uniform_ubo(unsigned int sz, GLenum target)
 
 painter_vao
 painter_vao_pool::
-request_vao(void)
+create_vao(unsigned int size_class)
 {
-  painter_vao return_value;
+  painter_vao vao;
+  fastuidraw::gl::opengl_trait_value v;
 
-  if(m_current == m_vaos[m_pool].size())
-    {
-      fastuidraw::gl::opengl_trait_value v;
+  vao.m_num_attributes = m_classes.attributes(size_class);
+  vao.m_num_indices = m_classes.indices(size_class);
+  vao.m_num_data = m_classes.store_blocks(size_class) * m_alignment;
 
-      m_vaos[m_pool].resize(m_current + 1);
-      glGenVertexArrays(1, &m_vaos[m_pool][m_current].m_vao);
+  glGenVertexArrays(1, &vao.m_vao);
 
-      FASTUIDRAWassert(m_vaos[m_pool][m_current].m_vao != 0);
-      glBindVertexArray(m_vaos[m_pool][m_current].m_vao);
+  FASTUIDRAWassert(vao.m_vao != 0);
+  glBindVertexArray(vao.m_vao);
 
-      m_vaos[m_pool][m_current].m_data_store_backing = m_data_store_backing;
+  vao.m_data_store_backing = m_data_store_backing;
 
-      switch(m_data_store_backing)
-        {
-        case fastuidraw::gl::PainterBackendGL::data_store_tbo:
-          {
-            m_vaos[m_pool][m_current].m_data_bo = generate_bo(GL_TEXTURE_BUFFER, m_data_buffer_size);
-            m_vaos[m_pool][m_current].m_data_store_binding_point = m_binding_points.data_store_buffer_tbo();
-            generate_tbos(m_vaos[m_pool][m_current]);
-          }
-          break;
+  switch(m_data_store_backing)
+    {
+    case fastuidraw::gl::PainterBackendGL::data_store_tbo:
+      {
+        vao.m_data_bo = generate_bo(GL_TEXTURE_BUFFER, vao.m_num_data * sizeof(fastuidraw::generic_data));
+        vao.m_data_store_binding_point = m_binding_points.data_store_buffer_tbo();
+        generate_tbos(vao);
+      }
+      break;
 
-        case fastuidraw::gl::PainterBackendGL::data_store_ubo:
-          {
-            m_vaos[m_pool][m_current].m_data_bo = generate_bo(GL_ARRAY_BUFFER, m_data_buffer_size);
-            m_vaos[m_pool][m_current].m_data_store_binding_point = m_binding_points.data_store_buffer_ubo();
-          }
-          break;
-        }
+    case fastuidraw::gl::PainterBackendGL::data_store_ubo:
+      {
+        vao.m_data_bo = generate_bo(GL_ARRAY_BUFFER, vao.m_num_data * sizeof(fastuidraw::generic_data));
+        vao.m_data_store_binding_point = m_binding_points.data_store_buffer_ubo();
+      }
+      break;
+    }
 
-      /* generate_bo leaves the returned buffer object bound to
-         the passed binding target.
-      */
-      m_vaos[m_pool][m_current].m_attribute_bo = generate_bo(GL_ARRAY_BUFFER, m_attribute_buffer_size);
-      m_vaos[m_pool][m_current].m_index_bo = generate_bo(GL_ELEMENT_ARRAY_BUFFER, m_index_buffer_size);
+  /* generate_bo leaves the returned buffer object bound to
+     the passed binding target.
+  */
+  vao.m_attribute_bo = generate_bo(GL_ARRAY_BUFFER, vao.m_num_attributes * sizeof(fastuidraw::PainterAttribute));
+  vao.m_index_bo = generate_bo(GL_ELEMENT_ARRAY_BUFFER, vao.m_num_indices * sizeof(fastuidraw::PainterIndex));
 
-      glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::primary_attrib_slot);
-      v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
-                                                                 offsetof(fastuidraw::PainterAttribute, m_attrib0));
-      fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::primary_attrib_slot, v);
+  glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::primary_attrib_slot);
+  v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
+                                                             offsetof(fastuidraw::PainterAttribute, m_attrib0));
+  fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::primary_attrib_slot, v);
 
-      glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::secondary_attrib_slot);
-      v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
-                                                                 offsetof(fastuidraw::PainterAttribute, m_attrib1));
-      fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::secondary_attrib_slot, v);
+  glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::secondary_attrib_slot);
+  v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
+                                                             offsetof(fastuidraw::PainterAttribute, m_attrib1));
+  fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::secondary_attrib_slot, v);
 
-      glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::uint_attrib_slot);
-      v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
-                                                                 offsetof(fastuidraw::PainterAttribute, m_attrib2));
-      fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::uint_attrib_slot, v);
+  glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::uint_attrib_slot);
+  v = fastuidraw::gl::opengl_trait_values<fastuidraw::uvec4>(sizeof(fastuidraw::PainterAttribute),
+                                                             offsetof(fastuidraw::PainterAttribute, m_attrib2));
+  fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::uint_attrib_slot, v);
 
-      m_vaos[m_pool][m_current].m_header_bo = generate_bo(GL_ARRAY_BUFFER, m_header_buffer_size);
-      glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot);
-      v = fastuidraw::gl::opengl_trait_values<uint32_t>();
-      fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot, v);
+  vao.m_header_bo = generate_bo(GL_ARRAY_BUFFER, vao.m_num_attributes * sizeof(uint32_t));
+  glEnableVertexAttribArray(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot);
+  v = fastuidraw::gl::opengl_trait_values<uint32_t>();
+  fastuidraw::gl::VertexAttribIPointer(fastuidraw::glsl::PainterBackendGLSL::header_attrib_slot, v);
 
-      glBindVertexArray(0);
+  glBindVertexArray(0);
+  return vao;
+}
+
+void
+painter_vao_pool::
+release_vao(painter_vao &vao)
+{
+  if(vao.m_data_tbo != 0)
+    {
+      glDeleteTextures(1, &vao.m_data_tbo);
     }
+  glDeleteBuffers(1, &vao.m_attribute_bo);
+  glDeleteBuffers(1, &vao.m_header_bo);
+  glDeleteBuffers(1, &vao.m_index_bo);
+  glDeleteBuffers(1, &vao.m_data_bo);
+  glDeleteVertexArrays(1, &vao.m_vao);
+  vao = painter_vao();
+}
+
+painter_vao
+painter_vao_pool::
+request_vao(unsigned int size_class)
+{
+  size_class_vaos &c(m_vaos[m_pool][size_class]);
 
-  return_value = m_vaos[m_pool][m_current];
-  ++m_current;
+  if(c.m_current == c.m_vaos.size())
+    {
+      c.m_vaos.push_back(create_vao(size_class));
+    }
 
-  return return_value;
+  return c.m_vaos[c.m_current++];
 }
 
 void
 painter_vao_pool::
 next_pool(void)
 {
+  /* release the painter_vao's of the pool that have
+     not been used for a while, this way a few frames
+     that need many (or large) buffers do not keep
+     them alive for the lifetime of the backend.
+   */
+  for(size_class_vaos &c : m_vaos[m_pool])
+    {
+      if(c.m_current < c.m_vaos.size())
+        {
+          ++c.m_idle_frames;
+          if(c.m_idle_frames > max_idle_frames)
+            {
+              for(unsigned int i = c.m_current, endi = c.m_vaos.size(); i < endi; ++i)
+                {
+                  release_vao(c.m_vaos[i]);
+                }
+              c.m_vaos.resize(c.m_current);
+              c.m_idle_frames = 0;
+            }
+        }
+      else
+        {
+          c.m_idle_frames = 0;
+        }
+      c.m_current = 0;
+    }
+
   ++m_pool;
   if(m_pool == m_vaos.size())
     {
       m_pool = 0;
     }
-
-  m_current = 0;
 }
 
-
 void
 painter_vao_pool::
 generate_tbos(painter_vao &vao)
@@ -750,10 +834,10 @@ convert_blend_func(enum fastuidraw::BlendMode::func_t v)
 // DrawCommand methods
 DrawCommand::
 DrawCommand(painter_vao_pool *hnd,
-            const fastuidraw::gl::PainterBackendGL::ConfigurationGL &params,
+            unsigned int size_class,
             PainterBackendGLPrivate *pr):
   m_pr(pr),
-  m_vao(hnd->request_vao()),
+  m_vao(hnd->request_vao(size_class)),
   m_attributes_written(0),
   m_indices_written(0)
 {
@@ -766,30 +850,30 @@ DrawCommand(painter_vao_pool *hnd,
   flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_attribute_bo);
-  attr_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->attribute_buffer_size(), flags);
+  attr_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, m_vao.m_num_attributes * sizeof(fastuidraw::PainterAttribute), flags);
   FASTUIDRAWassert(attr_bo != nullptr);
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_header_bo);
-  header_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->header_buffer_size(), flags);
+  header_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, m_vao.m_num_attributes * sizeof(uint32_t), flags);
   FASTUIDRAWassert(header_bo != nullptr);
 
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_vao.m_index_bo);
-  index_bo = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, hnd->index_buffer_size(), flags);
+  index_bo = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, m_vao.m_num_indices * sizeof(fastuidraw::PainterIndex), flags);
   FASTUIDRAWassert(index_bo != nullptr);
 
   glBindBuffer(GL_ARRAY_BUFFER, m_vao.m_data_bo);
-  data_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, hnd->data_buffer_size(), flags);
+  data_bo = glMapBufferRange(GL_ARRAY_BUFFER, 0, m_vao.m_num_data * sizeof(fastuidraw::generic_data), flags);
   FASTUIDRAWassert(data_bo != nullptr);
 
   m_attributes = fastuidraw::c_array<fastuidraw::PainterAttribute>(static_cast<fastuidraw::PainterAttribute*>(attr_bo),
-                                                                 params.attributes_per_buffer());
+                                                                 m_vao.m_num_attributes);
   m_indices = fastuidraw::c_array<fastuidraw::PainterIndex>(static_cast<fastuidraw::PainterIndex*>(index_bo),
-                                                          params.indices_per_buffer());
+                                                          m_vao.m_num_indices);
   m_store = fastuidraw::c_array<fastuidraw::generic_data>(static_cast<fastuidraw::generic_data*>(data_bo),
-                                                          hnd->data_buffer_size() / sizeof(fastuidraw::generic_data));
+                                                          m_vao.m_num_data);
 
   m_header_attributes = fastuidraw::c_array<uint32_t>(static_cast<uint32_t*>(header_bo),
-                                                     params.attributes_per_buffer());
+                                                     m_vao.m_num_attributes);
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -1577,6 +1661,7 @@ setget_implement(unsigned int, attributes_per_buffer)
 setget_implement(unsigned int, indices_per_buffer)
 setget_implement(unsigned int, data_blocks_per_store_buffer)
 setget_implement(unsigned int, number_pools)
+setget_implement(unsigned int, number_buffer_size_classes)
 setget_implement(bool, break_on_shader_change)
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::gl::ImageAtlasGL>&, image_atlas)
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::gl::ColorStopAtlasGL>&, colorstop_atlas)
@@ -1958,5 +2043,21 @@ map_draw(void)
   PainterBackendGLPrivate *d;
   d = static_cast<PainterBackendGLPrivate*>(m_d);
 
-  return FASTUIDRAWnew DrawCommand(d->m_pool, d->m_params, d);
+  return FASTUIDRAWnew DrawCommand(d->m_pool, 0, d);
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::gl::PainterBackendGL::
+map_draw(unsigned int attributes_requested,
+         unsigned int indices_requested,
+         unsigned int store_requested)
+{
+  PainterBackendGLPrivate *d;
+  unsigned int size_class;
+
+  d = static_cast<PainterBackendGLPrivate*>(m_d);
+  size_class = d->m_pool->choose_size_class(attributes_requested,
+                                            indices_requested,
+                                            store_requested);
+  return FASTUIDRAWnew DrawCommand(d->m_pool, size_class, d);
 }
@@ -0,0 +1,753 @@
+/*!
+ * \file painter_backend_null.cpp
+ * \brief file painter_backend_null.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/glsl/painter_backend_null.hpp>
+#include "../private/util_private.hpp"
+#include "../private/painter_draw_size_classes.hpp"
+
+namespace
+{
+  /* Backing stores that only track their dimensions; the
+     data written to them is discarded since nothing will
+     ever sample from them.
+   */
+  class NullGlyphTexelStore:public fastuidraw::GlyphAtlasTexelBackingStoreBase
+  {
+  public:
+    NullGlyphTexelStore(void):
+      fastuidraw::GlyphAtlasTexelBackingStoreBase(fastuidraw::ivec3(1024, 1024, 16), true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int, fastuidraw::c_array<const uint8_t>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class NullGlyphGeometryStore:public fastuidraw::GlyphAtlasGeometryBackingStoreBase
+  {
+  public:
+    NullGlyphGeometryStore(void):
+      fastuidraw::GlyphAtlasGeometryBackingStoreBase(4, 1024 * 1024 / 4, true)
+    {}
+
+    virtual
+    void
+    set_values(unsigned int, fastuidraw::c_array<const fastuidraw::generic_data>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(unsigned int)
+    {}
+  };
+
+  class NullColorStore:public fastuidraw::AtlasColorBackingStoreBase
+  {
+  public:
+    NullColorStore(int tile_size, int tiles_per_row_per_col):
+      fastuidraw::AtlasColorBackingStoreBase(tile_size * tiles_per_row_per_col,
+                                             tile_size * tiles_per_row_per_col,
+                                             1, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int, fastuidraw::c_array<const fastuidraw::u8vec4>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class NullIndexStore:public fastuidraw::AtlasIndexBackingStoreBase
+  {
+  public:
+    NullIndexStore(int tile_size, int tiles_per_row_per_col):
+      fastuidraw::AtlasIndexBackingStoreBase(tile_size * tiles_per_row_per_col,
+                                             tile_size * tiles_per_row_per_col,
+                                             4, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int,
+             fastuidraw::c_array<const fastuidraw::ivec3>,
+             int, const fastuidraw::AtlasColorBackingStoreBase*, int)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, int, int,
+             fastuidraw::c_array<const fastuidraw::ivec3>)
+    {}
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class NullColorStopStore:public fastuidraw::ColorStopBackingStore
+  {
+  public:
+    NullColorStopStore(void):
+      fastuidraw::ColorStopBackingStore(1024, 32, true)
+    {}
+
+    virtual
+    void
+    set_data(int, int, int, fastuidraw::c_array<const fastuidraw::u8vec4>)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int)
+    {}
+  };
+
+  class ConfigurationNullPrivate
+  {
+  public:
+    ConfigurationNullPrivate(void):
+      m_attributes_per_buffer(512 * 512),
+      m_indices_per_buffer((m_attributes_per_buffer * 6) / 4),
+      m_data_blocks_per_store_buffer(1024 * 64),
+      m_number_buffer_size_classes(1),
+      m_record_draws(false),
+      m_use_hw_clip_planes(true)
+    {}
+
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas> m_image_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas> m_colorstop_atlas;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_glyph_atlas;
+    unsigned int m_attributes_per_buffer;
+    unsigned int m_indices_per_buffer;
+    unsigned int m_data_blocks_per_store_buffer;
+    unsigned int m_number_buffer_size_classes;
+    bool m_record_draws;
+    bool m_use_hw_clip_planes;
+  };
+
+  /* Holds the host memory of a PainterDraw; also used
+     as the DrawRecord when recording draws.
+   */
+  class DrawBuffers:public fastuidraw::glsl::PainterBackendNull::DrawRecord
+  {
+  public:
+    DrawBuffers(void):
+      m_attributes_written(0),
+      m_indices_written(0),
+      m_data_store_written(0)
+    {}
+
+    DrawBuffers(unsigned int num_attributes,
+                unsigned int num_indices,
+                unsigned int num_data):
+      m_attributes(num_attributes),
+      m_header_attributes(num_attributes),
+      m_indices(num_indices),
+      m_store(num_data),
+      m_attributes_written(0),
+      m_indices_written(0),
+      m_data_store_written(0)
+    {}
+
+    virtual
+    fastuidraw::c_array<const fastuidraw::PainterAttribute>
+    attributes(void) const
+    {
+      return fastuidraw::make_c_array(m_attributes).sub_array(0, m_attributes_written);
+    }
+
+    virtual
+    fastuidraw::c_array<const uint32_t>
+    header_attributes(void) const
+    {
+      return fastuidraw::make_c_array(m_header_attributes).sub_array(0, m_attributes_written);
+    }
+
+    virtual
+    fastuidraw::c_array<const fastuidraw::PainterIndex>
+    indices(void) const
+    {
+      return fastuidraw::make_c_array(m_indices).sub_array(0, m_indices_written);
+    }
+
+    virtual
+    fastuidraw::c_array<const fastuidraw::generic_data>
+    store(void) const
+    {
+      return fastuidraw::make_c_array(m_store).sub_array(0, m_data_store_written);
+    }
+
+    virtual
+    fastuidraw::c_array<const unsigned int>
+    draw_breaks(void) const
+    {
+      return fastuidraw::make_c_array(m_draw_breaks);
+    }
+
+    /* create a DrawRecord holding only the written
+       portions of this DrawBuffers
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::glsl::PainterBackendNull::DrawRecord>
+    create_record(void) const;
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+    std::vector<unsigned int> m_draw_breaks;
+    unsigned int m_attributes_written, m_indices_written, m_data_store_written;
+  };
+
+  class DrawBuffersPool:
+    public fastuidraw::reference_counted<DrawBuffersPool>::non_concurrent
+  {
+  public:
+    DrawBuffersPool(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config,
+                    unsigned int alignment):
+      m_classes(config.attributes_per_buffer(),
+                config.indices_per_buffer(),
+                config.data_blocks_per_store_buffer(),
+                config.number_buffer_size_classes()),
+      m_alignment(alignment),
+      m_free(m_classes.number_classes())
+    {}
+
+    /* returns the size class for a PainterDraw that
+       holds the requested amounts
+     */
+    unsigned int
+    choose_size_class(unsigned int num_attributes,
+                      unsigned int num_indices,
+                      unsigned int num_data) const
+    {
+      return m_classes.choose(num_attributes, num_indices,
+                              (num_data + m_alignment - 1) / m_alignment);
+    }
+
+    fastuidraw::reference_counted_ptr<DrawBuffers>
+    request_buffers(unsigned int size_class);
+
+    void
+    release_buffers(const fastuidraw::reference_counted_ptr<DrawBuffers> &b,
+                    unsigned int size_class);
+
+  private:
+    fastuidraw::detail::PainterDrawSizeClasses m_classes;
+    unsigned int m_alignment;
+    std::vector<std::vector<fastuidraw::reference_counted_ptr<DrawBuffers> > > m_free;
+  };
+
+  class PainterBackendNullPrivate
+  {
+  public:
+    PainterBackendNullPrivate(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config,
+                              fastuidraw::glsl::PainterBackendNull *p);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+    compute_glyph_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+    compute_image_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+    compute_colorstop_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config);
+
+    static
+    fastuidraw::glsl::PainterBackendGLSL::ConfigurationGLSL
+    compute_glsl_config(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config);
+
+    fastuidraw::glsl::PainterBackendNull::ConfigurationNull m_params;
+    fastuidraw::reference_counted_ptr<DrawBuffersPool> m_pool;
+    unsigned int m_number_draws;
+    std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::glsl::PainterBackendNull::DrawRecord> > m_records;
+    fastuidraw::glsl::PainterBackendNull *m_p;
+  };
+
+  class DrawCommand:public fastuidraw::PainterDraw
+  {
+  public:
+    DrawCommand(PainterBackendNullPrivate *pr, unsigned int size_class);
+
+    virtual
+    ~DrawCommand();
+
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+               const fastuidraw::PainterShaderGroup &new_shaders,
+               unsigned int indices_written) const;
+
+    virtual
+    void
+    draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action,
+               unsigned int indices_written) const;
+
+    virtual
+    void
+    draw(void) const;
+
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int attributes_written,
+                    unsigned int indices_written,
+                    unsigned int data_store_written) const;
+
+  private:
+    PainterBackendNullPrivate *m_pr;
+    fastuidraw::reference_counted_ptr<DrawBuffersPool> m_pool;
+    fastuidraw::reference_counted_ptr<DrawBuffers> m_buffers;
+    unsigned int m_size_class;
+
+    /* actions to execute on draw() */
+    mutable std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> > m_actions;
+  };
+}
+
+//////////////////////////////////////
+// DrawBuffers methods
+fastuidraw::reference_counted_ptr<const fastuidraw::glsl::PainterBackendNull::DrawRecord>
+DrawBuffers::
+create_record(void) const
+{
+  DrawBuffers *return_value;
+
+  return_value = FASTUIDRAWnew DrawBuffers();
+  return_value->m_attributes.assign(m_attributes.begin(), m_attributes.begin() + m_attributes_written);
+  return_value->m_header_attributes.assign(m_header_attributes.begin(), m_header_attributes.begin() + m_attributes_written);
+  return_value->m_indices.assign(m_indices.begin(), m_indices.begin() + m_indices_written);
+  return_value->m_store.assign(m_store.begin(), m_store.begin() + m_data_store_written);
+  return_value->m_draw_breaks = m_draw_breaks;
+  return_value->m_attributes_written = m_attributes_written;
+  return_value->m_indices_written = m_indices_written;
+  return_value->m_data_store_written = m_data_store_written;
+
+  return return_value;
+}
+
+//////////////////////////////////////
+// DrawBuffersPool methods
+fastuidraw::reference_counted_ptr<DrawBuffers>
+DrawBuffersPool::
+request_buffers(unsigned int size_class)
+{
+  fastuidraw::reference_counted_ptr<DrawBuffers> return_value;
+  std::vector<fastuidraw::reference_counted_ptr<DrawBuffers> > &free_list(m_free[size_class]);
+
+  if(free_list.empty())
+    {
+      return_value = FASTUIDRAWnew DrawBuffers(m_classes.attributes(size_class),
+                                               m_classes.indices(size_class),
+                                               m_classes.store_blocks(size_class) * m_alignment);
+    }
+  else
+    {
+      return_value = free_list.back();
+      free_list.pop_back();
+    }
+
+  return_value->m_attributes_written = 0;
+  return_value->m_indices_written = 0;
+  return_value->m_data_store_written = 0;
+  return_value->m_draw_breaks.clear();
+  return return_value;
+}
+
+void
+DrawBuffersPool::
+release_buffers(const fastuidraw::reference_counted_ptr<DrawBuffers> &b,
+                unsigned int size_class)
+{
+  FASTUIDRAWassert(b);
+  FASTUIDRAWassert(size_class < m_free.size());
+  m_free[size_class].push_back(b);
+}
+
+//////////////////////////////////////
+// DrawCommand methods
+DrawCommand::
+DrawCommand(PainterBackendNullPrivate *pr, unsigned int size_class):
+  m_pr(pr),
+  m_pool(pr->m_pool),
+  m_size_class(size_class)
+{
+  m_buffers = m_pool->request_buffers(m_size_class);
+  m_attributes = fastuidraw::make_c_array(m_buffers->m_attributes);
+  m_header_attributes = fastuidraw::make_c_array(m_buffers->m_header_attributes);
+  m_indices = fastuidraw::make_c_array(m_buffers->m_indices);
+  m_store = fastuidraw::make_c_array(m_buffers->m_store);
+}
+
+DrawCommand::
+~DrawCommand()
+{
+  m_pool->release_buffers(m_buffers, m_size_class);
+}
+
+void
+DrawCommand::
+draw_break(const fastuidraw::PainterShaderGroup &old_shaders,
+           const fastuidraw::PainterShaderGroup &new_shaders,
+           unsigned int indices_written) const
+{
+  FASTUIDRAWunused(old_shaders);
+  FASTUIDRAWunused(new_shaders);
+  m_buffers->m_draw_breaks.push_back(indices_written);
+}
+
+void
+DrawCommand::
+draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action,
+           unsigned int indices_written) const
+{
+  if(action)
+    {
+      m_buffers->m_draw_breaks.push_back(indices_written);
+      m_actions.push_back(action);
+    }
+}
+
+void
+DrawCommand::
+unmap_implement(unsigned int attributes_written,
+                unsigned int indices_written,
+                unsigned int data_store_written) const
+{
+  m_buffers->m_attributes_written = attributes_written;
+  m_buffers->m_indices_written = indices_written;
+  m_buffers->m_data_store_written = data_store_written;
+}
+
+void
+DrawCommand::
+draw(void) const
+{
+  for(unsigned int i = 0, endi = m_actions.size(); i < endi; ++i)
+    {
+      m_actions[i]->execute();
+    }
+
+  ++m_pr->m_number_draws;
+  if(m_pr->m_params.record_draws())
+    {
+      m_pr->m_records.push_back(m_buffers->create_record());
+    }
+}
+
+//////////////////////////////////////////////////
+// PainterBackendNullPrivate methods
+PainterBackendNullPrivate::
+PainterBackendNullPrivate(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config,
+                          fastuidraw::glsl::PainterBackendNull *p):
+  m_params(config),
+  m_number_draws(0),
+  m_p(p)
+{
+  m_pool = FASTUIDRAWnew DrawBuffersPool(m_params, m_p->configuration_base().alignment());
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+PainterBackendNullPrivate::
+compute_glyph_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config)
+{
+  if(config.glyph_atlas())
+    {
+      return config.glyph_atlas();
+    }
+  return FASTUIDRAWnew fastuidraw::GlyphAtlas(FASTUIDRAWnew NullGlyphTexelStore(),
+                                              FASTUIDRAWnew NullGlyphGeometryStore());
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+PainterBackendNullPrivate::
+compute_image_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config)
+{
+  if(config.image_atlas())
+    {
+      return config.image_atlas();
+    }
+
+  /* same tile sizes and counts as the defaults of gl::ImageAtlasGL::params */
+  const int color_tile_size(32), index_tile_size(4);
+  return FASTUIDRAWnew fastuidraw::ImageAtlas(color_tile_size, index_tile_size,
+                                              FASTUIDRAWnew NullColorStore(color_tile_size, 256),
+                                              FASTUIDRAWnew NullIndexStore(index_tile_size, 64));
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+PainterBackendNullPrivate::
+compute_colorstop_atlas(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config)
+{
+  if(config.colorstop_atlas())
+    {
+      return config.colorstop_atlas();
+    }
+  return FASTUIDRAWnew fastuidraw::ColorStopAtlas(FASTUIDRAWnew NullColorStopStore());
+}
+
+fastuidraw::glsl::PainterBackendGLSL::ConfigurationGLSL
+PainterBackendNullPrivate::
+compute_glsl_config(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &config)
+{
+  fastuidraw::glsl::PainterBackendGLSL::ConfigurationGLSL return_value;
+  return_value.use_hw_clip_planes(config.use_hw_clip_planes());
+  return return_value;
+}
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendNull::ConfigurationNull methods
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+ConfigurationNull(void)
+{
+  m_d = FASTUIDRAWnew ConfigurationNullPrivate();
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+ConfigurationNull(const ConfigurationNull &obj)
+{
+  ConfigurationNullPrivate *d;
+  d = static_cast<ConfigurationNullPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ConfigurationNullPrivate(*d);
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+~ConfigurationNull()
+{
+  ConfigurationNullPrivate *d;
+  d = static_cast<ConfigurationNullPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+swap(ConfigurationNull &obj)
+{
+  std::swap(m_d, obj.m_d);
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull&
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+operator=(const ConfigurationNull &rhs)
+{
+  if(this != &rhs)
+    {
+      ConfigurationNull v(rhs);
+      swap(v);
+    }
+  return *this;
+}
+
+#define setget_implement(type, name)                                    \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull&              \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull::             \
+  name(type v)                                                          \
+  {                                                                     \
+    ConfigurationNullPrivate *d;                                        \
+    d = static_cast<ConfigurationNullPrivate*>(m_d);                    \
+    d->m_##name = v;                                                    \
+    return *this;                                                       \
+  }                                                                     \
+                                                                        \
+  type                                                                  \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull::             \
+  name(void) const                                                      \
+  {                                                                     \
+    ConfigurationNullPrivate *d;                                        \
+    d = static_cast<ConfigurationNullPrivate*>(m_d);                    \
+    return d->m_##name;                                                 \
+  }
+
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>&, image_atlas)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>&, colorstop_atlas)
+setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&, glyph_atlas)
+setget_implement(unsigned int, attributes_per_buffer)
+setget_implement(unsigned int, indices_per_buffer)
+setget_implement(unsigned int, data_blocks_per_store_buffer)
+setget_implement(unsigned int, number_buffer_size_classes)
+setget_implement(bool, record_draws)
+setget_implement(bool, use_hw_clip_planes)
+#undef setget_implement
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendNull methods
+fastuidraw::glsl::PainterBackendNull::
+PainterBackendNull(const ConfigurationNull &config_null,
+                   const ConfigurationBase &config_base):
+  PainterBackendGLSL(PainterBackendNullPrivate::compute_glyph_atlas(config_null),
+                     PainterBackendNullPrivate::compute_image_atlas(config_null),
+                     PainterBackendNullPrivate::compute_colorstop_atlas(config_null),
+                     PainterBackendNullPrivate::compute_glsl_config(config_null),
+                     config_base)
+{
+  m_d = FASTUIDRAWnew PainterBackendNullPrivate(config_null, this);
+}
+
+fastuidraw::glsl::PainterBackendNull::
+~PainterBackendNull()
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::glsl::PainterBackendNull::ConfigurationNull&
+fastuidraw::glsl::PainterBackendNull::
+configuration_null(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  return d->m_params;
+}
+
+unsigned int
+fastuidraw::glsl::PainterBackendNull::
+number_draws(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  return d->m_number_draws;
+}
+
+unsigned int
+fastuidraw::glsl::PainterBackendNull::
+number_recorded_draws(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  return d->m_records.size();
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::glsl::PainterBackendNull::DrawRecord>&
+fastuidraw::glsl::PainterBackendNull::
+recorded_draw(unsigned int I) const
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  FASTUIDRAWassert(I < d->m_records.size());
+  return d->m_records[I];
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+clear_recorded_draws(void)
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  d->m_records.clear();
+  d->m_number_draws = 0;
+}
+
+unsigned int
+fastuidraw::glsl::PainterBackendNull::
+attribs_per_mapping(void) const
+{
+  return configuration_null().attributes_per_buffer();
+}
+
+unsigned int
+fastuidraw::glsl::PainterBackendNull::
+indices_per_mapping(void) const
+{
+  return configuration_null().indices_per_buffer();
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_pre_draw(void)
+{
+  /* the uber-shader is never built, but we still
+     consume the flag so that shader registration
+     behaves exactly as it does for a real backend.
+   */
+  shader_code_added();
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_post_draw(void)
+{
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::glsl::PainterBackendNull::
+map_draw(void)
+{
+  PainterBackendNullPrivate *d;
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  return FASTUIDRAWnew DrawCommand(d, 0);
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::glsl::PainterBackendNull::
+map_draw(unsigned int attributes_requested,
+         unsigned int indices_requested,
+         unsigned int store_requested)
+{
+  PainterBackendNullPrivate *d;
+  unsigned int size_class;
+
+  d = static_cast<PainterBackendNullPrivate*>(m_d);
+  size_class = d->m_pool->choose_size_class(attributes_requested,
+                                            indices_requested,
+                                            store_requested);
+  return FASTUIDRAWnew DrawCommand(d, size_class);
+}
@@ -257,7 +257,8 @@ namespace
       m_color_tiles(pcolor_tile_size, pcolor_store->dimensions()),
       m_index_store(pindex_store),
       m_index_tiles(pindex_tile_size, pindex_store->dimensions()),
-      m_resizeable(m_color_store->resizeable() && m_index_store->resizeable())
+      m_resizeable(m_color_store->resizeable() && m_index_store->resizeable()),
+      m_bytes_uploaded(0)
     {}
 
     fastuidraw::mutex m_mutex;
@@ -269,6 +270,7 @@ namespace
     tile_allocator m_index_tiles;
 
     bool m_resizeable;
+    uint64_t m_bytes_uploaded;
   };
 
   class per_color_tile
@@ -897,6 +899,7 @@ add_index_tile(fastuidraw::c_array<const fastuidraw::ivec3> data, int slack)
                              slack,
                              d->m_color_store.get(),
                              d->m_color_tiles.tile_size());
+  d->m_bytes_uploaded += data.size() * sizeof(ivec3);
 
   return return_value;
 }
@@ -918,6 +921,7 @@ add_index_tile_index_data(fastuidraw::c_array<const fastuidraw::ivec3> data)
                              d->m_index_tiles.tile_size(),
                              d->m_index_tiles.tile_size(),
                              data);
+  d->m_bytes_uploaded += data.size() * sizeof(ivec3);
 
   return return_value;
 }
@@ -960,6 +964,7 @@ add_color_tile(fastuidraw::c_array<const u8vec4> data)
                              d->m_color_tiles.tile_size(),
                              d->m_color_tiles.tile_size(),
                              data);
+  d->m_bytes_uploaded += data.size() * sizeof(u8vec4);
   return return_value;
 }
 
@@ -984,6 +989,16 @@ flush(void) const
   d->m_color_store->flush();
 }
 
+uint64_t
+fastuidraw::ImageAtlas::
+bytes_uploaded(void) const
+{
+  ImageAtlasPrivate *d;
+  d = static_cast<ImageAtlasPrivate*>(m_d);
+  autolock_mutex M(d->m_mutex);
+  return d->m_bytes_uploaded;
+}
+
 fastuidraw::reference_counted_ptr<const fastuidraw::AtlasColorBackingStoreBase>
 fastuidraw::ImageAtlas::
 color_store(void) const
@@ -14,6 +14,7 @@ FASTUIDRAW_SOURCES += $(call filelist, fill_rule.cpp \
 	painter_brush.cpp painter_stroke_params.cpp \
 	painter_dashed_stroke_params.cpp \
 	painter.cpp painter_enums.cpp \
+	painter_display_list.cpp painter_trace.cpp \
 	painter_shader_data.cpp \
 	painter_clip_equations.cpp \
 	painter_item_matrix.cpp painter_header.cpp \
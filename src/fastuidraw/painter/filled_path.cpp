@@ -18,10 +18,10 @@
 
 
 #include <vector>
-#include <list>
 #include <map>
 #include <set>
 #include <algorithm>
+#include <atomic>
 #include <ctime>
 #include <math.h>
 
@@ -33,26 +33,23 @@
 #include "../private/util_private_ostream.hpp"
 #include "../private/bounding_box.hpp"
 #include "../private/clip.hpp"
-#include "../../3rd_party/glu-tess/glu-tess.hpp"
+#include "../private/task_queue.hpp"
+#include "../private/sweep_triangulator.hpp"
 
-/* Actual triangulation is handled by GLU-tess.
+/* Actual triangulation is handled by detail::SweepTriangulator.
    The main complexity in creating a FilledPath
    comes from two elements:
     - handling overlapping edges
     - creating a hierarchy for creating triangulations
       and for culling.
 
-   The first is needed because GLU-tess will fail
-   if any two edges overlap (we say a pair of edges
-   overlap if they intersect at more than just a single
-   point). We handle this by observing that GLU-tess
-   takes doubles but TessellatedPath is floats. When
-   we feed the coordinates to GLU-tess, we offset the
-   values by an amount that is visible in fp64 but not
-   in fp32. In addition, we also want to merge points
-   that are close in fp32 as well. The details are
-   handled in CoordinateCoverter, PointHoard and
-   tesser.
+   The first is handled by converting the points
+   to integer coordinates; points that are the same
+   after conversion are merged and the triangulator
+   works exactly on the integer coordinates, so
+   overlapping edges are detected and merged. The
+   details are handled in CoordinateCoverter and
+   PointHoard.
 
    The second is needed for primarily to speed up
    tessellation. If a TessellatedPath has a large
@@ -79,7 +76,14 @@ namespace SubsetConstants
   enum
     {
       recursion_depth = 12,
-      points_per_subset = 64
+      points_per_subset = 64,
+
+      /* when building the hierarchy in parallel, a
+         SubsetPrivate whose SubPath has fewer points
+         than this builds its children on the calling
+         thread.
+       */
+      points_per_task = 2048
     };
 
   /* if negative, aspect ratio is not
@@ -91,27 +95,18 @@ namespace SubsetConstants
 /* Constants for CoordinateConverter.
    CoordinateConverter's purpose is to remap
    the bounding box of a fastuidraw::TessellatedPath
-   to [0, 2 ^ N] x [0,  2 ^ N]
-   and then apply a fudge offset to the point
-   that an fp64 sees but an fp32 does not.
-
-   We do this to allow for the input TessellatedPath
-   to have overlapping edges. The value for the
-   fudge offset is to be incremented on each point.
+   to [0, 2 ^ N] x [0,  2 ^ N] with integer
+   coordinates.
 
    An fp32 has a 23-bit significand that allows it
    to represent any integer in the range [-2^24, 2^24]
-   exactly. An fp64 has a 52 bit significand.
-
-   We set N to be 24 and the fudginess to be 2^-20
-   (leaving 9-bits for GLU to use for intersections).
+   exactly, so we set N to be 24.
  */
 namespace CoordinateConverterConstants
 {
   enum
     {
       log2_box_dim = 24,
-      negative_log2_fudge = 20,
       box_dim = (1 << log2_box_dim),
     };
 
@@ -397,44 +392,19 @@ namespace
     uint32_t m_bd_mask;
   };
 
-  class per_winding_data:
-    public fastuidraw::reference_counted<per_winding_data>::non_concurrent
-  {
-  public:
-    per_winding_data(void):
-      m_count(0)
-    {}
-
-    void
-    add_index(unsigned int idx)
-    {
-      m_indices.push_back(idx);
-      ++m_count;
-    }
-
-    unsigned int
-    count(void) const
-    {
-      return m_count;
-    }
-
-    void
-    fill_at(unsigned int &offset,
-            fastuidraw::c_array<unsigned int> dest,
-            fastuidraw::c_array<const unsigned int> &sub_range)
-    {
-      FASTUIDRAWassert(count() + offset <= dest.size());
-      std::copy(m_indices.begin(), m_indices.end(), &dest[offset]);
-      sub_range = dest.sub_array(offset, count());
-      offset += count();
-    }
-
-  private:
-    std::list<unsigned int> m_indices;
-    unsigned int m_count;
-  };
+  /* indices of the triangles of each winding number */
+  typedef std::map<int, std::vector<unsigned int> > winding_index_hoard;
 
-  typedef std::map<int, fastuidraw::reference_counted_ptr<per_winding_data> > winding_index_hoard;
+  void
+  fill_at(const std::vector<unsigned int> &src, unsigned int &offset,
+          fastuidraw::c_array<unsigned int> dest,
+          fastuidraw::c_array<const unsigned int> &sub_range)
+  {
+    FASTUIDRAWassert(src.size() + offset <= dest.size());
+    std::copy(src.begin(), src.end(), &dest[offset]);
+    sub_range = dest.sub_array(offset, src.size());
+    offset += src.size();
+  }
 
   bool
   is_even(int v)
@@ -462,7 +432,6 @@ namespace
       m_scale = fastuidraw::vecN<double, 2>(1.0, 1.0) / delta;
       m_scale *= static_cast<double>(CoordinateConverterConstants::box_dim);
       m_translate = pmin;
-      m_delta_fudge = ::exp2(static_cast<double>(-CoordinateConverterConstants::negative_log2_fudge));
     }
 
     fastuidraw::ivec2
@@ -486,12 +455,6 @@ namespace
       return p;
     }
 
-    double
-    fudge_delta(void) const
-    {
-      return m_delta_fudge;
-    }
-
     static
     uint32_t
     compute_boundary_bits(const fastuidraw::ivec2 &pt)
@@ -569,7 +532,6 @@ namespace
       return v;
     }
 
-    double m_delta_fudge;
     fastuidraw::dvec2 m_scale, m_translate;
   };
 
@@ -643,12 +605,14 @@ namespace
     std::vector<SubContour> m_contours;
   };
 
-  class PointHoard:fastuidraw::noncopyable
+  class PointHoard:
+    public fastuidraw::detail::SweepTriangulator::PointSource,
+    fastuidraw::noncopyable
   {
   public:
     typedef uint32_t ContourPoint;
     typedef std::vector<ContourPoint> Contour;
-    typedef std::list<Contour> Path;
+    typedef std::vector<Contour> Path;
 
     explicit
     PointHoard(const fastuidraw::BoundingBox<double> &bounds,
@@ -660,18 +624,9 @@ namespace
     }
 
     unsigned int
-    fetch(const fastuidraw::dvec2 &pt);
-
-    fastuidraw::dvec2
-    apply(unsigned int I, unsigned int fudge_count) const
+    fetch(const fastuidraw::dvec2 &pt)
     {
-      fastuidraw::dvec2 r(m_ipts[I]);
-      double fudge;
-
-      fudge = static_cast<double>(fudge_count) * converter().fudge_delta();
-      r.x() += fudge;
-      r.y() += fudge;
-      return r;
+      return fetch(m_converter.iapply(pt), pt);
     }
 
     void
@@ -697,176 +652,37 @@ namespace
       return m_converter;
     }
 
-  private:
-    void
-    generate_contour(const SubPath::SubContour &input, Contour &output);
-
-    CoordinateConverter m_converter;
-    std::map<fastuidraw::ivec2, unsigned int> m_map;
-    std::vector<fastuidraw::ivec2> m_ipts;
-    std::vector<fastuidraw::dvec2> &m_pts;
-  };
-
-  class tesser:fastuidraw::noncopyable
-  {
-  protected:
-    explicit
-    tesser(PointHoard &points,
-           BoundaryEdgeTracker &tr,
-           int winding_offset);
-
-    virtual
-    ~tesser(void);
-
-    void
-    start(void);
-
-    void
-    stop(void);
-
-    void
-    add_path(const PointHoard::Path &P);
-
-    void
-    add_path_boundary(const SubPath &P);
-
-    bool
-    triangulation_failed(void)
-    {
-      return m_triangulation_failed;
-    }
-
-    virtual
-    void
-    on_begin_polygon(void) = 0;
-
-    virtual
-    void
-    on_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2) = 0;
-
     virtual
-    FASTUIDRAW_GLUboolean
-    fill_region(int winding_number) = 0;
-
-    int
-    current_winding(void)
-    {
-      return m_current_winding;
-    }
-
-  private:
-    void
-    add_contour(const PointHoard::Contour &C);
-
-    static
-    void
-    begin_callBack(FASTUIDRAW_GLUenum type, int winding_number, void *tess);
-
-    static
-    void
-    vertex_callBack(unsigned int vertex_data, void *tess);
-
-    static
-    void
-    combine_callback(double x, double y, unsigned int data[4],
-                     double weight[4],  unsigned int *outData,
-                     void *tess);
-
-    static
-    FASTUIDRAW_GLUboolean
-    winding_callBack(int winding_number, void *tess);
-
-    bool
-    temp_verts_non_degenerate_triangle(uint64_t &twice_area);
-
-    BoundaryEdgeTracker &m_boundary_edge_tracker;
-    unsigned int m_point_count;
-    fastuidraw_GLUtesselator *m_tess;
-    PointHoard &m_points;
-    fastuidraw::vecN<unsigned int, 3> m_temp_verts;
-    unsigned int m_temp_vert_count;
-    bool m_triangulation_failed;
-    int m_current_winding, m_winding_offset;
-    bool m_current_winding_inited;
-  };
-
-  class non_zero_tesser:private tesser
-  {
-  public:
-    static
-    bool
-    execute_path(PointHoard &points,
-                 const PointHoard::Path &P,
-                 const SubPath &path,
-                 winding_index_hoard &hoard,
-                 BoundaryEdgeTracker &tr)
+    fastuidraw::ivec2
+    position(unsigned int I) const
     {
-      non_zero_tesser NZ(points, P, path, hoard, tr);
-      return NZ.triangulation_failed();
+      return ipt(I);
     }
 
-  private:
-    non_zero_tesser(PointHoard &points,
-                    const PointHoard::Path &P,
-                    const SubPath &path,
-                    winding_index_hoard &hoard,
-                    BoundaryEdgeTracker &tr);
-
-    virtual
-    void
-    on_begin_polygon(void);
-
-    virtual
-    void
-    on_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2);
-
     virtual
-    FASTUIDRAW_GLUboolean
-    fill_region(int winding_number);
-
-    winding_index_hoard &m_hoard;
-    fastuidraw::reference_counted_ptr<per_winding_data> m_current_indices;
-  };
-
-  class zero_tesser:private tesser
-  {
-  public:
-    static
-    bool
-    execute_path(PointHoard &points,
-                 const PointHoard::Path &P,
-                 const SubPath &path,
-                 winding_index_hoard &hoard,
-                 BoundaryEdgeTracker &tr)
+    unsigned int
+    intersection_point(const fastuidraw::ivec2 &p, unsigned int a,
+                       unsigned int b, double t)
     {
-      zero_tesser Z(points, P, path, hoard, tr);
-      return Z.triangulation_failed();
+      return fetch(p, m_pts[a] + t * (m_pts[b] - m_pts[a]));
     }
 
   private:
+    unsigned int
+    fetch(const fastuidraw::ivec2 &ipt, const fastuidraw::dvec2 &pt);
 
-    zero_tesser(PointHoard &points,
-                const PointHoard::Path &P,
-                const SubPath &path,
-                winding_index_hoard &hoard,
-                BoundaryEdgeTracker &tr);
-
-    virtual
-    void
-    on_begin_polygon(void);
-
-    virtual
     void
-    on_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2);
-
-    virtual
-    FASTUIDRAW_GLUboolean
-    fill_region(int winding_number);
+    generate_contour(const SubPath::SubContour &input, Contour &output);
 
-    fastuidraw::reference_counted_ptr<per_winding_data> &m_indices;
+    CoordinateConverter m_converter;
+    std::map<fastuidraw::ivec2, unsigned int> m_map;
+    std::vector<fastuidraw::ivec2> m_ipts;
+    std::vector<fastuidraw::dvec2> &m_pts;
   };
 
-  class builder:fastuidraw::noncopyable
+  class builder:
+    private fastuidraw::detail::SweepTriangulator::IndexSink,
+    fastuidraw::noncopyable
   {
   public:
     explicit
@@ -894,6 +710,16 @@ namespace
     }
 
   private:
+    virtual
+    std::vector<unsigned int>&
+    indices(int w)
+    {
+      return m_hoard[w];
+    }
+
+    uint64_t
+    twice_area(unsigned int v0, unsigned int v1, unsigned int v2) const;
+
     winding_index_hoard m_hoard;
     PointHoard m_points;
     BoundaryEdgeTracker m_boundary_edge_tracker;
@@ -1029,6 +855,8 @@ namespace
     }
   };
 
+  class SubsetPrivate;
+
   class ScratchSpacePrivate
   {
   public:
@@ -1037,6 +865,8 @@ namespace
 
     fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_clip_scratch_vec2s;
     std::vector<float> m_clip_scratch_floats;
+
+    std::vector<SubsetPrivate*> m_unready;
   };
 
   class SubsetPrivate
@@ -1052,9 +882,40 @@ namespace
                    unsigned int max_index_cnt,
                    fastuidraw::c_array<unsigned int> dst);
 
+    /* Walks the hierarchy the same way select_subsets() does,
+       but instead of triangulating the childless SubsetPrivate
+       objects that select_subsets() would need, appends them
+       to dst.
+     */
+    void
+    unready_subsets(ScratchSpacePrivate &scratch,
+                    fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
+                    const fastuidraw::float3x3 &clip_matrix_local,
+                    unsigned int max_attribute_cnt,
+                    unsigned int max_index_cnt,
+                    std::vector<SubsetPrivate*> &dst);
+
+    /* Thread safe; may be called from any thread and
+       concurrently with other calls to make_ready().
+     */
     void
     make_ready(void);
 
+    bool
+    ready(void) const
+    {
+      return m_ready.load(std::memory_order_acquire);
+    }
+
+    /* Returns true exactly once, the first time it is called;
+       used to schedule a triangulation at most once.
+     */
+    bool
+    mark_scheduled(void)
+    {
+      return !m_scheduled.exchange(true);
+    }
+
     fastuidraw::c_array<const int>
     winding_numbers(void)
     {
@@ -1088,15 +949,24 @@ namespace
       return *m_fuzz_painter_data;
     }
 
+    /* if group is non-null, the hierarchy is built with
+       the tasks of group.
+     */
     static
     SubsetPrivate*
-    create_root_subset(SubPath *P, std::vector<SubsetPrivate*> &out_values);
+    create_root_subset(SubPath *P, std::vector<SubsetPrivate*> &out_values,
+                       fastuidraw::detail::TaskGroup *group);
 
   private:
 
     SubsetPrivate(SubsetPrivate *parent, SubPath *P, int max_recursion,
-                  std::vector<SubsetPrivate*> &out_values,
-                  int child_id);
+                  int child_id, fastuidraw::detail::TaskGroup *group);
+
+    /* assigns m_ID in the order in which the hierarchy
+       is walked depth first.
+     */
+    void
+    assign_ids(std::vector<SubsetPrivate*> &out_values);
 
     void
     select_subsets_implement(ScratchSpacePrivate &scratch,
@@ -1111,6 +981,41 @@ namespace
                                 unsigned int max_index_cnt,
                                 unsigned int &current);
 
+    void
+    unready_subsets_implement(ScratchSpacePrivate &scratch,
+                              unsigned int max_attribute_cnt,
+                              unsigned int max_index_cnt,
+                              std::vector<SubsetPrivate*> &dst);
+
+    void
+    unready_subsets_all_unculled(unsigned int max_attribute_cnt,
+                                 unsigned int max_index_cnt,
+                                 std::vector<SubsetPrivate*> &dst);
+
+    /* returns true if the bounds of this SubsetPrivate
+       are completely clipped by scratch.m_adjusted_clip_eqs,
+       if not writes to unclipped if the bounds are completely
+       unclipped.
+     */
+    bool
+    culled(ScratchSpacePrivate &scratch, bool *unclipped);
+
+    /* may only be called once m_sizes_ready is true */
+    bool
+    fits(unsigned int max_attribute_cnt, unsigned int max_index_cnt) const
+    {
+      return m_num_attributes <= max_attribute_cnt
+        && m_largest_index_block <= max_index_cnt
+        && 4 * m_aa_edge_list_counter.largest_edge_count() <= max_attribute_cnt
+        && 6 * m_aa_edge_list_counter.largest_edge_count() <= max_index_cnt;
+    }
+
+    /* computes the sizes of this SubsetPrivate from its children,
+       the children must have their sizes ready.
+     */
+    void
+    ready_sizes_from_children(void);
+
     void
     make_ready_from_children(void);
 
@@ -1156,10 +1061,23 @@ namespace
     AAEdgeListCounter m_aa_edge_list_counter;
     std::vector<std::vector<int> > m_winding_neighbors;
 
-    bool m_sizes_ready;
     unsigned int m_num_attributes;
     unsigned int m_largest_index_block;
 
+    /* The fields above are written only while m_mutex is
+       locked; m_sizes_ready and m_ready are set with release
+       semantics once the sizes, respectively m_painter_data,
+       m_fuzz_painter_data and the winding values, are
+       written so that readers that see them as true (with
+       acquire semantics) do not need to lock m_mutex.
+       For a SubsetPrivate with no children, both are set
+       at the same time.
+     */
+    fastuidraw::mutex m_mutex;
+    std::atomic<bool> m_sizes_ready;
+    std::atomic<bool> m_ready;
+    std::atomic<bool> m_scheduled;
+
     /* m_sub_path is non-nullptr only if this SubsetPrivate
        has no children. In addition, it is set to nullptr
        and deleted when m_painter_data is created from
@@ -1178,16 +1096,60 @@ namespace
     uint32_t m_bd_mask;
   };
 
+  /* The triangulations handed to TaskQueue::background()
+     reference SubsetPrivate objects of a FilledPathPrivate
+     but the tasks can outlive the FilledPathPrivate; the
+     tasks instead hold a reference to a PendingTriangulations
+     which the FilledPathPrivate cancels on destruction.
+   */
+  class PendingTriangulations:
+    public fastuidraw::reference_counted<PendingTriangulations>::default_base
+  {
+  public:
+    PendingTriangulations(void):
+      m_running(0),
+      m_canceled(false)
+    {}
+
+    /* called from a worker thread of the TaskQueue */
+    void
+    triangulate(SubsetPrivate *p);
+
+    /* after cancel() returns, no task will touch any
+       SubsetPrivate.
+     */
+    void
+    cancel(void);
+
+  private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    unsigned int m_running;
+    bool m_canceled;
+  };
+
   class FilledPathPrivate
   {
   public:
-    explicit
-    FilledPathPrivate(const fastuidraw::TessellatedPath &P);
+    FilledPathPrivate(const fastuidraw::TessellatedPath &P, bool parallel_build);
 
     ~FilledPathPrivate();
 
+    void
+    schedule_triangulation(fastuidraw::c_array<SubsetPrivate* const> subsets);
+
+    /* triangulates the passed SubsetPrivate objects using
+       the threads of TaskQueue::background() and waits for
+       them to finish.
+     */
+    static
+    void
+    parallel_triangulation(fastuidraw::c_array<SubsetPrivate* const> subsets);
+
     SubsetPrivate *m_root;
     std::vector<SubsetPrivate*> m_subsets;
+    fastuidraw::reference_counted_ptr<PendingTriangulations> m_pending;
+    bool m_parallel_build;
   };
 }
 
@@ -1351,10 +1313,10 @@ copy_contour(SubContour &dst,
       fastuidraw::range_type<unsigned int> R;
 
       R = src.edge_range(C, e);
-      dst.push_back(SubContourPoint(src.point_data()[R.m_begin].m_p));
+      dst.push_back(SubContourPoint(src.point_position(R.m_begin)));
       for(unsigned int v = R.m_begin + 1; v + 1 < R.m_end; ++v)
         {
-          SubContourPoint pt(src.point_data()[v].m_p);
+          SubContourPoint pt(src.point_position(v));
           dst.push_back(pt);
         }
     }
@@ -1618,15 +1580,13 @@ split(int &splitting_coordinate) const
 // PointHoard methods
 unsigned int
 PointHoard::
-fetch(const fastuidraw::dvec2 &pt)
+fetch(const fastuidraw::ivec2 &ipt, const fastuidraw::dvec2 &pt)
 {
   std::map<fastuidraw::ivec2, unsigned int>::iterator iter;
-  fastuidraw::ivec2 ipt;
   unsigned int return_value;
 
   FASTUIDRAWassert(m_pts.size() == m_ipts.size());
 
-  ipt = m_converter.iapply(pt);
   iter = m_map.find(ipt);
   if(iter != m_map.end())
     {
@@ -1672,91 +1632,18 @@ generate_contour(const SubPath::SubContour &C, Contour &output)
     }
 }
 
-////////////////////////////////////////
-// tesser methods
-tesser::
-tesser(PointHoard &points, BoundaryEdgeTracker &tr,
-       int winding_offset):
-  m_boundary_edge_tracker(tr),
-  m_point_count(0),
-  m_points(points),
-  m_triangulation_failed(false),
-  m_current_winding(0),
-  m_winding_offset(winding_offset),
-  m_current_winding_inited(false)
-{
-  m_tess = fastuidraw_gluNewTess;
-  fastuidraw_gluTessCallbackBegin(m_tess, &begin_callBack);
-  fastuidraw_gluTessCallbackVertex(m_tess, &vertex_callBack);
-  fastuidraw_gluTessCallbackCombine(m_tess, &combine_callback);
-  fastuidraw_gluTessCallbackFillRule(m_tess, &winding_callBack);
-  fastuidraw_gluTessPropertyBoundaryOnly(m_tess, FASTUIDRAW_GLU_FALSE);
-}
-
-tesser::
-~tesser(void)
-{
-  fastuidraw_gluDeleteTess(m_tess);
-}
-
-
-void
-tesser::
-start(void)
-{
-  fastuidraw_gluTessBeginPolygon(m_tess, this);
-}
-
-void
-tesser::
-stop(void)
-{
-  fastuidraw_gluTessEndPolygon(m_tess);
-}
-
-void
-tesser::
-add_path(const PointHoard::Path &P)
-{
-  for(PointHoard::Path::const_iterator iter = P.begin(),
-        end = P.end(); iter != end; ++iter)
-    {
-      add_contour(*iter);
-    }
-}
-
-void
-tesser::
-add_contour(const PointHoard::Contour &C)
-{
-  FASTUIDRAWassert(!C.empty());
-
-  fastuidraw_gluTessBeginContour(m_tess, FASTUIDRAW_GLU_TRUE);
-  for(unsigned int v = 0, endv = C.size(); v < endv; ++v)
-    {
-      fastuidraw::vecN<double, 2> p;
-      PointHoard::ContourPoint I;
-
-      /* TODO: Incrementing the amount by which to apply
-         fudge is not the correct thing to do. Rather, we
-         should only increment and apply fudge on overlapping
-         and degenerate edges.
-      */
-      I = C[v];
-      p = m_points.apply(I, m_point_count);
-      ++m_point_count;
-
-      fastuidraw_gluTessVertex(m_tess, p.x(), p.y(), I);
-    }
-  fastuidraw_gluTessEndContour(m_tess);
-}
-
-void
-tesser::
-add_path_boundary(const SubPath &P)
+/////////////////////////////////////////
+// builder methods
+builder::
+builder(uint32_t bd_mask, const SubPath &P,
+        std::vector<fastuidraw::dvec2> &points):
+  m_points(P.bounds(), points),
+  m_boundary_edge_tracker(bd_mask, &m_points)
 {
+  fastuidraw::detail::SweepTriangulator triangulator(m_points);
+  PointHoard::Path path;
   fastuidraw::dvec2 pmin, pmax;
-  unsigned int vertex_ids[4];
+  fastuidraw::vecN<unsigned int, 4> box;
   const unsigned int src[4] =
     {
       box_min_x_min_y,
@@ -1765,315 +1652,61 @@ add_path_boundary(const SubPath &P)
       box_max_x_min_y,
     };
 
+  m_points.generate_path(P, path);
+  for(const PointHoard::Contour &C : path)
+    {
+      triangulator.add_contour(fastuidraw::make_c_array(C));
+    }
+
+  /* the bounding box of the SubPath is the domain of
+     the triangulation; this gives the triangles of the
+     regions with winding number zero.
+   */
   pmin = P.bounds().min_point();
   pmax = P.bounds().max_point();
-
-  fastuidraw_gluTessBeginContour(m_tess, FASTUIDRAW_GLU_TRUE);
   for(unsigned int i = 0; i < 4; ++i)
     {
-      double x, y;
-      unsigned int k;
       fastuidraw::dvec2 p;
+      unsigned int k;
 
       k = src[i];
-      if(k & box_max_x_flag)
-        {
-          x = static_cast<double>(CoordinateConverterConstants::box_dim);
-          p.x() = pmax.x();
-        }
-      else
-        {
-          x = 0.0;
-          p.x() = pmin.x();
-        }
+      p.x() = (k & box_max_x_flag) ? pmax.x() : pmin.x();
+      p.y() = (k & box_max_y_flag) ? pmax.y() : pmin.y();
+      box[i] = m_points.fetch(p);
+    }
+  triangulator.add_domain_contour(box);
 
-      if(k & box_max_y_flag)
-        {
-          y = static_cast<double>(CoordinateConverterConstants::box_dim);
-          p.y() = pmax.y();
-        }
-      else
+  m_failed = !triangulator.triangulate(*this, CoordinateConverterConstants::min_height);
+
+  for(winding_index_hoard::const_iterator iter = m_hoard.begin(),
+        end = m_hoard.end(); iter != end; ++iter)
+    {
+      const std::vector<unsigned int> &tris(iter->second);
+      for(unsigned int i = 0, endi = tris.size(); i < endi; i += 3)
         {
-          y = 0.0;
-          p.y() = pmin.y();
+          m_boundary_edge_tracker.record_triangle(iter->first,
+                                                  twice_area(tris[i], tris[i + 1], tris[i + 2]),
+                                                  tris[i], tris[i + 1], tris[i + 2]);
         }
-      vertex_ids[k] = m_points.fetch(p);
-      fastuidraw_gluTessVertex(m_tess, x, y, vertex_ids[k]);
     }
-
-  fastuidraw_gluTessEndContour(m_tess);
 }
 
-bool
-tesser::
-temp_verts_non_degenerate_triangle(uint64_t &twice_area)
+builder::
+~builder()
 {
-  if(m_temp_verts[0] == m_temp_verts[1]
-     || m_temp_verts[0] == m_temp_verts[2]
-     || m_temp_verts[1] == m_temp_verts[2])
-    {
-      return false;
-    }
+}
 
-  fastuidraw::i64vec2 p0(m_points.ipt(m_temp_verts[0]));
-  fastuidraw::i64vec2 p1(m_points.ipt(m_temp_verts[1]));
-  fastuidraw::i64vec2 p2(m_points.ipt(m_temp_verts[2]));
+uint64_t
+builder::
+twice_area(unsigned int v0, unsigned int v1, unsigned int v2) const
+{
+  fastuidraw::i64vec2 p0(m_points.ipt(v0));
+  fastuidraw::i64vec2 p1(m_points.ipt(v1));
+  fastuidraw::i64vec2 p2(m_points.ipt(v2));
   fastuidraw::i64vec2 v(p1 - p0), w(p2 - p0);
 
-  twice_area = fastuidraw::t_abs(v.x() * w.y() - v.y() * w.x());
-  if(twice_area == 0)
-    {
-      return false;
-    }
-
-  fastuidraw::i64vec2 u(p2 - p1);
-  double vmag, wmag, umag, two_area(twice_area);
-  const double min_height(CoordinateConverterConstants::min_height);
-
-  vmag = fastuidraw::t_sqrt(static_cast<double>(dot(v, v)));
-  wmag = fastuidraw::t_sqrt(static_cast<double>(dot(w, w)));
-  umag = fastuidraw::t_sqrt(static_cast<double>(dot(u, u)));
-
-  /* the distance from an edge to the 3rd
-     point is given as twice the area divided
-     by the length of the edge. We ask that
-     the distance is atleast 1.
-   */
-  if(two_area < min_height * vmag
-     || two_area < min_height * wmag
-     || two_area < min_height * umag)
-    {
-      twice_area = 0u;
-      return false;
-    }
-
-  return true;
-}
-
-void
-tesser::
-begin_callBack(FASTUIDRAW_GLUenum type, int winding_number, void *tess)
-{
-  tesser *p;
-  p = static_cast<tesser*>(tess);
-  FASTUIDRAWassert(FASTUIDRAW_GLU_TRIANGLES == type);
-  FASTUIDRAWunused(type);
-
-  p->m_temp_vert_count = 0;
-  if(!p->m_current_winding_inited || p->m_current_winding != winding_number)
-    {
-      p->m_current_winding_inited = true;
-      p->m_current_winding = winding_number;
-      p->on_begin_polygon();
-    }
-}
-
-void
-tesser::
-vertex_callBack(unsigned int vertex_id, void *tess)
-{
-  tesser *p;
-  p = static_cast<tesser*>(tess);
-
-  if(vertex_id == FASTUIDRAW_GLU_nullptr_CLIENT_ID)
-    {
-      p->m_triangulation_failed = true;
-    }
-
-  /* Cache adds vertices in groups of 3 (triangles),
-     then if all vertices are NOT FASTUIDRAW_GLU_nullptr_CLIENT_ID,
-     then add them.
-   */
-  p->m_temp_verts[p->m_temp_vert_count] = vertex_id;
-  p->m_temp_vert_count++;
-  if(p->m_temp_vert_count == 3)
-    {
-      uint64_t twice_area(0u);
-      p->m_temp_vert_count = 0;
-      /*
-        if vertex_id is FASTUIDRAW_GLU_nullptr_CLIENT_ID, that means
-        the triangle is junked.
-      */
-      if(p->m_temp_verts[0] != FASTUIDRAW_GLU_nullptr_CLIENT_ID
-         && p->m_temp_verts[1] != FASTUIDRAW_GLU_nullptr_CLIENT_ID
-         && p->m_temp_verts[2] != FASTUIDRAW_GLU_nullptr_CLIENT_ID
-         && p->temp_verts_non_degenerate_triangle(twice_area))
-        {
-          FASTUIDRAWassert(twice_area > 0);
-          p->m_boundary_edge_tracker.record_triangle(p->current_winding() + p->m_winding_offset,
-                                                     twice_area,
-                                                     p->m_temp_verts[0],
-                                                     p->m_temp_verts[1],
-                                                     p->m_temp_verts[2]);
-          p->on_add_triangle(p->m_temp_verts[0],
-                             p->m_temp_verts[1],
-                             p->m_temp_verts[2]);
-        }
-    }
-}
-
-void
-tesser::
-combine_callback(double x, double y, unsigned int data[4],
-                 double weight[4],  unsigned int *outData,
-                 void *tess)
-{
-  FASTUIDRAWunused(x);
-  FASTUIDRAWunused(y);
-
-  tesser *p;
-  unsigned int v;
-  Edge e0(data[0], data[1]);
-  Edge e1(data[2], data[3]);
-  fastuidraw::dvec2 pt(0.0, 0.0);
-
-  p = static_cast<tesser*>(tess);
-  for(unsigned int i = 0; i < 4; ++i)
-    {
-      if(data[i] != FASTUIDRAW_GLU_nullptr_CLIENT_ID)
-        {
-          pt += weight[i] * p->m_points[data[i]];
-        }
-    }
-  v = p->m_points.fetch(pt);
-
-  //p->m_boundary_edge_tracker.split_edge(e0, v, e1);
-  //p->m_boundary_edge_tracker.split_edge(e1, v, e0);
-
-  *outData = v;
-}
-
-FASTUIDRAW_GLUboolean
-tesser::
-winding_callBack(int winding_number, void *tess)
-{
-  tesser *p;
-  FASTUIDRAW_GLUboolean return_value;
-
-  p = static_cast<tesser*>(tess);
-  return_value = p->fill_region(winding_number);
-  return return_value;
-}
-
-///////////////////////////////////
-// non_zero_tesser methods
-non_zero_tesser::
-non_zero_tesser(PointHoard &points,
-                const PointHoard::Path &P,
-                const SubPath &path,
-                winding_index_hoard &hoard,
-                BoundaryEdgeTracker &tr):
-  tesser(points, tr, 0),
-  m_hoard(hoard)
-{
-  start();
-  add_path(P);
-  stop();
-  FASTUIDRAWunused(path);
-}
-
-void
-non_zero_tesser::
-on_begin_polygon(void)
-{
-  int w(current_winding());
-
-  fastuidraw::reference_counted_ptr<per_winding_data> &h(m_hoard[w]);
-  if(!h)
-    {
-      h = FASTUIDRAWnew per_winding_data();
-    }
-  m_current_indices = h;
-}
-
-void
-non_zero_tesser::
-on_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2)
-{
-  m_current_indices->add_index(v0);
-  m_current_indices->add_index(v1);
-  m_current_indices->add_index(v2);
-}
-
-
-FASTUIDRAW_GLUboolean
-non_zero_tesser::
-fill_region(int winding_number)
-{
-  return winding_number != 0 ?
-    FASTUIDRAW_GLU_TRUE :
-    FASTUIDRAW_GLU_FALSE;
-}
-
-///////////////////////////////
-// zero_tesser methods
-zero_tesser::
-zero_tesser(PointHoard &points,
-            const PointHoard::Path &P,
-            const SubPath &path,
-            winding_index_hoard &hoard,
-            BoundaryEdgeTracker &tr):
-  tesser(points, tr, 1),
-  m_indices(hoard[0])
-{
-  if(!m_indices)
-    {
-      m_indices = FASTUIDRAWnew per_winding_data();
-    }
-
-  start();
-  add_path(P);
-  add_path_boundary(path);
-  stop();
-}
-
-void
-zero_tesser::
-on_begin_polygon(void)
-{
-  FASTUIDRAWassert(current_winding() == -1);
-}
-
-void
-zero_tesser::
-on_add_triangle(unsigned int v0, unsigned int v1, unsigned int v2)
-{
-  m_indices->add_index(v0);
-  m_indices->add_index(v1);
-  m_indices->add_index(v2);
-}
-
-FASTUIDRAW_GLUboolean
-zero_tesser::
-fill_region(int winding_number)
-{
-  return winding_number == -1 ?
-    FASTUIDRAW_GLU_TRUE :
-    FASTUIDRAW_GLU_FALSE;
-}
-
-/////////////////////////////////////////
-// builder methods
-builder::
-builder(uint32_t bd_mask, const SubPath &P,
-        std::vector<fastuidraw::dvec2> &points):
-  m_points(P.bounds(), points),
-  m_boundary_edge_tracker(bd_mask, &m_points)
-{
-  bool failZ, failNZ;
-  PointHoard::Path path;
-
-  m_points.generate_path(P, path);
-  failNZ = non_zero_tesser::execute_path(m_points, path, P, m_hoard, m_boundary_edge_tracker);
-  failZ = zero_tesser::execute_path(m_points, path, P, m_hoard,
-                                    m_boundary_edge_tracker);
-  m_failed = failNZ || failZ;
-}
-
-builder::
-~builder()
-{
-}
+  return fastuidraw::t_abs(v.x() * w.y() - v.y() * w.x());
+}
 
 void
 builder::
@@ -2090,7 +1723,7 @@ fill_indices(std::vector<unsigned int> &indices,
     {
       unsigned int cnt;
 
-      cnt = iter->second->count();
+      cnt = iter->second.size();
       total += cnt;
       if(iter->first == 0)
         {
@@ -2119,29 +1752,29 @@ fill_indices(std::vector<unsigned int> &indices,
     {
       if(iter->first == 0)
         {
-          if(iter->second->count() > 0)
+          if(!iter->second.empty())
             {
-              iter->second->fill_at(current_zero,
-                                    fastuidraw::make_c_array(indices),
-                                    winding_map[iter->first]);
+              fill_at(iter->second, current_zero,
+                      fastuidraw::make_c_array(indices),
+                      winding_map[iter->first]);
             }
         }
       else if(is_even(iter->first))
         {
-          if(iter->second->count() > 0)
+          if(!iter->second.empty())
             {
-              iter->second->fill_at(current_even_non_zero,
-                                    fastuidraw::make_c_array(indices),
-                                    winding_map[iter->first]);
+              fill_at(iter->second, current_even_non_zero,
+                      fastuidraw::make_c_array(indices),
+                      winding_map[iter->first]);
             }
         }
       else
         {
-          if(iter->second->count() > 0)
+          if(!iter->second.empty())
             {
-              iter->second->fill_at(current_odd,
-                                    fastuidraw::make_c_array(indices),
-                                    winding_map[iter->first]);
+              fill_at(iter->second, current_odd,
+                      fastuidraw::make_c_array(indices),
+                      winding_map[iter->first]);
             }
         }
     }
@@ -2513,21 +2146,21 @@ fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
 // SubsetPrivate methods
 SubsetPrivate::
 SubsetPrivate(SubsetPrivate *parent, SubPath *Q, int max_recursion,
-              std::vector<SubsetPrivate*> &out_values,
-              int child_id):
-  m_ID(out_values.size()),
+              int child_id, fastuidraw::detail::TaskGroup *group):
+  m_ID(0),
   m_bounds(Q->bounds()),
   m_bounds_f(fastuidraw::vec2(m_bounds.min_point()),
              fastuidraw::vec2(m_bounds.max_point())),
   m_painter_data(nullptr),
   m_fuzz_painter_data(nullptr),
   m_sizes_ready(false),
+  m_ready(false),
+  m_scheduled(false),
   m_sub_path(Q),
   m_children(nullptr, nullptr),
   m_splitting_coordinate(-1),
   m_bd_mask(compute_bd_mask_value(parent, child_id))
 {
-  out_values.push_back(this);
   if(max_recursion > 0 && m_sub_path->total_points() > SubsetConstants::points_per_subset)
     {
       fastuidraw::vecN<SubPath*, 2> C;
@@ -2535,8 +2168,18 @@ SubsetPrivate(SubsetPrivate *parent, SubPath *Q, int max_recursion,
       C = Q->split(m_splitting_coordinate);
       if(C[0]->total_points() < m_sub_path->total_points() || C[1]->total_points() < m_sub_path->total_points())
         {
-          m_children[0] = FASTUIDRAWnew SubsetPrivate(this, C[0], max_recursion - 1, out_values, 0);
-          m_children[1] = FASTUIDRAWnew SubsetPrivate(this, C[1], max_recursion - 1, out_values, 1);
+          if(group != nullptr && C[1]->total_points() >= SubsetConstants::points_per_task)
+            {
+              SubPath *C1(C[1]);
+              group->add([this, C1, max_recursion, group]() {
+                  m_children[1] = FASTUIDRAWnew SubsetPrivate(this, C1, max_recursion - 1, 1, group);
+                });
+            }
+          else
+            {
+              m_children[1] = FASTUIDRAWnew SubsetPrivate(this, C[1], max_recursion - 1, 1, group);
+            }
+          m_children[0] = FASTUIDRAWnew SubsetPrivate(this, C[0], max_recursion - 1, 0, group);
           FASTUIDRAWdelete(m_sub_path);
           m_sub_path = nullptr;
         }
@@ -2579,13 +2222,37 @@ SubsetPrivate::
 
 SubsetPrivate*
 SubsetPrivate::
-create_root_subset(SubPath *P, std::vector<SubsetPrivate*> &out_values)
+create_root_subset(SubPath *P, std::vector<SubsetPrivate*> &out_values,
+                   fastuidraw::detail::TaskGroup *group)
 {
   SubsetPrivate *root;
-  root = FASTUIDRAWnew SubsetPrivate(nullptr, P, SubsetConstants::recursion_depth, out_values, -1);
+  root = FASTUIDRAWnew SubsetPrivate(nullptr, P, SubsetConstants::recursion_depth, -1, group);
+  if(group != nullptr)
+    {
+      group->wait();
+    }
+
+  /* the IDs are assigned after the hierarchy is built so that
+     they do not depend on the order in which the threads build
+     the SubsetPrivate objects.
+   */
+  root->assign_ids(out_values);
   return root;
 }
 
+void
+SubsetPrivate::
+assign_ids(std::vector<SubsetPrivate*> &out_values)
+{
+  m_ID = out_values.size();
+  out_values.push_back(this);
+  if(m_children[0] != nullptr)
+    {
+      m_children[0]->assign_ids(out_values);
+      m_children[1]->assign_ids(out_values);
+    }
+}
+
 uint32_t
 SubsetPrivate::
 compute_bd_mask_value(SubsetPrivate *parent, int child_id)
@@ -2635,6 +2302,24 @@ select_subsets(ScratchSpacePrivate &scratch,
   return return_value;
 }
 
+bool
+SubsetPrivate::
+culled(ScratchSpacePrivate &scratch, bool *unclipped)
+{
+  using namespace fastuidraw;
+  using namespace fastuidraw::detail;
+
+  vecN<vec2, 4> bb;
+
+  m_bounds_f.inflated_polygon(bb, 0.0f);
+  *unclipped = clip_against_planes(make_c_array(scratch.m_adjusted_clip_eqs),
+                                   bb, scratch.m_clipped_rect,
+                                   scratch.m_clip_scratch_floats,
+                                   scratch.m_clip_scratch_vec2s);
+
+  return scratch.m_clipped_rect.empty();
+}
+
 void
 SubsetPrivate::
 select_subsets_implement(ScratchSpacePrivate &scratch,
@@ -2643,20 +2328,10 @@ select_subsets_implement(ScratchSpacePrivate &scratch,
                          unsigned int max_index_cnt,
                          unsigned int &current)
 {
-  using namespace fastuidraw;
-  using namespace fastuidraw::detail;
-
-  vecN<vec2, 4> bb;
   bool unclipped;
 
-  m_bounds_f.inflated_polygon(bb, 0.0f);
-  unclipped = clip_against_planes(make_c_array(scratch.m_adjusted_clip_eqs),
-                                  bb, scratch.m_clipped_rect,
-                                  scratch.m_clip_scratch_floats,
-                                  scratch.m_clip_scratch_vec2s);
-
   //completely clipped
-  if(scratch.m_clipped_rect.empty())
+  if(culled(scratch, &unclipped))
     {
       return;
     }
@@ -2680,20 +2355,17 @@ select_subsets_all_unculled(fastuidraw::c_array<unsigned int> dst,
                             unsigned int max_index_cnt,
                             unsigned int &current)
 {
-  if(!m_sizes_ready && m_children[0] == nullptr && m_sub_path != nullptr)
+  if(m_children[0] == nullptr)
     {
       /* we are going to need the attributes because
          the element will be selected.
        */
-      make_ready_from_sub_path();
+      make_ready();
       FASTUIDRAWassert(m_painter_data != nullptr);
     }
 
-  if(m_sizes_ready
-     && m_num_attributes <= max_attribute_cnt
-     && m_largest_index_block <= max_index_cnt
-     && 4 * m_aa_edge_list_counter.largest_edge_count() <= max_attribute_cnt
-     && 6 * m_aa_edge_list_counter.largest_edge_count() <= max_index_cnt)
+  if(m_sizes_ready.load(std::memory_order_acquire)
+     && fits(max_attribute_cnt, max_index_cnt))
     {
       dst[current] = m_ID;
       ++current;
@@ -2702,19 +2374,10 @@ select_subsets_all_unculled(fastuidraw::c_array<unsigned int> dst,
     {
       m_children[0]->select_subsets_all_unculled(dst, max_attribute_cnt, max_index_cnt, current);
       m_children[1]->select_subsets_all_unculled(dst, max_attribute_cnt, max_index_cnt, current);
-      if(!m_sizes_ready)
+      if(!m_sizes_ready.load(std::memory_order_acquire))
         {
-          m_sizes_ready = true;
-          FASTUIDRAWassert(m_children[0]->m_sizes_ready);
-          FASTUIDRAWassert(m_children[1]->m_sizes_ready);
-          m_num_attributes = m_children[0]->m_num_attributes + m_children[1]->m_num_attributes;
-          /* TODO: the actual value for m_largest_index_block might be smaller;
-             this happens if the largest index block of m_children[0] and m_children[1]
-             come from different index sets.
-          */
-          m_largest_index_block = m_children[0]->m_largest_index_block + m_children[1]->m_largest_index_block;
-          m_aa_edge_list_counter.add_counts(m_children[0]->m_aa_edge_list_counter);
-          m_aa_edge_list_counter.add_counts(m_children[1]->m_aa_edge_list_counter);
+          fastuidraw::autolock_mutex M(m_mutex);
+          ready_sizes_from_children();
         }
     }
   else
@@ -2726,19 +2389,122 @@ select_subsets_all_unculled(fastuidraw::c_array<unsigned int> dst,
 
 void
 SubsetPrivate::
-make_ready(void)
+unready_subsets(ScratchSpacePrivate &scratch,
+                fastuidraw::c_array<const fastuidraw::vec3> clip_equations,
+                const fastuidraw::float3x3 &clip_matrix_local,
+                unsigned int max_attribute_cnt,
+                unsigned int max_index_cnt,
+                std::vector<SubsetPrivate*> &dst)
 {
-  if(m_painter_data == nullptr)
+  scratch.m_adjusted_clip_eqs.resize(clip_equations.size());
+  for(unsigned int i = 0; i < clip_equations.size(); ++i)
     {
-      if(m_sub_path != nullptr)
-        {
-          make_ready_from_sub_path();
-        }
-      else
+      scratch.m_adjusted_clip_eqs[i] = clip_equations[i] * clip_matrix_local;
+    }
+  unready_subsets_implement(scratch, max_attribute_cnt, max_index_cnt, dst);
+}
+
+void
+SubsetPrivate::
+unready_subsets_implement(ScratchSpacePrivate &scratch,
+                          unsigned int max_attribute_cnt,
+                          unsigned int max_index_cnt,
+                          std::vector<SubsetPrivate*> &dst)
+{
+  bool unclipped;
+
+  if(culled(scratch, &unclipped))
+    {
+      return;
+    }
+
+  if(unclipped || m_children[0] == nullptr)
+    {
+      unready_subsets_all_unculled(max_attribute_cnt, max_index_cnt, dst);
+      return;
+    }
+
+  m_children[0]->unready_subsets_implement(scratch, max_attribute_cnt, max_index_cnt, dst);
+  m_children[1]->unready_subsets_implement(scratch, max_attribute_cnt, max_index_cnt, dst);
+}
+
+void
+SubsetPrivate::
+unready_subsets_all_unculled(unsigned int max_attribute_cnt,
+                             unsigned int max_index_cnt,
+                             std::vector<SubsetPrivate*> &dst)
+{
+  if(m_children[0] == nullptr)
+    {
+      if(!ready())
         {
-          make_ready_from_children();
+          dst.push_back(this);
         }
+      return;
     }
+
+  /* if the sizes of this SubsetPrivate are known, then
+     all of its descendants are triangulated, so if it
+     fits it is selected and making it ready only needs
+     to merge the data of its children.
+   */
+  if(m_sizes_ready.load(std::memory_order_acquire)
+     && fits(max_attribute_cnt, max_index_cnt))
+    {
+      return;
+    }
+
+  m_children[0]->unready_subsets_all_unculled(max_attribute_cnt, max_index_cnt, dst);
+  m_children[1]->unready_subsets_all_unculled(max_attribute_cnt, max_index_cnt, dst);
+}
+
+void
+SubsetPrivate::
+make_ready(void)
+{
+  if(ready())
+    {
+      return;
+    }
+
+  fastuidraw::autolock_mutex M(m_mutex);
+  if(m_ready.load(std::memory_order_relaxed))
+    {
+      /* made ready by another thread while we waited on m_mutex */
+      return;
+    }
+
+  if(m_sub_path != nullptr)
+    {
+      make_ready_from_sub_path();
+    }
+  else
+    {
+      make_ready_from_children();
+    }
+  m_ready.store(true, std::memory_order_release);
+}
+
+void
+SubsetPrivate::
+ready_sizes_from_children(void)
+{
+  if(m_sizes_ready.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+  FASTUIDRAWassert(m_children[0]->m_sizes_ready);
+  FASTUIDRAWassert(m_children[1]->m_sizes_ready);
+  m_num_attributes = m_children[0]->m_num_attributes + m_children[1]->m_num_attributes;
+  /* TODO: the actual value for m_largest_index_block might be smaller;
+     this happens if the largest index block of m_children[0] and m_children[1]
+     come from different index sets.
+  */
+  m_largest_index_block = m_children[0]->m_largest_index_block + m_children[1]->m_largest_index_block;
+  m_aa_edge_list_counter.add_counts(m_children[0]->m_aa_edge_list_counter);
+  m_aa_edge_list_counter.add_counts(m_children[1]->m_aa_edge_list_counter);
+  m_sizes_ready.store(true, std::memory_order_release);
 }
 
 
@@ -2796,20 +2562,7 @@ make_ready_from_children(void)
       merge_winding_lists(a, b, &m_winding_neighbors[i]);
     }
 
-  if(!m_sizes_ready)
-    {
-      m_sizes_ready = true;
-      FASTUIDRAWassert(m_children[0]->m_sizes_ready);
-      FASTUIDRAWassert(m_children[1]->m_sizes_ready);
-      m_num_attributes = m_children[0]->m_num_attributes + m_children[1]->m_num_attributes;
-      /* TODO: the actual value for m_largest_index_block might be smaller;
-         this happens if the largest index block of m_children[0] and m_children[1]
-         come from different index sets.
-       */
-      m_largest_index_block = m_children[0]->m_largest_index_block + m_children[1]->m_largest_index_block;
-      m_aa_edge_list_counter.add_counts(m_children[0]->m_aa_edge_list_counter);
-      m_aa_edge_list_counter.add_counts(m_children[1]->m_aa_edge_list_counter);
-    }
+  ready_sizes_from_children();
 
   m_fuzz_painter_data = FASTUIDRAWnew fastuidraw::PainterAttributeData();
   AttributeDataMerger fuzz_merger(m_children[0]->fuzz_painter_data(),
@@ -2846,7 +2599,6 @@ make_ready_from_sub_path(void)
   filler.m_even_winding_indices = indices_ptr.sub_array(even_non_zero_start);
   filler.m_zero_winding_indices = indices_ptr.sub_array(zero_start);
 
-  m_sizes_ready = true;
   m1 = fastuidraw::t_max(filler.m_nonzero_winding_indices.size(),
                          filler.m_zero_winding_indices.size());
   m2 = fastuidraw::t_max(filler.m_odd_winding_indices.size(),
@@ -2882,6 +2634,7 @@ make_ready_from_sub_path(void)
 
   FASTUIDRAWdelete(m_sub_path);
   m_sub_path = nullptr;
+  m_sizes_ready.store(true, std::memory_order_release);
 
   #ifdef FASTUIDRAW_DEBUG
     {
@@ -2901,19 +2654,92 @@ make_ready_from_sub_path(void)
 /////////////////////////////////
 // FilledPathPrivate methods
 FilledPathPrivate::
-FilledPathPrivate(const fastuidraw::TessellatedPath &P)
+FilledPathPrivate(const fastuidraw::TessellatedPath &P, bool parallel_build):
+  m_parallel_build(parallel_build)
 {
   SubPath *q;
   q = FASTUIDRAWnew SubPath(P);
-  m_root = SubsetPrivate::create_root_subset(q, m_subsets);
+  if(parallel_build)
+    {
+      fastuidraw::detail::TaskGroup group;
+      m_root = SubsetPrivate::create_root_subset(q, m_subsets, &group);
+    }
+  else
+    {
+      m_root = SubsetPrivate::create_root_subset(q, m_subsets, nullptr);
+    }
+  m_pending = FASTUIDRAWnew PendingTriangulations();
 }
 
 FilledPathPrivate::
 ~FilledPathPrivate()
 {
+  m_pending->cancel();
   FASTUIDRAWdelete(m_root);
 }
 
+void
+FilledPathPrivate::
+schedule_triangulation(fastuidraw::c_array<SubsetPrivate* const> subsets)
+{
+  for(SubsetPrivate *p : subsets)
+    {
+      if(p->mark_scheduled())
+        {
+          fastuidraw::reference_counted_ptr<PendingTriangulations> pending(m_pending);
+          fastuidraw::detail::TaskQueue::background().add([pending, p]() { pending->triangulate(p); });
+        }
+    }
+}
+
+void
+FilledPathPrivate::
+parallel_triangulation(fastuidraw::c_array<SubsetPrivate* const> subsets)
+{
+  fastuidraw::detail::TaskGroup group;
+  for(SubsetPrivate *p : subsets)
+    {
+      group.add([p]() { p->make_ready(); });
+    }
+  group.wait();
+}
+
+/////////////////////////////////
+// PendingTriangulations methods
+void
+PendingTriangulations::
+triangulate(SubsetPrivate *p)
+{
+  {
+    std::lock_guard<std::mutex> M(m_mutex);
+    if(m_canceled)
+      {
+        return;
+      }
+    ++m_running;
+  }
+
+  p->make_ready();
+
+  {
+    std::lock_guard<std::mutex> M(m_mutex);
+    --m_running;
+  }
+  m_cond.notify_all();
+}
+
+void
+PendingTriangulations::
+cancel(void)
+{
+  std::unique_lock<std::mutex> M(m_mutex);
+  m_canceled = true;
+  while(m_running > 0)
+    {
+      m_cond.wait(M);
+    }
+}
+
 ///////////////////////////////
 //fastuidraw::FilledPath::ScratchSpace methods
 fastuidraw::FilledPath::ScratchSpace::
@@ -3016,9 +2842,9 @@ chunk_for_aa_fuzz(int winding0, int winding1)
 ///////////////////////////////////////
 // fastuidraw::FilledPath methods
 fastuidraw::FilledPath::
-FilledPath(const TessellatedPath &P)
+FilledPath(const TessellatedPath &P, bool parallel_build)
 {
-  m_d = FASTUIDRAWnew FilledPathPrivate(P);
+  m_d = FASTUIDRAWnew FilledPathPrivate(P, parallel_build);
 }
 
 fastuidraw::FilledPath::
@@ -3069,29 +2895,67 @@ select_subsets(ScratchSpace &work_room,
 
   d = static_cast<FilledPathPrivate*>(m_d);
   FASTUIDRAWassert(dst.size() >= d->m_subsets.size());
-  /* TODO:
-       - have another method in SubsetPrivate called
-         "fast_select_subsets" which ignores the requirements
-         coming from max_attribute_cnt and max_index_cnt.
-         By ignoring this requirement, we do NOT need
-         to do call make_ready() for any SubsetPrivate
-         object chosen.
-       - have the fast_select_subsets() also return
-         if paths needed require triangulation.
-       - if there such, spawn a thread and let the
-         caller decide if to wait for the thread to
-         finish before proceeding or to do something
-         else (like use a lower level of detail that
-         is ready). Another alternatic is to return
-         what Subset's need to have triangulation done
-         and spawn a set of threads to do the job (!)
-       - All this work means we need to make SubsetPrivate
-         thread safe (with regards to the SubsetPrivate
-         being made ready via make_ready()).
-   */
+  if(d->m_parallel_build)
+    {
+      ScratchSpacePrivate *scratch;
+
+      /* triangulate what select_subsets() needs in parallel
+         first, the selection then only merges.
+       */
+      scratch = static_cast<ScratchSpacePrivate*>(work_room.m_d);
+      scratch->m_unready.clear();
+      d->m_root->unready_subsets(*scratch, clip_equations, clip_matrix_local,
+                                 max_attribute_cnt, max_index_cnt,
+                                 scratch->m_unready);
+      if(scratch->m_unready.size() > 1)
+        {
+          FilledPathPrivate::parallel_triangulation(make_c_array(scratch->m_unready));
+        }
+    }
   return_value= d->m_root->select_subsets(*static_cast<ScratchSpacePrivate*>(work_room.m_d),
                                           clip_equations, clip_matrix_local,
                                           max_attribute_cnt, max_index_cnt, dst);
 
   return return_value;
 }
+
+bool
+fastuidraw::FilledPath::
+select_subsets_no_wait(ScratchSpace &work_room,
+                       c_array<const vec3> clip_equations,
+                       const float3x3 &clip_matrix_local,
+                       unsigned int max_attribute_cnt,
+                       unsigned int max_index_cnt,
+                       c_array<unsigned int> dst,
+                       unsigned int *out_number_subsets,
+                       bool schedule_triangulation) const
+{
+  FilledPathPrivate *d;
+  ScratchSpacePrivate *scratch;
+
+  d = static_cast<FilledPathPrivate*>(m_d);
+  scratch = static_cast<ScratchSpacePrivate*>(work_room.m_d);
+  FASTUIDRAWassert(dst.size() >= d->m_subsets.size());
+
+  /* a SubsetPrivate with children is made ready by merging
+     the data of its children, which is cheap compared to
+     triangulating; thus only the childless SubsetPrivate
+     objects are checked and handed to the background.
+   */
+  scratch->m_unready.clear();
+  d->m_root->unready_subsets(*scratch, clip_equations, clip_matrix_local,
+                             max_attribute_cnt, max_index_cnt,
+                             scratch->m_unready);
+  if(!scratch->m_unready.empty())
+    {
+      if(schedule_triangulation)
+        {
+          d->schedule_triangulation(make_c_array(scratch->m_unready));
+        }
+      return false;
+    }
+
+  *out_number_subsets = d->m_root->select_subsets(*scratch, clip_equations, clip_matrix_local,
+                                                  max_attribute_cnt, max_index_cnt, dst);
+  return true;
+}
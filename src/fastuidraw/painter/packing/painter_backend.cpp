@@ -62,12 +62,14 @@ namespace
     ConfigurationPrivate(void):
       m_brush_shader_mask(0),
       m_alignment(4),
-      m_blend_type(fastuidraw::PainterBlendShader::dual_src)
+      m_blend_type(fastuidraw::PainterBlendShader::dual_src),
+      m_hash_packed_state(false)
     {}
 
     uint32_t m_brush_shader_mask;
     int m_alignment;
     enum fastuidraw::PainterBlendShader::shader_type m_blend_type;
+    bool m_hash_packed_state;
   };
 }
 
@@ -208,6 +210,25 @@ blend_type(enum PainterBlendShader::shader_type v)
   return *this;
 }
 
+bool
+fastuidraw::PainterBackend::ConfigurationBase::
+hash_packed_state(void) const
+{
+  ConfigurationPrivate *d;
+  d = static_cast<ConfigurationPrivate*>(m_d);
+  return d->m_hash_packed_state;
+}
+
+fastuidraw::PainterBackend::ConfigurationBase&
+fastuidraw::PainterBackend::ConfigurationBase::
+hash_packed_state(bool v)
+{
+  ConfigurationPrivate *d;
+  d = static_cast<ConfigurationPrivate*>(m_d);
+  d->m_hash_packed_state = v;
+  return *this;
+}
+
 ////////////////////////////////////
 // fastuidraw::PainterBackend methods
 fastuidraw::PainterBackend::
@@ -416,3 +437,15 @@ configuration_base(void) const
   d = static_cast<PainterBackendPrivate*>(m_d);
   return d->m_config;
 }
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::PainterBackend::
+map_draw(unsigned int attributes_requested,
+         unsigned int indices_requested,
+         unsigned int store_requested)
+{
+  FASTUIDRAWunused(attributes_requested);
+  FASTUIDRAWunused(indices_requested);
+  FASTUIDRAWunused(store_requested);
+  return map_draw();
+}
@@ -20,11 +20,15 @@
 
 #include <vector>
 #include <list>
+#include <atomic>
+#include <bitset>
+#include <unordered_map>
 #include <cstring>
 
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 #include <fastuidraw/painter/painter_header.hpp>
 #include "../../private/util_private.hpp"
+#include "../../private/bulk_copy.hpp"
 
 namespace
 {
@@ -67,6 +71,11 @@ namespace
       PainterShaderGroupValues(obj)
     {}
 
+    explicit
+    PainterShaderGroupPrivate(const PainterShaderGroupValues &obj):
+      PainterShaderGroupValues(obj)
+    {}
+
     void
     operator=(const PainterShaderGroupPrivate &obj)
     {
@@ -74,10 +83,11 @@ namespace
     }
   };
 
-  /* QUESTION
-      - does the reference count to a pool need to be thread safe?
+  /* The reference count to a pool needs to be thread safe
+     because a PainterPackedValue from a thread safe pool
+     may be released from any thread.
    */
-  class PoolBase:public fastuidraw::reference_counted<PoolBase>::non_concurrent
+  class PoolBase:public fastuidraw::reference_counted<PoolBase>::default_base
   {
   public:
     enum
@@ -85,36 +95,48 @@ namespace
         pool_size = 1024
       };
 
-    PoolBase(void):
+    explicit
+    PoolBase(bool thread_safe):
+      m_thread_safe(thread_safe),
       m_free_slots_back(pool_size - 1)
     {
       for(unsigned int i = 0; i < pool_size; ++i)
         {
           m_free_slots[i] = pool_size - 1 - i;
         }
+
+      /* the lock free stack starts with all slots, with
+         slot i linking to slot i + 1.
+       */
+      for(unsigned int i = 0; i < pool_size; ++i)
+        {
+          m_next_free[i].store((i + 1 < pool_size) ? int(i + 1) : -1, std::memory_order_relaxed);
+        }
+      m_free_head.store(pack_head(0, 0), std::memory_order_relaxed);
     }
 
     ~PoolBase()
     {
-      FASTUIDRAWassert(m_free_slots_back == pool_size - 1);
+      /* every slot must have been released */
+      FASTUIDRAWassert(number_free_slots() == pool_size);
+    }
+
+    bool
+    thread_safe(void) const
+    {
+      return m_thread_safe;
     }
 
     int
     aquire_slot(void)
     {
-      /* Should we make this thread safe? We can make it
-         thread safe by using atomic operation on m_free_slots_back.
-         The following code would make it thread safe.
-
-         return_value = m_free_slots_back.fetch_sub(1, std::memory_order_aquire)
-         if(return_value < 0)
-           {
-              m_free_slots_back.fetch_add(1, std::memory_order_aquire);
-           }
-         return return_value;
-       */
       int return_value(-1);
 
+      if(m_thread_safe)
+        {
+          return aquire_slot_lock_free();
+        }
+
       if(m_free_slots_back >= 0)
         {
           return_value = m_free_slots[m_free_slots_back];
@@ -126,19 +148,15 @@ namespace
     void
     release_slot(int v)
     {
-      /* Should we make this thread safe? We can make it
-         thread safe by using atomic operation on m_free_slots_back.
-         The following code would make it thread safe.
-
-         int S;
-         S = m_free_slots_back.fetch_add(1, std::memory_order_release);
-         std::atomic_thread_fence(std::memory_order_acquire);
-         FASTUIDRAWassert(S < pool_size);
-         m_free_slots[S] = v;
-       */
       FASTUIDRAWassert(v >= 0);
       FASTUIDRAWassert(v < pool_size);
 
+      if(m_thread_safe)
+        {
+          release_slot_lock_free(v);
+          return;
+        }
+
       ++m_free_slots_back;
 
       FASTUIDRAWassert(m_free_slots_back < pool_size);
@@ -146,8 +164,109 @@ namespace
     }
 
   private:
+    /* number of distinct slots on the free list; only
+       called when no other thread accesses the pool.
+     */
+    int
+    number_free_slots(void) const
+    {
+      std::bitset<pool_size> seen;
+      int return_value(0);
+
+      if(!m_thread_safe)
+        {
+          return m_free_slots_back + 1;
+        }
+
+      for(int slot = head_slot(m_free_head.load(std::memory_order_acquire));
+          slot >= 0 && slot < pool_size && !seen[slot];
+          slot = m_next_free[slot].load(std::memory_order_relaxed))
+        {
+          seen[slot] = true;
+          ++return_value;
+        }
+      return return_value;
+    }
+
+    /* The free list of a thread safe pool is a lock free
+       stack (Treiber stack) of slots: m_free_head packs the
+       slot at the top of the stack in its low 32-bits and a
+       tag in its high 32-bits; the tag is incremented on each
+       change to the head so that a compare and swap against
+       a stale head fails even if the same slot is at the top
+       again (i.e. the ABA problem).
+     */
+    static
+    uint64_t
+    pack_head(int slot, uint32_t tag)
+    {
+      return (uint64_t(tag) << 32u) | uint64_t(uint32_t(slot));
+    }
+
+    static
+    int
+    head_slot(uint64_t head)
+    {
+      return int(uint32_t(head & 0xFFFFFFFFu));
+    }
+
+    static
+    uint32_t
+    head_tag(uint64_t head)
+    {
+      return uint32_t(head >> 32u);
+    }
+
+    int
+    aquire_slot_lock_free(void)
+    {
+      uint64_t head, new_head;
+      int slot;
+
+      head = m_free_head.load(std::memory_order_acquire);
+      do
+        {
+          slot = head_slot(head);
+          if(slot < 0)
+            {
+              return -1;
+            }
+          new_head = pack_head(m_next_free[slot].load(std::memory_order_relaxed),
+                               head_tag(head) + 1u);
+        }
+      while(!m_free_head.compare_exchange_weak(head, new_head,
+                                               std::memory_order_acquire,
+                                               std::memory_order_acquire));
+      return slot;
+    }
+
+    void
+    release_slot_lock_free(int v)
+    {
+      uint64_t head, new_head;
+
+      head = m_free_head.load(std::memory_order_relaxed);
+      do
+        {
+          m_next_free[v].store(head_slot(head), std::memory_order_relaxed);
+          new_head = pack_head(v, head_tag(head) + 1u);
+        }
+      while(!m_free_head.compare_exchange_weak(head, new_head,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+    bool m_thread_safe;
+
+    /* free list for non-thread safe pools
+     */
     int m_free_slots_back;
     fastuidraw::vecN<int, pool_size> m_free_slots;
+
+    /* free list for thread safe pools
+     */
+    std::atomic<uint64_t> m_free_head;
+    std::atomic<int> m_next_free[pool_size];
   };
 
   class EntryBase
@@ -156,7 +275,9 @@ namespace
 
     EntryBase(void):
       m_raw_value(nullptr),
-      m_pool_slot(-1)
+      m_pool_slot(-1),
+      m_thread_safe(false),
+      m_count(0)
     {}
 
     void
@@ -164,19 +285,51 @@ namespace
     {
       FASTUIDRAWassert(m_pool);
       FASTUIDRAWassert(m_pool_slot >= 0);
-      m_count.add_reference();
+      if(m_thread_safe)
+        {
+          m_count.fetch_add(1, std::memory_order_relaxed);
+        }
+      else
+        {
+          m_count.store(m_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
     }
 
     void
     release(void)
     {
+      bool last_reference;
+
       FASTUIDRAWassert(m_pool);
       FASTUIDRAWassert(m_pool_slot >= 0);
-      if(m_count.remove_reference())
+      if(m_thread_safe)
+        {
+          last_reference = (m_count.fetch_sub(1, std::memory_order_release) == 1);
+          if(last_reference)
+            {
+              std::atomic_thread_fence(std::memory_order_acquire);
+            }
+        }
+      else
+        {
+          int v;
+          v = m_count.load(std::memory_order_relaxed) - 1;
+          m_count.store(v, std::memory_order_relaxed);
+          last_reference = (v == 0);
+        }
+
+      if(last_reference)
         {
-          m_pool->release_slot(m_pool_slot);
+          /* once the slot is released, another thread may take
+             it and reset its fields, so clear our fields first
+             and keep the pool alive until the slot is released.
+           */
+          fastuidraw::reference_counted_ptr<PoolBase> pool;
+          int slot(m_pool_slot);
+
+          pool.swap(m_pool);
           m_pool_slot = -1;
-          m_pool = nullptr;
+          pool->release_slot(slot);
         }
     }
 
@@ -209,11 +362,16 @@ namespace
     fastuidraw::reference_counted_ptr<PoolBase> m_pool;
     int m_pool_slot;
 
+    /* if true, m_count is modified with atomic
+       operations, value comes from the pool.
+     */
+    bool m_thread_safe;
+
   private:
-    /* Entry reference count is not thread safe because
-       the objects themselves are not.
+    /* Entry reference count is only updated atomically
+       for entries of a thread safe pool.
     */
-    fastuidraw::reference_count_non_concurrent m_count;
+    std::atomic<int> m_count;
   };
 
   template<typename T>
@@ -234,6 +392,7 @@ namespace
       m_pool = p;
       m_state = st;
       m_pool_slot = slot;
+      m_thread_safe = p->thread_safe();
 
       this->m_begin_id = -1;
       this->m_draw_command_id = 0;
@@ -251,6 +410,11 @@ namespace
   class Pool:public PoolBase
   {
   public:
+    explicit
+    Pool(bool thread_safe):
+      PoolBase(thread_safe)
+    {}
+
     /* Returning nullptr indicates no free entries left in the pool
      */
     Entry<T>*
@@ -277,9 +441,12 @@ namespace
   {
   public:
 
-    PoolSet(void)
+    explicit
+    PoolSet(bool thread_safe):
+      m_thread_safe(thread_safe)
     {
-      m_pools.push_back(FASTUIDRAWnew Pool<T>());
+      m_pools.push_back(FASTUIDRAWnew Pool<T>(m_thread_safe));
+      m_current.store(m_pools.back().get(), std::memory_order_relaxed);
     }
 
     Entry<T>*
@@ -287,10 +454,15 @@ namespace
     {
       Entry<T> *return_value;
 
+      if(m_thread_safe)
+        {
+          return allocate_thread_safe(st, alignment);
+        }
+
       return_value = m_pools.back()->allocate(st, alignment);
       if(!return_value)
         {
-          m_pools.push_back(FASTUIDRAWnew Pool<T>());
+          m_pools.push_back(FASTUIDRAWnew Pool<T>(m_thread_safe));
           return_value = m_pools.back()->allocate(st, alignment);
         }
 
@@ -299,18 +471,56 @@ namespace
     }
 
   private:
+    /* allocating from the current pool is lock free, only
+       adding a new pool requires locking.
+     */
+    Entry<T>*
+    allocate_thread_safe(const T &st, int alignment)
+    {
+      Entry<T> *return_value;
+
+      return_value = m_current.load(std::memory_order_acquire)->allocate(st, alignment);
+      if(!return_value)
+        {
+          fastuidraw::autolock_mutex M(m_mutex);
+
+          /* another thread may have added a pool
+             while we waited for the lock.
+           */
+          return_value = m_pools.back()->allocate(st, alignment);
+          if(!return_value)
+            {
+              m_pools.push_back(FASTUIDRAWnew Pool<T>(m_thread_safe));
+              m_current.store(m_pools.back().get(), std::memory_order_release);
+              return_value = m_pools.back()->allocate(st, alignment);
+            }
+        }
+
+      FASTUIDRAWassert(return_value);
+      return return_value;
+    }
+
+    bool m_thread_safe;
+    fastuidraw::mutex m_mutex;
+    std::atomic<Pool<T>*> m_current;
     std::vector<fastuidraw::reference_counted_ptr<Pool<T> > > m_pools;
   };
 
   class PainterPackedValuePoolPrivate
   {
   public:
-    explicit
-    PainterPackedValuePoolPrivate(int d):
-      m_alignment(d)
+    PainterPackedValuePoolPrivate(int d, bool thread_safe):
+      m_alignment(d),
+      m_thread_safe(thread_safe),
+      m_brush_pool(thread_safe),
+      m_clip_equations_pool(thread_safe),
+      m_item_matrix_pool(thread_safe),
+      m_item_shader_data_pool(thread_safe),
+      m_blend_shader_data_pool(thread_safe)
     {}
 
     int m_alignment;
+    bool m_thread_safe;
 
     PoolSet<fastuidraw::PainterBrush> m_brush_pool;
     PoolSet<fastuidraw::PainterClipEquations> m_clip_equations_pool;
@@ -329,13 +539,197 @@ namespace
     uint32_t m_blend_shader_data_loc;
   };
 
+  /* Host memory backing of the PainterDraw objects of
+     a recording stream.
+   */
+  class RecordingBuffers
+  {
+  public:
+    RecordingBuffers(unsigned int num_attributes,
+                     unsigned int num_indices,
+                     unsigned int store_size):
+      m_attributes(num_attributes),
+      m_header_attributes(num_attributes),
+      m_indices(num_indices),
+      m_store(store_size)
+    {}
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+  };
+
+  /* A recording stream is only used by one thread at a time,
+     so the pool need not be thread safe.
+   */
+  class RecordingBufferPool:
+    public fastuidraw::reference_counted<RecordingBufferPool>::non_concurrent
+  {
+  public:
+    RecordingBufferPool(unsigned int num_attributes,
+                        unsigned int num_indices,
+                        unsigned int store_size):
+      m_num_attributes(num_attributes),
+      m_num_indices(num_indices),
+      m_store_size(store_size)
+    {}
+
+    ~RecordingBufferPool()
+    {
+      for(RecordingBuffers *p : m_free)
+        {
+          FASTUIDRAWdelete(p);
+        }
+    }
+
+    RecordingBuffers*
+    request_buffers(void)
+    {
+      RecordingBuffers *return_value;
+      if(m_free.empty())
+        {
+          return_value = FASTUIDRAWnew RecordingBuffers(m_num_attributes, m_num_indices, m_store_size);
+        }
+      else
+        {
+          return_value = m_free.back();
+          m_free.pop_back();
+        }
+      return return_value;
+    }
+
+    void
+    release_buffers(RecordingBuffers *p)
+    {
+      m_free.push_back(p);
+    }
+
+  private:
+    unsigned int m_num_attributes, m_num_indices, m_store_size;
+    std::vector<RecordingBuffers*> m_free;
+  };
+
+  /* A draw break as seen by a RecordedDraw, if m_action
+     is nullptr, the break is from a change in shader groups.
+   */
+  class recorded_break
+  {
+  public:
+    recorded_break(void):
+      m_new_groups(),
+      m_indices_written(0)
+    {}
+
+    PainterShaderGroupValues m_new_groups;
+    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> m_action;
+    unsigned int m_indices_written;
+  };
+
+  /* A RecordedDraw is the PainterDraw used by a recording stream;
+     it is never drawn, instead its contents are copied into the
+     PainterDraw objects of another PainterPacker.
+   */
+  class RecordedDraw:public fastuidraw::PainterDraw
+  {
+  public:
+    explicit
+    RecordedDraw(const fastuidraw::reference_counted_ptr<RecordingBufferPool> &pool):
+      m_pool(pool)
+    {
+      m_buffers = m_pool->request_buffers();
+      m_attributes = fastuidraw::make_c_array(m_buffers->m_attributes);
+      m_header_attributes = fastuidraw::make_c_array(m_buffers->m_header_attributes);
+      m_indices = fastuidraw::make_c_array(m_buffers->m_indices);
+      m_store = fastuidraw::make_c_array(m_buffers->m_store);
+    }
+
+    ~RecordedDraw()
+    {
+      m_pool->release_buffers(m_buffers);
+    }
+
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup &old_groups,
+               const fastuidraw::PainterShaderGroup &new_groups,
+               unsigned int indices_written) const
+    {
+      recorded_break B;
+
+      FASTUIDRAWunused(old_groups);
+      B.m_new_groups = static_cast<const PainterShaderGroupPrivate&>(new_groups);
+      B.m_indices_written = indices_written;
+      m_breaks.push_back(B);
+    }
+
+    virtual
+    void
+    draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action,
+               unsigned int indices_written) const
+    {
+      recorded_break B;
+
+      B.m_action = action;
+      B.m_indices_written = indices_written;
+      m_breaks.push_back(B);
+    }
+
+    virtual
+    void
+    draw(void) const
+    {
+      FASTUIDRAWassert(!"A recording stream cannot draw");
+    }
+
+    fastuidraw::c_array<const recorded_break>
+    breaks(void) const
+    {
+      return fastuidraw::make_c_array(m_breaks);
+    }
+
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int, unsigned int, unsigned int) const
+    {}
+
+  private:
+    fastuidraw::reference_counted_ptr<RecordingBufferPool> m_pool;
+    RecordingBuffers *m_buffers;
+    mutable std::vector<recorded_break> m_breaks;
+  };
+
+  /* If non-nullptr passed to per_draw_command::splice(), then the
+     item matrix of each spliced header is replaced by m_matrix times
+     the recorded item matrix and the clip equations by m_clip.
+   */
+  class splice_transformation
+  {
+  public:
+    fastuidraw::float3x3 m_matrix;
+    fastuidraw::PainterClipEquations m_clip;
+  };
+
+  class splice_workroom
+  {
+  public:
+    std::vector<uint32_t> m_headers;
+
+    /* maps from location of item matrix in recorded store to
+       location of transformed item matrix.
+     */
+    std::vector<uint32_t> m_item_matrix_locations;
+  };
+
   class PainterPackerPrivate;
 
   class per_draw_command
   {
   public:
     per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                     const fastuidraw::PainterBackend::ConfigurationBase &config);
+                     const fastuidraw::PainterBackend::ConfigurationBase &config,
+                     bool is_recording);
 
     unsigned int
     attribute_room(void)
@@ -355,17 +749,42 @@ namespace
     store_room(void)
     {
       unsigned int s;
-      s = store_written();
+      s = store_written() + m_store_reserved;
       FASTUIDRAWassert(s <= m_draw_command->m_store.size());
       return m_draw_command->m_store.size() - s;
     }
 
+    /* store room, in addition to the data itself, that packing
+       a new item matrix takes in the current command, see
+       m_store_reserved.
+     */
+    unsigned int
+    store_room_per_matrix(void) const
+    {
+      return m_is_recording ? m_matrix_size : 0u;
+    }
+
     unsigned int
-    store_written(void)
+    store_written(void) const
     {
       return current_block() * m_alignment;
     }
 
+    bool
+    has_room_for(const per_draw_command &src, unsigned int extra_store)
+    {
+      return attribute_room() >= src.m_attributes_written
+        && index_room() >= src.m_indices_written
+        && store_room() >= src.store_written() + extra_store
+                           + src.m_matrices_written * store_room_per_matrix();
+    }
+
+    /* fetch the locations of the headers of a per_draw_command
+       of a recording stream.
+     */
+    void
+    recorded_headers(std::vector<uint32_t> &out_headers) const;
+
     void
     unmap(void)
     {
@@ -389,37 +808,86 @@ namespace
     void
     draw_break(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw::Action> &action)
     {
+      ++m_action_breaks;
       m_draw_command->draw_break(action, m_indices_written);
     }
 
+    /* copy the data of a per_draw_command of a recording
+       stream, returns the number of headers copied.
+     */
+    unsigned int
+    splice(const per_draw_command &src, unsigned int header_size, int z_offset,
+           const splice_transformation *tr, splice_workroom &work);
+
     fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_draw_command;
     unsigned int m_attributes_written, m_indices_written;
 
+    /* number of draw breaks from changes in shaders, from
+       changes in blending and from PainterDraw::Action objects;
+       a break from a change of both shaders and blending is
+       counted in both m_shader_breaks and m_blend_breaks.
+     */
+    unsigned int m_shader_breaks, m_blend_breaks, m_action_breaks;
+
+    /* number of item matrices written to the store of a
+       command of a recording stream (including those of
+       the commands spliced into it).
+     */
+    unsigned int m_matrices_written;
+
   private:
+    void
+    note_matrices_written(unsigned int count)
+    {
+      if(m_is_recording)
+        {
+          m_matrices_written += count;
+          m_store_reserved += count * m_matrix_size;
+        }
+    }
+
     fastuidraw::c_array<fastuidraw::generic_data>
     allocate_store(unsigned int num_elements);
 
     unsigned int
-    current_block(void)
+    current_block(void) const
     {
       return m_store_blocks_written;
     }
 
+    bool
+    shader_changed(const PainterShaderGroupValues &current)
+    {
+      return current.m_item_group != m_prev_state.m_item_group
+        || (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u;
+    }
+
+    bool
+    blend_changed(const PainterShaderGroupValues &current)
+    {
+      return current.m_blend_group != m_prev_state.m_blend_group
+        || current.m_blend_mode != m_prev_state.m_blend_mode;
+    }
+
+    /* if current requires a draw break against m_prev_state,
+       counts the reasons and returns true
+     */
+    bool
+    needs_draw_break(const PainterShaderGroupValues &current)
+    {
+      bool shader(shader_changed(current)), blend(blend_changed(current));
+
+      m_shader_breaks += shader ? 1u : 0u;
+      m_blend_breaks += blend ? 1u : 0u;
+      return shader || blend;
+    }
+
     void
     pack_state_data(PainterPackerPrivate *p, EntryBase *st_d, uint32_t &location);
 
     template<typename T>
     void
-    pack_state_data_from_value(const T &st, uint32_t &location)
-    {
-      fastuidraw::c_array<fastuidraw::generic_data> dst;
-      unsigned int data_sz;
-
-      location = current_block();
-      data_sz = st.data_size(m_alignment);
-      dst = allocate_store(data_sz);
-      st.pack_data(m_alignment, dst);
-    }
+    pack_state_data_from_value(PainterPackerPrivate *p, const T &st, uint32_t &location);
 
     template<typename T>
     void
@@ -435,18 +903,29 @@ namespace
         }
       else if(obj.m_value != nullptr)
         {
-          pack_state_data_from_value(*obj.m_value, location);
+          pack_state_data_from_value(p, *obj.m_value, location);
         }
       else
         {
           static T v;
-          pack_state_data_from_value(v, location);
+          pack_state_data_from_value(p, v, location);
         }
     }
 
     unsigned int m_store_blocks_written;
     unsigned int m_alignment;
     uint32_t m_brush_shader_mask;
+
+    /* splicing the command of a recording stream with a
+       transformation adds one PainterClipEquations and
+       a transformed copy of each item matrix to the store
+       of the destination. So that a recorded command always
+       fits in a PainterDraw of the backend, a command of a
+       recording stream keeps that much of its store free.
+     */
+    bool m_is_recording;
+    unsigned int m_matrix_size;
+    unsigned int m_store_reserved;
     PainterShaderGroupPrivate m_prev_state;
     fastuidraw::BlendMode m_prev_blend_mode;
   };
@@ -455,6 +934,90 @@ namespace
   {
   public:
     std::vector<unsigned int> m_attribs_loaded;
+    std::vector<fastuidraw::generic_data> m_packed_state;
+  };
+
+  /* A PackedStateHash tracks, by their packed contents, the state
+     values written to the store of the current PainterDraw so that
+     an identical value can reuse the location already written.
+     Because PainterDraw::m_store is write only, the packed values
+     are also kept in host memory to resolve hash collisions.
+   */
+  class PackedStateHash
+  {
+  public:
+    void
+    clear(void)
+    {
+      m_entries.clear();
+      m_data.clear();
+    }
+
+    bool
+    fetch(fastuidraw::c_array<const fastuidraw::generic_data> packed,
+          uint32_t &location) const;
+
+    void
+    add(fastuidraw::c_array<const fastuidraw::generic_data> packed,
+        uint32_t location);
+
+  private:
+    class entry
+    {
+    public:
+      unsigned int m_offset, m_size;
+      uint32_t m_location;
+    };
+
+    static
+    uint64_t
+    compute_hash(fastuidraw::c_array<const fastuidraw::generic_data> packed);
+
+    std::unordered_multimap<uint64_t, entry> m_entries;
+    std::vector<fastuidraw::generic_data> m_data;
+  };
+
+  /* A DrawSizePredictor chooses the sizes (attributes, indices
+     and store) to request from PainterBackend::map_draw() from
+     the amounts written by recent frames: a request is for what
+     the largest of the recent frames wrote beyond what the current
+     frame has written so far. Once the current frame has written
+     more than that, each request is for twice the sizes of the
+     previous PainterDraw of the frame so that the sizes grow
+     quickly for a frame that is larger than the recent ones.
+   */
+  class DrawSizePredictor
+  {
+  public:
+    enum
+      {
+        history_size = 8
+      };
+
+    DrawSizePredictor(void):
+      m_frames(fastuidraw::uvec3(0u)),
+      m_current(0),
+      m_largest(0u),
+      m_last_mapped(0u)
+    {}
+
+    void
+    end_frame(const fastuidraw::uvec3 &written);
+
+    void
+    mapped(const fastuidraw::uvec3 &sizes)
+    {
+      m_last_mapped = sizes;
+    }
+
+    fastuidraw::uvec3
+    request(const fastuidraw::uvec3 &needed,
+            const fastuidraw::uvec3 &written) const;
+
+  private:
+    fastuidraw::vecN<fastuidraw::uvec3, history_size> m_frames;
+    unsigned int m_current;
+    fastuidraw::uvec3 m_largest, m_last_mapped;
   };
 
   class AttributeIndexSrcFromArray
@@ -520,11 +1083,20 @@ namespace
       src = m_index_chunks[index_chunk];
 
       FASTUIDRAWassert(dst.size() == src.size());
-      for(unsigned int i = 0; i < dst.size(); ++i)
+      #ifdef FASTUIDRAW_DEBUG
         {
-          FASTUIDRAWassert(int(src[i]) + m_index_adjusts[index_chunk] >= 0);
-          dst[i] = int(src[i] + index_offset_value) + m_index_adjusts[index_chunk];
+          for(unsigned int i = 0; i < src.size(); ++i)
+            {
+              FASTUIDRAWassert(int(src[i]) + m_index_adjusts[index_chunk] >= 0);
+            }
         }
+      #endif
+
+      /* unsigned addition wraps, so adding the (possibly negative)
+         adjustment as unsigned gives the same values.
+       */
+      fastuidraw::detail::copy_indices_with_offset(dst, src,
+                                                   index_offset_value + m_index_adjusts[index_chunk]);
     }
 
     void
@@ -536,8 +1108,7 @@ namespace
       FASTUIDRAWassert(attribute_chunk < m_attrib_chunks.size());
       src = m_attrib_chunks[attribute_chunk];
 
-      FASTUIDRAWassert(dst.size() == src.size());
-      std::memcpy(dst.c_ptr(), src.c_ptr(), sizeof(fastuidraw::PainterAttribute) * dst.size());
+      fastuidraw::detail::copy_attributes(dst, src);
     }
 
     fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterAttribute> > m_attrib_chunks;
@@ -549,12 +1120,39 @@ namespace
   class PainterPackerPrivate
   {
   public:
-    explicit
     PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
-                         fastuidraw::PainterPacker *p);
+                         fastuidraw::PainterPacker *p,
+                         const fastuidraw::PainterPacker *recording_target);
+
+    /* start a new PainterDraw which is to hold atleast
+       the passed amounts of data
+     */
+    void
+    start_new_command(unsigned int attributes_needed,
+                      unsigned int indices_needed,
+                      unsigned int store_needed);
+
+    void
+    unmap_current_command(void);
+
+    /* increment the stat recording why the current
+       PainterDraw cannot accept more data; if neither
+       attributes nor indices are full, then it is the
+       store that is full.
+     */
+    void
+    note_draw_full(bool attributes_full, bool indices_full);
 
     void
-    start_new_command(void);
+    splice_recording_stream(const PainterPackerPrivate *stream, int z_offset,
+                            const splice_transformation *tr);
+
+    /* returns the store room needed beyond the recorded
+       store for transforming a spliced per_draw_command
+     */
+    unsigned int
+    compute_room_needed_for_transformation(const per_draw_command &src,
+                                           const splice_transformation *tr);
 
     void
     upload_draw_state(const fastuidraw::PainterPackerData &draw_state);
@@ -609,31 +1207,164 @@ namespace
     painter_state_location m_painter_state_location;
     int m_number_begins;
 
+    /* largest store size of the PainterDraw objects returned by
+       PainterBackend::map_draw(), used to size recording streams.
+     */
+    unsigned int m_mapped_store_size;
+    DrawSizePredictor m_draw_size_predictor;
+
+    /* non-nullptr only for a recording stream
+     */
+    const fastuidraw::PainterPacker *m_recording_target;
+    fastuidraw::reference_counted_ptr<RecordingBufferPool> m_recording_pool;
+
     std::vector<per_draw_command> m_accumulated_draws;
     fastuidraw::PainterPacker *m_p;
 
     PainterPackerPrivateWorkroom m_work_room;
+    splice_workroom m_splice_work_room;
     fastuidraw::vecN<unsigned int, fastuidraw::PainterPacker::num_stats> m_stats;
+
+    /* value of ConfigurationBase::hash_packed_state()
+       of the backend
+     */
+    bool m_hash_packed_state;
+    PackedStateHash m_packed_state_hash;
   };
 }
 
+//////////////////////////////////////////
+// PackedStateHash methods
+uint64_t
+PackedStateHash::
+compute_hash(fastuidraw::c_array<const fastuidraw::generic_data> packed)
+{
+  /* FNV-1a over the 32-bit words of the packed data */
+  uint64_t return_value(14695981039346656037ull);
+  for(unsigned int i = 0; i < packed.size(); ++i)
+    {
+      return_value ^= packed[i].u;
+      return_value *= 1099511628211ull;
+    }
+  return return_value;
+}
+
+bool
+PackedStateHash::
+fetch(fastuidraw::c_array<const fastuidraw::generic_data> packed,
+      uint32_t &location) const
+{
+  typedef std::unordered_multimap<uint64_t, entry>::const_iterator iterator;
+  std::pair<iterator, iterator> R;
+
+  R = m_entries.equal_range(compute_hash(packed));
+  for(iterator iter = R.first; iter != R.second; ++iter)
+    {
+      const entry &e(iter->second);
+      if(e.m_size == packed.size()
+         && std::memcmp(&m_data[e.m_offset], packed.c_ptr(),
+                        sizeof(fastuidraw::generic_data) * packed.size()) == 0)
+        {
+          location = e.m_location;
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+PackedStateHash::
+add(fastuidraw::c_array<const fastuidraw::generic_data> packed,
+    uint32_t location)
+{
+  entry e;
+
+  e.m_offset = m_data.size();
+  e.m_size = packed.size();
+  e.m_location = location;
+  m_data.insert(m_data.end(), packed.begin(), packed.end());
+  m_entries.insert(std::make_pair(compute_hash(packed), e));
+}
+
+//////////////////////////////////////////
+// DrawSizePredictor methods
+void
+DrawSizePredictor::
+end_frame(const fastuidraw::uvec3 &written)
+{
+  m_frames[m_current] = written;
+  m_current = (m_current + 1) % history_size;
+
+  m_largest = fastuidraw::uvec3(0u);
+  for(const fastuidraw::uvec3 &f : m_frames)
+    {
+      for(unsigned int i = 0; i < 3; ++i)
+        {
+          m_largest[i] = fastuidraw::t_max(m_largest[i], f[i]);
+        }
+    }
+  m_last_mapped = fastuidraw::uvec3(0u);
+}
+
+fastuidraw::uvec3
+DrawSizePredictor::
+request(const fastuidraw::uvec3 &needed,
+        const fastuidraw::uvec3 &written) const
+{
+  fastuidraw::uvec3 return_value;
+
+  for(unsigned int i = 0; i < 3; ++i)
+    {
+      unsigned int v;
+
+      v = (m_largest[i] > written[i]) ?
+        m_largest[i] - written[i] :
+        2u * m_last_mapped[i];
+      return_value[i] = fastuidraw::t_max(needed[i], v);
+    }
+  return return_value;
+}
 
 //////////////////////////////////////////
 // per_draw_command methods
 per_draw_command::
 per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                 const fastuidraw::PainterBackend::ConfigurationBase &config):
+                 const fastuidraw::PainterBackend::ConfigurationBase &config,
+                 bool is_recording):
   m_draw_command(r),
   m_attributes_written(0),
   m_indices_written(0),
+  m_shader_breaks(0),
+  m_blend_breaks(0),
+  m_action_breaks(0),
+  m_matrices_written(0),
   m_store_blocks_written(0),
   m_alignment(config.alignment()),
-  m_brush_shader_mask(config.brush_shader_mask())
+  m_brush_shader_mask(config.brush_shader_mask()),
+  m_is_recording(is_recording),
+  m_matrix_size(fastuidraw::PainterItemMatrix().data_size(m_alignment)),
+  m_store_reserved(is_recording ?
+                   fastuidraw::PainterClipEquations().data_size(m_alignment) :
+                   0u)
 {
-  m_prev_state.m_item_group = 0;
-  m_prev_state.m_brush = 0;
-  m_prev_state.m_blend_group = 0;
-  m_prev_state.m_blend_mode = 0;
+  if(is_recording)
+    {
+      /* the state of the PainterDraw into which the recorded
+         data is spliced is not known, so we force the first
+         header to record the shader groups it uses.
+       */
+      m_prev_state.m_item_group = ~0u;
+      m_prev_state.m_brush = ~0u;
+      m_prev_state.m_blend_group = ~0u;
+      m_prev_state.m_blend_mode = ~uint64_t(0);
+    }
+  else
+    {
+      m_prev_state.m_item_group = 0;
+      m_prev_state.m_brush = 0;
+      m_prev_state.m_blend_group = 0;
+      m_prev_state.m_blend_mode = 0;
+    }
 }
 
 
@@ -656,10 +1387,13 @@ pack_state_data(PainterPackerPrivate *p,
   if(d->m_painter == p->m_p && d->m_begin_id == p->m_number_begins
      && d->m_draw_command_id == p->m_accumulated_draws.size())
     {
+      ++p->m_stats[fastuidraw::PainterPacker::num_packed_state_hits];
       location = d->m_offset;
       return;
     }
 
+  ++p->m_stats[fastuidraw::PainterPacker::num_packed_state_misses];
+
   /* data not in current data store add
      it to the current store.
    */
@@ -677,13 +1411,55 @@ pack_state_data(PainterPackerPrivate *p,
   d->m_offset = location;
 }
 
+template<typename T>
+void
+per_draw_command::
+pack_state_data_from_value(PainterPackerPrivate *p, const T &st, uint32_t &location)
+{
+  fastuidraw::c_array<fastuidraw::generic_data> dst;
+  unsigned int data_sz;
+
+  data_sz = st.data_size(m_alignment);
+  if(p->m_hash_packed_state)
+    {
+      std::vector<fastuidraw::generic_data> &packed(p->m_work_room.m_packed_state);
+
+      packed.resize(data_sz);
+      st.pack_data(m_alignment, fastuidraw::make_c_array(packed));
+      if(p->m_packed_state_hash.fetch(fastuidraw::make_c_array(packed), location))
+        {
+          ++p->m_stats[fastuidraw::PainterPacker::num_packed_state_hits];
+          return;
+        }
+
+      ++p->m_stats[fastuidraw::PainterPacker::num_packed_state_misses];
+      location = current_block();
+      dst = allocate_store(data_sz);
+      std::copy(packed.begin(), packed.end(), dst.begin());
+      p->m_packed_state_hash.add(fastuidraw::make_c_array(packed), location);
+      return;
+    }
+
+  ++p->m_stats[fastuidraw::PainterPacker::num_packed_state_misses];
+  location = current_block();
+  dst = allocate_store(data_sz);
+  st.pack_data(m_alignment, dst);
+}
+
 void
 per_draw_command::
 pack_painter_state(const fastuidraw::PainterPackerData &state,
                    PainterPackerPrivate *p, painter_state_location &out_data)
 {
+  unsigned int matrix_block;
+
   pack_state_data(p, state.m_clip, out_data.m_clipping_data_loc);
+  matrix_block = current_block();
   pack_state_data(p, state.m_matrix, out_data.m_item_matrix_data_loc);
+  if(current_block() != matrix_block)
+    {
+      note_matrices_written(1);
+    }
   pack_state_data(p, state.m_item_shader_data, out_data.m_item_shader_data_loc);
   pack_state_data(p, state.m_blend_shader_data, out_data.m_blend_shader_data_loc);
   pack_state_data(p, state.m_brush, out_data.m_brush_shader_data_loc);
@@ -735,10 +1511,7 @@ pack_header(unsigned int header_size,
   header.m_z = z;
   header.pack_data(m_alignment, dst);
 
-  if(current.m_item_group != m_prev_state.m_item_group
-     || current.m_blend_group != m_prev_state.m_blend_group
-     || (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u
-     || current.m_blend_mode != m_prev_state.m_blend_mode)
+  if(needs_draw_break(current))
     {
       m_draw_command->draw_break(m_prev_state, current,
                                  m_indices_written);
@@ -754,12 +1527,178 @@ pack_header(unsigned int header_size,
   return return_value;
 }
 
+void
+per_draw_command::
+recorded_headers(std::vector<uint32_t> &out_headers) const
+{
+  fastuidraw::c_array<const uint32_t> header_attribs;
+
+  /* Each header is referenced by the attributes written just
+     after it, so the header locations of the attributes form
+     increasing runs, one run per header.
+   */
+  header_attribs = m_draw_command->m_header_attributes.sub_array(0, m_attributes_written);
+  out_headers.clear();
+  for(unsigned int i = 0; i < header_attribs.size(); ++i)
+    {
+      if(out_headers.empty() || out_headers.back() != header_attribs[i])
+        {
+          out_headers.push_back(header_attribs[i]);
+        }
+    }
+}
+
+unsigned int
+per_draw_command::
+splice(const per_draw_command &src, unsigned int header_size, int z_offset,
+       const splice_transformation *tr, splice_workroom &work)
+{
+  const RecordedDraw *recorded;
+  unsigned int attrib_offset, index_offset, block_offset;
+  uint32_t clip_location(0);
+  fastuidraw::c_array<const fastuidraw::PainterAttribute> src_attribs;
+  fastuidraw::c_array<const uint32_t> src_header_attribs;
+  fastuidraw::c_array<const fastuidraw::PainterIndex> src_indices;
+  fastuidraw::c_array<const fastuidraw::generic_data> src_store;
+  fastuidraw::c_array<fastuidraw::PainterAttribute> dst_attribs;
+  fastuidraw::c_array<uint32_t> dst_header_attribs;
+  fastuidraw::c_array<fastuidraw::PainterIndex> dst_indices;
+  fastuidraw::c_array<fastuidraw::generic_data> dst_store;
+
+  recorded = static_cast<const RecordedDraw*>(src.m_draw_command.get());
+  FASTUIDRAWassert(recorded->unmapped());
+
+  attrib_offset = m_attributes_written;
+  index_offset = m_indices_written;
+  block_offset = current_block();
+
+  src_attribs = recorded->m_attributes.sub_array(0, src.m_attributes_written);
+  src_header_attribs = recorded->m_header_attributes.sub_array(0, src.m_attributes_written);
+  src_indices = recorded->m_indices.sub_array(0, src.m_indices_written);
+  src_store = recorded->m_store.sub_array(0, src.store_written());
+
+  dst_attribs = m_draw_command->m_attributes.sub_array(attrib_offset, src_attribs.size());
+  dst_header_attribs = m_draw_command->m_header_attributes.sub_array(attrib_offset, src_attribs.size());
+  dst_indices = m_draw_command->m_indices.sub_array(index_offset, src_indices.size());
+  dst_store = allocate_store(src_store.size());
+
+  /* attributes and the store are copied as-is, then the header
+     locations are incremented by the block offset and the
+     indices by the attribute offset
+   */
+  fastuidraw::detail::copy_attributes(dst_attribs, src_attribs);
+  std::copy(src_store.begin(), src_store.end(), dst_store.begin());
+  fastuidraw::detail::copy_indices_with_offset(dst_header_attribs, src_header_attribs, block_offset);
+  fastuidraw::detail::copy_indices_with_offset(dst_indices, src_indices, attrib_offset);
+
+  if(tr)
+    {
+      fastuidraw::c_array<fastuidraw::generic_data> dst;
+
+      clip_location = current_block();
+      dst = allocate_store(tr->m_clip.data_size(m_alignment));
+      tr->m_clip.pack_data(m_alignment, dst);
+
+      work.m_item_matrix_locations.clear();
+      work.m_item_matrix_locations.resize(src_store.size() / m_alignment, ~0u);
+    }
+
+  /* rebase the store locations and z-value of each header.
+   */
+  src.recorded_headers(work.m_headers);
+  for(uint32_t loc : work.m_headers)
+    {
+      fastuidraw::c_array<fastuidraw::generic_data> header;
+
+      header = dst_store.sub_array(loc * m_alignment, header_size);
+      header[fastuidraw::PainterHeader::brush_shader_data_location_offset].u += block_offset;
+      header[fastuidraw::PainterHeader::item_shader_data_location_offset].u += block_offset;
+      header[fastuidraw::PainterHeader::blend_shader_data_location_offset].u += block_offset;
+      header[fastuidraw::PainterHeader::z_offset].i += z_offset;
+
+      if(tr)
+        {
+          uint32_t src_matrix_loc;
+
+          /* the transformed item matrix is written to a new
+             location so that a store block that only happens to
+             have the same contents is not affected.
+           */
+          src_matrix_loc = header[fastuidraw::PainterHeader::item_matrix_location_offset].u;
+          uint32_t &dst_matrix_loc(work.m_item_matrix_locations[src_matrix_loc]);
+          if(dst_matrix_loc == ~0u)
+            {
+              fastuidraw::c_array<const fastuidraw::generic_data> m;
+              fastuidraw::PainterItemMatrix M;
+
+              m = src_store.sub_array(src_matrix_loc * m_alignment, fastuidraw::PainterItemMatrix::matrix_data_size);
+              M.m_item_matrix(0, 0) = m[fastuidraw::PainterItemMatrix::matrix00_offset].f;
+              M.m_item_matrix(0, 1) = m[fastuidraw::PainterItemMatrix::matrix01_offset].f;
+              M.m_item_matrix(0, 2) = m[fastuidraw::PainterItemMatrix::matrix02_offset].f;
+              M.m_item_matrix(1, 0) = m[fastuidraw::PainterItemMatrix::matrix10_offset].f;
+              M.m_item_matrix(1, 1) = m[fastuidraw::PainterItemMatrix::matrix11_offset].f;
+              M.m_item_matrix(1, 2) = m[fastuidraw::PainterItemMatrix::matrix12_offset].f;
+              M.m_item_matrix(2, 0) = m[fastuidraw::PainterItemMatrix::matrix20_offset].f;
+              M.m_item_matrix(2, 1) = m[fastuidraw::PainterItemMatrix::matrix21_offset].f;
+              M.m_item_matrix(2, 2) = m[fastuidraw::PainterItemMatrix::matrix22_offset].f;
+              M.m_item_matrix = tr->m_matrix * M.m_item_matrix;
+
+              dst_matrix_loc = current_block();
+              M.pack_data(m_alignment, allocate_store(M.data_size(m_alignment)));
+            }
+          header[fastuidraw::PainterHeader::item_matrix_location_offset].u = dst_matrix_loc;
+          header[fastuidraw::PainterHeader::clip_equations_location_offset].u = clip_location;
+        }
+      else
+        {
+          header[fastuidraw::PainterHeader::clip_equations_location_offset].u += block_offset;
+          header[fastuidraw::PainterHeader::item_matrix_location_offset].u += block_offset;
+        }
+    }
+
+  /* replay the draw breaks, a change of shader groups is
+     only a break if it is a break against our current state.
+   */
+  fastuidraw::c_array<const recorded_break> breaks(recorded->breaks());
+  for(unsigned int i = 0; i < breaks.size(); ++i)
+    {
+      if(breaks[i].m_action)
+        {
+          ++m_action_breaks;
+          m_draw_command->draw_break(breaks[i].m_action, breaks[i].m_indices_written + index_offset);
+        }
+      else
+        {
+          PainterShaderGroupPrivate current(breaks[i].m_new_groups);
+          if(needs_draw_break(current))
+            {
+              m_draw_command->draw_break(m_prev_state, current,
+                                         breaks[i].m_indices_written + index_offset);
+            }
+          m_prev_state = current;
+        }
+    }
+
+  m_attributes_written += src_attribs.size();
+  m_indices_written += src_indices.size();
+
+  /* a transformed splice writes at most one matrix for
+     each matrix of src.
+   */
+  note_matrices_written(src.m_matrices_written);
+
+  return work.m_headers.size();
+}
+
 ///////////////////////////////////////////
 // PainterPackerPrivate methods
 PainterPackerPrivate::
 PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
-                     fastuidraw::PainterPacker *p):
+                     fastuidraw::PainterPacker *p,
+                     const fastuidraw::PainterPacker *recording_target):
   m_backend(backend),
+  m_mapped_store_size(0),
+  m_recording_target(recording_target),
   m_p(p)
 {
   m_alignment = m_backend->configuration_base().alignment();
@@ -771,11 +1710,12 @@ PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBacken
   // the shaders as well.
   m_default_shaders = m_backend->default_shaders();
   m_number_begins = 0;
+  m_hash_packed_state = m_backend->configuration_base().hash_packed_state();
 }
 
 void
 PainterPackerPrivate::
-start_new_command(void)
+unmap_current_command(void)
 {
   if(!m_accumulated_draws.empty())
     {
@@ -785,13 +1725,137 @@ start_new_command(void)
       m_stats[fastuidraw::PainterPacker::num_indices] += c.m_indices_written;
       m_stats[fastuidraw::PainterPacker::num_generic_datas] += c.store_written();
       m_stats[fastuidraw::PainterPacker::num_draws] += 1u;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_shader] += c.m_shader_breaks;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_blend] += c.m_blend_breaks;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_action] += c.m_action_breaks;
 
       c.unmap();
     }
+}
+
+void
+PainterPackerPrivate::
+note_draw_full(bool attributes_full, bool indices_full)
+{
+  if(attributes_full)
+    {
+      ++m_stats[fastuidraw::PainterPacker::num_draws_attributes_full];
+    }
+  else if(indices_full)
+    {
+      ++m_stats[fastuidraw::PainterPacker::num_draws_indices_full];
+    }
+  else
+    {
+      ++m_stats[fastuidraw::PainterPacker::num_draws_store_full];
+    }
+}
 
+void
+PainterPackerPrivate::
+start_new_command(unsigned int attributes_needed,
+                  unsigned int indices_needed,
+                  unsigned int store_needed)
+{
   fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> r;
-  r = m_backend->map_draw();
-  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base()));
+
+  unmap_current_command();
+  m_packed_state_hash.clear();
+  if(m_recording_pool)
+    {
+      r = FASTUIDRAWnew RecordedDraw(m_recording_pool);
+    }
+  else
+    {
+      fastuidraw::uvec3 written, request;
+
+      written = fastuidraw::uvec3(m_stats[fastuidraw::PainterPacker::num_attributes],
+                                  m_stats[fastuidraw::PainterPacker::num_indices],
+                                  m_stats[fastuidraw::PainterPacker::num_generic_datas]);
+      request = m_draw_size_predictor.request(fastuidraw::uvec3(attributes_needed, indices_needed, store_needed),
+                                              written);
+      r = m_backend->map_draw(request.x(), request.y(), request.z());
+      m_draw_size_predictor.mapped(fastuidraw::uvec3(r->m_attributes.size(),
+                                                     r->m_indices.size(),
+                                                     r->m_store.size()));
+      m_mapped_store_size = fastuidraw::t_max(m_mapped_store_size,
+                                              static_cast<unsigned int>(r->m_store.size()));
+    }
+  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base(),
+                                                 m_recording_target != nullptr));
+}
+
+unsigned int
+PainterPackerPrivate::
+compute_room_needed_for_transformation(const per_draw_command &src,
+                                       const splice_transformation *tr)
+{
+  if(!tr)
+    {
+      return 0;
+    }
+
+  std::vector<uint32_t> &headers(m_splice_work_room.m_headers);
+  std::vector<uint32_t> &matrix_locs(m_splice_work_room.m_item_matrix_locations);
+  const RecordedDraw *recorded;
+  unsigned int num_matrices(0);
+
+  /* room for one PainterClipEquations and for each
+     distinct item matrix referenced by the headers
+   */
+  recorded = static_cast<const RecordedDraw*>(src.m_draw_command.get());
+  src.recorded_headers(headers);
+  matrix_locs.clear();
+  matrix_locs.resize(src.store_written() / m_alignment, 0u);
+  for(uint32_t loc : headers)
+    {
+      uint32_t M;
+
+      M = recorded->m_store[loc * m_alignment + fastuidraw::PainterHeader::item_matrix_location_offset].u;
+      if(matrix_locs[M] == 0u)
+        {
+          matrix_locs[M] = 1u;
+          ++num_matrices;
+        }
+    }
+
+  return tr->m_clip.data_size(m_alignment)
+    + num_matrices * fastuidraw::PainterItemMatrix().data_size(m_alignment);
+}
+
+void
+PainterPackerPrivate::
+splice_recording_stream(const PainterPackerPrivate *stream, int z_offset,
+                        const splice_transformation *tr)
+{
+  FASTUIDRAWassert(!m_accumulated_draws.empty());
+  for(const per_draw_command &cmd : stream->m_accumulated_draws)
+    {
+      unsigned int extra_room;
+
+      extra_room = compute_room_needed_for_transformation(cmd, tr);
+      if(!m_accumulated_draws.back().has_room_for(cmd, extra_room))
+        {
+          note_draw_full(m_accumulated_draws.back().attribute_room() < cmd.m_attributes_written,
+                         m_accumulated_draws.back().index_room() < cmd.m_indices_written);
+          start_new_command(cmd.m_attributes_written, cmd.m_indices_written,
+                            cmd.store_written() + extra_room);
+
+          /* a command of a recording stream keeps room for
+             the transformation (see per_draw_command::m_store_reserved),
+             so this only fails if the backend maps smaller
+             PainterDraw objects than those of the recording.
+           */
+          if(!m_accumulated_draws.back().has_room_for(cmd, extra_room))
+            {
+              FASTUIDRAWassert(!"Unable to fit recorded command into freshly allocated draw command, not good!");
+              continue;
+            }
+        }
+      m_stats[fastuidraw::PainterPacker::num_headers]
+        += m_accumulated_draws.back().splice(cmd, m_header_size, z_offset,
+                                             tr, m_splice_work_room);
+    }
 }
 
 unsigned int
@@ -814,10 +1878,12 @@ upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
   unsigned int needed_room;
 
   FASTUIDRAWassert(!m_accumulated_draws.empty());
-  needed_room = compute_room_needed_for_packing(draw_state);
+  needed_room = compute_room_needed_for_packing(draw_state)
+    + m_accumulated_draws.back().store_room_per_matrix();
   if(needed_room > m_accumulated_draws.back().store_room())
     {
-      start_new_command();
+      ++m_stats[fastuidraw::PainterPacker::num_draws_store_full];
+      start_new_command(0, 0, needed_room);
     }
   m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
 }
@@ -880,7 +1946,9 @@ draw_generic_implement(const fastuidraw::reference_counted_ptr<fastuidraw::Paint
       if(attrib_room < needed_attrib_room || index_room < num_indices
          || (allocate_header && data_room < m_header_size))
         {
-          start_new_command();
+          note_draw_full(attrib_room < needed_attrib_room, index_room < num_indices);
+          start_new_command(num_attribs, num_indices,
+                            compute_room_needed_for_packing(draw) + m_header_size);
           upload_draw_state(draw);
 
           /* reset attribs_loaded[] and recompute needed_attrib_room
@@ -998,7 +2066,25 @@ fastuidraw::PainterPacker::
 PainterPacker(reference_counted_ptr<PainterBackend> backend)
 {
   FASTUIDRAWassert(backend);
-  m_d = FASTUIDRAWnew PainterPackerPrivate(backend, this);
+  m_d = FASTUIDRAWnew PainterPackerPrivate(backend, this, nullptr);
+}
+
+fastuidraw::PainterPacker::
+PainterPacker(reference_counted_ptr<PainterBackend> backend,
+              const PainterPacker *recording_target)
+{
+  PainterPackerPrivate *d;
+  const PainterPackerPrivate *target;
+
+  FASTUIDRAWassert(backend);
+  FASTUIDRAWassert(recording_target);
+
+  d = FASTUIDRAWnew PainterPackerPrivate(backend, this, recording_target);
+  target = static_cast<const PainterPackerPrivate*>(recording_target->m_d);
+  d->m_recording_pool = FASTUIDRAWnew RecordingBufferPool(backend->attribs_per_mapping(),
+                                                          backend->indices_per_mapping(),
+                                                          target->m_mapped_store_size);
+  m_d = d;
 }
 
 fastuidraw::PainterPacker::
@@ -1017,11 +2103,28 @@ begin(void)
   PainterPackerPrivate *d;
   d = static_cast<PainterPackerPrivate*>(m_d);
 
-  FASTUIDRAWassert(d->m_accumulated_draws.empty());
-  d->m_backend->image_atlas()->delay_tile_freeing();
-  d->m_backend->colorstop_atlas()->delay_interval_freeing();
+  if(d->m_recording_target)
+    {
+      /* discard what was recorded since the previous begin();
+         the atlases are not touched since a recording stream
+         is not the owner of the frame.
+       */
+      d->m_accumulated_draws.clear();
+    }
+  else
+    {
+      FASTUIDRAWassert(d->m_accumulated_draws.empty());
+      d->m_backend->image_atlas()->delay_tile_freeing();
+      d->m_backend->colorstop_atlas()->delay_interval_freeing();
+      if(d->m_number_begins > 0)
+        {
+          d->m_draw_size_predictor.end_frame(uvec3(d->m_stats[num_attributes],
+                                                   d->m_stats[num_indices],
+                                                   d->m_stats[num_generic_datas]));
+        }
+    }
   std::fill(d->m_stats.begin(), d->m_stats.end(), 0u);
-  d->start_new_command();
+  d->start_new_command(0, 0, 0);
   ++d->m_number_begins;
 }
 
@@ -1040,28 +2143,53 @@ query_stat(enum stats_t st) const
       tmp[num_indices] = c.m_indices_written;
       tmp[num_generic_datas] = c.store_written();
       tmp[num_draws] = 1u;
+      tmp[num_draw_breaks_shader] = c.m_shader_breaks;
+      tmp[num_draw_breaks_blend] = c.m_blend_breaks;
+      tmp[num_draw_breaks_action] = c.m_action_breaks;
     }
   return d->m_stats[st] + tmp[st];
 }
 
+fastuidraw::c_string
+fastuidraw::PainterPacker::
+stat_name(enum stats_t st)
+{
+#define EASY(X) case X: return #X
+
+  switch(st)
+    {
+      EASY(num_attributes);
+      EASY(num_indices);
+      EASY(num_generic_datas);
+      EASY(num_draws);
+      EASY(num_headers);
+      EASY(num_draws_attributes_full);
+      EASY(num_draws_indices_full);
+      EASY(num_draws_store_full);
+      EASY(num_draw_breaks_shader);
+      EASY(num_draw_breaks_blend);
+      EASY(num_draw_breaks_action);
+      EASY(num_packed_state_hits);
+      EASY(num_packed_state_misses);
+    default:
+      return "unknown";
+    }
+
+#undef EASY
+}
+
 void
 fastuidraw::PainterPacker::
 flush(void)
 {
   PainterPackerPrivate *d;
   d = static_cast<PainterPackerPrivate*>(m_d);
-  if(!d->m_accumulated_draws.empty())
+  if(d->m_recording_target)
     {
-      per_draw_command &c(d->m_accumulated_draws.back());
-
-      d->m_stats[fastuidraw::PainterPacker::num_attributes] += c.m_attributes_written;
-      d->m_stats[fastuidraw::PainterPacker::num_indices] += c.m_indices_written;
-      d->m_stats[fastuidraw::PainterPacker::num_generic_datas] += c.store_written();
-      d->m_stats[fastuidraw::PainterPacker::num_draws] += 1u;
-
-      c.unmap();
+      return;
     }
 
+  d->unmap_current_command();
   d->m_backend->on_pre_draw();
   for(std::vector<per_draw_command>::iterator iter = d->m_accumulated_draws.begin(),
         end = d->m_accumulated_draws.end(); iter != end; ++iter)
@@ -1077,6 +2205,20 @@ void
 fastuidraw::PainterPacker::
 end(void)
 {
+  PainterPackerPrivate *d;
+  d = static_cast<PainterPackerPrivate*>(m_d);
+  if(d->m_recording_target)
+    {
+      /* keep the recorded commands, but do not add the last
+         command to m_stats since query_stat() adds it in.
+       */
+      if(!d->m_accumulated_draws.empty())
+        {
+          d->m_accumulated_draws.back().unmap();
+        }
+      return;
+    }
+
   flush();
   image_atlas()->undelay_tile_freeing();
   colorstop_atlas()->undelay_interval_freeing();
@@ -1281,7 +2423,75 @@ target_resolution(int w, int h)
 {
   PainterPackerPrivate *d;
   d = static_cast<PainterPackerPrivate*>(m_d);
-  d->m_backend->target_resolution(w, h);
+  if(!d->m_recording_target)
+    {
+      d->m_backend->target_resolution(w, h);
+    }
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker>
+fastuidraw::PainterPacker::
+create_recording_stream(void)
+{
+  PainterPackerPrivate *d;
+  d = static_cast<PainterPackerPrivate*>(m_d);
+
+  /* the sizes of the buffers of a recording stream come from
+     the PainterDraw objects of the backend, so at least one must
+     have been mapped, i.e. begin() must have been called.
+   */
+  FASTUIDRAWassert(!d->m_recording_target);
+  FASTUIDRAWassert(d->m_mapped_store_size > 0);
+  return FASTUIDRAWnew PainterPacker(d->m_backend, this);
+}
+
+bool
+fastuidraw::PainterPacker::
+is_recording_stream(void) const
+{
+  PainterPackerPrivate *d;
+  d = static_cast<PainterPackerPrivate*>(m_d);
+  return d->m_recording_target != nullptr;
+}
+
+void
+fastuidraw::PainterPacker::
+splice_recording_stream(const reference_counted_ptr<const PainterPacker> &stream,
+                        int z_offset)
+{
+  PainterPackerPrivate *d;
+  const PainterPackerPrivate *s;
+
+  FASTUIDRAWassert(stream);
+  d = static_cast<PainterPackerPrivate*>(m_d);
+  s = static_cast<const PainterPackerPrivate*>(stream->m_d);
+
+  FASTUIDRAWassert(s->m_recording_target == this);
+  FASTUIDRAWassert(s->m_accumulated_draws.empty()
+                   || s->m_accumulated_draws.back().m_draw_command->unmapped());
+  d->splice_recording_stream(s, z_offset, nullptr);
+}
+
+void
+fastuidraw::PainterPacker::
+splice_recording_stream(const reference_counted_ptr<const PainterPacker> &stream,
+                        int z_offset, const float3x3 &transformation,
+                        const PainterClipEquations &clip)
+{
+  PainterPackerPrivate *d;
+  const PainterPackerPrivate *s;
+  splice_transformation tr;
+
+  FASTUIDRAWassert(stream);
+  d = static_cast<PainterPackerPrivate*>(m_d);
+  s = static_cast<const PainterPackerPrivate*>(stream->m_d);
+
+  FASTUIDRAWassert(s->m_recording_target == this);
+  FASTUIDRAWassert(s->m_accumulated_draws.empty()
+                   || s->m_accumulated_draws.back().m_draw_command->unmapped());
+  tr.m_matrix = transformation;
+  tr.m_clip = clip;
+  d->splice_recording_stream(s, z_offset, &tr);
 }
 
 //////////////////////////////////////////
@@ -1371,9 +2581,9 @@ raw_value(void) const
 /////////////////////////////////////////////////////
 // PainterPackedValuePool methods
 fastuidraw::PainterPackedValuePool::
-PainterPackedValuePool(int alignment)
+PainterPackedValuePool(int alignment, bool thread_safe)
 {
-  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment);
+  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment, thread_safe);
 }
 
 fastuidraw::PainterPackedValuePool::
@@ -1385,6 +2595,15 @@ fastuidraw::PainterPackedValuePool::
   m_d = nullptr;
 }
 
+bool
+fastuidraw::PainterPackedValuePool::
+thread_safe(void) const
+{
+  PainterPackedValuePoolPrivate *d;
+  d = static_cast<PainterPackedValuePoolPrivate*>(m_d);
+  return d->m_thread_safe;
+}
+
 fastuidraw::PainterPackedValue<fastuidraw::PainterBrush>
 fastuidraw::PainterPackedValuePool::
 create_packed_value(const PainterBrush &value)
@@ -19,10 +19,14 @@
 
 #include <vector>
 #include <bitset>
+#include <algorithm>
+#include <limits>
 
 #include <fastuidraw/util/math.hpp>
 #include <fastuidraw/painter/painter_header.hpp>
 #include <fastuidraw/painter/painter.hpp>
+#include <fastuidraw/painter/painter_display_list.hpp>
+#include <fastuidraw/text/glyph.hpp>
 
 #include "../private/util_private.hpp"
 #include "../private/util_private_ostream.hpp"
@@ -30,10 +34,68 @@
 
 namespace
 {
-  class ZDelayedAction;
-  class ZDataCallBack;
   class PainterPrivate;
 
+  /* work of Painter that is timed when a PainterTrace is set
+   */
+  enum trace_timing_t
+    {
+      trace_select_subsets,
+      trace_compute_chunks,
+      trace_clip,
+
+      number_trace_timings
+    };
+
+  enum trace_atlas_t
+    {
+      trace_glyph_atlas,
+      trace_image_atlas,
+      trace_colorstop_atlas,
+
+      number_trace_atlases
+    };
+
+  inline
+  fastuidraw::c_string
+  trace_timing_name(enum trace_timing_t tp)
+  {
+    static const fastuidraw::c_string names[number_trace_timings] =
+      {
+        "FilledPath::select_subsets",
+        "StrokedPath::compute_chunks",
+        "clip",
+      };
+    return names[tp];
+  }
+
+  /* the calls of an aggregated trace_timing_t are made once
+     or more per draw call of a Painter, so instead of adding
+     a duration event for each call, the calls made while the
+     same PainterDraw is current are recorded as one event.
+   */
+  inline
+  bool
+  trace_timing_aggregated(enum trace_timing_t tp)
+  {
+    return tp == trace_select_subsets || tp == trace_compute_chunks;
+  }
+
+  class trace_aggregate
+  {
+  public:
+    trace_aggregate(void):
+      m_start(0),
+      m_end(0),
+      m_total(0),
+      m_calls(0),
+      m_draw(0)
+    {}
+
+    uint64_t m_start, m_end, m_total;
+    unsigned int m_calls, m_draw;
+  };
+
   /* A WindingSet is way to cache values from a
      fastuidraw::CustomFillRuleBase.
    */
@@ -124,79 +186,6 @@ namespace
     std::vector<uint32_t> m_values;
   };
 
-  class change_header_z
-  {
-  public:
-    change_header_z(const fastuidraw::PainterHeader &header,
-                    fastuidraw::c_array<fastuidraw::generic_data> mapped_location)
-    {
-      FASTUIDRAWunused(header);
-      m_mapped = &mapped_location[fastuidraw::PainterHeader::z_offset].i;
-    }
-
-    //location to which to write to overwrite value.
-    int32_t *m_mapped;
-  };
-
-  class ZDelayedAction:public fastuidraw::PainterDraw::DelayedAction
-  {
-  public:
-    void
-    finalize_z(int z)
-    {
-      m_z_to_write = z;
-      perform_action();
-    }
-
-  protected:
-
-    virtual
-    void
-    action(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &)
-    {
-      for(unsigned int i = 0, endi = m_dests.size(); i < endi; ++i)
-        {
-          *m_dests[i].m_mapped = m_z_to_write;
-        }
-    }
-
-  private:
-    friend class ZDataCallBack;
-    int32_t m_z_to_write;
-    std::vector<change_header_z> m_dests;
-  };
-
-  class ZDataCallBack:public fastuidraw::PainterPacker::DataCallBack
-  {
-  public:
-    virtual
-    void
-    current_draw(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &h)
-    {
-      if(h != m_cmd)
-        {
-          m_cmd = h;
-          m_current = FASTUIDRAWnew ZDelayedAction();
-          m_actions.push_back(m_current);
-          m_cmd->add_action(m_current);
-        }
-    }
-
-    virtual
-    void
-    header_added(const fastuidraw::PainterHeader &original_value,
-                 fastuidraw::c_array<fastuidraw::generic_data> mapped_location)
-    {
-      m_current->m_dests.push_back(change_header_z(original_value, mapped_location));
-    }
-
-    std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PainterDraw::DelayedAction> > m_actions;
-
-  private:
-    fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_cmd;
-    fastuidraw::reference_counted_ptr<ZDelayedAction> m_current;
-  };
-
   bool
   all_pts_culled_by_one_half_plane(const fastuidraw::vecN<fastuidraw::vec3, 4> &pts,
                                    const fastuidraw::PainterClipEquations &eq)
@@ -226,8 +215,7 @@ namespace
   void
   draw_half_plane_complement(const fastuidraw::PainterData &draw,
                              fastuidraw::Painter *painter,
-                             const fastuidraw::vec3 &plane,
-                             const fastuidraw::reference_counted_ptr<ZDataCallBack> &callback)
+                             const fastuidraw::vec3 &plane)
   {
     if(fastuidraw::t_abs(plane.x()) > fastuidraw::t_abs(plane.y()))
       {
@@ -264,8 +252,7 @@ namespace
                            fastuidraw::vec2(c, -1.0f),
                            fastuidraw::vec2(d, +1.0f),
                            fastuidraw::vec2(b, +1.0f),
-                           false,
-                           callback);
+                           false);
       }
     else if(fastuidraw::t_abs(plane.y()) > 0.0f)
       {
@@ -289,8 +276,7 @@ namespace
                            fastuidraw::vec2(-1.0f, c),
                            fastuidraw::vec2(+1.0f, d),
                            fastuidraw::vec2(+1.0f, b),
-                           false,
-                           callback);
+                           false);
 
       }
     else if(plane.z() <= 0.0f)
@@ -302,8 +288,7 @@ namespace
                            fastuidraw::vec2(-1.0f, +1.0f),
                            fastuidraw::vec2(+1.0f, +1.0f),
                            fastuidraw::vec2(+1.0f, -1.0f),
-                           false,
-                           callback);
+                           false);
       }
   }
 
@@ -468,12 +453,35 @@ namespace
 
     void
     clip_polygon(fastuidraw::c_array<const fastuidraw::vec2> pts,
+                 std::vector<fastuidraw::vec2> &out_pts,
+                 std::vector<fastuidraw::vec2> &work_vec2s,
+                 std::vector<float> &work_floats)
+    {
+      clip_polygon(item_matrix(), pts, out_pts, work_vec2s, work_floats);
+    }
+
+    /* clip a polygon drawn with item matrix m instead
+       of the current item matrix.
+     */
+    void
+    clip_polygon(const fastuidraw::float3x3 &m,
+                 fastuidraw::c_array<const fastuidraw::vec2> pts,
                  std::vector<fastuidraw::vec2> &out_pts,
                  std::vector<fastuidraw::vec2> &work_vec2s,
                  std::vector<float> &work_floats);
 
     bool
-    rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh);
+    rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
+    {
+      return rect_is_culled(m_item_matrix.m_item_matrix, pmin, wh);
+    }
+
+    /* check if a rect drawn with item matrix m instead
+       of the current item matrix is culled.
+     */
+    bool
+    rect_is_culled(const fastuidraw::float3x3 &m,
+                   const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh);
 
     clip_rect m_clip_rect;
     bool m_all_content_culled;
@@ -489,24 +497,101 @@ namespace
     fastuidraw::float3x3 m_item_matrix_inverse_transpose;
   };
 
-  class occluder_stack_entry
+  /* A draw of an occluder captured so that the occluder
+     can be drawn again with a different z-value.
+   */
+  class occluder_draw
+  {
+  public:
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_shader;
+    fastuidraw::PainterPackerData m_data;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> m_blend;
+    fastuidraw::BlendMode::packed_value m_blend_mode;
+    std::vector<fastuidraw::c_array<const fastuidraw::PainterAttribute> > m_attrib_chunks;
+    std::vector<fastuidraw::c_array<const fastuidraw::PainterIndex> > m_index_chunks;
+    std::vector<int> m_index_adjusts;
+    std::vector<unsigned int> m_attrib_chunk_selector;
+  };
+
+  /* The occluders added by a single clipOutPath() or clipInRect().
+
+     The occluders must occlude everything drawn after them until
+     they are popped, but nothing drawn after they are popped. Since
+     the depth test is GL_GEQUAL, this means that the z-value of
+     the occluders must be greater than the z-value of all content
+     drawn while they are on the occluder stack. Rather than patching
+     the z-value of the occluder headers when the occluders are popped,
+     a range of z-values is reserved for the content when the occluders
+     are added and the occluders are drawn directly with the z-value
+     m_z at the end of that range. Should the content need more z-values
+     than reserved, the occluders are drawn again (see PainterPrivate::reserve_z())
+     with a larger z-value; drawing an occluder again only occludes content
+     drawn after it, which is exactly the content that needs it. On popping
+     the occluders, the current z-value is advanced to m_z.
+   */
+  class occluder_stack_entry:
+    public fastuidraw::reference_counted<occluder_stack_entry>::non_concurrent
   {
   public:
-    /* steals the data it does.
+    /* If copy_data is true, the attribute and index data of each captured
+       draw is copied; otherwise the caller guarantees that the data stays
+       valid for the lifetime of the occluder_stack_entry.
      */
-    explicit
-    occluder_stack_entry(std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PainterDraw::DelayedAction> > &pz)
+    occluder_stack_entry(unsigned int index, int start_z, int reservation, bool copy_data):
+      m_index(index),
+      m_start_z(start_z),
+      m_z(start_z + reservation),
+      m_reservation(reservation),
+      m_copy_data(copy_data)
+    {}
+
+    void
+    capture(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+            const fastuidraw::PainterPackerData &data,
+            const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend,
+            fastuidraw::BlendMode::packed_value blend_mode,
+            fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterAttribute> > attrib_chunks,
+            fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
+            fastuidraw::c_array<const int> index_adjusts,
+            fastuidraw::c_array<const unsigned int> attrib_chunk_selector,
+            fastuidraw::PainterPackedValuePool &pool);
+
+    /* draw the captured occluders again with the value of m_z */
+    void
+    redraw(fastuidraw::PainterPacker &core) const;
+
+    bool
+    empty(void) const
     {
-      m_set_occluder_z.swap(pz);
+      return m_draws.empty();
     }
 
-    void
-    on_pop(fastuidraw::Painter *p);
+    /* number of occluder_stack_entry objects created
+       in the frame before this one.
+     */
+    unsigned int m_index;
 
-  private:
-    /* action to execute on popping.
+    /* value of the current z when the occluders were added */
+    int m_start_z;
+
+    /* z-value of the occluders */
+    int m_z;
+
+    /* number of z-values reserved for the content when
+       the occluders were last drawn.
      */
-    std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PainterDraw::DelayedAction> > m_set_occluder_z;
+    int m_reservation;
+
+    /* keeps alive the attribute data of the occluders
+       when they come from filling a path.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_filled_path;
+
+  private:
+    bool m_copy_data;
+    std::vector<occluder_draw> m_draws;
+    std::vector<std::vector<fastuidraw::PainterAttribute> > m_attribs;
+    std::vector<std::vector<fastuidraw::PainterIndex> > m_indices;
   };
 
   class state_stack_entry
@@ -644,13 +729,23 @@ namespace
     std::vector<int> m_fill_aa_fuzz_index_adjusts;
     fastuidraw::StrokedPath::ScratchSpace m_stroked_path_scratch;
     fastuidraw::FilledPath::ScratchSpace m_filled_path_scratch;
+    std::vector<fastuidraw::PainterData> m_batch_draws;
+    std::vector<fastuidraw::float3x3> m_batch_matrices;
+    std::vector<fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> > m_batch_matrix_states;
+    std::vector<fastuidraw::PainterAttribute> m_batch_attribs;
+    std::vector<fastuidraw::PainterIndex> m_batch_indices;
+    std::vector<fastuidraw::range_type<unsigned int> > m_batch_attrib_ranges, m_batch_index_ranges;
+    std::vector<fastuidraw::c_array<const fastuidraw::PainterAttribute> > m_batch_attrib_chunks;
+    std::vector<fastuidraw::c_array<const fastuidraw::PainterIndex> > m_batch_index_chunks;
+    std::vector<int> m_batch_index_adjusts;
+    std::vector<unsigned int> m_batch_glyph_types;
   };
 
   class PainterPrivate
   {
   public:
-    explicit
-    PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend);
+    PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
+                   fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker> core);
 
     void
     draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
@@ -675,6 +770,54 @@ namespace
                          const WindingSet &wset,
                          const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
 
+    /* set the PainterData and transformations that the
+       BatchedRect and BatchedGlyphRun values index into.
+     */
+    void
+    begin_batch(fastuidraw::c_array<const fastuidraw::PainterData> draws,
+                fastuidraw::c_array<const fastuidraw::float3x3> transformations);
+
+    const fastuidraw::float3x3&
+    batch_matrix(int transformation);
+
+    const fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix>&
+    batch_matrix_state(int transformation);
+
+    /* draw chunks with a single header with the PainterData and
+       transformation of the batch named by draw and transformation.
+     */
+    void
+    draw_batch_chunks(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                      unsigned int draw, int transformation,
+                      fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterAttribute> > attrib_chunks,
+                      fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
+                      fastuidraw::c_array<const int> index_adjusts,
+                      const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    /* draw a sequence of rects that all share the same
+       PainterData and transformation.
+     */
+    void
+    draw_rect_run(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                  fastuidraw::c_array<const fastuidraw::Painter::BatchedRect> rects,
+                  const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    /* draw a sequence of glyph runs that all share the
+       same PainterData and transformation.
+     */
+    void
+    draw_glyph_run(const fastuidraw::PainterGlyphShader &shader,
+                   fastuidraw::c_array<const fastuidraw::Painter::BatchedGlyphRun> runs,
+                   const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
+
+    /* stamp the glyphs as used by the current frame so that
+       a GlyphCache does not evict them, see
+       fastuidraw::Glyph::mark_used(); a recording stream also
+       keeps them in m_recorded_glyphs.
+     */
+    void
+    mark_glyphs_used(fastuidraw::c_array<const fastuidraw::Glyph> glyphs);
+
     bool
     update_clip_equation_series(const fastuidraw::vec2 &pmin,
                                 const fastuidraw::vec2 &pmax);
@@ -688,20 +831,172 @@ namespace
     float
     select_path_thresh_perspective(const fastuidraw::Path &path);
 
+    /* returns the TessellatedPath with which to draw a Path
+       for the threshold thresh (from select_path_thresh()),
+       applying m_tessellation_hysteresis and
+       m_async_path_tessellation.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+    select_tessellation(const fastuidraw::Path &path, float thresh);
+
+    /* returns the FilledPath with which to fill a Path; if
+       m_async_fill_triangulation is true and the FilledPath
+       of the level of detail from select_path_thresh() needs
+       triangulation for the current clipping, its triangulation
+       is moved to the background and the FilledPath of the
+       finest coarser level of detail that needs no triangulation
+       is returned instead (or the coarsest level of detail if
+       none is ready).
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath>
+    select_filled_path(const fastuidraw::Path &path);
+
+    bool
+    filled_path_ready(const fastuidraw::FilledPath &filled_path, bool schedule);
+
+    /* selects the subsets of filled_path to draw into
+       m_work_room.m_fill_subset_selector and returns their
+       number; reuses the selection made by the last call to
+       filled_path_ready() if it returned true for the same
+       FilledPath, clip equations and item matrix.
+     */
+    unsigned int
+    select_fill_subsets(const fastuidraw::FilledPath &filled_path);
+
+    /* make sure that content can be drawn with the z-values
+       m_current_z, m_current_z + 1, ..., m_current_z + n, i.e.
+       that those values are less than the z-value of each
+       occluder on m_occluder_stack, drawing occluders again
+       with a larger z-value as needed.
+     */
+    void
+    reserve_z(int n);
+
+    /* begin_occluders() reserves a range of z-values for the
+       content to be occluded and sets m_current_z to the z-value
+       of the occluders; the draws until end_occluders() are
+       captured in the returned occluder_stack_entry which
+       end_occluders() adds to m_occluder_stack.
+     */
+    occluder_stack_entry*
+    begin_occluders(bool copy_data);
+
+    void
+    end_occluders(void);
+
+    void
+    pop_occluders(void);
+
+    /* record to m_trace a call of tp from start to end */
+    void
+    trace_add(enum trace_timing_t tp, uint64_t start, uint64_t end);
+
+    /* add to m_trace the aggregated calls of tp, if any */
+    void
+    trace_flush_aggregate(enum trace_timing_t tp);
+
     fastuidraw::vec2 m_resolution;
     fastuidraw::vec2 m_one_pixel_width;
     float m_curve_flatness;
+    float m_tessellation_hysteresis;
+    bool m_async_path_tessellation;
+    bool m_async_fill_triangulation;
+    bool m_parallel_path_construction;
+    bool m_advance_glyph_atlas_frame;
     int m_current_z;
     clip_rect_state m_clip_rect_state;
-    std::vector<occluder_stack_entry> m_occluder_stack;
+    std::vector<fastuidraw::reference_counted_ptr<occluder_stack_entry> > m_occluder_stack;
+    fastuidraw::reference_counted_ptr<occluder_stack_entry> m_occluder_capture;
+
+    /* the i'th element is the number of z-values used by the
+       content of the i'th occluder_stack_entry of the current
+       frame (m_occluder_z_usage) and of the previous frame
+       (m_occluder_z_usage_prev); used to choose how many z-values
+       to reserve for the content of occluders.
+     */
+    unsigned int m_number_occluders;
+    std::vector<int> m_occluder_z_usage, m_occluder_z_usage_prev;
     std::vector<state_stack_entry> m_state_stack;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> m_backend;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker> m_core;
+    std::vector<fastuidraw::reference_counted_ptr<fastuidraw::Painter> > m_submitted_streams;
     fastuidraw::PainterPackedValuePool m_pool;
     fastuidraw::PainterPackedValue<fastuidraw::PainterBrush> m_reset_brush, m_black_brush;
     fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> m_identiy_matrix;
     ClipEquationStore m_clip_store;
     PainterWorkRoom m_work_room;
+
+    /* the selection left in m_work_room.m_fill_subset_selector
+       by filled_path_ready(), m_ready_fill_path is nullptr if
+       there is none.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_ready_fill_path;
+    std::vector<fastuidraw::vec3> m_ready_fill_clip;
+    fastuidraw::float3x3 m_ready_fill_matrix;
+    unsigned int m_ready_fill_num_subsets;
     unsigned int m_max_attribs_per_block, m_max_indices_per_block;
+
+    /* tracing state; m_trace_timings is the time spent, in
+       microseconds, of each trace_timing_t since begin()
+       and m_trace_atlas_bytes is the value of bytes_uploaded()
+       of each atlas at begin().
+     */
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterTrace> m_trace;
+    uint64_t m_trace_frame_start;
+    fastuidraw::vecN<uint64_t, number_trace_timings> m_trace_timings;
+    fastuidraw::vecN<uint64_t, number_trace_atlases> m_trace_atlas_bytes;
+    fastuidraw::vecN<unsigned int, number_trace_timings> m_trace_depth;
+    fastuidraw::vecN<trace_aggregate, number_trace_timings> m_trace_aggregates;
+
+    /* glyphs drawn since begin() by a recording stream; a
+       PainterDisplayList replayed by draw_display_list() does
+       not go through draw_glyphs(), so its glyphs are marked
+       as used from this list on each replay.
+     */
+    std::vector<fastuidraw::Glyph> m_recorded_glyphs;
+  };
+
+  /* Records a duration event to PainterPrivate::m_trace (if
+     non-null) for the lifetime of the trace_scope, see also
+     PainterPrivate::trace_add(). Nested trace_scope's of the
+     same trace_timing_t are only counted once in
+     PainterPrivate::m_trace_timings.
+   */
+  class trace_scope:fastuidraw::noncopyable
+  {
+  public:
+    trace_scope(PainterPrivate *d, enum trace_timing_t tp):
+      m_d(d->m_trace ? d : nullptr),
+      m_tp(tp),
+      m_start(0)
+    {
+      if(m_d)
+        {
+          m_start = fastuidraw::PainterTrace::time_stamp();
+          ++m_d->m_trace_depth[m_tp];
+        }
+    }
+
+    ~trace_scope()
+    {
+      if(m_d)
+        {
+          uint64_t end;
+
+          end = fastuidraw::PainterTrace::time_stamp();
+          --m_d->m_trace_depth[m_tp];
+          if(m_d->m_trace_depth[m_tp] == 0)
+            {
+              m_d->m_trace_timings[m_tp] += end - m_start;
+            }
+          m_d->trace_add(m_tp, m_start, end);
+        }
+    }
+
+  private:
+    PainterPrivate *m_d;
+    enum trace_timing_t m_tp;
+    uint64_t m_start;
   };
 }
 
@@ -761,22 +1056,70 @@ scale(float s)
 // occluder_stack_entry methods
 void
 occluder_stack_entry::
-on_pop(fastuidraw::Painter *p)
+capture(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+        const fastuidraw::PainterPackerData &data,
+        const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend,
+        fastuidraw::BlendMode::packed_value blend_mode,
+        fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterAttribute> > attrib_chunks,
+        fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
+        fastuidraw::c_array<const int> index_adjusts,
+        fastuidraw::c_array<const unsigned int> attrib_chunk_selector,
+        fastuidraw::PainterPackedValuePool &pool)
 {
-  /* depth test is GL_GEQUAL, so we need to increment the Z
-     before hand so that the occluders block all that
-     is drawn below them.
+  m_draws.push_back(occluder_draw());
+
+  occluder_draw &dst(m_draws.back());
+  dst.m_shader = shader;
+  dst.m_data = data;
+  dst.m_data.make_packed(pool);
+  dst.m_blend = blend;
+  dst.m_blend_mode = blend_mode;
+  dst.m_index_adjusts.assign(index_adjusts.begin(), index_adjusts.end());
+  dst.m_attrib_chunk_selector.assign(attrib_chunk_selector.begin(), attrib_chunk_selector.end());
+
+  if(!m_copy_data)
+    {
+      dst.m_attrib_chunks.assign(attrib_chunks.begin(), attrib_chunks.end());
+      dst.m_index_chunks.assign(index_chunks.begin(), index_chunks.end());
+      return;
+    }
+
+  /* the std::vector's of m_attribs and m_indices are moved (not
+     copied) when m_attribs and m_indices grow, so the chunks
+     pointing into them stay valid.
    */
-  p->increment_z();
-  for(unsigned int i = 0, endi = m_set_occluder_z.size(); i < endi; ++i)
+  for(fastuidraw::c_array<const fastuidraw::PainterAttribute> chunk : attrib_chunks)
     {
-      ZDelayedAction *ptr;
-      FASTUIDRAWassert(dynamic_cast<ZDelayedAction*>(m_set_occluder_z[i].get()) != nullptr);
-      ptr = static_cast<ZDelayedAction*>(m_set_occluder_z[i].get());
-      ptr->finalize_z(p->current_z());
+      m_attribs.push_back(std::vector<fastuidraw::PainterAttribute>(chunk.begin(), chunk.end()));
+      dst.m_attrib_chunks.push_back(fastuidraw::make_c_array(m_attribs.back()));
+    }
+  for(fastuidraw::c_array<const fastuidraw::PainterIndex> chunk : index_chunks)
+    {
+      m_indices.push_back(std::vector<fastuidraw::PainterIndex>(chunk.begin(), chunk.end()));
+      dst.m_index_chunks.push_back(fastuidraw::make_c_array(m_indices.back()));
     }
 }
 
+void
+occluder_stack_entry::
+redraw(fastuidraw::PainterPacker &core) const
+{
+  fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> old_blend(core.blend_shader());
+  fastuidraw::BlendMode::packed_value old_blend_mode(core.blend_mode());
+
+  for(const occluder_draw &draw : m_draws)
+    {
+      core.blend_shader(draw.m_blend, draw.m_blend_mode);
+      core.draw_generic(draw.m_shader, draw.m_data,
+                        fastuidraw::make_c_array(draw.m_attrib_chunks),
+                        fastuidraw::make_c_array(draw.m_index_chunks),
+                        fastuidraw::make_c_array(draw.m_index_adjusts),
+                        fastuidraw::make_c_array(draw.m_attrib_chunk_selector),
+                        m_z);
+    }
+  core.blend_shader(old_blend, old_blend_mode);
+}
+
 ///////////////////////////////////////////////
 // clip_rect_stat methods
 const fastuidraw::float3x3&
@@ -874,13 +1217,13 @@ set_clip_equations_to_clip_rect(const fastuidraw::PainterPackedValue<fastuidraw:
 
 void
 clip_rect_state::
-clip_polygon(fastuidraw::c_array<const fastuidraw::vec2> pts,
+clip_polygon(const fastuidraw::float3x3 &m,
+             fastuidraw::c_array<const fastuidraw::vec2> pts,
              std::vector<fastuidraw::vec2> &out_pts,
              std::vector<fastuidraw::vec2> &work_vec2s,
              std::vector<float> &work_floats)
 {
   const fastuidraw::PainterClipEquations &eqs(m_clip_equations);
-  const fastuidraw::float3x3 &m(item_matrix());
 
   /* Clip planes are in clip coordinates, i.e.
        ClipDistance[i] = dot(M * p, clip_equation[i])
@@ -907,7 +1250,8 @@ clip_polygon(fastuidraw::c_array<const fastuidraw::vec2> pts,
 
 bool
 clip_rect_state::
-rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
+rect_is_culled(const fastuidraw::float3x3 &m,
+               const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
 {
   /* apply the current transformation matrix to
      the corners of the clipping rectangle and check
@@ -916,10 +1260,10 @@ rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
    */
   fastuidraw::vec2 pmax(wh + pmin);
   fastuidraw::vecN<fastuidraw::vec3, 4> pts;
-  pts[0] = m_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmin.y(), 1.0f);
-  pts[1] = m_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmax.y(), 1.0f);
-  pts[2] = m_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmax.y(), 1.0f);
-  pts[3] = m_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmin.y(), 1.0f);
+  pts[0] = m * fastuidraw::vec3(pmin.x(), pmin.y(), 1.0f);
+  pts[1] = m * fastuidraw::vec3(pmin.x(), pmax.y(), 1.0f);
+  pts[2] = m * fastuidraw::vec3(pmax.x(), pmax.y(), 1.0f);
+  pts[3] = m * fastuidraw::vec3(pmax.x(), pmin.y(), 1.0f);
 
   if(m_clip_rect.m_enabled)
     {
@@ -963,20 +1307,37 @@ clip_against_current(const fastuidraw::float3x3 &clip_matrix_local,
 //////////////////////////////////
 // PainterPrivate methods
 PainterPrivate::
-PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend):
+PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
+               fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker> core):
   m_resolution(1.0f, 1.0f),
   m_one_pixel_width(1.0f, 1.0f),
   m_curve_flatness(1.0f),
+  m_tessellation_hysteresis(1.0f),
+  m_async_path_tessellation(false),
+  m_async_fill_triangulation(false),
+  m_parallel_path_construction(false),
+  m_advance_glyph_atlas_frame(true),
+  m_backend(backend),
+  m_core(core),
   m_pool(backend->configuration_base().alignment())
 {
-  m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
+  if(!m_core)
+    {
+      m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
+    }
   m_reset_brush = m_pool.create_packed_value(fastuidraw::PainterBrush());
   m_black_brush = m_pool.create_packed_value(fastuidraw::PainterBrush()
                                              .pen(0.0f, 0.0f, 0.0f, 0.0f));
   m_identiy_matrix = m_pool.create_packed_value(fastuidraw::PainterItemMatrix());
   m_current_z = 1;
+  m_number_occluders = 0;
   m_max_attribs_per_block = backend->attribs_per_mapping();
   m_max_indices_per_block = backend->indices_per_mapping();
+  m_ready_fill_num_subsets = 0;
+  m_trace_frame_start = 0;
+  m_trace_timings = fastuidraw::vecN<uint64_t, number_trace_timings>(0);
+  m_trace_atlas_bytes = fastuidraw::vecN<uint64_t, number_trace_atlases>(0);
+  m_trace_depth = fastuidraw::vecN<unsigned int, number_trace_timings>(0);
 }
 
 bool
@@ -1194,6 +1555,134 @@ select_path_thresh(const fastuidraw::Path &path)
     }
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+PainterPrivate::
+select_tessellation(const fastuidraw::Path &path, float thresh)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> tess;
+
+  if(!m_async_path_tessellation && m_tessellation_hysteresis <= 1.0f)
+    {
+      return path.tessellation(thresh);
+    }
+
+  tess = path.tessellation_no_wait(thresh, m_tessellation_hysteresis, m_async_path_tessellation);
+  if(!tess)
+    {
+      /* if async, draw with the finest level of detail
+         available until the requested one is ready.
+       */
+      tess = (m_async_path_tessellation) ?
+        path.tessellation_no_wait(thresh, std::numeric_limits<float>::max(), false) :
+        path.tessellation(thresh);
+    }
+  return tess;
+}
+
+bool
+PainterPrivate::
+filled_path_ready(const fastuidraw::FilledPath &filled_path, bool schedule)
+{
+  unsigned int num_subsets;
+  bool ready;
+
+  m_work_room.m_fill_subset_selector.resize(filled_path.number_subsets());
+  ready = filled_path.select_subsets_no_wait(m_work_room.m_filled_path_scratch,
+                                             m_clip_store.current(),
+                                             m_clip_rect_state.item_matrix(),
+                                             m_max_attribs_per_block,
+                                             m_max_indices_per_block,
+                                             fastuidraw::make_c_array(m_work_room.m_fill_subset_selector),
+                                             &num_subsets, schedule);
+  if(ready)
+    {
+      fastuidraw::c_array<const fastuidraw::vec3> clip(m_clip_store.current());
+
+      m_ready_fill_path = &filled_path;
+      m_ready_fill_clip.assign(clip.begin(), clip.end());
+      m_ready_fill_matrix = m_clip_rect_state.item_matrix();
+      m_ready_fill_num_subsets = num_subsets;
+    }
+  else
+    {
+      m_ready_fill_path = nullptr;
+    }
+  return ready;
+}
+
+unsigned int
+PainterPrivate::
+select_fill_subsets(const fastuidraw::FilledPath &filled_path)
+{
+  unsigned int num_subsets;
+  fastuidraw::c_array<const fastuidraw::vec3> clip(m_clip_store.current());
+
+  if(m_ready_fill_path.get() == &filled_path
+     && m_ready_fill_matrix.raw_data() == m_clip_rect_state.item_matrix().raw_data()
+     && m_ready_fill_clip.size() == clip.size()
+     && std::equal(clip.begin(), clip.end(), m_ready_fill_clip.begin()))
+    {
+      m_ready_fill_path = nullptr;
+      return m_ready_fill_num_subsets;
+    }
+
+  m_ready_fill_path = nullptr;
+  m_work_room.m_fill_subset_selector.resize(filled_path.number_subsets());
+  {
+    trace_scope tr(this, trace_select_subsets);
+    num_subsets = filled_path.select_subsets(m_work_room.m_filled_path_scratch,
+                                             clip,
+                                             m_clip_rect_state.item_matrix(),
+                                             m_max_attribs_per_block,
+                                             m_max_indices_per_block,
+                                             fastuidraw::make_c_array(m_work_room.m_fill_subset_selector));
+  }
+  return num_subsets;
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath>
+PainterPrivate::
+select_filled_path(const fastuidraw::Path &path)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> tess(select_tessellation(path, select_path_thresh(path)));
+  unsigned int lod, num_lods;
+
+  /* if tess is the coarsest level of detail, there is
+     nothing to fall back to.
+   */
+  if(!m_async_fill_triangulation
+     || tess == path.tessellation_lod(0)
+     || filled_path_ready(*tess->filled(m_parallel_path_construction), true))
+    {
+      return tess->filled(m_parallel_path_construction);
+    }
+
+  /* the coarser levels of detail come first; looking from the
+     front only touches (in the TessellatedPathCache) the levels
+     of detail that are candidates to fall back to.
+   */
+  for(lod = 1, num_lods = path.number_tessellation_lods();
+      lod < num_lods && path.tessellation_lod(lod) != tess; ++lod)
+    {}
+
+  /* try the finest coarser level of detail first, the levels of
+     detail dropped by the TessellatedPathCache are skipped.
+   */
+  for(; lod > 1; --lod)
+    {
+      fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> t(path.tessellation_lod(lod - 1));
+      if(t && filled_path_ready(*t->filled(m_parallel_path_construction), false))
+        {
+          return t->filled(m_parallel_path_construction);
+        }
+    }
+
+  /* nothing is ready, the coarsest level of detail is
+     the cheapest to wait on.
+   */
+  return path.tessellation_lod(0)->filled(m_parallel_path_construction);
+}
+
 void
 PainterPrivate::
 draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
@@ -1209,6 +1698,13 @@ draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShad
 
   p.m_clip = m_clip_rect_state.clip_equations_state(m_pool);
   p.m_matrix = m_clip_rect_state.current_item_marix_state(m_pool);
+  if(m_occluder_capture)
+    {
+      FASTUIDRAWassert(z == m_occluder_capture->m_z);
+      m_occluder_capture->capture(shader, p, m_core->blend_shader(), m_core->blend_mode(),
+                                  attrib_chunks, index_chunks, index_adjusts,
+                                  attrib_chunk_selector, m_pool);
+    }
   m_core->draw_generic(shader, p, attrib_chunks, index_chunks, index_adjusts, attrib_chunk_selector, z, call_back);
 }
 
@@ -1221,11 +1717,180 @@ draw_generic(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShad
              const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
 {
   fastuidraw::PainterPackerData p(draw);
+
+  /* occluders are only drawn from attribute and index chunks */
+  FASTUIDRAWassert(!m_occluder_capture);
   p.m_clip = m_clip_rect_state.clip_equations_state(m_pool);
   p.m_matrix = m_clip_rect_state.current_item_marix_state(m_pool);
   m_core->draw_generic(shader, p, src, z, call_back);
 }
 
+void
+PainterPrivate::
+reserve_z(int n)
+{
+  unsigned int first;
+  int needed;
+
+  FASTUIDRAWassert(n >= 0);
+  FASTUIDRAWassert(!m_occluder_capture);
+
+  /* find the occluders whose z-value is too small, the z-value
+     of each occluder must be greater than that of the occluders
+     above it on the stack.
+   */
+  needed = m_current_z + n + 1;
+  for(first = m_occluder_stack.size();
+      first > 0 && m_occluder_stack[first - 1]->m_z < needed; --first)
+    {
+      occluder_stack_entry *e(m_occluder_stack[first - 1].get());
+
+      e->m_reservation *= 2;
+      e->m_z = needed + e->m_reservation;
+      needed = e->m_z + 1;
+    }
+
+  for(unsigned int i = first, endi = m_occluder_stack.size(); i < endi; ++i)
+    {
+      m_occluder_stack[i]->redraw(*m_core);
+    }
+}
+
+occluder_stack_entry*
+PainterPrivate::
+begin_occluders(bool copy_data)
+{
+  /* The number of z-values reserved for the content drawn while
+     the occluders are on the stack is the number used by the content
+     of the occluders added at the same point in the previous frame;
+     for content that is the same frame to frame this is exactly what
+     is needed. If there is no such value, take the smaller of
+     occluder_z_reservation and half of the z-values left by the
+     occluders below so that nested occluders do not immediately
+     exhaust the range of their parent.
+   */
+  const int occluder_z_reservation(256), occluder_min_z_reservation(8);
+  unsigned int index(m_number_occluders++);
+  int room, reservation;
+
+  FASTUIDRAWassert(!m_occluder_capture);
+  room = m_occluder_stack.empty() ?
+    std::numeric_limits<int>::max() - m_current_z :
+    m_occluder_stack.back()->m_z - 1 - m_current_z;
+
+  if(index < m_occluder_z_usage_prev.size() && m_occluder_z_usage_prev[index] > 0)
+    {
+      reservation = m_occluder_z_usage_prev[index];
+      if(reservation > room)
+        {
+          reserve_z(reservation);
+        }
+    }
+  else
+    {
+      if(room / 2 < occluder_min_z_reservation)
+        {
+          reserve_z(2 * occluder_min_z_reservation);
+          room = m_occluder_stack.back()->m_z - 1 - m_current_z;
+        }
+      reservation = fastuidraw::t_min(occluder_z_reservation, room / 2);
+    }
+
+  m_occluder_capture = FASTUIDRAWnew occluder_stack_entry(index, m_current_z, reservation, copy_data);
+  m_current_z = m_occluder_capture->m_z;
+  return m_occluder_capture.get();
+}
+
+void
+PainterPrivate::
+end_occluders(void)
+{
+  FASTUIDRAWassert(m_occluder_capture);
+  m_current_z = m_occluder_capture->m_start_z;
+  if(!m_occluder_capture->empty())
+    {
+      m_occluder_stack.push_back(m_occluder_capture);
+    }
+  m_occluder_capture.clear();
+}
+
+void
+PainterPrivate::
+trace_add(enum trace_timing_t tp, uint64_t start, uint64_t end)
+{
+  if(!trace_timing_aggregated(tp))
+    {
+      m_trace->add_duration_event(trace_timing_name(tp), "Painter", start, end);
+      return;
+    }
+
+  /* a nested call is part of the call containing it */
+  if(m_trace_depth[tp] != 0)
+    {
+      return;
+    }
+
+  trace_aggregate &A(m_trace_aggregates[tp]);
+  unsigned int draw;
+
+  draw = m_core->query_stat(fastuidraw::PainterPacker::num_draws);
+  if(A.m_calls != 0 && A.m_draw != draw)
+    {
+      trace_flush_aggregate(tp);
+    }
+
+  if(A.m_calls == 0)
+    {
+      A.m_start = start;
+      A.m_draw = draw;
+    }
+  A.m_end = end;
+  A.m_total += end - start;
+  ++A.m_calls;
+}
+
+void
+PainterPrivate::
+trace_flush_aggregate(enum trace_timing_t tp)
+{
+  trace_aggregate &A(m_trace_aggregates[tp]);
+
+  if(A.m_calls != 0 && m_trace)
+    {
+      fastuidraw::vecN<fastuidraw::c_string, 2> labels("calls", "time (us)");
+      fastuidraw::vecN<uint64_t, 2> values(A.m_calls, A.m_total);
+
+      m_trace->add_duration_event(trace_timing_name(tp), "Painter",
+                                  A.m_start, A.m_end, labels, values);
+    }
+  A = trace_aggregate();
+}
+
+void
+PainterPrivate::
+pop_occluders(void)
+{
+  FASTUIDRAWassert(!m_occluder_stack.empty());
+
+  const occluder_stack_entry &e(*m_occluder_stack.back());
+
+  FASTUIDRAWassert(m_current_z < e.m_z);
+
+  /* the content may have used the z-values m_start_z, ..., m_current_z */
+  if(e.m_index >= m_occluder_z_usage.size())
+    {
+      m_occluder_z_usage.resize(e.m_index + 1, 0);
+    }
+  m_occluder_z_usage[e.m_index] = m_current_z - e.m_start_z + 1;
+
+  /* content drawn after the pop is not occluded, the depth
+     test is GL_GEQUAL so it must have z-value at least that
+     of the occluders.
+   */
+  m_current_z = fastuidraw::t_max(m_current_z, e.m_z);
+  m_occluder_stack.pop_back();
+}
+
 void
 PainterPrivate::
 draw_anti_alias_fuzz(const fastuidraw::PainterFillShader &shader, const fastuidraw::PainterData &draw,
@@ -1243,48 +1908,303 @@ draw_anti_alias_fuzz(const fastuidraw::PainterFillShader &shader, const fastuidr
       fastuidraw::FilledPath::Subset subset(filled_path.subset(s));
       const fastuidraw::PainterAttributeData &data(subset.aa_fuzz_painter_data());
 
-      for(fastuidraw::c_array<const int>::iterator iter = subset.winding_numbers().begin(),
-            end = subset.winding_numbers().end(); iter != end; ++iter)
+      for(fastuidraw::c_array<const int>::iterator iter = subset.winding_numbers().begin(),
+            end = subset.winding_numbers().end(); iter != end; ++iter)
+        {
+          int w0(*iter);
+          if(wset(w0))
+            {
+              unsigned int chunk;
+              chunk = fastuidraw::FilledPath::Subset::chunk_for_aa_fuzz(w0, w0);
+              if(!data.attribute_data_chunk(chunk).empty())
+                {
+                  m_work_room.m_fill_aa_fuzz_attrib_chunks.push_back(data.attribute_data_chunk(chunk));
+                  m_work_room.m_fill_aa_fuzz_index_chunks.push_back(data.index_data_chunk(chunk));
+                  m_work_room.m_fill_aa_fuzz_index_adjusts.push_back(data.index_adjust_chunk(chunk));
+                }
+            }
+
+          for(fastuidraw::c_array<const int>::iterator i = subset.winding_neighbors(w0).begin(),
+                e = subset.winding_neighbors(w0).end(); i != e; ++i)
+            {
+              int w1(*i);
+              if(wset(w0) != wset(w1))
+                {
+                  unsigned int chunk;
+                  chunk = fastuidraw::FilledPath::Subset::chunk_for_aa_fuzz(w0, w1);
+                  if(!data.attribute_data_chunk(chunk).empty())
+                    {
+                      m_work_room.m_fill_aa_fuzz_attrib_chunks.push_back(data.attribute_data_chunk(chunk));
+                      m_work_room.m_fill_aa_fuzz_index_chunks.push_back(data.index_data_chunk(chunk));
+                      m_work_room.m_fill_aa_fuzz_index_adjusts.push_back(data.index_adjust_chunk(chunk));
+                    }
+                }
+            }
+        }
+    }
+
+  draw_generic(shader.aa_fuzz_shader(), draw,
+               fastuidraw::make_c_array(m_work_room.m_fill_aa_fuzz_attrib_chunks),
+               fastuidraw::make_c_array(m_work_room.m_fill_aa_fuzz_index_chunks),
+               fastuidraw::make_c_array(m_work_room.m_fill_aa_fuzz_index_adjusts),
+               fastuidraw::c_array<const unsigned int>(),
+               m_current_z,
+               call_back);
+}
+
+void
+PainterPrivate::
+begin_batch(fastuidraw::c_array<const fastuidraw::PainterData> draws,
+            fastuidraw::c_array<const fastuidraw::float3x3> transformations)
+{
+  /* pack the values of each PainterData once so that each
+     header of the batch reuses them instead of packing them
+     again.
+   */
+  m_work_room.m_batch_draws.assign(draws.begin(), draws.end());
+  for(fastuidraw::PainterData &draw : m_work_room.m_batch_draws)
+    {
+      draw.make_packed(m_pool);
+    }
+
+  m_work_room.m_batch_matrices.resize(transformations.size());
+  m_work_room.m_batch_matrix_states.clear();
+  m_work_room.m_batch_matrix_states.resize(transformations.size());
+  for(unsigned int i = 0; i < transformations.size(); ++i)
+    {
+      m_work_room.m_batch_matrices[i] = m_clip_rect_state.item_matrix() * transformations[i];
+    }
+}
+
+const fastuidraw::float3x3&
+PainterPrivate::
+batch_matrix(int transformation)
+{
+  FASTUIDRAWassert(transformation < static_cast<int>(m_work_room.m_batch_matrices.size()));
+  return (transformation < 0) ?
+    m_clip_rect_state.item_matrix() :
+    m_work_room.m_batch_matrices[transformation];
+}
+
+const fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix>&
+PainterPrivate::
+batch_matrix_state(int transformation)
+{
+  FASTUIDRAWassert(transformation < static_cast<int>(m_work_room.m_batch_matrices.size()));
+  if(transformation < 0)
+    {
+      return m_clip_rect_state.current_item_marix_state(m_pool);
+    }
+
+  fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> &v(m_work_room.m_batch_matrix_states[transformation]);
+  if(!v)
+    {
+      v = m_pool.create_packed_value(fastuidraw::PainterItemMatrix(m_work_room.m_batch_matrices[transformation]));
+    }
+  return v;
+}
+
+void
+PainterPrivate::
+draw_batch_chunks(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+                  unsigned int draw, int transformation,
+                  fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterAttribute> > attrib_chunks,
+                  fastuidraw::c_array<const fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
+                  fastuidraw::c_array<const int> index_adjusts,
+                  const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  FASTUIDRAWassert(draw < m_work_room.m_batch_draws.size());
+
+  fastuidraw::PainterPackerData p(m_work_room.m_batch_draws[draw]);
+  p.m_clip = m_clip_rect_state.clip_equations_state(m_pool);
+  p.m_matrix = batch_matrix_state(transformation);
+  m_core->draw_generic(shader, p, attrib_chunks, index_chunks, index_adjusts,
+                       fastuidraw::c_array<const unsigned int>(), m_current_z, call_back);
+}
+
+void
+PainterPrivate::
+draw_rect_run(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
+              fastuidraw::c_array<const fastuidraw::Painter::BatchedRect> rects,
+              const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  /* Each chunk handed to PainterPacker must fit within a single
+     PainterDraw; keeping the chunks small lets the packer fill
+     each PainterDraw instead of starting a new one whenever the
+     current one cannot take a whole (large) chunk.
+   */
+  const unsigned int max_chunk_attribs(1024);
+  unsigned int max_attribs, max_indices;
+  unsigned int chunk_attrib_start(0), chunk_index_start(0);
+  int transformation(rects.front().m_transformation);
+  const fastuidraw::float3x3 &m(batch_matrix(transformation));
+  bool cpu_clip(!m_core->hints().clipping_via_hw_clip_planes());
+  std::vector<fastuidraw::PainterAttribute> &attribs(m_work_room.m_batch_attribs);
+  std::vector<fastuidraw::PainterIndex> &indices(m_work_room.m_batch_indices);
+
+  max_attribs = std::min(m_max_attribs_per_block, max_chunk_attribs);
+  max_indices = std::min(m_max_indices_per_block, 3 * max_chunk_attribs);
+  attribs.clear();
+  indices.clear();
+  m_work_room.m_batch_attrib_ranges.clear();
+  m_work_room.m_batch_index_ranges.clear();
+
+  for(const fastuidraw::Painter::BatchedRect &rect : rects)
+    {
+      fastuidraw::vecN<fastuidraw::vec2, 4> quad;
+      fastuidraw::c_array<const fastuidraw::vec2> pts;
+      unsigned int base;
+
+      if(m_clip_rect_state.rect_is_culled(m, rect.m_min_point, rect.m_size))
+        {
+          continue;
+        }
+
+      /* same vertex order as Painter::draw_rect() */
+      quad[0] = rect.m_min_point;
+      quad[1] = rect.m_min_point + fastuidraw::vec2(0.0f, rect.m_size.y());
+      quad[2] = rect.m_min_point + rect.m_size;
+      quad[3] = rect.m_min_point + fastuidraw::vec2(rect.m_size.x(), 0.0f);
+      pts = fastuidraw::c_array<const fastuidraw::vec2>(&quad[0], quad.size());
+
+      if(cpu_clip)
+        {
+          m_clip_rect_state.clip_polygon(m, pts, m_work_room.m_pts_draw_convex_polygon,
+                                         m_work_room.m_clipper_vec2s[0],
+                                         m_work_room.m_clipper_floats);
+          pts = fastuidraw::make_c_array(m_work_room.m_pts_draw_convex_polygon);
+          if(pts.size() < 3)
+            {
+              continue;
+            }
+        }
+
+      if(attribs.size() + pts.size() - chunk_attrib_start > max_attribs
+         || indices.size() + 3 * (pts.size() - 2) - chunk_index_start > max_indices)
+        {
+          m_work_room.m_batch_attrib_ranges.push_back(fastuidraw::range_type<unsigned int>(chunk_attrib_start, attribs.size()));
+          m_work_room.m_batch_index_ranges.push_back(fastuidraw::range_type<unsigned int>(chunk_index_start, indices.size()));
+          chunk_attrib_start = attribs.size();
+          chunk_index_start = indices.size();
+        }
+
+      base = attribs.size() - chunk_attrib_start;
+      for(const fastuidraw::vec2 &p : pts)
+        {
+          fastuidraw::PainterAttribute A;
+
+          A.m_attrib0 = fastuidraw::pack_vec4(p.x(), p.y(), 0.0f, 0.0f);
+          A.m_attrib1 = fastuidraw::uvec4(0u, 0u, 0u, 0u);
+          A.m_attrib2 = fastuidraw::uvec4(0u, 0u, 0u, 0u);
+          attribs.push_back(A);
+        }
+
+      for(unsigned int i = 2; i < pts.size(); ++i)
+        {
+          indices.push_back(base);
+          indices.push_back(base + i - 1);
+          indices.push_back(base + i);
+        }
+    }
+
+  if(attribs.size() > chunk_attrib_start)
+    {
+      m_work_room.m_batch_attrib_ranges.push_back(fastuidraw::range_type<unsigned int>(chunk_attrib_start, attribs.size()));
+      m_work_room.m_batch_index_ranges.push_back(fastuidraw::range_type<unsigned int>(chunk_index_start, indices.size()));
+    }
+
+  if(m_work_room.m_batch_attrib_ranges.empty())
+    {
+      return;
+    }
+
+  m_work_room.m_batch_attrib_chunks.resize(m_work_room.m_batch_attrib_ranges.size());
+  m_work_room.m_batch_index_chunks.resize(m_work_room.m_batch_index_ranges.size());
+  m_work_room.m_batch_index_adjusts.resize(m_work_room.m_batch_index_ranges.size());
+  for(unsigned int c = 0; c < m_work_room.m_batch_attrib_ranges.size(); ++c)
+    {
+      const fastuidraw::range_type<unsigned int> &ra(m_work_room.m_batch_attrib_ranges[c]);
+      const fastuidraw::range_type<unsigned int> &ri(m_work_room.m_batch_index_ranges[c]);
+
+      m_work_room.m_batch_attrib_chunks[c] = fastuidraw::make_c_array(attribs).sub_array(ra.m_begin, ra.m_end - ra.m_begin);
+      m_work_room.m_batch_index_chunks[c] = fastuidraw::make_c_array(indices).sub_array(ri.m_begin, ri.m_end - ri.m_begin);
+      m_work_room.m_batch_index_adjusts[c] = 0;
+    }
+
+  draw_batch_chunks(shader, rects.front().m_draw, transformation,
+                    fastuidraw::make_c_array(m_work_room.m_batch_attrib_chunks),
+                    fastuidraw::make_c_array(m_work_room.m_batch_index_chunks),
+                    fastuidraw::make_c_array(m_work_room.m_batch_index_adjusts),
+                    call_back);
+}
+
+void
+PainterPrivate::
+mark_glyphs_used(fastuidraw::c_array<const fastuidraw::Glyph> glyphs)
+{
+  for(const fastuidraw::Glyph &g : glyphs)
+    {
+      g.mark_used();
+    }
+
+  if(m_core->is_recording_stream())
+    {
+      m_recorded_glyphs.insert(m_recorded_glyphs.end(), glyphs.begin(), glyphs.end());
+    }
+}
+
+void
+PainterPrivate::
+draw_glyph_run(const fastuidraw::PainterGlyphShader &shader,
+               fastuidraw::c_array<const fastuidraw::Painter::BatchedGlyphRun> runs,
+               const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back)
+{
+  std::vector<unsigned int> &glyph_types(m_work_room.m_batch_glyph_types);
+
+  /* collect the glyph types used by the runs, in
+     order of first appearance.
+   */
+  glyph_types.clear();
+  for(const fastuidraw::Painter::BatchedGlyphRun &run : runs)
+    {
+      if(run.m_data == nullptr)
+        {
+          continue;
+        }
+
+      mark_glyphs_used(run.m_data->glyphs());
+
+      for(unsigned int k : run.m_data->non_empty_index_data_chunks())
         {
-          int w0(*iter);
-          if(wset(w0))
+          if(std::find(glyph_types.begin(), glyph_types.end(), k) == glyph_types.end())
             {
-              unsigned int chunk;
-              chunk = fastuidraw::FilledPath::Subset::chunk_for_aa_fuzz(w0, w0);
-              if(!data.attribute_data_chunk(chunk).empty())
-                {
-                  m_work_room.m_fill_aa_fuzz_attrib_chunks.push_back(data.attribute_data_chunk(chunk));
-                  m_work_room.m_fill_aa_fuzz_index_chunks.push_back(data.index_data_chunk(chunk));
-                  m_work_room.m_fill_aa_fuzz_index_adjusts.push_back(data.index_adjust_chunk(chunk));
-                }
+              glyph_types.push_back(k);
             }
+        }
+    }
 
-          for(fastuidraw::c_array<const int>::iterator i = subset.winding_neighbors(w0).begin(),
-                e = subset.winding_neighbors(w0).end(); i != e; ++i)
+  for(unsigned int k : glyph_types)
+    {
+      m_work_room.m_batch_attrib_chunks.clear();
+      m_work_room.m_batch_index_chunks.clear();
+      m_work_room.m_batch_index_adjusts.clear();
+      for(const fastuidraw::Painter::BatchedGlyphRun &run : runs)
+        {
+          if(run.m_data != nullptr && !run.m_data->index_data_chunk(k).empty())
             {
-              int w1(*i);
-              if(wset(w0) != wset(w1))
-                {
-                  unsigned int chunk;
-                  chunk = fastuidraw::FilledPath::Subset::chunk_for_aa_fuzz(w0, w1);
-                  if(!data.attribute_data_chunk(chunk).empty())
-                    {
-                      m_work_room.m_fill_aa_fuzz_attrib_chunks.push_back(data.attribute_data_chunk(chunk));
-                      m_work_room.m_fill_aa_fuzz_index_chunks.push_back(data.index_data_chunk(chunk));
-                      m_work_room.m_fill_aa_fuzz_index_adjusts.push_back(data.index_adjust_chunk(chunk));
-                    }
-                }
+              m_work_room.m_batch_attrib_chunks.push_back(run.m_data->attribute_data_chunk(k));
+              m_work_room.m_batch_index_chunks.push_back(run.m_data->index_data_chunk(k));
+              m_work_room.m_batch_index_adjusts.push_back(run.m_data->index_adjust_chunk(k));
             }
         }
-    }
 
-  draw_generic(shader.aa_fuzz_shader(), draw,
-               fastuidraw::make_c_array(m_work_room.m_fill_aa_fuzz_attrib_chunks),
-               fastuidraw::make_c_array(m_work_room.m_fill_aa_fuzz_index_chunks),
-               fastuidraw::make_c_array(m_work_room.m_fill_aa_fuzz_index_adjusts),
-               fastuidraw::c_array<const unsigned int>(),
-               m_current_z,
-               call_back);
+      draw_batch_chunks(shader.shader(static_cast<enum fastuidraw::glyph_type>(k)),
+                        runs.front().m_draw, runs.front().m_transformation,
+                        fastuidraw::make_c_array(m_work_room.m_batch_attrib_chunks),
+                        fastuidraw::make_c_array(m_work_room.m_batch_index_chunks),
+                        fastuidraw::make_c_array(m_work_room.m_batch_index_adjusts),
+                        call_back);
+    }
 }
 
 //////////////////////////////////
@@ -1292,7 +2212,15 @@ draw_anti_alias_fuzz(const fastuidraw::PainterFillShader &shader, const fastuidr
 fastuidraw::Painter::
 Painter(reference_counted_ptr<PainterBackend> backend)
 {
-  m_d = FASTUIDRAWnew PainterPrivate(backend);
+  m_d = FASTUIDRAWnew PainterPrivate(backend, reference_counted_ptr<PainterPacker>());
+}
+
+fastuidraw::Painter::
+Painter(reference_counted_ptr<PainterBackend> backend,
+        reference_counted_ptr<PainterPacker> recording_stream)
+{
+  FASTUIDRAWassert(recording_stream && recording_stream->is_recording_stream());
+  m_d = FASTUIDRAWnew PainterPrivate(backend, recording_stream);
 }
 
 fastuidraw::Painter::
@@ -1336,6 +2264,11 @@ begin(bool reset_z)
   d = static_cast<PainterPrivate*>(m_d);
 
   d->m_core->begin();
+  d->m_recorded_glyphs.clear();
+  if(d->m_advance_glyph_atlas_frame)
+    {
+      d->m_core->glyph_atlas()->advance_frame();
+    }
 
   if(reset_z)
     {
@@ -1343,7 +2276,20 @@ begin(bool reset_z)
     }
   d->m_clip_rect_state.reset();
   d->m_clip_store.set_current(d->m_clip_rect_state.clip_equations().m_clip_equations);
+  d->m_occluder_z_usage_prev.swap(d->m_occluder_z_usage);
+  d->m_occluder_z_usage.clear();
+  d->m_number_occluders = 0;
   blend_shader(PainterEnums::blend_porter_duff_src_over);
+
+  if(d->m_trace)
+    {
+      d->m_trace_frame_start = PainterTrace::time_stamp();
+      std::fill(d->m_trace_timings.begin(), d->m_trace_timings.end(), 0u);
+      std::fill(d->m_trace_aggregates.begin(), d->m_trace_aggregates.end(), trace_aggregate());
+      d->m_trace_atlas_bytes[trace_glyph_atlas] = d->m_core->glyph_atlas()->bytes_uploaded();
+      d->m_trace_atlas_bytes[trace_image_atlas] = d->m_core->image_atlas()->bytes_uploaded();
+      d->m_trace_atlas_bytes[trace_colorstop_atlas] = d->m_core->colorstop_atlas()->bytes_uploaded();
+    }
 }
 
 void
@@ -1353,18 +2299,139 @@ end(void)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
-  /* pop m_clip_stack to perform necessary writes
+  /* pop the occluders so that m_current_z is past them
    */
   while(!d->m_occluder_stack.empty())
     {
-      d->m_occluder_stack.back().on_pop(this);
-      d->m_occluder_stack.pop_back();
+      d->pop_occluders();
     }
   /* clear state stack as well.
    */
   d->m_clip_store.clear();
   d->m_state_stack.clear();
+  d->m_ready_fill_path = nullptr;
+
+  /* add the recording streams in the order submitted, each
+     stream starts its z-values at 1, so offset them to start
+     at our current z.
+   */
+  for(const reference_counted_ptr<Painter> &stream : d->m_submitted_streams)
+    {
+      PainterPrivate *sd;
+
+      sd = static_cast<PainterPrivate*>(stream->m_d);
+      d->m_core->splice_recording_stream(sd->m_core, d->m_current_z - 1);
+      d->m_current_z += sd->m_current_z - 1;
+    }
+  d->m_submitted_streams.clear();
   d->m_core->end();
+
+  if(d->m_trace)
+    {
+      uint64_t end_time(PainterTrace::time_stamp());
+      vecN<c_string, PainterPacker::num_stats> stat_labels;
+      vecN<uint64_t, PainterPacker::num_stats> stat_values;
+      vecN<c_string, number_trace_timings> timing_labels;
+      vecN<c_string, number_trace_atlases> atlas_labels;
+      vecN<uint64_t, number_trace_atlases> atlas_values;
+
+      for(unsigned int i = 0; i < number_trace_timings; ++i)
+        {
+          d->trace_flush_aggregate(static_cast<enum trace_timing_t>(i));
+        }
+      d->m_trace->add_duration_event("Painter::frame", "Painter",
+                                     d->m_trace_frame_start, end_time);
+
+      for(unsigned int i = 0; i < PainterPacker::num_stats; ++i)
+        {
+          enum PainterPacker::stats_t st;
+
+          st = static_cast<enum PainterPacker::stats_t>(i);
+          stat_labels[i] = PainterPacker::stat_name(st);
+          stat_values[i] = d->m_core->query_stat(st);
+        }
+      d->m_trace->add_counter_event("PainterPacker stats", stat_labels, stat_values, end_time);
+
+      for(unsigned int i = 0; i < number_trace_timings; ++i)
+        {
+          timing_labels[i] = trace_timing_name(static_cast<enum trace_timing_t>(i));
+        }
+      d->m_trace->add_counter_event("Painter time (us)", timing_labels, d->m_trace_timings, end_time);
+
+      atlas_labels[trace_glyph_atlas] = "GlyphAtlas";
+      atlas_labels[trace_image_atlas] = "ImageAtlas";
+      atlas_labels[trace_colorstop_atlas] = "ColorStopAtlas";
+      atlas_values[trace_glyph_atlas] = d->m_core->glyph_atlas()->bytes_uploaded();
+      atlas_values[trace_image_atlas] = d->m_core->image_atlas()->bytes_uploaded();
+      atlas_values[trace_colorstop_atlas] = d->m_core->colorstop_atlas()->bytes_uploaded();
+      for(unsigned int i = 0; i < number_trace_atlases; ++i)
+        {
+          atlas_values[i] -= d->m_trace_atlas_bytes[i];
+        }
+      d->m_trace->add_counter_event("Atlas bytes uploaded", atlas_labels, atlas_values, end_time);
+    }
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::Painter>
+fastuidraw::Painter::
+create_recording_stream(void)
+{
+  PainterPrivate *d;
+  reference_counted_ptr<Painter> return_value;
+
+  d = static_cast<PainterPrivate*>(m_d);
+  return_value = FASTUIDRAWnew Painter(d->m_backend, d->m_core->create_recording_stream());
+  return_value->target_resolution(static_cast<int>(d->m_resolution.x()),
+                                  static_cast<int>(d->m_resolution.y()));
+  return_value->curveFlatness(d->m_curve_flatness);
+  return_value->tessellation_hysteresis(d->m_tessellation_hysteresis);
+  return_value->async_path_tessellation(d->m_async_path_tessellation);
+  return_value->async_fill_triangulation(d->m_async_fill_triangulation);
+  return_value->parallel_path_construction(d->m_parallel_path_construction);
+  /* the frame belongs to the Painter the stream is submitted to */
+  return_value->advance_glyph_atlas_frame(false);
+  return return_value;
+}
+
+void
+fastuidraw::Painter::
+submit_recording_stream(const reference_counted_ptr<Painter> &stream)
+{
+  PainterPrivate *d;
+
+  d = static_cast<PainterPrivate*>(m_d);
+  FASTUIDRAWassert(stream && stream != this);
+  d->m_submitted_streams.push_back(stream);
+}
+
+void
+fastuidraw::Painter::
+draw_display_list(const PainterDisplayList &list)
+{
+  PainterPrivate *d, *sd;
+  vec2 pmin(list.min_bb()), pmax(list.max_bb());
+
+  d = static_cast<PainterPrivate*>(m_d);
+  sd = static_cast<PainterPrivate*>(list.painter()->m_d);
+  FASTUIDRAWassert(!list.recording());
+
+  if(d->m_clip_rect_state.m_all_content_culled
+     || d->m_clip_rect_state.rect_is_culled(pmin, pmax - pmin))
+    {
+      return;
+    }
+
+  /* the recording stream maps from the coordinates of the display
+     list by a transformation T, the spliced item matrices need
+     to be the current transformation times the inverse of T.
+   */
+  float3x3 tr;
+  tr = d->m_clip_rect_state.item_matrix() * list.inverse_transformation();
+  d->mark_glyphs_used(make_c_array(sd->m_recorded_glyphs));
+  d->reserve_z(sd->m_current_z - 1);
+  d->m_core->splice_recording_stream(sd->m_core, d->m_current_z - 1, tr,
+                                     d->m_clip_rect_state.clip_equations());
+  d->m_current_z += sd->m_current_z - 1;
 }
 
 void
@@ -1465,6 +2532,7 @@ draw_convex_polygon(const PainterFillShader &shader,
 
   if(with_anti_aliasing)
     {
+      d->reserve_z(1);
       ++d->m_current_z;
     }
   draw_generic(shader.item_shader(), draw,
@@ -1582,6 +2650,43 @@ draw_rect(const PainterData &draw, const vec2 &p, const vec2 &wh,
             with_anti_aliasing, call_back);
 }
 
+void
+fastuidraw::Painter::
+draw_rects(const PainterFillShader &shader,
+           c_array<const PainterData> draws,
+           c_array<const float3x3> transformations,
+           c_array<const BatchedRect> rects,
+           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+
+  if(rects.empty() || d->m_clip_rect_state.m_all_content_culled)
+    {
+      return;
+    }
+
+  d->begin_batch(draws, transformations);
+  for(unsigned int begin = 0, end; begin < rects.size(); begin = end)
+    {
+      for(end = begin + 1; end < rects.size()
+            && rects[end].m_draw == rects[begin].m_draw
+            && rects[end].m_transformation == rects[begin].m_transformation; ++end)
+        {}
+      d->draw_rect_run(shader.item_shader(), rects.sub_array(begin, end - begin), call_back);
+    }
+}
+
+void
+fastuidraw::Painter::
+draw_rects(c_array<const PainterData> draws,
+           c_array<const float3x3> transformations,
+           c_array<const BatchedRect> rects,
+           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  draw_rects(default_shaders().fill_shader(), draws, transformations, rects, call_back);
+}
+
 void
 fastuidraw::Painter::
 stroke_path(const PainterStrokeShader &shader, const PainterData &pdraw,
@@ -1686,8 +2791,12 @@ stroke_path(const PainterStrokeShader &shader, const PainterData &pdraw,
    */
   draw.make_packed(d->m_pool);
 
-  startz = d->m_current_z;
   modify_z = !with_anti_aliasing || shader.aa_type() == PainterStrokeShader::draws_solid_then_fuzz;
+  if(modify_z)
+    {
+      d->reserve_z(zinc_sum + 1);
+    }
+  startz = d->m_current_z;
   sh = (with_anti_aliasing) ? &shader.aa_shader_pass1(): &shader.non_aa_shader();
 
   if(with_anti_aliasing)
@@ -1842,18 +2951,21 @@ stroke_path_common(const PainterStrokeShader &shader, const PainterData &draw,
 
   float pixels_additional_room(0.0f), item_space_additional_room(0.0f);
   shader.stroking_data_selector()->stroking_distances(raw_data, &pixels_additional_room, &item_space_additional_room);
-  path.compute_chunks(d->m_work_room.m_stroked_path_scratch,
-                      dash_evaluator, draw.m_item_shader_data.data().data_base(),
-                      d->m_clip_store.current(),
-                      d->m_clip_rect_state.item_matrix(),
-                      d->m_one_pixel_width,
-                      pixels_additional_room,
-                      item_space_additional_room,
-                      close_contours,
-                      d->m_max_attribs_per_block,
-                      d->m_max_indices_per_block,
-                      is_miter_join,
-                      d->m_work_room.m_stroke_chunk_set);
+  {
+    trace_scope tr(d, trace_compute_chunks);
+    path.compute_chunks(d->m_work_room.m_stroked_path_scratch,
+                        dash_evaluator, draw.m_item_shader_data.data().data_base(),
+                        d->m_clip_store.current(),
+                        d->m_clip_rect_state.item_matrix(),
+                        d->m_one_pixel_width,
+                        pixels_additional_room,
+                        item_space_additional_room,
+                        close_contours,
+                        d->m_max_attribs_per_block,
+                        d->m_max_indices_per_block,
+                        is_miter_join,
+                        d->m_work_room.m_stroke_chunk_set);
+  }
 
   stroke_path(shader, draw,
               edge_data, d->m_work_room.m_stroke_chunk_set.edge_chunks(),
@@ -1889,7 +3001,7 @@ stroke_path(const PainterStrokeShader &shader, const PainterData &draw, const Pa
 
   d = static_cast<PainterPrivate*>(m_d);
   thresh = d->select_path_thresh(path);
-  stroke_path(shader, draw, *path.tessellation(thresh)->stroked(), thresh,
+  stroke_path(shader, draw, *d->select_tessellation(path, thresh)->stroked(d->m_parallel_path_construction), thresh,
               close_contours, cp, js, with_anti_aliasing, call_back);
 }
 
@@ -1944,7 +3056,7 @@ stroke_dashed_path(const PainterDashedStrokeShaderSet &shader, const PainterData
 
   d = static_cast<PainterPrivate*>(m_d);
   thresh = d->select_path_thresh(path);
-  stroke_dashed_path(shader, draw, *path.tessellation(thresh)->stroked(), thresh,
+  stroke_dashed_path(shader, draw, *d->select_tessellation(path, thresh)->stroked(d->m_parallel_path_construction), thresh,
                      close_contours, cp, js, with_anti_aliasing, call_back);
 }
 
@@ -1989,13 +3101,7 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
   idx_chunk = FilledPath::Subset::chunk_from_fill_rule(fill_rule);
   atr_chunk = 0;
 
-  d->m_work_room.m_fill_subset_selector.resize(filled_path.number_subsets());
-  num_subsets = filled_path.select_subsets(d->m_work_room.m_filled_path_scratch,
-                                           d->m_clip_store.current(),
-                                           d->m_clip_rect_state.item_matrix(),
-                                           d->m_max_attribs_per_block,
-                                           d->m_max_indices_per_block,
-                                           make_c_array(d->m_work_room.m_fill_subset_selector));
+  num_subsets = d->select_fill_subsets(filled_path);
 
   if(num_subsets == 0)
     {
@@ -2021,6 +3127,7 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
 
   if(with_anti_aliasing)
     {
+      d->reserve_z(1);
       ++d->m_current_z;
     }
   draw_generic(shader.item_shader(), draw,
@@ -2049,11 +3156,13 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
   PainterPrivate *d;
-  float thresh;
 
   d = static_cast<PainterPrivate*>(m_d);
-  thresh = d->select_path_thresh(path);
-  fill_path(shader, draw, *path.tessellation(thresh)->filled(), fill_rule,
+  if(d->m_clip_rect_state.m_all_content_culled)
+    {
+      return;
+    }
+  fill_path(shader, draw, *d->select_filled_path(path), fill_rule,
             with_anti_aliasing, call_back);
 }
 
@@ -2083,13 +3192,7 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
       return;
     }
 
-  d->m_work_room.m_fill_subset_selector.resize(filled_path.number_subsets());
-  num_subsets = filled_path.select_subsets(d->m_work_room.m_filled_path_scratch,
-                                           d->m_clip_store.current(),
-                                           d->m_clip_rect_state.item_matrix(),
-                                           d->m_max_attribs_per_block,
-                                           d->m_max_indices_per_block,
-                                           make_c_array(d->m_work_room.m_fill_subset_selector));
+  num_subsets = d->select_fill_subsets(filled_path);
 
   if(num_subsets == 0)
     {
@@ -2147,6 +3250,7 @@ fill_path(const PainterFillShader &shader, const PainterData &draw,
     {
       if(with_anti_aliasing)
         {
+          d->reserve_z(1);
           ++d->m_current_z;
         }
 
@@ -2176,11 +3280,13 @@ fill_path(const PainterFillShader &shader,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
   PainterPrivate *d;
-  float thresh;
 
   d = static_cast<PainterPrivate*>(m_d);
-  thresh = d->select_path_thresh(path);
-  fill_path(shader, draw, *path.tessellation(thresh)->filled(), fill_rule,
+  if(d->m_clip_rect_state.m_all_content_culled)
+    {
+      return;
+    }
+  fill_path(shader, draw, *d->select_filled_path(path), fill_rule,
             with_anti_aliasing, call_back);
 }
 
@@ -2208,6 +3314,7 @@ draw_glyphs(const PainterGlyphShader &shader, const PainterData &draw,
       return;
     }
 
+  d->mark_glyphs_used(data.glyphs());
   c_array<const unsigned int> chks(data.non_empty_index_data_chunks());
   for(unsigned int i = 0; i < chks.size(); ++i)
     {
@@ -2238,6 +3345,51 @@ draw_glyphs(const PainterData &draw,
     }
 }
 
+void
+fastuidraw::Painter::
+draw_glyph_runs(const PainterGlyphShader &shader,
+                c_array<const PainterData> draws,
+                c_array<const float3x3> transformations,
+                c_array<const BatchedGlyphRun> runs,
+                const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+
+  if(runs.empty() || d->m_clip_rect_state.m_all_content_culled)
+    {
+      return;
+    }
+
+  d->begin_batch(draws, transformations);
+  for(unsigned int begin = 0, end; begin < runs.size(); begin = end)
+    {
+      for(end = begin + 1; end < runs.size()
+            && runs[end].m_draw == runs[begin].m_draw
+            && runs[end].m_transformation == runs[begin].m_transformation; ++end)
+        {}
+      d->draw_glyph_run(shader, runs.sub_array(begin, end - begin), call_back);
+    }
+}
+
+void
+fastuidraw::Painter::
+draw_glyph_runs(c_array<const PainterData> draws,
+                c_array<const float3x3> transformations,
+                c_array<const BatchedGlyphRun> runs,
+                bool use_anistopic_antialias,
+                const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  if(use_anistopic_antialias)
+    {
+      draw_glyph_runs(default_shaders().glyph_shader_anisotropic(), draws, transformations, runs, call_back);
+    }
+  else
+    {
+      draw_glyph_runs(default_shaders().glyph_shader(), draws, transformations, runs, call_back);
+    }
+}
+
 const fastuidraw::PainterItemMatrix&
 fastuidraw::Painter::
 transformation(void)
@@ -2379,6 +3531,96 @@ curveFlatness(void)
   return d->m_curve_flatness;
 }
 
+void
+fastuidraw::Painter::
+tessellation_hysteresis(float v)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  d->m_tessellation_hysteresis = t_max(v, 1.0f);
+}
+
+float
+fastuidraw::Painter::
+tessellation_hysteresis(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_tessellation_hysteresis;
+}
+
+void
+fastuidraw::Painter::
+async_path_tessellation(bool v)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  d->m_async_path_tessellation = v;
+}
+
+bool
+fastuidraw::Painter::
+async_path_tessellation(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_async_path_tessellation;
+}
+
+void
+fastuidraw::Painter::
+async_fill_triangulation(bool v)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  d->m_async_fill_triangulation = v;
+}
+
+bool
+fastuidraw::Painter::
+async_fill_triangulation(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_async_fill_triangulation;
+}
+
+void
+fastuidraw::Painter::
+parallel_path_construction(bool v)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  d->m_parallel_path_construction = v;
+}
+
+bool
+fastuidraw::Painter::
+parallel_path_construction(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_parallel_path_construction;
+}
+
+void
+fastuidraw::Painter::
+advance_glyph_atlas_frame(bool v)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  d->m_advance_glyph_atlas_frame = v;
+}
+
+bool
+fastuidraw::Painter::
+advance_glyph_atlas_frame(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_advance_glyph_atlas_frame;
+}
+
 void
 fastuidraw::Painter::
 save(void)
@@ -2412,8 +3654,7 @@ restore(void)
   d->m_curve_flatness = st.m_curve_flatness;
   while(d->m_occluder_stack.size() > st.m_occluder_stack_position)
     {
-      d->m_occluder_stack.back().on_pop(this);
-      d->m_occluder_stack.pop_back();
+      d->pop_occluders();
     }
   d->m_state_stack.pop_back();
   d->m_clip_store.pop();
@@ -2421,12 +3662,14 @@ restore(void)
 
 /* How we handle clipping.
         - clipOut by path P
-           1. add "draw" the path P filled, but with call back for
-              the data indicating where in the attribute or data
-              store buffer to write the new z-value
-           2. on doing clipPop, we know the z-value to use for
-              all the elements that are occluded by the fill
-              path, so we write that value.
+           1. reserve a range of z-values for the content drawn
+              until the clip is popped and draw the path P filled
+              with the z-value at the end of that range
+           2. if the content needs more z-values than reserved,
+              draw P again with a larger z-value (see
+              occluder_stack_entry and PainterPrivate::reserve_z())
+           3. on doing clipPop, advance the current z-value to
+              that of the fill of P.
 
         - clipIn by rect R
             * easy case A: No changes to tranformation matrix since last clipIn by rect
@@ -2451,6 +3694,8 @@ clipOutPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  trace_scope tr(d, trace_clip);
+
   if(d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2460,22 +3705,27 @@ clipOutPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
 
   reference_counted_ptr<PainterBlendShader> old_blend;
   BlendMode::packed_value old_blend_mode;
-  reference_counted_ptr<ZDataCallBack> zdatacallback;
+  reference_counted_ptr<const FilledPath> filled_path;
+  occluder_stack_entry *occluders;
 
-  /* zdatacallback generates a list of PainterDraw::DelayedAction
-     objects (held in m_actions) who's action is to write the correct
-     z-value to occlude elements drawn after clipOut but not after
-     the next time m_occluder_stack is popped.
+  /* the occluders are drawn directly with their final z-value,
+     see occluder_stack_entry; the attribute data of the occluders
+     comes from filled_path, which the occluder_stack_entry keeps
+     alive so that the occluders can be drawn again.
    */
-  zdatacallback = FASTUIDRAWnew ZDataCallBack();
+  filled_path = d->select_filled_path(path);
+  occluders = d->begin_occluders(false);
+  occluders->m_filled_path = filled_path;
+
   old_blend = blend_shader();
   old_blend_mode = blend_mode();
 
   blend_shader(PainterEnums::blend_porter_duff_dst);
-  fill_path(PainterData(d->m_black_brush), path, fill_rule, false, zdatacallback);
+  fill_path(default_shaders().fill_shader(), PainterData(d->m_black_brush),
+            *filled_path, fill_rule, false);
   blend_shader(old_blend, old_blend_mode);
 
-  d->m_occluder_stack.push_back(occluder_stack_entry(zdatacallback->m_actions));
+  d->end_occluders();
 }
 
 void
@@ -2485,6 +3735,8 @@ clipOutPath(const Path &path, const CustomFillRuleBase &fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  trace_scope tr(d, trace_clip);
+
   if(d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2492,24 +3744,29 @@ clipOutPath(const Path &path, const CustomFillRuleBase &fill_rule)
       return;
     }
 
-  fastuidraw::reference_counted_ptr<PainterBlendShader> old_blend;
+  reference_counted_ptr<PainterBlendShader> old_blend;
   BlendMode::packed_value old_blend_mode;
-  reference_counted_ptr<ZDataCallBack> zdatacallback;
+  reference_counted_ptr<const FilledPath> filled_path;
+  occluder_stack_entry *occluders;
 
-  /* zdatacallback generates a list of PainterDraw::DelayedAction
-     objects (held in m_actions) who's action is to write the correct
-     z-value to occlude elements drawn after clipOut but not after
-     the next time m_occluder_stack is popped.
+  /* the occluders are drawn directly with their final z-value,
+     see occluder_stack_entry; the attribute data of the occluders
+     comes from filled_path, which the occluder_stack_entry keeps
+     alive so that the occluders can be drawn again.
    */
-  zdatacallback = FASTUIDRAWnew ZDataCallBack();
+  filled_path = d->select_filled_path(path);
+  occluders = d->begin_occluders(false);
+  occluders->m_filled_path = filled_path;
+
   old_blend = blend_shader();
   old_blend_mode = blend_mode();
 
   blend_shader(PainterEnums::blend_porter_duff_dst);
-  fill_path(PainterData(d->m_black_brush), path, fill_rule, false, zdatacallback);
+  fill_path(default_shaders().fill_shader(), PainterData(d->m_black_brush),
+            *filled_path, fill_rule, false);
   blend_shader(old_blend, old_blend_mode);
 
-  d->m_occluder_stack.push_back(occluder_stack_entry(zdatacallback->m_actions));
+  d->end_occluders();
 }
 
 void
@@ -2519,6 +3776,8 @@ clipInPath(const Path &path, enum PainterEnums::fill_rule_t fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  trace_scope tr(d, trace_clip);
+
   if(d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2540,6 +3799,8 @@ clipInPath(const Path &path, const CustomFillRuleBase &fill_rule)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  trace_scope tr(d, trace_clip);
+
   if(d->m_clip_rect_state.m_all_content_culled)
     {
       /* everything is clipped anyways, adding more clipping does not matter
@@ -2561,6 +3822,8 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
 
+  trace_scope tr(d, trace_clip);
+
   vec2 pmax(pmin + wh);
 
   d->m_clip_rect_state.m_all_content_culled =
@@ -2649,8 +3912,10 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
   FASTUIDRAWassert(matrix_state);
   d->m_clip_rect_state.item_matrix_state(d->m_identiy_matrix, false);
 
-  reference_counted_ptr<ZDataCallBack> zdatacallback;
-  zdatacallback = FASTUIDRAWnew ZDataCallBack();
+  /* the data of the quads drawn by draw_half_plane_complement()
+     is transient, so the occluder_stack_entry must copy it.
+   */
+  d->begin_occluders(true);
 
   fastuidraw::reference_counted_ptr<PainterBlendShader> old_blend;
   BlendMode::packed_value old_blend_mode;
@@ -2681,7 +3946,7 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
       if(!skip_occluder[i])
         {
           draw_half_plane_complement(PainterData(d->m_black_brush), this,
-                                     prev_clip.value().m_clip_equations[i], zdatacallback);
+                                     prev_clip.value().m_clip_equations[i]);
         }
     }
 
@@ -2689,7 +3954,7 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
 
   /* add to occluder stack.
    */
-  d->m_occluder_stack.push_back(occluder_stack_entry(zdatacallback->m_actions));
+  d->end_occluders();
 
   d->m_clip_rect_state.item_matrix_state(matrix_state, false);
   blend_shader(old_blend, old_blend_mode);
@@ -2768,6 +4033,24 @@ query_stat(enum PainterPacker::stats_t st) const
   return d->m_core->query_stat(st);
 }
 
+void
+fastuidraw::Painter::
+trace(const reference_counted_ptr<PainterTrace> &v)
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  d->m_trace = v;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::PainterTrace>&
+fastuidraw::Painter::
+trace(void) const
+{
+  PainterPrivate *d;
+  d = static_cast<PainterPrivate*>(m_d);
+  return d->m_trace;
+}
+
 int
 fastuidraw::Painter::
 current_z(void) const
@@ -2783,6 +4066,7 @@ increment_z(int amount)
 {
   PainterPrivate *d;
   d = static_cast<PainterPrivate*>(m_d);
+  d->reserve_z(amount);
   d->m_current_z += amount;
 }
 
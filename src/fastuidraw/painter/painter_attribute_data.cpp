@@ -20,6 +20,7 @@
 #include <vector>
 #include <fastuidraw/util/fastuidraw_memory.hpp>
 #include <fastuidraw/painter/painter_attribute_data.hpp>
+#include <fastuidraw/text/glyph.hpp>
 #include "../private/util_private.hpp"
 
 namespace
@@ -38,6 +39,7 @@ namespace
     std::vector<fastuidraw::range_type<int> > m_z_ranges;
     std::vector<unsigned int> m_non_empty_index_data_chunks;
     std::vector<int> m_index_adjust_chunks;
+    std::vector<fastuidraw::Glyph> m_glyphs;
   };
 }
 
@@ -107,6 +109,10 @@ set_data(const PainterAttributeDataFiller &filler)
                    make_c_array(d->m_z_ranges),
                    make_c_array(d->m_index_adjust_chunks));
 
+  d->m_glyphs.clear();
+  d->m_glyphs.resize(filler.number_glyphs_referenced());
+  filler.fill_glyphs(make_c_array(d->m_glyphs));
+
   d->ready_non_empty_index_data_chunks();
 }
 
@@ -198,3 +204,12 @@ non_empty_index_data_chunks(void) const
   d = static_cast<PainterAttributeDataPrivate*>(m_d);
   return make_c_array(d->m_non_empty_index_data_chunks);
 }
+
+fastuidraw::c_array<const fastuidraw::Glyph>
+fastuidraw::PainterAttributeData::
+glyphs(void) const
+{
+  PainterAttributeDataPrivate *d;
+  d = static_cast<PainterAttributeDataPrivate*>(m_d);
+  return make_c_array(d->m_glyphs);
+}
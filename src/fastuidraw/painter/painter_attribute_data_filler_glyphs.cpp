@@ -138,7 +138,15 @@ namespace
     enum fastuidraw::PainterEnums::glyph_orientation m_orientation;
     std::pair<bool, float> m_render_pixel_size;
     unsigned int m_number_glyphs;
+    unsigned int m_number_pending_glyphs;
     std::vector<unsigned int> m_cnt_by_type;
+
+    /* the glyphs to pack, in order: m_glyphs[m_drawn_index[i]]
+       is drawn with m_drawn_glyphs[i], which is its fallback
+       if m_glyphs[m_drawn_index[i]] is not ready
+     */
+    std::vector<unsigned int> m_drawn_index;
+    std::vector<fastuidraw::Glyph> m_drawn_glyphs;
   };
 }
 
@@ -154,7 +162,8 @@ FillGlyphsPrivate(fastuidraw::c_array<const fastuidraw::vec2> glyph_positions,
   m_scale_factors(scale_factors),
   m_orientation(orientation),
   m_render_pixel_size(false, 1.0f),
-  m_number_glyphs(0)
+  m_number_glyphs(0),
+  m_number_pending_glyphs(0)
 {
   FASTUIDRAWassert(glyph_positions.size() == glyphs.size());
   FASTUIDRAWassert(scale_factors.empty() || scale_factors.size() == glyphs.size());
@@ -169,7 +178,8 @@ FillGlyphsPrivate(fastuidraw::c_array<const fastuidraw::vec2> glyph_positions,
   m_glyphs(glyphs),
   m_orientation(orientation),
   m_render_pixel_size(true, render_pixel_size),
-  m_number_glyphs(0)
+  m_number_glyphs(0),
+  m_number_pending_glyphs(0)
 {
   FASTUIDRAWassert(glyph_positions.size() == glyphs.size());
 }
@@ -182,7 +192,8 @@ FillGlyphsPrivate(fastuidraw::c_array<const fastuidraw::vec2> glyph_positions,
   m_glyphs(glyphs),
   m_orientation(orientation),
   m_render_pixel_size(false, 1.0f),
-  m_number_glyphs(0)
+  m_number_glyphs(0),
+  m_number_pending_glyphs(0)
 {
   FASTUIDRAWassert(glyph_positions.size() == glyphs.size());
 }
@@ -191,25 +202,48 @@ void
 FillGlyphsPrivate::
 compute_number_glyphs(void)
 {
-  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
+  m_number_glyphs = 0;
+  m_number_pending_glyphs = 0;
+  m_cnt_by_type.clear();
+  m_drawn_index.clear();
+  m_drawn_glyphs.clear();
+
+  for(unsigned int endi = m_glyphs.size(); m_number_glyphs < endi; ++m_number_glyphs)
     {
       enum fastuidraw::return_code R;
+      fastuidraw::Glyph G(m_glyphs[m_number_glyphs]);
 
-      if(m_glyphs[i].valid())
+      if(!G.valid())
         {
-          R = m_glyphs[i].upload_to_atlas();
-          if(R != fastuidraw::routine_success)
-            {
-              return;
-            }
-          ++m_number_glyphs;
+          continue;
+        }
 
-          if(m_cnt_by_type.size() <= m_glyphs[i].type())
+      /* a glyph whose data is still computed is drawn with
+         its fallback glyph, or skipped if it has none
+       */
+      if(!G.ready())
+        {
+          ++m_number_pending_glyphs;
+          G = G.fallback();
+          if(!G.valid())
             {
-              m_cnt_by_type.resize(1 + m_glyphs[i].type(), 0);
+              continue;
             }
-          ++m_cnt_by_type[m_glyphs[i].type()];
         }
+
+      R = G.upload_to_atlas();
+      if(R != fastuidraw::routine_success)
+        {
+          return;
+        }
+
+      m_drawn_index.push_back(m_number_glyphs);
+      m_drawn_glyphs.push_back(G);
+      if(m_cnt_by_type.size() <= G.type())
+        {
+          m_cnt_by_type.resize(1 + G.type(), 0);
+        }
+      ++m_cnt_by_type[G.type()];
     }
 }
 
@@ -263,8 +297,8 @@ compute_sizes(unsigned int &number_attributes,
   d = static_cast<FillGlyphsPrivate*>(m_d);
 
   d->compute_number_glyphs();
-  number_attributes = 4 * d->m_number_glyphs;
-  number_indices = 6 * d->m_number_glyphs;
+  number_attributes = 4 * d->m_drawn_glyphs.size();
+  number_indices = 6 * d->m_drawn_glyphs.size();
   number_attribute_chunks = d->m_cnt_by_type.size();
   number_index_chunks = d->m_cnt_by_type.size();
   number_z_ranges = 0;
@@ -293,23 +327,63 @@ fill_data(c_array<PainterAttribute> attribute_data,
   FASTUIDRAWunused(zranges);
 
   std::vector<unsigned int> current(attrib_chunks.size(), 0);
-  for(unsigned int g = 0; g < d->m_number_glyphs; ++g)
+  for(unsigned int i = 0, endi = d->m_drawn_glyphs.size(); i < endi; ++i)
     {
-      if(d->m_glyphs[g].valid())
-        {
-          float scale;
-          unsigned int t;
-
-          scale = (d->m_render_pixel_size.first) ?
-            d->m_render_pixel_size.second / d->m_glyphs[g].layout().m_units_per_EM :
-            (d->m_scale_factors.empty()) ? 1.0f : d->m_scale_factors[g];
-
-          t = d->m_glyphs[g].type();
-          pack_glyph_attributes(d->m_orientation, d->m_glyph_positions[g],
-                                d->m_glyphs[g], scale,
-                                const_cast_c_array(attrib_chunks[t].sub_array(4 * current[t], 4)));
-          pack_glyph_indices(const_cast_c_array(index_chunks[t].sub_array(6 * current[t], 6)), 4 * current[t]);
-          ++current[t];
-        }
+      const fastuidraw::Glyph &G(d->m_drawn_glyphs[i]);
+      unsigned int g(d->m_drawn_index[i]);
+      float scale;
+      unsigned int t;
+
+      /* a fallback glyph has the layout of the glyph it
+         replaces in the same units, so the scale factor
+         of the glyph applies to it as well
+       */
+      scale = (d->m_render_pixel_size.first) ?
+        d->m_render_pixel_size.second / G.layout().m_units_per_EM :
+        (d->m_scale_factors.empty()) ? 1.0f : d->m_scale_factors[g];
+
+      t = G.type();
+      pack_glyph_attributes(d->m_orientation, d->m_glyph_positions[g],
+                            G, scale,
+                            const_cast_c_array(attrib_chunks[t].sub_array(4 * current[t], 4)));
+      pack_glyph_indices(const_cast_c_array(index_chunks[t].sub_array(6 * current[t], 6)), 4 * current[t]);
+      ++current[t];
     }
 }
+
+unsigned int
+fastuidraw::PainterAttributeDataFillerGlyphs::
+number_glyphs(void) const
+{
+  FillGlyphsPrivate *d;
+  d = static_cast<FillGlyphsPrivate*>(m_d);
+  return d->m_number_glyphs;
+}
+
+unsigned int
+fastuidraw::PainterAttributeDataFillerGlyphs::
+number_pending_glyphs(void) const
+{
+  FillGlyphsPrivate *d;
+  d = static_cast<FillGlyphsPrivate*>(m_d);
+  return d->m_number_pending_glyphs;
+}
+
+unsigned int
+fastuidraw::PainterAttributeDataFillerGlyphs::
+number_glyphs_referenced(void) const
+{
+  FillGlyphsPrivate *d;
+  d = static_cast<FillGlyphsPrivate*>(m_d);
+  return d->m_drawn_glyphs.size();
+}
+
+void
+fastuidraw::PainterAttributeDataFillerGlyphs::
+fill_glyphs(c_array<Glyph> glyphs) const
+{
+  FillGlyphsPrivate *d;
+  d = static_cast<FillGlyphsPrivate*>(m_d);
+  FASTUIDRAWassert(glyphs.size() == d->m_drawn_glyphs.size());
+  std::copy(d->m_drawn_glyphs.begin(), d->m_drawn_glyphs.end(), glyphs.begin());
+}
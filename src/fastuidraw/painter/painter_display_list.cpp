@@ -0,0 +1,141 @@
+/*!
+ * \file painter_display_list.cpp
+ * \brief file painter_display_list.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <fastuidraw/painter/painter_display_list.hpp>
+
+namespace
+{
+  class PainterDisplayListPrivate
+  {
+  public:
+    explicit
+    PainterDisplayListPrivate(const fastuidraw::reference_counted_ptr<fastuidraw::Painter> &target):
+      m_recording(false),
+      m_min_bb(-1.0f, -1.0f),
+      m_max_bb(1.0f, 1.0f)
+    {
+      m_painter = target->create_recording_stream();
+    }
+
+    bool m_recording;
+    fastuidraw::reference_counted_ptr<fastuidraw::Painter> m_painter;
+    fastuidraw::vec2 m_min_bb, m_max_bb;
+    fastuidraw::float3x3 m_inverse_transformation;
+  };
+}
+
+//////////////////////////////////////////
+// fastuidraw::PainterDisplayList methods
+fastuidraw::PainterDisplayList::
+PainterDisplayList(const reference_counted_ptr<Painter> &target)
+{
+  FASTUIDRAWassert(target);
+  m_d = FASTUIDRAWnew PainterDisplayListPrivate(target);
+}
+
+fastuidraw::PainterDisplayList::
+~PainterDisplayList()
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::Painter>&
+fastuidraw::PainterDisplayList::
+begin(const vec2 &min_bb, const vec2 &max_bb)
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+
+  FASTUIDRAWassert(!d->m_recording);
+  FASTUIDRAWassert(min_bb.x() < max_bb.x() && min_bb.y() < max_bb.y());
+
+  d->m_recording = true;
+  d->m_min_bb = min_bb;
+  d->m_max_bb = max_bb;
+
+  /* the recording Painter culls against [-1, 1]x[-1, 1] in
+     its clip-coordinates, so map the bounding box to that.
+   */
+  float3x3 tr(float_orthogonal_projection_params(min_bb.x(), max_bb.x(),
+                                                 max_bb.y(), min_bb.y()));
+  tr.inverse(d->m_inverse_transformation);
+
+  d->m_painter->begin();
+  d->m_painter->transformation(tr);
+  return d->m_painter;
+}
+
+void
+fastuidraw::PainterDisplayList::
+end(void)
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+
+  FASTUIDRAWassert(d->m_recording);
+  d->m_painter->end();
+  d->m_recording = false;
+}
+
+bool
+fastuidraw::PainterDisplayList::
+recording(void) const
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+  return d->m_recording;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::Painter>&
+fastuidraw::PainterDisplayList::
+painter(void) const
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+  return d->m_painter;
+}
+
+const fastuidraw::vec2&
+fastuidraw::PainterDisplayList::
+min_bb(void) const
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+  return d->m_min_bb;
+}
+
+const fastuidraw::vec2&
+fastuidraw::PainterDisplayList::
+max_bb(void) const
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+  return d->m_max_bb;
+}
+
+const fastuidraw::float3x3&
+fastuidraw::PainterDisplayList::
+inverse_transformation(void) const
+{
+  PainterDisplayListPrivate *d;
+  d = static_cast<PainterDisplayListPrivate*>(m_d);
+  return d->m_inverse_transformation;
+}
@@ -0,0 +1,284 @@
+/*!
+ * \file painter_trace.cpp
+ * \brief file painter_trace.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <map>
+#include <chrono>
+#include <thread>
+#include <fastuidraw/painter/painter_trace.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class trace_event
+  {
+  public:
+    enum type_t
+      {
+        duration_event,
+        counter_event
+      };
+
+    enum type_t m_type;
+    std::string m_name, m_category;
+    uint64_t m_start, m_duration;
+    unsigned int m_thread;
+    std::vector<std::pair<std::string, uint64_t> > m_values;
+  };
+
+  class PainterTracePrivate
+  {
+  public:
+    unsigned int
+    thread_id(void);
+
+    static
+    void
+    write_json_string(std::ostream &str, const std::string &v);
+
+    static
+    void
+    write_json_values(std::ostream &str,
+                      const std::vector<std::pair<std::string, uint64_t> > &v);
+
+    trace_event&
+    add_event(enum trace_event::type_t tp, fastuidraw::c_string name,
+              fastuidraw::c_array<const fastuidraw::c_string> labels,
+              fastuidraw::c_array<const uint64_t> values);
+
+    mutable fastuidraw::mutex m_mutex;
+    std::vector<trace_event> m_events;
+    std::map<std::thread::id, unsigned int> m_threads;
+  };
+}
+
+///////////////////////////////////
+// PainterTracePrivate methods
+unsigned int
+PainterTracePrivate::
+thread_id(void)
+{
+  std::map<std::thread::id, unsigned int>::iterator iter;
+  std::thread::id id(std::this_thread::get_id());
+
+  /* the Chrome trace format wants small integers for
+     thread ID's, so assign them in order of first use.
+   */
+  iter = m_threads.find(id);
+  if(iter == m_threads.end())
+    {
+      unsigned int v(m_threads.size());
+      m_threads[id] = v;
+      return v;
+    }
+  return iter->second;
+}
+
+void
+PainterTracePrivate::
+write_json_string(std::ostream &str, const std::string &v)
+{
+  str << "\"";
+  for(char c : v)
+    {
+      if(c == '"' || c == '\\')
+        {
+          str << '\\' << c;
+        }
+      else if(static_cast<unsigned char>(c) < 0x20)
+        {
+          str << ' ';
+        }
+      else
+        {
+          str << c;
+        }
+    }
+  str << "\"";
+}
+
+void
+PainterTracePrivate::
+write_json_values(std::ostream &str,
+                  const std::vector<std::pair<std::string, uint64_t> > &v)
+{
+  str << ",\"args\":{";
+  for(unsigned int i = 0; i < v.size(); ++i)
+    {
+      str << ((i != 0) ? "," : "");
+      write_json_string(str, v[i].first);
+      str << ":" << v[i].second;
+    }
+  str << "}";
+}
+
+trace_event&
+PainterTracePrivate::
+add_event(enum trace_event::type_t tp, fastuidraw::c_string name,
+          fastuidraw::c_array<const fastuidraw::c_string> labels,
+          fastuidraw::c_array<const uint64_t> values)
+{
+  /* m_mutex must be locked by the caller */
+  FASTUIDRAWassert(labels.size() == values.size());
+  m_events.push_back(trace_event());
+
+  trace_event &e(m_events.back());
+  e.m_type = tp;
+  e.m_name = name;
+  e.m_duration = 0u;
+  e.m_thread = thread_id();
+  e.m_values.resize(labels.size());
+  for(unsigned int i = 0; i < labels.size(); ++i)
+    {
+      e.m_values[i].first = labels[i];
+      e.m_values[i].second = values[i];
+    }
+  return e;
+}
+
+///////////////////////////////////
+// fastuidraw::PainterTrace methods
+fastuidraw::PainterTrace::
+PainterTrace(void)
+{
+  m_d = FASTUIDRAWnew PainterTracePrivate();
+}
+
+fastuidraw::PainterTrace::
+~PainterTrace()
+{
+  PainterTracePrivate *d;
+  d = static_cast<PainterTracePrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+uint64_t
+fastuidraw::PainterTrace::
+time_stamp(void)
+{
+  std::chrono::steady_clock::duration t;
+  t = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(t).count();
+}
+
+void
+fastuidraw::PainterTrace::
+add_duration_event(c_string name, c_string category,
+                   uint64_t start, uint64_t end)
+{
+  add_duration_event(name, category, start, end,
+                     c_array<const c_string>(),
+                     c_array<const uint64_t>());
+}
+
+void
+fastuidraw::PainterTrace::
+add_duration_event(c_string name, c_string category,
+                   uint64_t start, uint64_t end,
+                   c_array<const c_string> labels,
+                   c_array<const uint64_t> values)
+{
+  PainterTracePrivate *d;
+  d = static_cast<PainterTracePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  trace_event &e(d->add_event(trace_event::duration_event, name, labels, values));
+  e.m_category = category;
+  e.m_start = start;
+  e.m_duration = (end > start) ? end - start : 0u;
+}
+
+void
+fastuidraw::PainterTrace::
+add_counter_event(c_string name,
+                  c_array<const c_string> labels,
+                  c_array<const uint64_t> values,
+                  uint64_t time)
+{
+  PainterTracePrivate *d;
+  d = static_cast<PainterTracePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  trace_event &e(d->add_event(trace_event::counter_event, name, labels, values));
+  e.m_start = time;
+}
+
+unsigned int
+fastuidraw::PainterTrace::
+number_events(void) const
+{
+  PainterTracePrivate *d;
+  d = static_cast<PainterTracePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_events.size();
+}
+
+void
+fastuidraw::PainterTrace::
+clear(void)
+{
+  PainterTracePrivate *d;
+  d = static_cast<PainterTracePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  d->m_events.clear();
+}
+
+std::string
+fastuidraw::PainterTrace::
+chrome_trace_json(void) const
+{
+  PainterTracePrivate *d;
+  std::ostringstream str;
+
+  d = static_cast<PainterTracePrivate*>(m_d);
+  autolock_mutex m(d->m_mutex);
+
+  str << "{\"traceEvents\":[";
+  for(unsigned int i = 0; i < d->m_events.size(); ++i)
+    {
+      const trace_event &e(d->m_events[i]);
+
+      str << ((i != 0) ? ",\n" : "\n") << "{\"name\":";
+      PainterTracePrivate::write_json_string(str, e.m_name);
+      if(e.m_type == trace_event::duration_event)
+        {
+          str << ",\"cat\":";
+          PainterTracePrivate::write_json_string(str, e.m_category);
+          str << ",\"ph\":\"X\",\"dur\":" << e.m_duration;
+          if(!e.m_values.empty())
+            {
+              PainterTracePrivate::write_json_values(str, e.m_values);
+            }
+        }
+      else
+        {
+          str << ",\"ph\":\"C\"";
+          PainterTracePrivate::write_json_values(str, e.m_values);
+        }
+      str << ",\"ts\":" << e.m_start
+          << ",\"pid\":0,\"tid\":" << e.m_thread << "}";
+    }
+  str << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  return str.str();
+}
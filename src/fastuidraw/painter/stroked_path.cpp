@@ -19,6 +19,7 @@
 #include <vector>
 #include <complex>
 #include <algorithm>
+#include <atomic>
 
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
@@ -30,6 +31,7 @@
 #include "../private/bounding_box.hpp"
 #include "../private/path_util_private.hpp"
 #include "../private/clip.hpp"
+#include "../private/task_queue.hpp"
 
 namespace
 {
@@ -189,6 +191,15 @@ namespace
         m_non_closing_edge.size();
     }
 
+    const OrderingEntry<JoinSource>&
+    join(unsigned int J) const
+    {
+      FASTUIDRAWassert(J < number_joins(true));
+      return (J >= m_non_closing_edge.size()) ?
+        m_closing_edge[J - m_non_closing_edge.size()]:
+        m_non_closing_edge[J];
+    }
+
     unsigned int
     join_chunk(unsigned int J) const
     {
@@ -294,12 +305,22 @@ namespace
   class PathData:fastuidraw::noncopyable
   {
   public:
+    explicit
+    PathData(bool parallel_build):
+      m_parallel_build(parallel_build)
+    {}
+
     ContourData m_contour_data;
 
     JoinOrdering m_join_ordering;
     unsigned int m_number_join_chunks;
     CapOrdering m_cap_ordering;
     unsigned int m_number_cap_chunks;
+
+    /* if true, the attribute data is filled with
+       the tasks of a fastuidraw::detail::TaskGroup
+     */
+    bool m_parallel_build;
   };
 
   class SingleSubEdge
@@ -342,9 +363,14 @@ namespace
   class SubEdgeCullingHierarchy:fastuidraw::noncopyable
   {
   public:
+    /* if parallel is true, the lists of the contours and
+       the large nodes of the hierarchy are created with the
+       tasks of a fastuidraw::detail::TaskGroup.
+     */
     static
     SubEdgeCullingHierarchy*
-    create(const fastuidraw::TessellatedPath &P, ContourData &contour_data);
+    create(const fastuidraw::TessellatedPath &P, ContourData &contour_data,
+           bool parallel);
 
     ~SubEdgeCullingHierarchy();
 
@@ -434,15 +460,36 @@ namespace
       fastuidraw::c_array<const T> m_closing;
     };
 
+    /* the sub-edges, joins and caps of a single contour
+     */
+    class ContourLists
+    {
+    public:
+      std::vector<SingleSubEdge> m_non_closing_edges, m_closing_edges;
+      std::vector<JoinSource> m_non_closing_joins, m_closing_joins;
+      std::vector<CapSource> m_caps;
+      fastuidraw::BoundingBox<float> m_bb;
+    };
+
     enum
       {
-        splitting_threshhold = 20
+        splitting_threshhold = 20,
+
+        /* number of contours whose lists are created
+           by a single task when building in parallel.
+         */
+        contours_per_task = 16,
+
+        /* a node with at least this many sub-edges builds
+           its children concurrently when building in parallel.
+         */
+        edges_per_task = 2048
       };
 
     SubEdgeCullingHierarchy(const fastuidraw::BoundingBox<float> &start_box,
                             std::vector<SingleSubEdge> &data, unsigned int num_non_closing_edges,
                             std::vector<JoinSource> &joins, unsigned int num_non_closing_joins,
-                            std::vector<CapSource> &caps);
+                            std::vector<CapSource> &caps, bool parallel);
 
     /* a value of -1 means to NOT split.
      */
@@ -457,7 +504,12 @@ namespace
                  std::vector<SingleSubEdge> &data, unsigned int &num_non_closing_edges,
                  fastuidraw::BoundingBox<float> &bx,
                  std::vector<JoinSource> &joins, unsigned int &num_non_closing_joins,
-                 std::vector<CapSource> &caps);
+                 std::vector<CapSource> &caps, bool parallel);
+
+    static
+    void
+    create_contour_lists(const fastuidraw::TessellatedPath &P, ContourData &contour_data,
+                         unsigned int contour, ContourLists &dst);
 
     static
     void
@@ -811,10 +863,10 @@ namespace
   class EdgeAttributeFiller:public fastuidraw::PainterAttributeDataFiller
   {
   public:
-    explicit
     EdgeAttributeFiller(const StrokedPathSubset *src,
                         const fastuidraw::TessellatedPath &P,
-                        const StrokedPathSubset::CreationValues &cnts);
+                        const StrokedPathSubset::CreationValues &cnts,
+                        bool parallel);
 
     virtual
     void
@@ -833,6 +885,15 @@ namespace
               fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
               fastuidraw::c_array<int> index_adjusts) const;
   private:
+    enum
+      {
+        /* a node whose edges have at least this many vertices
+           fills the data of its children concurrently when
+           filling in parallel.
+         */
+        vertices_per_task = 4096
+      };
+
     void
     fill_data_worker(const StrokedPathSubset *e,
                      fastuidraw::c_array<fastuidraw::PainterAttribute> attribute_data,
@@ -861,6 +922,7 @@ namespace
     const fastuidraw::TessellatedPath &m_P;
     unsigned int m_total_vertex_cnt, m_total_index_cnt;
     unsigned int m_total_number_chunks;
+    bool m_parallel;
   };
 
   class JoinCount
@@ -933,6 +995,13 @@ namespace
     post_ctor_initalize(void);
 
   private:
+    enum
+      {
+        /* number of joins filled by a single task when
+           filling in parallel.
+         */
+        joins_per_task = 256
+      };
 
     void
     fill_join(unsigned int join_id,
@@ -941,13 +1010,10 @@ namespace
               unsigned int chunk, unsigned int depth,
               fastuidraw::c_array<fastuidraw::PainterAttribute> pts,
               fastuidraw::c_array<unsigned int> indices,
-              unsigned int &vertex_offset, unsigned int &index_offset,
               fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterAttribute> > attribute_chunks,
               fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
               fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
-              fastuidraw::c_array<int> index_adjusts,
-              fastuidraw::c_array<fastuidraw::range_type<int> > join_vertex_ranges,
-              fastuidraw::c_array<fastuidraw::range_type<int> > join_index_ranges) const;
+              fastuidraw::c_array<int> index_adjusts) const;
 
     static
     void
@@ -995,6 +1061,14 @@ namespace
     const StrokedPathSubset *m_st;
     unsigned int m_num_verts, m_num_indices, m_num_chunks, m_num_joins;
     bool m_post_ctor_initalized_called;
+    bool m_parallel;
+
+    /* range of vertices and indices of each join, computed
+       in post_ctor_initalize() so that the joins can be
+       filled independently of each other.
+     */
+    std::vector<fastuidraw::range_type<int> > m_join_vertex_ranges;
+    std::vector<fastuidraw::range_type<int> > m_join_index_ranges;
   };
 
 
@@ -1197,6 +1271,14 @@ namespace
               fastuidraw::c_array<int> index_adjusts) const;
 
   private:
+    enum
+      {
+        /* number of caps filled by a single task when
+           filling in parallel.
+         */
+        caps_per_task = 512
+      };
+
     virtual
     void
     add_cap(const fastuidraw::vec2 &normal_from_stroking,
@@ -1225,6 +1307,7 @@ namespace
 
     unsigned int m_num_chunks;
     PointIndexCapSize m_size;
+    bool m_parallel;
   };
 
   class RoundedCapCreator:public CapCreatorBase
@@ -1355,30 +1438,37 @@ namespace
     void
     mark_as_empty(void)
     {
-      m_ready = true;
+      m_ready.store(true, std::memory_order_release);
     }
 
+    /* may be called from several threads at the same time,
+       the data is created only once.
+     */
     const fastuidraw::PainterAttributeData&
     data(const PathData &P, const StrokedPathSubset *st)
     {
-      if(!m_ready)
+      if(!m_ready.load(std::memory_order_acquire))
         {
-          m_data.set_data(T(P, st));
-          m_ready = true;
+          fastuidraw::autolock_mutex m(m_mutex);
+          if(!m_ready.load(std::memory_order_relaxed))
+            {
+              m_data.set_data(T(P, st));
+              m_ready.store(true, std::memory_order_release);
+            }
         }
       return m_data;
     }
 
   private:
     fastuidraw::PainterAttributeData m_data;
-    bool m_ready;
+    fastuidraw::mutex m_mutex;
+    std::atomic<bool> m_ready;
   };
 
   class StrokedPathPrivate:fastuidraw::noncopyable
   {
   public:
-    explicit
-    StrokedPathPrivate(const fastuidraw::TessellatedPath &P);
+    StrokedPathPrivate(const fastuidraw::TessellatedPath &P, bool parallel_build);
     ~StrokedPathPrivate();
 
     void
@@ -1404,6 +1494,11 @@ namespace
     fastuidraw::vecN<unsigned int, 2> m_chunk_of_edges;
     unsigned int m_chunk_of_caps;
 
+    /* m_rounded_mutex protects m_rounded_joins and m_rounded_caps,
+       the elements are never removed and their m_data values
+       stay valid for the lifetime of the StrokedPath.
+     */
+    fastuidraw::mutex m_rounded_mutex;
     std::vector<ThreshWithData> m_rounded_joins;
     std::vector<ThreshWithData> m_rounded_caps;
 
@@ -1478,7 +1573,8 @@ const float SubEdgeCullingHierarchy::sm_mag_tol = 0.000001f;
 
 SubEdgeCullingHierarchy*
 SubEdgeCullingHierarchy::
-create(const fastuidraw::TessellatedPath &P, ContourData &path_data)
+create(const fastuidraw::TessellatedPath &P, ContourData &path_data,
+       bool parallel)
 {
   std::vector<SingleSubEdge> data;
   std::vector<JoinSource> joins;
@@ -1489,9 +1585,10 @@ create(const fastuidraw::TessellatedPath &P, ContourData &path_data)
 
   create_lists(P, path_data,
                data, num_non_closing_edges, bx,
-               joins, num_non_closing_joins, caps);
+               joins, num_non_closing_joins, caps, parallel);
   return_value =  FASTUIDRAWnew SubEdgeCullingHierarchy(bx, data, num_non_closing_edges,
-                                                        joins, num_non_closing_joins, caps);
+                                                        joins, num_non_closing_joins, caps,
+                                                        parallel);
   return return_value;
 }
 
@@ -1501,74 +1598,111 @@ create_lists(const fastuidraw::TessellatedPath &P, ContourData &path_data,
              std::vector<SingleSubEdge> &data, unsigned int &num_non_closing_edges,
              fastuidraw::BoundingBox<float> &bx,
              std::vector<JoinSource> &joins, unsigned int &num_non_closing_joins,
-             std::vector<CapSource> &caps)
+             std::vector<CapSource> &caps, bool parallel)
 {
-  path_data.m_per_contour_data.resize(P.number_contours());
+  std::vector<ContourLists> lists(P.number_contours());
 
-  /* place data of closing sub-edges at the tail of the lists.
+  /* each contour only writes to its own element of
+     m_per_contour_data and of lists, so the contours
+     can be processed independently.
    */
-  for(unsigned int o = 0; o < P.number_contours(); ++o)
+  auto create_contours = [&](unsigned int begin, unsigned int end)
     {
-      path_data.m_per_contour_data[o].m_edge_data_store.resize(P.number_edges(o));
-      path_data.m_per_contour_data[o].m_start_contour_pt = P.unclosed_contour_point_data(o).front();
-      path_data.m_per_contour_data[o].m_end_contour_pt = P.unclosed_contour_point_data(o).back();
-      for(unsigned int e = 0, ende = P.number_edges(o); e + 1 < ende; ++e)
+      for(unsigned int o = begin; o < end; ++o)
         {
-          process_edge(P, path_data, o, e, data, bx);
-
-          if(e + 2 != ende)
-            {
-              JoinSource J;
-              J.m_contour = o;
-              J.m_edge_going_into_join = e;
-              J.m_of_closing_edge = false;
-              J.m_pt = path_data.m_per_contour_data[o].m_edge_data_store[e].m_end_pt.m_p;
-              joins.push_back(J);
-            }
+          create_contour_lists(P, path_data, o, lists[o]);
         }
+    };
+
+  path_data.m_per_contour_data.resize(P.number_contours());
+  fastuidraw::detail::for_each_block(P.number_contours(), contours_per_task,
+                                     parallel, create_contours);
+
+  /* place data of closing sub-edges at the tail of the lists.
+   */
+  for(const ContourLists &L : lists)
+    {
+      data.insert(data.end(), L.m_non_closing_edges.begin(), L.m_non_closing_edges.end());
+      joins.insert(joins.end(), L.m_non_closing_joins.begin(), L.m_non_closing_joins.end());
+      bx.union_box(L.m_bb);
     }
 
   num_non_closing_edges = data.size();
   num_non_closing_joins = joins.size();
 
-  for(unsigned int o = 0; o < P.number_contours(); ++o)
+  for(const ContourLists &L : lists)
     {
-      if(P.number_edges(o) > 0)
-        {
-          process_edge(P, path_data, o, P.number_edges(o) - 1, data, bx);
+      data.insert(data.end(), L.m_closing_edges.begin(), L.m_closing_edges.end());
+      joins.insert(joins.end(), L.m_closing_joins.begin(), L.m_closing_joins.end());
+      caps.insert(caps.end(), L.m_caps.begin(), L.m_caps.end());
+    }
+}
 
-          if(P.number_edges(o) >= 2)
-            {
-              JoinSource J;
-              unsigned int e;
-
-              e = P.number_edges(o) - 2;
-              J.m_contour = o;
-              J.m_edge_going_into_join = e;
-              J.m_of_closing_edge = true;
-              J.m_pt = path_data.m_per_contour_data[o].m_edge_data_store[e].m_end_pt.m_p;
-              joins.push_back(J);
-
-              e = P.number_edges(o) - 1;
-              J.m_contour = o;
-              J.m_edge_going_into_join = e;
-              J.m_of_closing_edge = true;
-              J.m_pt = path_data.m_per_contour_data[o].m_edge_data_store[e].m_end_pt.m_p;
-              joins.push_back(J);
-            }
+void
+SubEdgeCullingHierarchy::
+create_contour_lists(const fastuidraw::TessellatedPath &P, ContourData &path_data,
+                     unsigned int o, ContourLists &dst)
+{
+  fastuidraw::range_type<unsigned int> R(P.unclosed_contour_range(o));
+  unsigned int last_unclosed_edge;
+
+  /* read the points with point_value() so that a TessellatedPath
+     with compact storage does not build its point array.
+   */
+  last_unclosed_edge = (P.number_edges(o) > 1) ? P.number_edges(o) - 2 : P.number_edges(o) - 1;
+  path_data.m_per_contour_data[o].m_edge_data_store.resize(P.number_edges(o));
+  path_data.m_per_contour_data[o].m_start_contour_pt = P.point_value(o, 0, R.m_begin);
+  path_data.m_per_contour_data[o].m_end_contour_pt = P.point_value(o, last_unclosed_edge, R.m_end - 1);
+  for(unsigned int e = 0, ende = P.number_edges(o); e + 1 < ende; ++e)
+    {
+      process_edge(P, path_data, o, e, dst.m_non_closing_edges, dst.m_bb);
+
+      if(e + 2 != ende)
+        {
+          JoinSource J;
+          J.m_contour = o;
+          J.m_edge_going_into_join = e;
+          J.m_of_closing_edge = false;
+          J.m_pt = path_data.m_per_contour_data[o].m_edge_data_store[e].m_end_pt.m_p;
+          dst.m_non_closing_joins.push_back(J);
         }
+    }
 
-      CapSource C0, C1;
-      C0.m_contour = o;
-      C0.m_is_start_cap = true;
-      C0.m_pt = P.unclosed_contour_point_data(o).front().m_p;
-      caps.push_back(C0);
+  if(P.number_edges(o) > 0)
+    {
+      process_edge(P, path_data, o, P.number_edges(o) - 1, dst.m_closing_edges, dst.m_bb);
 
-      C1.m_contour = o;
-      C1.m_is_start_cap = false;
-      C1.m_pt = P.unclosed_contour_point_data(o).back().m_p;
-      caps.push_back(C1);
+      if(P.number_edges(o) >= 2)
+        {
+          JoinSource J;
+          unsigned int e;
+
+          e = P.number_edges(o) - 2;
+          J.m_contour = o;
+          J.m_edge_going_into_join = e;
+          J.m_of_closing_edge = true;
+          J.m_pt = path_data.m_per_contour_data[o].m_edge_data_store[e].m_end_pt.m_p;
+          dst.m_closing_joins.push_back(J);
+
+          e = P.number_edges(o) - 1;
+          J.m_contour = o;
+          J.m_edge_going_into_join = e;
+          J.m_of_closing_edge = true;
+          J.m_pt = path_data.m_per_contour_data[o].m_edge_data_store[e].m_end_pt.m_p;
+          dst.m_closing_joins.push_back(J);
+        }
     }
+
+  CapSource C0, C1;
+  C0.m_contour = o;
+  C0.m_is_start_cap = true;
+  C0.m_pt = path_data.m_per_contour_data[o].m_start_contour_pt.m_p;
+  dst.m_caps.push_back(C0);
+
+  C1.m_contour = o;
+  C1.m_is_start_cap = false;
+  C1.m_pt = path_data.m_per_contour_data[o].m_end_contour_pt.m_p;
+  dst.m_caps.push_back(C1);
 }
 
 void
@@ -1578,7 +1712,6 @@ process_edge(const fastuidraw::TessellatedPath &P, ContourData &path_data,
              std::vector<SingleSubEdge> &dst, fastuidraw::BoundingBox<float> &bx)
 {
   fastuidraw::range_type<unsigned int> R;
-  fastuidraw::c_array<const fastuidraw::TessellatedPath::point> src_pts(P.point_data());
   fastuidraw::vec2 normal(1.0f, 0.0f), last_normal(1.0f, 0.0f);
   bool is_closing_edge;
 
@@ -1588,13 +1721,16 @@ process_edge(const fastuidraw::TessellatedPath &P, ContourData &path_data,
 
   for(unsigned int i = R.m_begin; i + 1 < R.m_end; ++i)
     {
-      /* for the edge connecting src_pts[i] to src_pts[i+1]
+      /* for the edge connecting point i to point i + 1
        */
+      fastuidraw::TessellatedPath::point pt0, pt1;
       fastuidraw::vec2 delta;
       float delta_magnitude;
       SingleSubEdge sub_edge;
 
-      delta = src_pts[i + 1].m_p - src_pts[i].m_p;
+      pt0 = P.point_value(contour, edge, i);
+      pt1 = P.point_value(contour, edge, i + 1);
+      delta = pt1.m_p - pt0.m_p;
       delta_magnitude = delta.magnitude();
 
       if(delta.magnitude() >= sm_mag_tol)
@@ -1604,9 +1740,9 @@ process_edge(const fastuidraw::TessellatedPath &P, ContourData &path_data,
       else
         {
           delta_magnitude = 0.0;
-          if(src_pts[i].m_p_t.magnitudeSq() >= sm_mag_tol * sm_mag_tol)
+          if(pt0.m_p_t.magnitudeSq() >= sm_mag_tol * sm_mag_tol)
             {
-              normal = fastuidraw::vec2(-src_pts[i].m_p_t.y(), src_pts[i].m_p_t.x());
+              normal = fastuidraw::vec2(-pt0.m_p_t.y(), pt0.m_p_t.x());
               normal.normalize();
             }
         }
@@ -1617,7 +1753,7 @@ process_edge(const fastuidraw::TessellatedPath &P, ContourData &path_data,
           sub_edge.m_has_bevel = false;
           sub_edge.m_bevel_normal = fastuidraw::vec2(0.0f, 0.0f);
           path_data.m_per_contour_data[contour].write_edge_data(edge).m_begin_normal = normal;
-          path_data.m_per_contour_data[contour].write_edge_data(edge).m_start_pt = src_pts[i];
+          path_data.m_per_contour_data[contour].write_edge_data(edge).m_start_pt = pt0;
           if(edge == 0)
             {
               path_data.m_per_contour_data[contour].m_begin_cap_normal = normal;
@@ -1631,24 +1767,26 @@ process_edge(const fastuidraw::TessellatedPath &P, ContourData &path_data,
         }
 
       sub_edge.m_of_closing_edge = is_closing_edge;
-      sub_edge.m_pt0 = SingleSubEdge::point(src_pts[i]);
-      sub_edge.m_pt1 = SingleSubEdge::point(src_pts[i + 1]);
+      sub_edge.m_pt0 = SingleSubEdge::point(pt0);
+      sub_edge.m_pt1 = SingleSubEdge::point(pt1);
       sub_edge.m_normal = normal;
       sub_edge.m_delta = delta;
 
       dst.push_back(sub_edge);
-      bx.union_point(src_pts[i].m_p);
-      bx.union_point(src_pts[i + 1].m_p);
+      bx.union_point(pt0.m_p);
+      bx.union_point(pt1.m_p);
 
       last_normal = normal;
     }
 
   if(R.m_begin + 1 >= R.m_end)
     {
-      normal = fastuidraw::vec2(-src_pts[R.m_begin].m_p_t.y(), src_pts[R.m_begin].m_p_t.x());
+      fastuidraw::TessellatedPath::point pt(P.point_value(contour, edge, R.m_begin));
+
+      normal = fastuidraw::vec2(-pt.m_p_t.y(), pt.m_p_t.x());
       normal.normalize();
       path_data.m_per_contour_data[contour].write_edge_data(edge).m_begin_normal = normal;
-      path_data.m_per_contour_data[contour].write_edge_data(edge).m_start_pt = src_pts[R.m_begin];
+      path_data.m_per_contour_data[contour].write_edge_data(edge).m_start_pt = pt;
       if(edge == 0)
         {
           path_data.m_per_contour_data[contour].m_begin_cap_normal = normal;
@@ -1656,7 +1794,7 @@ process_edge(const fastuidraw::TessellatedPath &P, ContourData &path_data,
     }
 
   path_data.m_per_contour_data[contour].write_edge_data(edge).m_end_normal = normal;
-  path_data.m_per_contour_data[contour].write_edge_data(edge).m_end_pt = src_pts[R.m_end - 1];
+  path_data.m_per_contour_data[contour].write_edge_data(edge).m_end_pt = P.point_value(contour, edge, R.m_end - 1);
   if(edge + 2 == P.number_edges(contour))
     {
       path_data.m_per_contour_data[contour].m_end_cap_normal = normal;
@@ -1692,7 +1830,7 @@ SubEdgeCullingHierarchy::
 SubEdgeCullingHierarchy(const fastuidraw::BoundingBox<float> &start_box,
                         std::vector<SingleSubEdge> &edges, unsigned int num_non_closing_edges,
                         std::vector<JoinSource> &joins, unsigned int num_non_closing_joins,
-                        std::vector<CapSource> &caps):
+                        std::vector<CapSource> &caps, bool parallel):
   m_children(nullptr, nullptr),
   m_bb(start_box)
 {
@@ -1767,14 +1905,21 @@ SubEdgeCullingHierarchy(const fastuidraw::BoundingBox<float> &start_box,
             }
         }
 
-      m_children[0] = FASTUIDRAWnew SubEdgeCullingHierarchy(child_boxes[0],
-                                                            child_sub_edges[0], child_num_non_closing_edges[0],
-                                                            child_joins[0], child_num_non_closing_joins[0],
-                                                            child_caps[0]);
-      m_children[1] = FASTUIDRAWnew SubEdgeCullingHierarchy(child_boxes[1],
-                                                            child_sub_edges[1], child_num_non_closing_edges[1],
-                                                            child_joins[1], child_num_non_closing_joins[1],
-                                                            child_caps[1]);
+      /* each child only touches the lists handed to it,
+         so for a large node they can be built concurrently.
+       */
+      auto create_children = [&](unsigned int begin, unsigned int end)
+        {
+          for(unsigned int i = begin; i < end; ++i)
+            {
+              m_children[i] = FASTUIDRAWnew SubEdgeCullingHierarchy(child_boxes[i],
+                                                                    child_sub_edges[i], child_num_non_closing_edges[i],
+                                                                    child_joins[i], child_num_non_closing_joins[i],
+                                                                    child_caps[i], parallel);
+            }
+        };
+      fastuidraw::detail::for_each_block(2, 1, parallel && edges.size() >= edges_per_task,
+                                         create_children);
     }
   else
     {
@@ -2233,12 +2378,14 @@ compute_chunks_implement(bool include_closing_edge,
 EdgeAttributeFiller::
 EdgeAttributeFiller(const StrokedPathSubset *src,
                     const fastuidraw::TessellatedPath &P,
-                    const StrokedPathSubset::CreationValues &cnts):
+                    const StrokedPathSubset::CreationValues &cnts,
+                    bool parallel):
   m_src(src),
   m_P(P),
   m_total_vertex_cnt(cnts.m_non_closing_edge_vertex_cnt + cnts.m_closing_edge_vertex_cnt),
   m_total_index_cnt(cnts.m_non_closing_edge_index_cnt + cnts.m_closing_edge_index_cnt),
-  m_total_number_chunks(cnts.m_non_closing_edge_chunk_cnt + cnts.m_closing_edge_chunk_cnt)
+  m_total_number_chunks(cnts.m_non_closing_edge_chunk_cnt + cnts.m_closing_edge_chunk_cnt),
+  m_parallel(parallel)
 {
 }
 
@@ -2285,11 +2432,23 @@ fill_data_worker(const StrokedPathSubset *e,
       FASTUIDRAWassert(e->non_closing_edges().m_src.empty());
       FASTUIDRAWassert(e->closing_edges().m_src.empty());
 
-      fill_data_worker(e->child(0), attribute_data, index_data,
-                       attribute_chunks, index_chunks, zranges, index_adjusts);
+      /* the children write to disjoint ranges of the
+         attribute and index data and to different chunks.
+       */
+      unsigned int num_verts;
+      auto fill_children = [&](unsigned int begin, unsigned int end)
+        {
+          for(unsigned int i = begin; i < end; ++i)
+            {
+              fill_data_worker(e->child(i), attribute_data, index_data,
+                               attribute_chunks, index_chunks, zranges, index_adjusts);
+            }
+        };
 
-      fill_data_worker(e->child(1), attribute_data, index_data,
-                       attribute_chunks, index_chunks, zranges, index_adjusts);
+      num_verts = e->non_closing_edges().m_vertex_data_range.difference()
+        + e->closing_edges().m_vertex_data_range.difference();
+      fastuidraw::detail::for_each_block(2, 1, m_parallel && num_verts >= vertices_per_task,
+                                         fill_children);
     }
 
   build_chunk(e->non_closing_edges(), attribute_data, index_data,
@@ -2616,7 +2775,8 @@ JoinCreatorBase(const PathData &P,
   m_num_indices(0),
   m_num_chunks(P.m_number_join_chunks),
   m_num_joins(0),
-  m_post_ctor_initalized_called(false)
+  m_post_ctor_initalized_called(false),
+  m_parallel(P.m_parallel_build)
 {}
 
 void
@@ -2626,22 +2786,19 @@ post_ctor_initalize(void)
   FASTUIDRAWassert(!m_post_ctor_initalized_called);
   m_post_ctor_initalized_called = true;
 
-  for(const JoinSource &J : m_ordering.non_closing_edge())
+  m_join_vertex_ranges.reserve(m_ordering.number_joins(true));
+  m_join_index_ranges.reserve(m_ordering.number_joins(true));
+  for(unsigned int endi = m_ordering.number_joins(true); m_num_joins < endi; ++m_num_joins)
     {
-      add_join(m_num_joins,
-               m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join),
-               m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join + 1),
-               m_num_verts, m_num_indices);
-      ++m_num_joins;
-    }
+      const JoinSource &J(m_ordering.join(m_num_joins));
+      unsigned int v(m_num_verts), i(m_num_indices);
 
-  for(const JoinSource &J : m_ordering.closing_edge())
-    {
       add_join(m_num_joins,
                m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join),
                m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join + 1),
                m_num_verts, m_num_indices);
-      ++m_num_joins;
+      m_join_vertex_ranges.push_back(fastuidraw::range_type<int>(v, m_num_verts));
+      m_join_index_ranges.push_back(fastuidraw::range_type<int>(i, m_num_indices));
     }
 }
 
@@ -2667,26 +2824,22 @@ fill_join(unsigned int join_id,
           unsigned int chunk, unsigned int depth,
           fastuidraw::c_array<fastuidraw::PainterAttribute> pts,
           fastuidraw::c_array<unsigned int> indices,
-          unsigned int &vertex_offset, unsigned int &index_offset,
           fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterAttribute> > attribute_chunks,
           fastuidraw::c_array<fastuidraw::c_array<const fastuidraw::PainterIndex> > index_chunks,
           fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
-          fastuidraw::c_array<int> index_adjusts,
-          fastuidraw::c_array<fastuidraw::range_type<int> > join_vertex_ranges,
-          fastuidraw::c_array<fastuidraw::range_type<int> > join_index_ranges) const
+          fastuidraw::c_array<int> index_adjusts) const
 {
-  unsigned int v(vertex_offset), i(index_offset);
+  unsigned int v, i, vertex_offset, index_offset;
 
   FASTUIDRAWassert(join_id < m_num_joins);
 
+  v = vertex_offset = m_join_vertex_ranges[join_id].m_begin;
+  i = index_offset = m_join_index_ranges[join_id].m_begin;
   fill_join_implement(join_id, into_join, leaving_join,
                       pts, depth, indices, vertex_offset, index_offset);
 
-  join_vertex_ranges[join_id].m_begin = v;
-  join_vertex_ranges[join_id].m_end = vertex_offset;
-
-  join_index_ranges[join_id].m_begin = i;
-  join_index_ranges[join_id].m_end = index_offset;
+  FASTUIDRAWassert(int(vertex_offset) == m_join_vertex_ranges[join_id].m_end);
+  FASTUIDRAWassert(int(index_offset) == m_join_index_ranges[join_id].m_end);
 
   attribute_chunks[chunk] = pts.sub_array(v, vertex_offset - v);
   index_chunks[chunk] = indices.sub_array(i, index_offset - i);
@@ -2703,13 +2856,6 @@ fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attribute_data,
           fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
           fastuidraw::c_array<int> index_adjusts) const
 {
-  unsigned int vertex_offset(0), index_offset(0), join_id(0);
-  std::vector<fastuidraw::range_type<int> > jvr(m_num_joins), jir(m_num_joins);
-  fastuidraw::c_array<fastuidraw::range_type<int> > join_vertex_ranges, join_index_ranges;
-
-  join_vertex_ranges = fastuidraw::make_c_array(jvr);
-  join_index_ranges = fastuidraw::make_c_array(jir);
-
   FASTUIDRAWassert(attribute_data.size() == m_num_verts);
   FASTUIDRAWassert(index_data.size() == m_num_indices);
   FASTUIDRAWassert(attribute_chunks.size() == m_num_chunks);
@@ -2719,41 +2865,28 @@ fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attribute_data,
 
   /* Note that we reverse the the depth value, we need to do this because
      we want the joins draw first to obscure the joins drawn later.
+     Each join writes only to its own range of vertices and indices
+     and to its own chunk, so blocks of joins can be filled concurrently.
    */
-  for(const OrderingEntry<JoinSource> &J : m_ordering.non_closing_edge())
-    {
-      fill_join(join_id,
-                m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join),
-                m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join + 1),
-                J.m_chunk, J.m_depth,
-                attribute_data, index_data,
-                vertex_offset, index_offset,
-                attribute_chunks, index_chunks,
-                zranges, index_adjusts,
-                join_vertex_ranges,
-                join_index_ranges);
-      ++join_id;
-    }
-
-  for(const OrderingEntry<JoinSource> &J : m_ordering.closing_edge())
+  auto fill_joins = [&](unsigned int begin, unsigned int end)
     {
-      fill_join(join_id,
-                m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join),
-                m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join + 1),
-                J.m_chunk, J.m_depth,
-                attribute_data, index_data,
-                vertex_offset, index_offset,
-                attribute_chunks, index_chunks,
-                zranges, index_adjusts,
-                join_vertex_ranges,
-                join_index_ranges);
-      ++join_id;
-    }
+      for(unsigned int join_id = begin; join_id < end; ++join_id)
+        {
+          const OrderingEntry<JoinSource> &J(m_ordering.join(join_id));
+          fill_join(join_id,
+                    m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join),
+                    m_P.m_per_contour_data[J.m_contour].edge_data(J.m_edge_going_into_join + 1),
+                    J.m_chunk, J.m_depth,
+                    attribute_data, index_data,
+                    attribute_chunks, index_chunks,
+                    zranges, index_adjusts);
+        }
+    };
+  fastuidraw::detail::for_each_block(m_num_joins, joins_per_task, m_parallel, fill_joins);
 
-  FASTUIDRAWassert(vertex_offset == m_num_verts);
-  FASTUIDRAWassert(index_offset == m_num_indices);
   set_chunks(m_st,
-             join_vertex_ranges, join_index_ranges,
+             fastuidraw::make_c_array(m_join_vertex_ranges),
+             fastuidraw::make_c_array(m_join_index_ranges),
              attribute_data, index_data,
              attribute_chunks, index_chunks,
              zranges, index_adjusts);
@@ -3398,7 +3531,8 @@ CapCreatorBase(const PathData &P,
   m_ordering(P.m_cap_ordering),
   m_st(st),
   m_num_chunks(P.m_number_cap_chunks),
-  m_size(sz)
+  m_size(sz),
+  m_parallel(P.m_parallel_build)
 {
 }
 
@@ -3424,42 +3558,59 @@ fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attribute_data,
           fastuidraw::c_array<fastuidraw::range_type<int> > zranges,
           fastuidraw::c_array<int> index_adjusts) const
 {
-  unsigned int vertex_offset(0u), index_offset(0u), cap_id(0u);
+  fastuidraw::c_array<const OrderingEntry<CapSource> > caps(m_ordering.caps());
   std::vector<fastuidraw::range_type<int> > cvr(m_num_chunks), cir(m_num_chunks);
+  unsigned int verts_per_cap, indices_per_cap;
 
-  for(const OrderingEntry<CapSource> C : m_ordering.caps())
+  /* every cap of a CapCreatorBase has the same number of
+     vertices and indices, thus where the data of each cap
+     goes is known before any cap is filled and blocks of
+     caps can be filled concurrently.
+   */
+  FASTUIDRAWassert(!caps.empty());
+  FASTUIDRAWassert(m_size.m_verts % caps.size() == 0);
+  FASTUIDRAWassert(m_size.m_indices % caps.size() == 0);
+  verts_per_cap = m_size.m_verts / caps.size();
+  indices_per_cap = m_size.m_indices / caps.size();
+  for(unsigned int cap_id = 0; cap_id < caps.size(); ++cap_id)
     {
-      unsigned int v(vertex_offset), i(index_offset);
-      const fastuidraw::vec2 *normal;
-      const fastuidraw::TessellatedPath::point *pt;
+      cvr[cap_id].m_begin = cap_id * verts_per_cap;
+      cvr[cap_id].m_end = cvr[cap_id].m_begin + verts_per_cap;
 
-      normal = C.m_is_start_cap ?
-        &m_P.m_per_contour_data[C.m_contour].m_begin_cap_normal:
-        &m_P.m_per_contour_data[C.m_contour].m_end_cap_normal;
+      cir[cap_id].m_begin = cap_id * indices_per_cap;
+      cir[cap_id].m_end = cir[cap_id].m_begin + indices_per_cap;
+    }
 
-      pt = C.m_is_start_cap ?
-        &m_P.m_per_contour_data[C.m_contour].m_start_contour_pt:
-        &m_P.m_per_contour_data[C.m_contour].m_end_contour_pt;
+  auto fill_caps = [&](unsigned int begin, unsigned int end)
+    {
+      for(unsigned int cap_id = begin; cap_id < end; ++cap_id)
+        {
+          const OrderingEntry<CapSource> &C(caps[cap_id]);
+          unsigned int vertex_offset(cvr[cap_id].m_begin), index_offset(cir[cap_id].m_begin);
+          const fastuidraw::vec2 *normal;
+          const fastuidraw::TessellatedPath::point *pt;
 
-      add_cap(*normal, C.m_is_start_cap, C.m_depth, *pt,
-              attribute_data, index_data, vertex_offset, index_offset);
+          normal = C.m_is_start_cap ?
+            &m_P.m_per_contour_data[C.m_contour].m_begin_cap_normal:
+            &m_P.m_per_contour_data[C.m_contour].m_end_cap_normal;
 
-      cvr[cap_id].m_begin = v;
-      cvr[cap_id].m_end = vertex_offset;
+          pt = C.m_is_start_cap ?
+            &m_P.m_per_contour_data[C.m_contour].m_start_contour_pt:
+            &m_P.m_per_contour_data[C.m_contour].m_end_contour_pt;
 
-      cir[cap_id].m_begin = i;
-      cir[cap_id].m_end = index_offset;
+          add_cap(*normal, C.m_is_start_cap, C.m_depth, *pt,
+                  attribute_data, index_data, vertex_offset, index_offset);
 
-      attribute_chunks[C.m_chunk] = attribute_data.sub_array(cvr[cap_id]);
-      index_chunks[C.m_chunk] = index_data.sub_array(cir[cap_id]);
-      zranges[C.m_chunk] = fastuidraw::range_type<int>(C.m_depth, C.m_depth + 1);
-      index_adjusts[C.m_chunk] = -int(v);
+          FASTUIDRAWassert(int(vertex_offset) == cvr[cap_id].m_end);
+          FASTUIDRAWassert(int(index_offset) == cir[cap_id].m_end);
 
-      ++cap_id;
-    }
-
-  FASTUIDRAWassert(vertex_offset == m_size.m_verts);
-  FASTUIDRAWassert(index_offset == m_size.m_indices);
+          attribute_chunks[C.m_chunk] = attribute_data.sub_array(cvr[cap_id]);
+          index_chunks[C.m_chunk] = index_data.sub_array(cir[cap_id]);
+          zranges[C.m_chunk] = fastuidraw::range_type<int>(C.m_depth, C.m_depth + 1);
+          index_adjusts[C.m_chunk] = -int(cvr[cap_id].m_begin);
+        }
+    };
+  fastuidraw::detail::for_each_block(caps.size(), caps_per_task, m_parallel, fill_caps);
 
   set_chunks(m_st,
              fastuidraw::make_c_array(cvr),
@@ -3857,10 +4008,11 @@ add_cap(const fastuidraw::vec2 &normal_from_stroking,
 /////////////////////////////////////////////
 // StrokedPathPrivate methods
 StrokedPathPrivate::
-StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
-  m_subset(nullptr)
+StrokedPathPrivate(const fastuidraw::TessellatedPath &P, bool parallel_build):
+  m_subset(nullptr),
+  m_path_data(parallel_build)
 {
-  if(!P.point_data().empty())
+  if(P.number_points() > 0)
     {
       m_empty_path = false;
       create_edges(P);
@@ -3909,9 +4061,9 @@ create_edges(const fastuidraw::TessellatedPath &P)
   StrokedPathSubset::CreationValues cnts;
 
   FASTUIDRAWassert(!m_empty_path);
-  s = SubEdgeCullingHierarchy::create(P, m_path_data.m_contour_data);
+  s = SubEdgeCullingHierarchy::create(P, m_path_data.m_contour_data, m_path_data.m_parallel_build);
   m_subset = StrokedPathSubset::create(s, cnts, m_path_data.m_join_ordering, m_path_data.m_cap_ordering);
-  m_edges.set_data(EdgeAttributeFiller(m_subset, P, cnts));
+  m_edges.set_data(EdgeAttributeFiller(m_subset, P, cnts, m_path_data.m_parallel_build));
 
   m_path_data.m_number_join_chunks = cnts.m_non_closing_join_chunk_cnt + cnts.m_closing_join_chunk_cnt;
   m_path_data.m_number_cap_chunks = cnts.m_cap_chunk_cnt;
@@ -3934,6 +4086,7 @@ const fastuidraw::PainterAttributeData&
 StrokedPathPrivate::
 fetch_create(float thresh, std::vector<ThreshWithData> &values)
 {
+  fastuidraw::autolock_mutex m(m_rounded_mutex);
   if(values.empty())
     {
       fastuidraw::PainterAttributeData *newD;
@@ -4259,10 +4412,10 @@ cap_chunks(void) const
 //////////////////////////////////////////////////////////////
 // fastuidraw::StrokedPath methods
 fastuidraw::StrokedPath::
-StrokedPath(const fastuidraw::TessellatedPath &P)
+StrokedPath(const fastuidraw::TessellatedPath &P, bool parallel_build)
 {
   FASTUIDRAWassert(point::number_offset_types < FASTUIDRAW_MAX_VALUE_FROM_NUM_BITS(point::offset_type_num_bits));
-  m_d = FASTUIDRAWnew StrokedPathPrivate(P);
+  m_d = FASTUIDRAWnew StrokedPathPrivate(P, parallel_build);
 }
 
 fastuidraw::StrokedPath::
@@ -25,6 +25,9 @@
 #include <fastuidraw/tessellated_path.hpp>
 #include "private/util_private.hpp"
 #include "private/path_util_private.hpp"
+#include "private/tessellated_path_cache_private.hpp"
+#include "private/path_tessellation_state.hpp"
+#include "private/task_queue.hpp"
 
 namespace
 {
@@ -271,7 +274,68 @@ namespace
     std::vector<fastuidraw::vec2> m_poly;
     std::vector<fastuidraw::vec2> m_poly_prime;
     std::vector<fastuidraw::vec2> m_poly_prime_prime;
-    fastuidraw::vecN<std::vector<fastuidraw::vec2>, 2> m_work_room;
+
+    /* coefficients in the power basis of the curve and its
+       derivative, i.e. p(t) = sum(0 <= k <= 3) t^k m_power[k];
+       only valid if the degree of the curve is at most 3.
+     */
+    fastuidraw::vecN<fastuidraw::vec2, 4> m_power;
+    fastuidraw::vecN<fastuidraw::vec2, 3> m_power_prime;
+  };
+
+  /* Evaluates a cubic (given in the power basis) and its
+     derivative at a batch of uniformly spaced times. The
+     batch is stored as a structure of arrays and the loops
+     have no dependencies between iterations so that the
+     compiler can vectorize them.
+   */
+  class BezierBatchEvaluator
+  {
+  public:
+    enum
+      {
+        batch_size = 8
+      };
+
+    BezierBatchEvaluator(const BezierPrivate &d)
+    {
+      for(unsigned int k = 0; k < 4; ++k)
+        {
+          m_ax[k] = d.m_power[k].x();
+          m_ay[k] = d.m_power[k].y();
+        }
+      for(unsigned int k = 0; k < 3; ++k)
+        {
+          m_bx[k] = d.m_power_prime[k].x();
+          m_by[k] = d.m_power_prime[k].y();
+        }
+    }
+
+    void
+    evaluate(unsigned int start, float delta_t)
+    {
+      for(unsigned int k = 0; k < batch_size; ++k)
+        {
+          m_t[k] = static_cast<float>(start + k) * delta_t;
+        }
+
+      for(unsigned int k = 0; k < batch_size; ++k)
+        {
+          float t(m_t[k]);
+          m_px[k] = ((m_ax[3] * t + m_ax[2]) * t + m_ax[1]) * t + m_ax[0];
+          m_py[k] = ((m_ay[3] * t + m_ay[2]) * t + m_ay[1]) * t + m_ay[0];
+          m_tx[k] = (m_bx[2] * t + m_bx[1]) * t + m_bx[0];
+          m_ty[k] = (m_by[2] * t + m_by[1]) * t + m_by[0];
+        }
+    }
+
+    float m_t[batch_size];
+    float m_px[batch_size], m_py[batch_size];
+    float m_tx[batch_size], m_ty[batch_size];
+
+  private:
+    float m_ax[4], m_ay[4];
+    float m_bx[3], m_by[3];
   };
 
   class ArcPrivate
@@ -303,10 +367,14 @@ namespace
   {
   public:
     typedef fastuidraw::TessellatedPath TessellatedPath;
-    typedef fastuidraw::reference_counted_ptr<const TessellatedPath> tessellated_path_ref;
+    typedef fastuidraw::detail::PathTessellationState PathTessellationState;
+    typedef fastuidraw::reference_counted_ptr<PathTessellationState> tessellation_state_ref;
+    typedef PathTessellationState::tessellated_path_ref tessellated_path_ref;
+    typedef PathTessellationState::cache_entry_ref cache_entry_ref;
 
     PathPrivate(void):
-      m_tessellation_done(false),
+      m_compact_tessellation_storage(false),
+      m_share_tessellation(false),
       m_start_check_bb(0),
       m_is_flat(true)
     {}
@@ -317,17 +385,44 @@ namespace
     current_contour(void)
     {
       FASTUIDRAWassert(!m_contours.empty());
-      m_tessellation.clear();
-      m_tessellation_done = false;
+      clear_tessellation();
       return m_contours.back();
     }
 
+    void
+    clear_tessellation(void)
+    {
+      m_tessellation_state = nullptr;
+    }
+
+    tessellation_state_ref
+    tessellation_state(const fastuidraw::Path &path);
+
+    /* The methods below are called with the mutex of st locked.
+       fetch_lod() returns the lowest level of detail in st that
+       is fine enough for thresh (constructing the coarsest level
+       of detail if necessary) or nullptr if none is in the
+       cache; fetch_finest_lod() returns the highest level of
+       detail in st; build_lod() constructs the level of detail
+       for thresh, unlocking the mutex of st while doing so.
+     */
+    static
+    tessellated_path_ref
+    fetch_lod(const fastuidraw::Path &path, PathTessellationState *st, float thresh);
+
+    static
+    tessellated_path_ref
+    fetch_finest_lod(PathTessellationState *st);
+
+    static
+    tessellated_path_ref
+    build_lod(const fastuidraw::Path &path, PathTessellationState *st, float thresh);
+
     void
     move_common(const fastuidraw::vec2 &pt)
     {
       bool last_contour_flat;
-      m_tessellation.clear();
-      m_tessellation_done = false;
+      clear_tessellation();
 
       last_contour_flat = m_contours.empty() || m_contours.back()->is_flat();
       m_is_flat = m_is_flat && last_contour_flat;
@@ -337,10 +432,18 @@ namespace
 
     std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > m_contours;
 
-    /* m_tessellation are gauranteed to be sorted from lowest to highest LOD.
+    /* the tessellations of the Path, constructed lazily;
+       the state is shared with copies of the Path and, if
+       m_share_tessellation is true, with the Path objects
+       of the same geometry.
      */
-    std::vector<tessellated_path_ref> m_tessellation;
-    bool m_tessellation_done;
+    tessellation_state_ref m_tessellation_state;
+
+    /* value for TessellationParams::m_compact_storage of the
+       TessellatedPath objects made by Path::tessellation().
+     */
+    bool m_compact_tessellation_storage;
+    bool m_share_tessellation;
 
     /* m_start_check_bb gives the index into m_contours that
        have not had their bounding box absorbed into
@@ -349,11 +452,56 @@ namespace
     unsigned int m_start_check_bb;
     fastuidraw::vec2 m_max_bb, m_min_bb;
     bool m_is_flat;
+
+    /* the const methods of Path lazily create the tessellations
+       and the bounding box, the mutexes allow for them to be
+       called from several threads at the same time.
+     */
+    mutable fastuidraw::mutex m_tessellation_mutex;
+    mutable fastuidraw::mutex m_bb_mutex;
+  };
+
+  /* A PendingTessellation is the task that constructs on
+     a background thread the level of detail requested by
+     Path::tessellation_no_wait().
+   */
+  class PendingTessellation:
+    public fastuidraw::reference_counted<PendingTessellation>::default_base
+  {
+  public:
+    PendingTessellation(const fastuidraw::Path &path,
+                        const PathPrivate::tessellation_state_ref &st,
+                        float thresh):
+      m_path(path),
+      m_state(st),
+      m_thresh(thresh)
+    {
+      /* m_path shares its contours with path, which is only
+         safe because they are all ended and thus never change
+         again, see Path::tessellation_no_wait().
+       */
+      FASTUIDRAWassert(m_path.number_contours() == 0
+                       || m_path.contour(m_path.number_contours() - 1)->ended());
+    }
+
+    void
+    run(void)
+    {
+      m_path.tessellation(m_thresh);
+
+      fastuidraw::autolock_mutex m(m_state->m_mutex);
+      m_state->m_scheduled = false;
+    }
+
+  private:
+    fastuidraw::Path m_path;
+    PathPrivate::tessellation_state_ref m_state;
+    float m_thresh;
   };
 
   inline
   bool
-  reverse_compare_curve_distance_thresh(const PathPrivate::tessellated_path_ref &lhs,
+  reverse_compare_curve_distance_thresh(const PathPrivate::cache_entry_ref &lhs,
                                         float rhs)
   {
     return lhs->effective_curve_distance_threshhold() > rhs;
@@ -744,8 +892,29 @@ init(void)
   BC.prepare_bernstein(m_poly_prime);
   BC.prepare_bernstein(m_poly_prime_prime);
 
-  m_work_room[0].resize(m_poly.size());
-  m_work_room[1].resize(m_poly.size());
+  /* the power basis coefficients are given by
+       m_power[k] = C(n, k) * D^k p(0)
+     where D^k is the k'th forward difference of
+     the (original) control points.
+   */
+  m_power = fastuidraw::vecN<fastuidraw::vec2, 4>(fastuidraw::vec2(0.0f, 0.0f));
+  m_power_prime = fastuidraw::vecN<fastuidraw::vec2, 3>(fastuidraw::vec2(0.0f, 0.0f));
+  if(degree <= 3)
+    {
+      std::vector<fastuidraw::vec2> diff(m_start_region.m_pts);
+      for(unsigned int k = 0; k <= degree; ++k)
+        {
+          m_power[k] = BC[k] * diff[0];
+          for(unsigned int j = 0; j + k < degree; ++j)
+            {
+              diff[j] = diff[j + 1] - diff[j];
+            }
+        }
+      for(unsigned int k = 0; k < 3; ++k)
+        {
+          m_power_prime[k] = static_cast<float>(k + 1) * m_power[k + 1];
+        }
+    }
 }
 
 ////////////////////////////////////////////
@@ -796,6 +965,13 @@ end_pt(void) const
   return d->m_end;
 }
 
+bool
+fastuidraw::PathContour::interpolator_base::
+geometry_values(c_array<const float>*) const
+{
+  return false;
+}
+
 //////////////////////////////////////////////
 // fastuidraw::PathContour::interpolator_generic methods
 unsigned int
@@ -940,11 +1116,14 @@ tessellate(tessellated_region *in_region,
   newA = FASTUIDRAWnew BezierTessRegion(in_region_casted, true);
   newB = FASTUIDRAWnew BezierTessRegion(in_region_casted, false);
 
-  c_array<vec2> dst, src;
-  src = make_c_array(in_region_casted->m_pts);
+  /* the splitting is done in place on a copy of the region's
+     points; the bezier object is shared across threads, so
+     it cannot hold the scratch space.
+   */
+  std::vector<vec2> work(in_region_casted->m_pts);
 
-  newA->m_pts.push_back(src.front());
-  newB->m_pts.push_back(src.back());
+  newA->m_pts.push_back(work.front());
+  newB->m_pts.push_back(work.back());
 
   /* For a Bezier curve, given by points p(0), .., p(n),
      and a time 0 <= t <= 1, De Casteljau's algorithm is
@@ -961,16 +1140,14 @@ tessellate(tessellated_region *in_region,
          the curve evaluated at t is given by q(n, 0).
      We use t = 0.5 because we are always doing mid-point cutting.
    */
-  for(unsigned int i = 0, endi = src.size(), sz = endi - 1; sz > 0 && i < endi; ++i, --sz)
+  for(unsigned int sz = work.size() - 1; sz > 0; --sz)
     {
-      dst = make_c_array(d->m_work_room[i & 1]).sub_array(0, sz);
-      for(unsigned int j = 0; j < dst.size(); ++j)
+      for(unsigned int j = 0; j < sz; ++j)
         {
-          dst[j] = 0.5f * src[j] + 0.5f * src[j + 1];
+          work[j] = 0.5f * work[j] + 0.5f * work[j + 1];
         }
-      newA->m_pts.push_back(dst.front());
-      newB->m_pts.push_back(dst.back());
-      src = dst;
+      newA->m_pts.push_back(work[0]);
+      newB->m_pts.push_back(work[sz - 1]);
     }
   std::reverse(newB->m_pts.begin(), newB->m_pts.end());
 
@@ -984,6 +1161,80 @@ tessellate(tessellated_region *in_region,
   *out_effective_curve_distance = fastuidraw::t_max(newA->compute_curve_distance(), newB->compute_curve_distance());
 }
 
+unsigned int
+fastuidraw::PathContour::bezier::
+produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
+                     c_array<TessellatedPath::point> out_data,
+                     float *out_effective_curve_distance,
+                     float *out_effective_curvature) const
+{
+  BezierPrivate *d;
+  d = static_cast<BezierPrivate*>(m_d);
+
+  /* For quadratic and cubic curves with distance tessellation,
+     the number of segments needed is computed directly from the
+     control points and the curve is evaluated at uniform times,
+     instead of recursively subdividing the curve. Curvature
+     tessellation and higher degree curves use the recursive
+     tessellator.
+   */
+  if(tess_params.m_curvature_tessellation
+     || d->m_poly.size() < 3 || d->m_poly.size() > 4)
+    {
+      return interpolator_generic::produce_tessellation(tess_params, out_data,
+                                                        out_effective_curve_distance,
+                                                        out_effective_curvature);
+    }
+
+  c_array<const vec2> pts(make_c_array(d->m_start_region.m_pts));
+  unsigned int num_segs;
+  float delta_t, curvature(0.0f);
+  BezierBatchEvaluator eval(*d);
+
+  num_segs = detail::number_segments_for_tessellation(pts, tess_params.m_threshhold);
+  num_segs = t_max(1u, t_min(num_segs, tess_params.m_max_segments));
+  FASTUIDRAWassert(num_segs + 1 <= out_data.size());
+
+  delta_t = 1.0f / static_cast<float>(num_segs);
+  for(unsigned int i = 0; i <= num_segs; i += BezierBatchEvaluator::batch_size)
+    {
+      unsigned int cnt;
+
+      eval.evaluate(i, delta_t);
+      cnt = t_min(static_cast<unsigned int>(BezierBatchEvaluator::batch_size), num_segs + 1 - i);
+      for(unsigned int k = 0; k < cnt; ++k)
+        {
+          out_data[i + k].m_p = vec2(eval.m_px[k], eval.m_py[k]);
+          out_data[i + k].m_p_t = vec2(eval.m_tx[k], eval.m_ty[k]);
+        }
+    }
+
+  /* enforce start and end point values */
+  out_data[0].m_p = start_pt();
+  out_data[num_segs].m_p = end_pt();
+
+  /* distance values along the edge and the largest angle
+     the tangent turns across a single segment.
+   */
+  out_data[0].m_distance_from_edge_start = 0.0f;
+  for(unsigned int i = 1; i <= num_segs; ++i)
+    {
+      const vec2 &a(out_data[i - 1].m_p_t);
+      const vec2 &b(out_data[i].m_p_t);
+      float cross;
+
+      out_data[i].m_distance_from_edge_start = (out_data[i].m_p - out_data[i - 1].m_p).magnitude()
+        + out_data[i - 1].m_distance_from_edge_start;
+
+      cross = a.x() * b.y() - a.y() * b.x();
+      curvature = t_max(curvature, std::atan2(t_abs(cross), dot(a, b)));
+    }
+
+  *out_effective_curve_distance = detail::curve_distance_for_tessellation(pts, num_segs);
+  *out_effective_curvature = curvature;
+  return num_segs + 1;
+}
+
 fastuidraw::PathContour::interpolator_base*
 fastuidraw::PathContour::bezier::
 deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
@@ -991,6 +1242,16 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
   return FASTUIDRAWnew bezier(*this, prev);
 }
 
+bool
+fastuidraw::PathContour::bezier::
+geometry_values(c_array<const float> *out_values) const
+{
+  BezierPrivate *d;
+  d = static_cast<BezierPrivate*>(m_d);
+  *out_values = make_c_array(d->m_start_region.m_pts).reinterpret_pointer<const float>();
+  return true;
+}
+
 //////////////////////////////////////
 // fastuidraw::PathContour::flat methods
 bool
@@ -1031,6 +1292,14 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
   return FASTUIDRAWnew flat(prev, end_pt());
 }
 
+bool
+fastuidraw::PathContour::flat::
+geometry_values(c_array<const float> *out_values) const
+{
+  *out_values = c_array<const float>();
+  return true;
+}
+
 void
 fastuidraw::PathContour::flat::
 approximate_bounding_box(vec2 *out_min_bb, vec2 *out_max_bb) const
@@ -1184,6 +1453,20 @@ deep_copy(const reference_counted_ptr<const interpolator_base> &prev) const
   return FASTUIDRAWnew arc(*this, prev);
 }
 
+bool
+fastuidraw::PathContour::arc::
+geometry_values(c_array<const float> *out_values) const
+{
+  ArcPrivate *d;
+  d = static_cast<ArcPrivate*>(m_d);
+
+  /* together with the end points, the signed angle
+     of the arc determines the arc.
+   */
+  *out_values = c_array<const float>(&d->m_angle_speed, 1);
+  return true;
+}
+
 ///////////////////////////////////
 // fastuidraw::PathContour methods
 fastuidraw::PathContour::
@@ -1506,23 +1789,197 @@ approximate_bounding_box(vec2 *out_min_bb, vec2 *out_max_bb) const
 PathPrivate::
 PathPrivate(const PathPrivate &obj):
   m_contours(obj.m_contours),
-  m_tessellation(obj.m_tessellation),
-  m_tessellation_done(obj.m_tessellation_done),
-  m_start_check_bb(obj.m_start_check_bb),
-  m_max_bb(obj.m_max_bb),
-  m_min_bb(obj.m_min_bb),
   m_is_flat(obj.m_is_flat)
 {
+  /* another thread may be filling the caches of obj
+   */
+  {
+    fastuidraw::autolock_mutex m(obj.m_tessellation_mutex);
+    m_tessellation_state = obj.m_tessellation_state;
+    m_compact_tessellation_storage = obj.m_compact_tessellation_storage;
+    m_share_tessellation = obj.m_share_tessellation;
+  }
+
+  {
+    fastuidraw::autolock_mutex m(obj.m_bb_mutex);
+    m_start_check_bb = obj.m_start_check_bb;
+    m_max_bb = obj.m_max_bb;
+    m_min_bb = obj.m_min_bb;
+  }
+
   /* if the last contour is not ended, we need to do a
      deep copy on it.
    */
-  if(!m_contours.back()->ended())
+  if(!m_contours.empty() && !m_contours.back()->ended())
     {
       m_contours.back() = m_contours.back()->deep_copy();
       m_is_flat = m_is_flat && m_contours.back()->is_flat();
     }
 }
 
+PathPrivate::tessellation_state_ref
+PathPrivate::
+tessellation_state(const fastuidraw::Path &path)
+{
+  fastuidraw::autolock_mutex m(m_tessellation_mutex);
+  if(!m_tessellation_state)
+    {
+      fastuidraw::detail::PathGeometryKey key;
+
+      if(m_share_tessellation && key.set(path, m_compact_tessellation_storage))
+        {
+          m_tessellation_state = PathTessellationState::fetch_shared(key);
+        }
+      else
+        {
+          m_tessellation_state = PathTessellationState::create(m_compact_tessellation_storage);
+        }
+    }
+  return m_tessellation_state;
+}
+
+PathPrivate::tessellated_path_ref
+PathPrivate::
+fetch_lod(const fastuidraw::Path &path, PathTessellationState *st, float thresh)
+{
+  if(!st->m_base)
+    {
+      TessellatedPath::TessellationParams params;
+      params.compact_storage(st->m_compact_storage);
+      st->m_base = FASTUIDRAWnew TessellatedPath(path, params);
+    }
+
+  if(thresh <= 0.0f || path.is_flat()
+     || st->m_base->effective_curve_distance_threshhold() <= thresh)
+    {
+      return st->m_base;
+    }
+
+  /* take the lowest LOD that is fine enough and still in the
+     cache; entries that were evicted are dropped as they are
+     found, which keeps m_lods sorted.
+   */
+  std::vector<cache_entry_ref>::iterator iter;
+  iter = std::lower_bound(st->m_lods.begin(),
+                          st->m_lods.end(),
+                          thresh,
+                          reverse_compare_curve_distance_thresh);
+  while(iter != st->m_lods.end())
+    {
+      tessellated_path_ref ref;
+
+      ref = (*iter)->fetch();
+      if(ref)
+        {
+          return ref;
+        }
+      iter = st->m_lods.erase(iter);
+    }
+
+  if(st->m_done)
+    {
+      /* tapped out: the highest LOD is as good as it gets */
+      tessellated_path_ref finest(fetch_finest_lod(st));
+
+      if(finest != st->m_base)
+        {
+          return finest;
+        }
+      st->m_done = false;
+    }
+
+  return nullptr;
+}
+
+PathPrivate::tessellated_path_ref
+PathPrivate::
+fetch_finest_lod(PathTessellationState *st)
+{
+  FASTUIDRAWassert(st->m_base);
+  while(!st->m_lods.empty())
+    {
+      tessellated_path_ref ref;
+
+      ref = st->m_lods.back()->fetch();
+      if(ref)
+        {
+          return ref;
+        }
+      st->m_lods.pop_back();
+    }
+  return st->m_base;
+}
+
+PathPrivate::tessellated_path_ref
+PathPrivate::
+build_lod(const fastuidraw::Path &path, PathTessellationState *st, float thresh)
+{
+  using namespace fastuidraw;
+
+  tessellated_path_ref base_ref, ref;
+  TessellatedPath::TessellationParams params;
+  float target, last_tess, scale;
+
+  FASTUIDRAWassert(!st->m_building);
+
+  /* Tessellate directly to the largest power of two that
+     is no more than thresh (so that nearby thresholds share
+     the same tessellation) instead of halving the threshold
+     one LOD at a time. The segment count needed to reach
+     a curve distance grows as the square root of the ratio of
+     the distances, which gives the initial guess (from the
+     coarsest LOD) for the maximum number of segments; it is
+     only doubled if an edge still hits that limit.
+   */
+  base_ref = st->m_base;
+  target = std::exp2(std::floor(std::log2(thresh)));
+  scale = std::ceil(t_sqrt(base_ref->effective_curve_distance_threshhold() / target));
+  params
+    .compact_storage(st->m_compact_storage)
+    .curve_distance_tessellate(target)
+    .max_segments(2u * t_max(base_ref->max_segments(), 1u) * static_cast<unsigned int>(t_min(scale, 1024.0f)));
+
+  /* construct without holding the lock so that readers
+     (in particular Path::tessellation_no_wait()) are not
+     blocked; m_building makes other threads that need a
+     new LOD wait instead of constructing the same one.
+   */
+  st->m_building = true;
+  st->m_mutex.unlock();
+
+  last_tess = base_ref->effective_curve_distance_threshhold();
+  ref = FASTUIDRAWnew TessellatedPath(path, params);
+  while(ref->effective_curve_distance_threshhold() > target
+        && ref->max_segments() >= params.m_max_segments
+        && ref->effective_curve_distance_threshhold() < last_tess)
+    {
+      last_tess = ref->effective_curve_distance_threshhold();
+      params.m_max_segments *= 2;
+      ref = FASTUIDRAWnew TessellatedPath(path, params);
+    }
+
+  st->m_mutex.lock();
+  st->m_building = false;
+  st->m_cond.notify_all();
+
+  /* if the tessellation could not get under the threshold
+     then more segments do not help and we are tapped out.
+   */
+  st->m_done = (ref->effective_curve_distance_threshhold() > thresh);
+  if(ref->effective_curve_distance_threshhold() >= base_ref->effective_curve_distance_threshhold())
+    {
+      return base_ref;
+    }
+
+  std::vector<cache_entry_ref>::iterator iter;
+  iter = std::lower_bound(st->m_lods.begin(),
+                          st->m_lods.end(),
+                          ref->effective_curve_distance_threshhold(),
+                          reverse_compare_curve_distance_thresh);
+  st->m_lods.insert(iter, detail::TessellatedPathCacheEntry::create(ref));
+  return ref;
+}
+
 /////////////////////////////////////////
 // fastuidraw::Path methods
 fastuidraw::Path::
@@ -1583,9 +2040,8 @@ clear(void)
 {
   PathPrivate *d;
   d = static_cast<PathPrivate*>(m_d);
-  d->m_tessellation.clear();
+  d->clear_tessellation();
   d->m_contours.clear();
-  d->m_tessellation_done = false;
   d->m_start_check_bb = 0u;
 }
 
@@ -1605,7 +2061,7 @@ add_contour(const reference_counted_ptr<const PathContour> &pcontour)
   contour = pcontour.const_cast_ptr<PathContour>();
   d->m_is_flat = d->m_is_flat && contour->is_flat();
 
-  d->m_tessellation.clear();
+  d->clear_tessellation();
   if(d->m_contours.empty() || d->m_contours.back()->ended())
     {
       d->m_contours.push_back(contour);
@@ -1631,7 +2087,7 @@ add_contours(const Path &path)
 
   if(d != pd && !pd->m_contours.empty())
     {
-      d->m_tessellation.clear();
+      d->clear_tessellation();
       d->m_contours.reserve(d->m_contours.size() + pd->m_contours.size());
       d->m_is_flat = d->m_is_flat && pd->m_is_flat;
 
@@ -1700,93 +2156,194 @@ operator<<(const fastuidraw::vec2 &pt)
   return *this;
 }
 
-const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
 fastuidraw::Path::
 tessellation(void) const
 {
   return tessellation(-1.0f);
 }
 
-const fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>&
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
 fastuidraw::Path::
 tessellation(float thresh) const
 {
   PathPrivate *d;
+  PathPrivate::tessellation_state_ref st;
+  PathPrivate::tessellated_path_ref ref;
+
   d = static_cast<PathPrivate*>(m_d);
+  st = d->tessellation_state(*this);
 
-  if(d->m_tessellation.empty())
+  fastuidraw::autolock_mutex m(st->m_mutex);
+  ref = PathPrivate::fetch_lod(*this, st.get(), thresh);
+  while(!ref)
     {
-      PathPrivate::tessellated_path_ref ref;
-      TessellatedPath::TessellationParams params;
-      ref = FASTUIDRAWnew TessellatedPath(*this, params);
-      d->m_tessellation.push_back(ref);
+      if(st->m_building)
+        {
+          /* another thread is constructing a level of detail,
+             it may be the one needed.
+           */
+          st->m_cond.wait(st->m_mutex);
+        }
+      else
+        {
+          return PathPrivate::build_lod(*this, st.get(), thresh);
+        }
+      ref = PathPrivate::fetch_lod(*this, st.get(), thresh);
     }
+  return ref;
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+fastuidraw::Path::
+tessellation_no_wait(float thresh, float slack, bool schedule) const
+{
+  PathPrivate *d;
+  PathPrivate::tessellation_state_ref st;
+
+  d = static_cast<PathPrivate*>(m_d);
+  st = d->tessellation_state(*this);
+
+  {
+    fastuidraw::autolock_mutex m(st->m_mutex);
+    PathPrivate::tessellated_path_ref ref, finest;
+    float finest_thresh;
+
+    ref = PathPrivate::fetch_lod(*this, st.get(), thresh);
+    if(ref)
+      {
+        return ref;
+      }
+
+    finest = PathPrivate::fetch_finest_lod(st.get());
+    finest_thresh = finest->effective_curve_distance_threshhold();
+    if(finest_thresh <= slack * thresh)
+      {
+        return finest;
+      }
+
+    /* the task shares the contours of this Path; a contour
+       that is not ended is changed as points are added to it,
+       so the tessellation is not made in the background while
+       the last contour is open.
+     */
+    if(!schedule || st->m_scheduled
+       || (!d->m_contours.empty() && !d->m_contours.back()->ended()))
+      {
+        return nullptr;
+      }
+    st->m_scheduled = true;
+  }
+
+  /* the task holds a copy of this Path (which shares st and
+     the contours, all of which are ended and never change
+     again) so that it does not matter if this Path is changed
+     or destroyed before the task runs.
+   */
+  reference_counted_ptr<PendingTessellation> pending;
+  pending = FASTUIDRAWnew PendingTessellation(*this, st, thresh);
+  detail::TaskQueue::background().add([pending]() { pending->run(); });
+  return nullptr;
+}
 
-  if(thresh <= 0.0f || is_flat())
+fastuidraw::Path&
+fastuidraw::Path::
+compact_tessellation_storage(bool v)
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
+
+  fastuidraw::autolock_mutex m(d->m_tessellation_mutex);
+  if(v != d->m_compact_tessellation_storage)
     {
-      return d->m_tessellation.front();
+      d->m_compact_tessellation_storage = v;
+      d->clear_tessellation();
     }
+  return *this;
+}
 
-  if(d->m_tessellation.back()->effective_curve_distance_threshhold() <= thresh)
-    {
-      std::vector<PathPrivate::tessellated_path_ref>::const_iterator iter;
-      iter = std::lower_bound(d->m_tessellation.begin(),
-                              d->m_tessellation.end(),
-                              thresh,
-                              reverse_compare_curve_distance_thresh);
+bool
+fastuidraw::Path::
+compact_tessellation_storage(void) const
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
 
-      FASTUIDRAWassert(iter != d->m_tessellation.end());
-      FASTUIDRAWassert(*iter);
-      FASTUIDRAWassert((*iter)->effective_curve_distance_threshhold() <= thresh);
-      return *iter;
-    }
-  else
+  fastuidraw::autolock_mutex m(d->m_tessellation_mutex);
+  return d->m_compact_tessellation_storage;
+}
+
+unsigned int
+fastuidraw::Path::
+number_tessellation_lods(void) const
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
+
+  PathPrivate::tessellation_state_ref st;
+  {
+    fastuidraw::autolock_mutex m(d->m_tessellation_mutex);
+    st = d->m_tessellation_state;
+  }
+
+  if(!st)
     {
-      if(d->m_tessellation_done)
-        {
-          return d->m_tessellation.back();
-        }
+      return 0u;
+    }
 
-      PathPrivate::tessellated_path_ref prev_ref, ref;
-      TessellatedPath::TessellationParams params;
+  fastuidraw::autolock_mutex m(st->m_mutex);
+  return (st->m_base) ?
+    1u + st->m_lods.size() :
+    0u;
+}
 
-      ref = d->m_tessellation.back();
-      params
-        .max_segments(2 * ref->max_segments())
-        .curve_distance_tessellate(ref->effective_curve_distance_threshhold());
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+fastuidraw::Path::
+tessellation_lod(unsigned int I) const
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
 
-      while(!d->m_tessellation_done
-            && ref->effective_curve_distance_threshhold() > thresh)
-        {
-          float last_tess;
+  PathPrivate::tessellation_state_ref st;
+  {
+    fastuidraw::autolock_mutex m(d->m_tessellation_mutex);
+    st = d->m_tessellation_state;
+  }
 
-          params.m_threshhold *= 0.5f;
-          last_tess = ref->effective_curve_distance_threshhold();
-          ref = FASTUIDRAWnew TessellatedPath(*this, params);
-          d->m_tessellation_done = (last_tess <= ref->effective_curve_distance_threshhold());
+  FASTUIDRAWassert(st);
+  fastuidraw::autolock_mutex m(st->m_mutex);
+  FASTUIDRAWassert(st->m_base);
+  FASTUIDRAWassert(I <= st->m_lods.size());
+  return (I == 0) ?
+    st->m_base :
+    st->m_lods[I - 1]->fetch();
+}
 
-          while(!d->m_tessellation_done && ref->effective_curve_distance_threshhold() > params.m_threshhold)
-            {
-              params.m_max_segments *= 2;
-              last_tess = ref->effective_curve_distance_threshhold();
-              ref = FASTUIDRAWnew TessellatedPath(*this, params);
-              d->m_tessellation_done = (last_tess <= ref->effective_curve_distance_threshhold());
-            }
+fastuidraw::Path&
+fastuidraw::Path::
+share_tessellation(bool v)
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
 
-          if(d->m_tessellation_done)
-            {
-              /*
-              std::cout << "Tapped out at (max_segs = "
-                        << ref->max_segments() << ", tess_factor = "
-                        << ref->effective_curve_distance_threshhold()
-                        << ", num_points = " << ref->point_data().size()
-                        << ")\n";
-              */
-            }
-          d->m_tessellation.push_back(ref);
-        }
-      return d->m_tessellation.back();
+  fastuidraw::autolock_mutex m(d->m_tessellation_mutex);
+  if(v != d->m_share_tessellation)
+    {
+      d->m_share_tessellation = v;
+      d->clear_tessellation();
     }
+  return *this;
+}
+
+bool
+fastuidraw::Path::
+share_tessellation(void) const
+{
+  PathPrivate *d;
+  d = static_cast<PathPrivate*>(m_d);
+
+  fastuidraw::autolock_mutex m(d->m_tessellation_mutex);
+  return d->m_share_tessellation;
 }
 
 bool
@@ -1796,6 +2353,7 @@ approximate_bounding_box(vec2 *out_min_bb, vec2 *out_max_bb) const
   PathPrivate *d;
   d = static_cast<PathPrivate*>(m_d);
 
+  fastuidraw::autolock_mutex m(d->m_bb_mutex);
   bool assigned_value(d->m_start_check_bb != 0u);
   for(unsigned endi = d->m_contours.size();
       d->m_start_check_bb < endi && d->m_contours[d->m_start_check_bb]->ended();
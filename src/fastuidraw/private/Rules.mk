@@ -4,7 +4,9 @@ dirstack_$(sp)	:= $(d)
 d		:= $(dir)
 # End standard header
 
-FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, interval_allocator.cpp path_util_private.cpp clip.cpp int_path.cpp)
+FASTUIDRAW_PRIVATE_SOURCES += $(call filelist, interval_allocator.cpp path_util_private.cpp clip.cpp int_path.cpp \
+	bulk_copy.cpp task_queue.cpp sweep_triangulator.cpp \
+	path_tessellation_state.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
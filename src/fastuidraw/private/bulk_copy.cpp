@@ -0,0 +1,221 @@
+/*!
+ * \file bulk_copy.cpp
+ * \brief file bulk_copy.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <cstring>
+#include "bulk_copy.hpp"
+#include "util_private.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FASTUIDRAW_BULK_COPY_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+  typedef void (*copy_indices_fptr)(fastuidraw::PainterIndex *dst,
+                                    const fastuidraw::PainterIndex *src,
+                                    unsigned int count, uint32_t offset);
+
+  typedef void (*copy_bytes_fptr)(void *dst, const void *src, size_t num_bytes);
+
+  /* copies smaller than this are done with memcpy; streaming
+     stores only pay off when the destination is not read back
+     soon and the copy is large enough to amortize the fence.
+   */
+  const size_t non_temporal_threshold = 16 * 1024;
+
+  void
+  copy_indices_scalar(fastuidraw::PainterIndex *dst,
+                      const fastuidraw::PainterIndex *src,
+                      unsigned int count, uint32_t offset)
+  {
+    for(unsigned int i = 0; i < count; ++i)
+      {
+        dst[i] = src[i] + offset;
+      }
+  }
+
+  void
+  copy_bytes_memcpy(void *dst, const void *src, size_t num_bytes)
+  {
+    std::memcpy(dst, src, num_bytes);
+  }
+
+#ifdef FASTUIDRAW_BULK_COPY_X86
+
+  __attribute__((target("sse2")))
+  void
+  copy_indices_sse2(fastuidraw::PainterIndex *dst,
+                    const fastuidraw::PainterIndex *src,
+                    unsigned int count, uint32_t offset)
+  {
+    __m128i voffset(_mm_set1_epi32(offset));
+    unsigned int i(0);
+
+    for(; i + 4 <= count; i += 4)
+      {
+        __m128i v;
+        v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi32(v, voffset));
+      }
+    copy_indices_scalar(dst + i, src + i, count - i, offset);
+  }
+
+  __attribute__((target("avx2")))
+  void
+  copy_indices_avx2(fastuidraw::PainterIndex *dst,
+                    const fastuidraw::PainterIndex *src,
+                    unsigned int count, uint32_t offset)
+  {
+    __m256i voffset(_mm256_set1_epi32(offset));
+    unsigned int i(0);
+
+    for(; i + 8 <= count; i += 8)
+      {
+        __m256i v;
+        v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_add_epi32(v, voffset));
+      }
+    copy_indices_scalar(dst + i, src + i, count - i, offset);
+  }
+
+  /* num_bytes must be a multiple of 16 and dst must be
+     16-byte aligned.
+   */
+  __attribute__((target("sse2")))
+  void
+  copy_bytes_stream_sse2(void *pdst, const void *psrc, size_t num_bytes)
+  {
+    __m128i *dst(static_cast<__m128i*>(pdst));
+    const __m128i *src(static_cast<const __m128i*>(psrc));
+    size_t count(num_bytes / sizeof(__m128i));
+
+    for(size_t i = 0; i < count; ++i)
+      {
+        _mm_stream_si128(dst + i, _mm_loadu_si128(src + i));
+      }
+    _mm_sfence();
+  }
+
+  /* num_bytes must be a multiple of 16 and dst must be
+     16-byte aligned.
+   */
+  __attribute__((target("avx2")))
+  void
+  copy_bytes_stream_avx2(void *pdst, const void *psrc, size_t num_bytes)
+  {
+    char *dst(static_cast<char*>(pdst));
+    const char *src(static_cast<const char*>(psrc));
+
+    /* get dst to be 32-byte aligned */
+    if(reinterpret_cast<uintptr_t>(dst) & 31u)
+      {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+        dst += 16;
+        src += 16;
+        num_bytes -= 16;
+      }
+
+    for(; num_bytes >= 32; num_bytes -= 32, dst += 32, src += 32)
+      {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+      }
+
+    if(num_bytes != 0)
+      {
+        FASTUIDRAWassert(num_bytes == 16);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+      }
+    _mm_sfence();
+  }
+
+#endif
+
+  class BulkCopyImplementation
+  {
+  public:
+    BulkCopyImplementation(void):
+      m_copy_indices(copy_indices_scalar),
+      m_stream_bytes(copy_bytes_memcpy)
+    {
+#ifdef FASTUIDRAW_BULK_COPY_X86
+      __builtin_cpu_init();
+      if(__builtin_cpu_supports("avx2"))
+        {
+          m_copy_indices = copy_indices_avx2;
+          m_stream_bytes = copy_bytes_stream_avx2;
+        }
+      else if(__builtin_cpu_supports("sse2"))
+        {
+          m_copy_indices = copy_indices_sse2;
+          m_stream_bytes = copy_bytes_stream_sse2;
+        }
+#endif
+    }
+
+    static
+    const BulkCopyImplementation&
+    get(void)
+    {
+      static BulkCopyImplementation R;
+      return R;
+    }
+
+    copy_indices_fptr m_copy_indices;
+    copy_bytes_fptr m_stream_bytes;
+  };
+}
+
+void
+fastuidraw::detail::
+copy_indices_with_offset(c_array<PainterIndex> dst,
+                         c_array<const PainterIndex> src,
+                         uint32_t offset)
+{
+  FASTUIDRAWassert(dst.size() == src.size());
+  if(dst.empty())
+    {
+      return;
+    }
+  BulkCopyImplementation::get().m_copy_indices(dst.c_ptr(), src.c_ptr(), dst.size(), offset);
+}
+
+void
+fastuidraw::detail::
+copy_attributes(c_array<PainterAttribute> dst,
+                c_array<const PainterAttribute> src)
+{
+  size_t num_bytes;
+
+  FASTUIDRAWstatic_assert(sizeof(PainterAttribute) % 16 == 0);
+  FASTUIDRAWassert(dst.size() == src.size());
+
+  num_bytes = sizeof(PainterAttribute) * dst.size();
+  if(num_bytes >= non_temporal_threshold
+     && (reinterpret_cast<uintptr_t>(dst.c_ptr()) & 15u) == 0)
+    {
+      BulkCopyImplementation::get().m_stream_bytes(dst.c_ptr(), src.c_ptr(), num_bytes);
+    }
+  else if(num_bytes > 0)
+    {
+      copy_bytes_memcpy(dst.c_ptr(), src.c_ptr(), num_bytes);
+    }
+}
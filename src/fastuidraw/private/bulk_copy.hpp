@@ -0,0 +1,49 @@
+/*!
+ * \file bulk_copy.hpp
+ * \brief file bulk_copy.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/painter/painter_attribute.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* Sets dst[i] = src[i] + offset; the implementation (AVX2,
+       SSE2 or scalar) is chosen at run time from the features
+       of the CPU. The arrays must be the same size and must
+       not overlap.
+     */
+    void
+    copy_indices_with_offset(c_array<PainterIndex> dst,
+                             c_array<const PainterIndex> src,
+                             uint32_t offset);
+
+    /* Copies src to dst. Large copies whose destination is
+       suitably aligned are done with non-temporal stores so
+       that data written to (typically write-combined) mapped
+       buffer memory does not evict the caches. The arrays must
+       be the same size and must not overlap.
+     */
+    void
+    copy_attributes(c_array<PainterAttribute> dst,
+                    c_array<const PainterAttribute> src);
+  }
+}
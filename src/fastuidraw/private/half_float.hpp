@@ -0,0 +1,137 @@
+/*!
+ * \file half_float.hpp
+ * \brief file half_float.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <cstring>
+#include <stdint.h>
+#include <fastuidraw/util/vecN.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* Convert a 32-bit float to IEEE 754 half precision, rounding
+       to nearest; values too large become infinity and values
+       too small become (signed) zero or a denormal.
+     */
+    inline
+    uint16_t
+    float_to_half(float f)
+    {
+      uint32_t x, sign, mant;
+      int exp;
+
+      std::memcpy(&x, &f, sizeof(float));
+      sign = (x >> 16u) & 0x8000u;
+      exp = static_cast<int>((x >> 23u) & 0xFFu);
+      mant = x & 0x7FFFFFu;
+
+      if(exp == 0xFF)
+        {
+          /* infinity or NaN */
+          return sign | 0x7C00u | (mant ? 0x200u : 0u);
+        }
+
+      exp = exp - 127 + 15;
+      if(exp >= 0x1F)
+        {
+          return sign | 0x7C00u;
+        }
+
+      if(exp <= 0)
+        {
+          uint32_t shift;
+
+          if(exp < -10)
+            {
+              return sign;
+            }
+          mant |= 0x800000u;
+          shift = static_cast<uint32_t>(14 - exp);
+          /* round to nearest */
+          mant = (mant + (1u << (shift - 1u))) >> shift;
+          return sign | mant;
+        }
+
+      /* round to nearest, a carry into the exponent is correct */
+      return sign | ((static_cast<uint32_t>(exp) << 10u) + ((mant + 0x1000u) >> 13u));
+    }
+
+    inline
+    float
+    half_to_float(uint16_t h)
+    {
+      uint32_t sign, exp, mant, x;
+      float f;
+
+      sign = static_cast<uint32_t>(h & 0x8000u) << 16u;
+      exp = (h >> 10u) & 0x1Fu;
+      mant = h & 0x3FFu;
+
+      if(exp == 0x1F)
+        {
+          x = sign | 0x7F800000u | (mant << 13u);
+        }
+      else if(exp == 0)
+        {
+          if(mant == 0)
+            {
+              x = sign;
+            }
+          else
+            {
+              /* denormal: normalize it */
+              exp = 127 - 15 + 1;
+              while((mant & 0x400u) == 0)
+                {
+                  mant <<= 1u;
+                  --exp;
+                }
+              mant &= 0x3FFu;
+              x = sign | (exp << 23u) | (mant << 13u);
+            }
+        }
+      else
+        {
+          x = sign | ((exp - 15 + 127) << 23u) | (mant << 13u);
+        }
+
+      std::memcpy(&f, &x, sizeof(float));
+      return f;
+    }
+
+    /* pack a vec2 as two half precision values, x in the low 16 bits */
+    inline
+    uint32_t
+    pack_half2(const vec2 &v)
+    {
+      return static_cast<uint32_t>(float_to_half(v.x()))
+        | (static_cast<uint32_t>(float_to_half(v.y())) << 16u);
+    }
+
+    inline
+    vec2
+    unpack_half2(uint32_t v)
+    {
+      return vec2(half_to_float(static_cast<uint16_t>(v & 0xFFFFu)),
+                  half_to_float(static_cast<uint16_t>(v >> 16u)));
+    }
+  }
+}
@@ -35,6 +35,7 @@
 #include <iterator>
 #include <set>
 #include "int_path.hpp"
+#include "task_queue.hpp"
 #include "util_private_ostream.hpp"
 
 namespace
@@ -338,6 +339,17 @@ namespace
                                const IntBezierCurve::transformation<int> &tr,
                                std::vector<std::vector<solution_pt> > *out_value) const;
 
+    /* as compute_lines_intersection() above, but only for the
+       lines c with begin <= c < end; out_value is still indexed
+       by c and the other lines are left untouched.
+     */
+    void
+    compute_lines_intersection(enum coordinate_type line_type,
+                               int step, int begin, int end,
+                               uint32_t solution_types_accepted,
+                               const IntBezierCurve::transformation<int> &tr,
+                               std::vector<std::vector<solution_pt> > *out_value) const;
+
   private:
     template<typename T>
     class MultiplierFunctor
@@ -481,6 +493,20 @@ namespace
     typedef fastuidraw::ivec2 ivec2;
     typedef fastuidraw::vec2 vec2;
 
+    enum
+      {
+        /* the lines along which the distances are computed are
+           handed in blocks of this many lines to the tasks of
+           fastuidraw::detail::for_each_block()
+         */
+        lines_per_task = 16,
+
+        /* the distance values are computed in parallel only if
+           the domain has at least this many points
+         */
+        parallel_point_threshold = 128 * 128
+      };
+
     explicit
     DistanceFieldGenerator(const std::vector<IntContour> &p):
       m_contours(p)
@@ -493,6 +519,9 @@ namespace
         x(i) = step.x() * i
         y(j) = step.y() * j
       One can get translation via using the transformation argument, tr.
+      For large domains, the solves along the fixed lines and the
+      distance updates along them are done in parallel on blocks
+      of lines; the values do not depend on if done in parallel.
      */
     void
     compute_distance_values(const ivec2 &step, const ivec2 &count,
@@ -526,12 +555,26 @@ namespace
     void
     compute_fixed_line_values(const ivec2 &step, const ivec2 &count,
                               const IntBezierCurve::transformation<int> &tr,
+                              bool parallel,
+                              fastuidraw::array2d<distance_value> &dst) const;
+    void
+    compute_fixed_line_values(enum Solver::coordinate_type tp,
+                              std::vector<std::vector<Solver::solution_pt> > &work_room,
+                              const ivec2 &step, const ivec2 &count,
+                              const IntBezierCurve::transformation<int> &tr,
+                              bool parallel,
                               fastuidraw::array2d<distance_value> &dst) const;
+
+    /* computes the values along the fixed lines c with
+       begin <= c < end; only writes to work_room[c] and to
+       the values of the points on those lines.
+     */
     void
     compute_fixed_line_values(enum Solver::coordinate_type tp,
                               std::vector<std::vector<Solver::solution_pt> > &work_room,
                               const ivec2 &step, const ivec2 &count,
                               const IntBezierCurve::transformation<int> &tr,
+                              int begin, int end,
                               fastuidraw::array2d<distance_value> &dst) const;
 
     const std::vector<fastuidraw::detail::IntContour> &m_contours;
@@ -1165,11 +1208,23 @@ compute_lines_intersection(enum coordinate_type tp, int step, int count,
                            uint32_t solution_types_accepted,
                            const IntBezierCurve::transformation<int> &tr,
                            std::vector<std::vector<solution_pt> > *out_value) const
+{
+  FASTUIDRAWassert(out_value->size() == static_cast<unsigned int>(count));
+  compute_lines_intersection(tp, step, 0, count, solution_types_accepted, tr, out_value);
+}
+
+void
+Solver::
+compute_lines_intersection(enum coordinate_type tp, int step, int begin, int end,
+                           uint32_t solution_types_accepted,
+                           const IntBezierCurve::transformation<int> &tr,
+                           std::vector<std::vector<solution_pt> > *out_value) const
 {
   int cstart, cend;
   int fixed_coord(fixed_coordinate(tp));
 
-  FASTUIDRAWassert(out_value->size() == static_cast<unsigned int>(count));
+  FASTUIDRAWassert(begin >= 0 && begin <= end);
+  FASTUIDRAWassert(out_value->size() >= static_cast<unsigned int>(end));
 
   if((solution_types_accepted & outside_0_1) == 0)
     {
@@ -1191,13 +1246,13 @@ compute_lines_intersection(enum coordinate_type tp, int step, int count,
             bbmin / step <= c <= bbmax / step
        */
 
-      cstart = fastuidraw::t_max(0, bbmin / step);
-      cend = fastuidraw::t_min(count, 2 + bbmax / step);
+      cstart = fastuidraw::t_max(begin, bbmin / step);
+      cend = fastuidraw::t_min(end, 2 + bbmax / step);
     }
   else
     {
-      cstart = 0;
-      cend = count;
+      cstart = begin;
+      cend = end;
     }
 
   for(int c = cstart; c < cend; ++c)
@@ -1280,9 +1335,21 @@ compute_distance_values(const ivec2 &step, const ivec2 &count,
      then just count.x (for 1) plus count.y (for 2). The items
      from (3) and (4) are already stored in IntBezierCurve
    */
+  bool parallel;
+
+  /* The values from (1) and (2) are where the time is spent: for
+     each line, every curve whose bounding box meets the line is
+     solved against it and then the line is walked to update the
+     values at its points. Different lines touch different points,
+     so the lines are handled in parallel in blocks. The values
+     from (3), (4) and (5) update the points of a box around a
+     point on the curve; the boxes overlap and the work is small,
+     so these are done serially.
+   */
+  parallel = (count.x() * count.y() >= parallel_point_threshold);
   compute_outline_point_values(step, count, tr, radius, dst);
   compute_derivative_cancel_values(step, count, tr, radius, dst);
-  compute_fixed_line_values(step, count, tr, dst);
+  compute_fixed_line_values(step, count, tr, parallel, dst);
 }
 
 void
@@ -1328,15 +1395,38 @@ void
 DistanceFieldGenerator::
 compute_fixed_line_values(const ivec2 &step, const ivec2 &count,
                           const IntBezierCurve::transformation<int> &tr,
+                          bool parallel,
                           fastuidraw::array2d<distance_value> &dst) const
 {
   std::vector<std::vector<Solver::solution_pt> > work_room0;
   std::vector<std::vector<Solver::solution_pt> > work_room1;
 
-  compute_fixed_line_values(Solver::x_fixed, work_room0, step, count, tr, dst);
-  compute_fixed_line_values(Solver::y_fixed, work_room1, step, count, tr, dst);
+  /* the x-fixed lines and the y-fixed lines cross, so the
+     two passes cannot run concurrently.
+   */
+  compute_fixed_line_values(Solver::x_fixed, work_room0, step, count, tr, parallel, dst);
+  compute_fixed_line_values(Solver::y_fixed, work_room1, step, count, tr, parallel, dst);
 }
 
+void
+DistanceFieldGenerator::
+compute_fixed_line_values(enum Solver::coordinate_type tp,
+                          std::vector<std::vector<Solver::solution_pt> > &work_room,
+                          const ivec2 &step, const ivec2 &count,
+                          const IntBezierCurve::transformation<int> &tr,
+                          bool parallel,
+                          fastuidraw::array2d<distance_value> &dst) const
+{
+  const int fixed_coord(Solver::fixed_coordinate(tp));
+
+  work_room.resize(count[fixed_coord]);
+  fastuidraw::detail::for_each_block(count[fixed_coord], lines_per_task, parallel,
+                                     [&](unsigned int begin, unsigned int end)
+                                     {
+                                       compute_fixed_line_values(tp, work_room, step, count, tr,
+                                                                 begin, end, dst);
+                                     });
+}
 
 void
 DistanceFieldGenerator::
@@ -1344,6 +1434,7 @@ compute_fixed_line_values(enum Solver::coordinate_type tp,
                           std::vector<std::vector<Solver::solution_pt> > &work_room,
                           const ivec2 &step, const ivec2 &count,
                           const IntBezierCurve::transformation<int> &tr,
+                          int begin, int end,
                           fastuidraw::array2d<distance_value> &dst) const
 {
   const enum distance_value::winding_ray_t ray_types[2][2] =
@@ -1356,8 +1447,7 @@ compute_fixed_line_values(enum Solver::coordinate_type tp,
   const int varying_coord(Solver::varying_coordinate(tp));
   const int winding_sgn((tp == Solver::x_fixed) ? 1 : -1);
 
-  work_room.resize(count[fixed_coord]);
-  for(int i = 0; i < count[fixed_coord]; ++i)
+  for(int i = begin; i < end; ++i)
     {
       work_room[i].clear();
     }
@@ -1369,14 +1459,14 @@ compute_fixed_line_values(enum Solver::coordinate_type tp,
       for(const IntBezierCurve &curve : curves)
         {
           Solver(curve).compute_lines_intersection(tp, step[fixed_coord],
-                                                   count[fixed_coord],
+                                                   begin, end,
                                                    Solver::within_0_1,
                                                    tr, &work_room);
         }
     }
 
   /* now for each line, do the distance computation along the line. */
-  for(int c = 0; c < count[fixed_coord]; ++c)
+  for(int c = begin; c < end; ++c)
     {
       std::vector<Solver::solution_pt> &L(work_room[c]);
       int total_cnt(0), winding(0);
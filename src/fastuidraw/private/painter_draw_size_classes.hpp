@@ -0,0 +1,113 @@
+/*!
+ * \file painter_draw_size_classes.hpp
+ * \brief file painter_draw_size_classes.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/util.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* The buffers of the PainterDraw objects of a backend come
+       in a number of size classes. Class 0 is the largest, its
+       sizes are the sizes from the configuration of the backend,
+       and each following class is half the size of the class
+       before it. The store size is in units of blocks, i.e.
+       in units of PainterBackend::ConfigurationBase::alignment()
+       generic_data values.
+     */
+    class PainterDrawSizeClasses
+    {
+    public:
+      /* If shrink_store is false, the store size is the same for
+         all classes, for example when the store is backed by a
+         UBO whose size is fixed by the shader.
+       */
+      PainterDrawSizeClasses(unsigned int num_attributes,
+                             unsigned int num_indices,
+                             unsigned int num_store_blocks,
+                             unsigned int number_classes,
+                             bool shrink_store = true):
+        m_attributes(num_attributes),
+        m_indices(num_indices),
+        m_store_blocks(num_store_blocks),
+        m_number_classes(t_max(number_classes, 1u)),
+        m_shrink_store(shrink_store)
+      {
+        /* do not let the smallest class be empty */
+        while(m_number_classes > 1
+              && (attributes(m_number_classes - 1) == 0
+                  || indices(m_number_classes - 1) == 0
+                  || store_blocks(m_number_classes - 1) == 0))
+          {
+            --m_number_classes;
+          }
+      }
+
+      unsigned int
+      number_classes(void) const
+      {
+        return m_number_classes;
+      }
+
+      unsigned int
+      attributes(unsigned int c) const
+      {
+        return m_attributes >> c;
+      }
+
+      unsigned int
+      indices(unsigned int c) const
+      {
+        return m_indices >> c;
+      }
+
+      unsigned int
+      store_blocks(unsigned int c) const
+      {
+        return (m_shrink_store) ? m_store_blocks >> c : m_store_blocks;
+      }
+
+      /* Returns the smallest class that holds the requested
+         amounts; requests larger than class 0 give class 0.
+       */
+      unsigned int
+      choose(unsigned int num_attributes,
+             unsigned int num_indices,
+             unsigned int num_store_blocks) const
+      {
+        unsigned int c(m_number_classes - 1);
+        while(c > 0
+              && (attributes(c) < num_attributes
+                  || indices(c) < num_indices
+                  || store_blocks(c) < num_store_blocks))
+          {
+            --c;
+          }
+        return c;
+      }
+
+    private:
+      unsigned int m_attributes, m_indices, m_store_blocks;
+      unsigned int m_number_classes;
+      bool m_shrink_store;
+    };
+  }
+}
@@ -0,0 +1,192 @@
+/*!
+ * \file path_tessellation_state.cpp
+ * \brief file path_tessellation_state.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <string.h>
+#include "path_tessellation_state.hpp"
+
+namespace
+{
+  class Registry:fastuidraw::noncopyable
+  {
+  public:
+    static
+    Registry&
+    get(void)
+    {
+      /* never deleted: Path objects with static storage may
+         outlive any static object of this file.
+       */
+      static Registry *R = new Registry();
+      return *R;
+    }
+
+    fastuidraw::mutex m_mutex;
+    std::multimap<size_t, fastuidraw::detail::PathTessellationState*> m_map;
+  };
+}
+
+//////////////////////////////////////////
+// fastuidraw::detail::PathGeometryKey methods
+void
+fastuidraw::detail::PathGeometryKey::
+add_value(uint32_t v)
+{
+  /* FNV-1a on the 32-bit words of the key */
+  m_values.push_back(v);
+  m_hash = (m_hash ^ v) * static_cast<size_t>(1099511628211ull);
+}
+
+void
+fastuidraw::detail::PathGeometryKey::
+add_value(float v)
+{
+  uint32_t u;
+
+  /* compare floats by their bits: values that are equal
+     but with different bits (i.e. 0.0 and -0.0) only make
+     for a missed chance to share.
+   */
+  memcpy(&u, &v, sizeof(u));
+  add_value(u);
+}
+
+bool
+fastuidraw::detail::PathGeometryKey::
+set(const Path &path, bool compact_storage)
+{
+  m_types.clear();
+  m_values.clear();
+  m_compact_storage = compact_storage;
+  m_hash = static_cast<size_t>(14695981039346656037ull);
+
+  add_value(static_cast<uint32_t>(compact_storage));
+  add_value(path.number_contours());
+  for(unsigned int c = 0, endc = path.number_contours(); c < endc; ++c)
+    {
+      reference_counted_ptr<const PathContour> contour(path.contour(c));
+
+      if(!contour->ended())
+        {
+          return false;
+        }
+
+      add_value(contour->number_points());
+      for(unsigned int i = 0, endi = contour->number_points(); i < endi; ++i)
+        {
+          const PathContour::interpolator_base *h(contour->interpolator(i).get());
+          c_array<const float> values;
+
+          if(!h->geometry_values(&values))
+            {
+              return false;
+            }
+
+          m_types.push_back(std::type_index(typeid(*h)));
+          add_value(static_cast<uint32_t>(m_types.back().hash_code()));
+          add_value(h->start_pt().x());
+          add_value(h->start_pt().y());
+          add_value(h->end_pt().x());
+          add_value(h->end_pt().y());
+          add_value(static_cast<uint32_t>(values.size()));
+          for(float v : values)
+            {
+              add_value(v);
+            }
+        }
+    }
+  return true;
+}
+
+//////////////////////////////////////////
+// fastuidraw::detail::PathTessellationState methods
+fastuidraw::reference_counted_ptr<fastuidraw::detail::PathTessellationState>
+fastuidraw::detail::PathTessellationState::
+create(bool compact_storage)
+{
+  return FASTUIDRAWnew PathTessellationState(compact_storage);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::detail::PathTessellationState>
+fastuidraw::detail::PathTessellationState::
+fetch_shared(const PathGeometryKey &key)
+{
+  Registry &R(Registry::get());
+  autolock_mutex m(R.m_mutex);
+  std::pair<registry_map::iterator, registry_map::iterator> range;
+
+  /* a state in the map is alive: remove_reference() takes
+     the state out of the map (with the lock of the registry
+     held) before the state is deleted.
+   */
+  range = R.m_map.equal_range(key.hash());
+  for(registry_map::iterator iter = range.first; iter != range.second; ++iter)
+    {
+      if(iter->second->m_key == key)
+        {
+          return iter->second;
+        }
+    }
+
+  PathTessellationState *p;
+  p = FASTUIDRAWnew PathTessellationState(key.compact_storage());
+  p->m_shared = true;
+  p->m_key = key;
+  p->m_location = R.m_map.insert(registry_map::value_type(key.hash(), p));
+  return p;
+}
+
+void
+fastuidraw::detail::PathTessellationState::
+add_reference(const PathTessellationState *p)
+{
+  FASTUIDRAWassert(p);
+  p->m_counter.add_reference();
+}
+
+void
+fastuidraw::detail::PathTessellationState::
+remove_reference(const PathTessellationState *p)
+{
+  bool last_reference;
+
+  FASTUIDRAWassert(p);
+  if(p->m_shared)
+    {
+      /* the count of a shared state only drops to zero with
+         the lock of the registry held so that fetch_shared()
+         never sees a state that is being deleted.
+       */
+      Registry &R(Registry::get());
+      autolock_mutex m(R.m_mutex);
+
+      last_reference = p->m_counter.remove_reference();
+      if(last_reference)
+        {
+          R.m_map.erase(p->m_location);
+        }
+    }
+  else
+    {
+      last_reference = p->m_counter.remove_reference();
+    }
+
+  if(last_reference)
+    {
+      FASTUIDRAWdelete(p);
+    }
+}
@@ -0,0 +1,175 @@
+/*!
+ * \file path_tessellation_state.hpp
+ * \brief file path_tessellation_state.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <map>
+#include <condition_variable>
+#include <vector>
+#include <typeinfo>
+#include <typeindex>
+#include <stdint.h>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/util/reference_count_atomic.hpp>
+#include "tessellated_path_cache_private.hpp"
+#include "util_private.hpp"
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* A PathGeometryKey describes the geometry of a Path (together
+       with the options of the TessellatedPath objects the Path
+       constructs) so that two Path objects with equal keys have
+       the same tessellations.
+     */
+    class PathGeometryKey
+    {
+    public:
+      PathGeometryKey(void):
+        m_compact_storage(false),
+        m_hash(0)
+      {}
+
+      /* Set the key from a Path; returns false if the geometry of
+         the Path cannot be described, i.e. a contour is not ended
+         or an interpolator does not implement
+         PathContour::interpolator_base::geometry_values().
+       */
+      bool
+      set(const Path &path, bool compact_storage);
+
+      bool
+      compact_storage(void) const
+      {
+        return m_compact_storage;
+      }
+
+      size_t
+      hash(void) const
+      {
+        return m_hash;
+      }
+
+      bool
+      operator==(const PathGeometryKey &rhs) const
+      {
+        return m_hash == rhs.m_hash
+          && m_values == rhs.m_values
+          && m_types == rhs.m_types;
+      }
+
+    private:
+      void
+      add_value(uint32_t v);
+
+      void
+      add_value(float v);
+
+      std::vector<std::type_index> m_types;
+      std::vector<uint32_t> m_values;
+      bool m_compact_storage;
+      size_t m_hash;
+    };
+
+    /* A PathTessellationState holds the tessellations that a Path
+       constructs: the coarsest level of detail and the entries of
+       the TessellatedPathCache for the finer ones. A Path that
+       does not share its tessellations owns its state alone; the
+       states of Path objects that share are found by their
+       PathGeometryKey in a process wide registry which only
+       references (and does not keep alive) the states, i.e. a
+       shared state is freed once the last Path using it drops it.
+     */
+    class PathTessellationState:noncopyable
+    {
+    public:
+      typedef reference_counted_ptr<const TessellatedPath> tessellated_path_ref;
+      typedef reference_counted_ptr<TessellatedPathCacheEntry> cache_entry_ref;
+
+      /* Create a state that is not shared.
+       */
+      static
+      reference_counted_ptr<PathTessellationState>
+      create(bool compact_storage);
+
+      /* Return the shared state of the key, creating it if there
+         is none.
+       */
+      static
+      reference_counted_ptr<PathTessellationState>
+      fetch_shared(const PathGeometryKey &key);
+
+      static
+      void
+      add_reference(const PathTessellationState *p);
+
+      static
+      void
+      remove_reference(const PathTessellationState *p);
+
+      /* the fields below are only accessed with m_mutex locked */
+      mutex m_mutex;
+
+      /* signaled when m_building goes to false */
+      std::condition_variable_any m_cond;
+
+      /* m_base is the coarsest LOD, made with the default
+         TessellationParams. The finer LOD's are held through
+         the TessellatedPathCache which may evict them; m_lods
+         is sorted from lowest to highest LOD.
+       */
+      tessellated_path_ref m_base;
+      std::vector<cache_entry_ref> m_lods;
+      bool m_done;
+
+      /* true while a thread constructs a LOD (without holding
+         m_mutex); only one LOD is constructed at a time.
+       */
+      bool m_building;
+
+      /* true while a LOD requested by Path::tessellation_no_wait()
+         is pending on TaskQueue::background().
+       */
+      bool m_scheduled;
+
+      /* value for TessellationParams::m_compact_storage of
+         the TessellatedPath objects of the state.
+       */
+      const bool m_compact_storage;
+
+    private:
+      typedef std::multimap<size_t, PathTessellationState*> registry_map;
+
+      explicit
+      PathTessellationState(bool compact_storage):
+        m_done(false),
+        m_building(false),
+        m_scheduled(false),
+        m_compact_storage(compact_storage),
+        m_shared(false)
+      {}
+
+      mutable reference_count_atomic m_counter;
+      bool m_shared;
+      PathGeometryKey m_key;
+      registry_map::iterator m_location;
+    };
+  }
+}
@@ -54,3 +54,62 @@ number_segments_for_tessellation(float arc_angle, float distance_thresh)
   needed_sizef = t_abs(arc_angle) / theta;
   return fastuidraw::t_max(3u, static_cast<unsigned int>(needed_sizef));
 }
+
+namespace
+{
+  /* Wang's formula: if p(0), .., p(n) are the control points of a
+     Bezier curve of degree n and
+       M = max_i || p(i + 2) - 2 p(i + 1) + p(i) ||
+     then the polyline that splits the curve into N segments of
+     equal time is within n (n - 1) M / (8 N^2) of the curve.
+     This returns n (n - 1) M / 8.
+   */
+  float
+  wang_factor(fastuidraw::c_array<const fastuidraw::vec2> bezier_pts)
+  {
+    float M(0.0f), n;
+
+    if(bezier_pts.size() < 3)
+      {
+        return 0.0f;
+      }
+
+    for(unsigned int i = 0, endi = bezier_pts.size() - 2; i < endi; ++i)
+      {
+        fastuidraw::vec2 v;
+        v = bezier_pts[i + 2] - 2.0f * bezier_pts[i + 1] + bezier_pts[i];
+        M = fastuidraw::t_max(M, v.magnitude());
+      }
+    n = static_cast<float>(bezier_pts.size() - 1);
+    return n * (n - 1.0f) * M / 8.0f;
+  }
+}
+
+unsigned int
+fastuidraw::detail::
+number_segments_for_tessellation(c_array<const vec2> bezier_pts, float distance_thresh)
+{
+  float f, needed_sizef;
+
+  f = wang_factor(bezier_pts);
+  if(f <= 0.0f)
+    {
+      return 1u;
+    }
+
+  needed_sizef = std::ceil(t_sqrt(f / t_max(distance_thresh, 1e-6f)));
+  /* avoid overflow when converting to unsigned int */
+  needed_sizef = t_min(needed_sizef, 1e8f);
+  return t_max(1u, static_cast<unsigned int>(needed_sizef));
+}
+
+float
+fastuidraw::detail::
+curve_distance_for_tessellation(c_array<const vec2> bezier_pts, unsigned int num_segments)
+{
+  float n;
+
+  FASTUIDRAWassert(num_segments > 0u);
+  n = static_cast<float>(num_segments);
+  return wang_factor(bezier_pts) / (n * n);
+}
@@ -31,5 +31,20 @@ namespace fastuidraw
 
     unsigned int
     number_segments_for_tessellation(float arc_angle, float distance_thresh);
+
+    /* Returns the number of segments needed so that uniformly
+       subdividing (in time) the Bezier curve with the given
+       control points gives a polyline that is within distance_thresh
+       of the curve; the count is not clamped to any maximum.
+     */
+    unsigned int
+    number_segments_for_tessellation(c_array<const vec2> bezier_pts, float distance_thresh);
+
+    /* Returns the largest distance between the Bezier curve with
+       the given control points and the polyline that uniformly
+       subdivides (in time) the curve into num_segments pieces.
+     */
+    float
+    curve_distance_for_tessellation(c_array<const vec2> bezier_pts, unsigned int num_segments);
   }
 }
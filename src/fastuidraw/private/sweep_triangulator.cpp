@@ -0,0 +1,1107 @@
+/*!
+ * \file sweep_triangulator.cpp
+ * \brief file sweep_triangulator.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <algorithm>
+#include <math.h>
+#include <fastuidraw/util/math.hpp>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+#include "sweep_triangulator.hpp"
+#include "util_private.hpp"
+
+/* The sweep triangulates each region (set of points of the plane with
+   the same winding number) by maintaining the classic stack of the
+   linear time triangulation of an x-monotone polygon. The sweep
+   processes the vertices in increasing x (then y); the status of the
+   sweep is the list of edges crossing the sweep line sorted from
+   bottom to top, and the space between two consecutive edges is
+   (a part of) a region. Each region holds a Funnel, the stack of
+   vertices to its left that are not yet fully triangulated:
+     - the first vertex of the stack is the latest vertex on one
+       boundary chain of the region (lower or upper)
+     - the remaining vertices are on the other chain, form a reflex
+       chain and the last vertex is the latest vertex processed for
+       the region.
+   The events of the sweep are then:
+     - a vertex arriving on a chain of a region; this is the usual
+       step of the monotone polygon triangulation.
+     - a region ending at a vertex; the vertex is joined to all of
+       the vertices of the Funnel.
+     - a vertex appearing in the interior of a region (split vertex);
+       it is connected to the latest vertex of the region, giving
+       two Funnels.
+     - two regions merging at a vertex (merge vertex); the merged
+       region keeps both Funnels until the next vertex of the region
+       is processed, the next vertex is connected to the merge vertex
+       which then closes one of the Funnels or splits the region
+       again.
+ */
+
+namespace
+{
+  typedef fastuidraw::i64vec2 point;
+
+  enum chain_t
+    {
+      lower_chain,
+      upper_chain,
+      no_chain
+    };
+
+  enum
+    {
+      /* number of times to split edges at crossing points
+         before giving up on making the edges non-crossing.
+       */
+      max_number_split_passes = 32
+    };
+
+  const unsigned int invalid_index = ~0u;
+
+  /* positive if c is to the left of the line from a to b */
+  int64_t
+  orientation(const point &a, const point &b, const point &c)
+  {
+    return (b.x() - a.x()) * (c.y() - a.y()) - (b.y() - a.y()) * (c.x() - a.x());
+  }
+
+  bool
+  opposite_signs(int64_t a, int64_t b)
+  {
+    return (a < 0 && b > 0) || (a > 0 && b < 0);
+  }
+
+  /* the sweep order */
+  bool
+  sweep_less(const point &a, const point &b)
+  {
+    return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+  }
+
+  class Vertex
+  {
+  public:
+    point m_pt;
+    unsigned int m_id;
+  };
+
+  class Edge
+  {
+  public:
+    /* m_v[0] comes before m_v[1] in sweep order; m_winding and
+       m_domain are added to the respective counts when crossing
+       the edge from below to above.
+     */
+    fastuidraw::uvec2 m_v;
+    int m_winding, m_domain;
+  };
+
+  class Split
+  {
+  public:
+    unsigned int m_edge;
+    unsigned int m_vertex;
+    int64_t m_param;
+
+    bool
+    operator<(const Split &rhs) const
+    {
+      if(m_edge != rhs.m_edge)
+        {
+          return m_edge < rhs.m_edge;
+        }
+      if(m_param != rhs.m_param)
+        {
+          return m_param < rhs.m_param;
+        }
+      return m_vertex < rhs.m_vertex;
+    }
+  };
+
+  class Funnel
+  {
+  public:
+    std::vector<unsigned int> m_stack;
+    enum chain_t m_chain;
+    std::vector<unsigned int> *m_dst;
+  };
+
+  class Region
+  {
+  public:
+    Region(void):
+      m_winding(0),
+      m_domain(0),
+      m_funnel(-1),
+      m_upper_funnel(-1)
+    {}
+
+    int m_winding, m_domain;
+
+    /* the Funnel of the region, -1 if the region is not
+       triangulated. While a merge vertex is pending, m_funnel
+       is the Funnel of the lower part and m_upper_funnel that of
+       the upper part, otherwise m_upper_funnel is -1.
+     */
+    int m_funnel, m_upper_funnel;
+  };
+
+  class ActiveEdge
+  {
+  public:
+    unsigned int m_edge;
+
+    /* region between this edge and the next edge up */
+    Region m_above;
+  };
+
+  class SweepTriangulatorPrivate:fastuidraw::noncopyable
+  {
+  public:
+    typedef fastuidraw::detail::SweepTriangulator::PointSource PointSource;
+    typedef fastuidraw::detail::SweepTriangulator::IndexSink IndexSink;
+
+    explicit
+    SweepTriangulatorPrivate(PointSource &points):
+      m_points(points),
+      m_out(nullptr),
+      m_min_height(0.0)
+    {}
+
+    void
+    add_contour(fastuidraw::c_array<const unsigned int> contour,
+                int winding, int domain);
+
+    bool
+    triangulate(IndexSink &out, double min_height);
+
+  private:
+    unsigned int
+    local_vertex(unsigned int id);
+
+    const point&
+    pt(unsigned int v) const
+    {
+      return m_vertices[v].m_pt;
+    }
+
+    /* add the edge from a to b, winding and domain are added
+       to the region to the left of a to b
+     */
+    void
+    add_edge(unsigned int a, unsigned int b, int winding, int domain);
+
+    void
+    merge_edges(void);
+
+    bool
+    find_splits(void);
+
+    void
+    test_edge_pair(unsigned int e, unsigned int f);
+
+    void
+    add_split(unsigned int e, unsigned int v);
+
+    bool
+    in_edge_interior(const Edge &e, unsigned int v) const;
+
+    void
+    apply_splits(void);
+
+    void
+    prepare_sweep(void);
+
+    void
+    sweep(void);
+
+    unsigned int
+    find_ending_edges(unsigned int v, unsigned int &hi);
+
+    Region&
+    region_below(unsigned int status_index)
+    {
+      return (status_index == 0) ?
+        m_bottom :
+        m_status[status_index - 1].m_above;
+    }
+
+    void
+    make_region(Region &R, int winding, int domain, unsigned int v);
+
+    void
+    split_region(const Region &R, unsigned int v, Region &low, Region &high);
+
+    void
+    add_vertex(Region &R, unsigned int v, enum chain_t chain);
+
+    void
+    close_region(Region &R, unsigned int v);
+
+    void
+    drop_region(Region &R);
+
+    int
+    allocate_funnel(int winding);
+
+    void
+    release_funnel(int f);
+
+    void
+    funnel_add(int f, unsigned int v, enum chain_t chain);
+
+    void
+    funnel_close(int f, unsigned int v);
+
+    void
+    emit_triangle(std::vector<unsigned int> &dst,
+                  unsigned int a, unsigned int b, unsigned int c);
+
+    PointSource &m_points;
+    IndexSink *m_out;
+    double m_min_height;
+    bool m_failed;
+
+    std::vector<Vertex> m_vertices;
+    std::vector<unsigned int> m_local_of_id;
+    std::vector<Edge> m_edges;
+
+    /* work room for splitting edges */
+    std::vector<Split> m_splits;
+    std::vector<unsigned int> m_edge_order;
+
+    /* edges sorted by first vertex and then bottom to top,
+       m_first_edge[v] is the first edge starting at v
+     */
+    std::vector<unsigned int> m_first_edge;
+
+    /* sweep status */
+    std::vector<ActiveEdge> m_status;
+    std::vector<ActiveEdge> m_new_active;
+    Region m_bottom;
+    std::vector<Funnel> m_funnels;
+    std::vector<int> m_free_funnels;
+  };
+}
+
+/////////////////////////////////////////////
+// SweepTriangulatorPrivate methods
+unsigned int
+SweepTriangulatorPrivate::
+local_vertex(unsigned int id)
+{
+  if(id >= m_local_of_id.size())
+    {
+      m_local_of_id.resize(id + 1, invalid_index);
+    }
+
+  if(m_local_of_id[id] == invalid_index)
+    {
+      fastuidraw::ivec2 p(m_points.position(id));
+      Vertex V;
+
+      V.m_pt = point(p.x(), p.y());
+      V.m_id = id;
+      m_local_of_id[id] = m_vertices.size();
+      m_vertices.push_back(V);
+    }
+  return m_local_of_id[id];
+}
+
+void
+SweepTriangulatorPrivate::
+add_edge(unsigned int a, unsigned int b, int winding, int domain)
+{
+  Edge E;
+
+  if(a == b)
+    {
+      return;
+    }
+
+  if(sweep_less(pt(a), pt(b)))
+    {
+      E.m_v = fastuidraw::uvec2(a, b);
+      E.m_winding = winding;
+      E.m_domain = domain;
+    }
+  else
+    {
+      E.m_v = fastuidraw::uvec2(b, a);
+      E.m_winding = -winding;
+      E.m_domain = -domain;
+    }
+  m_edges.push_back(E);
+}
+
+void
+SweepTriangulatorPrivate::
+add_contour(fastuidraw::c_array<const unsigned int> contour,
+            int winding, int domain)
+{
+  unsigned int first, prev;
+
+  if(contour.empty())
+    {
+      return;
+    }
+
+  first = prev = local_vertex(contour[0]);
+  for(unsigned int i = 1, endi = contour.size(); i < endi; ++i)
+    {
+      unsigned int v;
+
+      v = local_vertex(contour[i]);
+      add_edge(prev, v, winding, domain);
+      prev = v;
+    }
+  add_edge(prev, first, winding, domain);
+}
+
+void
+SweepTriangulatorPrivate::
+merge_edges(void)
+{
+  unsigned int dst(0);
+
+  /* overlapping edges, once split against each other, are
+     the same edge; combine them into one edge and drop
+     edges that do not change anything.
+   */
+  std::sort(m_edges.begin(), m_edges.end(),
+            [](const Edge &a, const Edge &b)
+            {
+              return a.m_v[0] < b.m_v[0]
+                || (a.m_v[0] == b.m_v[0] && a.m_v[1] < b.m_v[1]);
+            });
+
+  for(unsigned int i = 0, endi = m_edges.size(); i < endi;)
+    {
+      Edge E(m_edges[i]);
+
+      for(++i; i < endi && m_edges[i].m_v == E.m_v; ++i)
+        {
+          E.m_winding += m_edges[i].m_winding;
+          E.m_domain += m_edges[i].m_domain;
+        }
+
+      if(E.m_winding != 0 || E.m_domain != 0)
+        {
+          m_edges[dst++] = E;
+        }
+    }
+  m_edges.resize(dst);
+}
+
+bool
+SweepTriangulatorPrivate::
+in_edge_interior(const Edge &e, unsigned int v) const
+{
+  const point &a(pt(e.m_v[0])), &b(pt(e.m_v[1])), &p(pt(v));
+
+  return v != e.m_v[0] && v != e.m_v[1]
+    && orientation(a, b, p) == 0
+    && dot(p - a, b - a) > 0
+    && dot(p - b, a - b) > 0;
+}
+
+void
+SweepTriangulatorPrivate::
+add_split(unsigned int e, unsigned int v)
+{
+  const Edge &E(m_edges[e]);
+  Split S;
+
+  if(v == E.m_v[0] || v == E.m_v[1])
+    {
+      return;
+    }
+
+  S.m_edge = e;
+  S.m_vertex = v;
+  S.m_param = dot(pt(v) - pt(E.m_v[0]), pt(E.m_v[1]) - pt(E.m_v[0]));
+  m_splits.push_back(S);
+}
+
+void
+SweepTriangulatorPrivate::
+test_edge_pair(unsigned int ei, unsigned int fi)
+{
+  const Edge &e(m_edges[ei]), &f(m_edges[fi]);
+  unsigned int a(e.m_v[0]), b(e.m_v[1]), c(f.m_v[0]), d(f.m_v[1]);
+  int64_t o1, o2, o3, o4;
+
+  if(a == c || a == d || b == c || b == d)
+    {
+      /* edges sharing an end point can only meet
+         elsewhere if they overlap.
+       */
+      if(in_edge_interior(e, c)) add_split(ei, c);
+      if(in_edge_interior(e, d)) add_split(ei, d);
+      if(in_edge_interior(f, a)) add_split(fi, a);
+      if(in_edge_interior(f, b)) add_split(fi, b);
+      return;
+    }
+
+  o1 = orientation(pt(a), pt(b), pt(c));
+  o2 = orientation(pt(a), pt(b), pt(d));
+  o3 = orientation(pt(c), pt(d), pt(a));
+  o4 = orientation(pt(c), pt(d), pt(b));
+
+  if(opposite_signs(o1, o2) && opposite_signs(o3, o4))
+    {
+      double t;
+      fastuidraw::dvec2 p;
+      fastuidraw::ivec2 ip;
+      unsigned int v;
+
+      /* the signed distance to the line through c and d is
+         linear along the edge from a to b and is o3 at a and
+         o4 at b.
+       */
+      t = static_cast<double>(o3) / static_cast<double>(o3 - o4);
+      p.x() = static_cast<double>(pt(a).x()) + t * static_cast<double>(pt(b).x() - pt(a).x());
+      p.y() = static_cast<double>(pt(a).y()) + t * static_cast<double>(pt(b).y() - pt(a).y());
+      ip.x() = static_cast<int>(::floor(p.x() + 0.5));
+      ip.y() = static_cast<int>(::floor(p.y() + 0.5));
+
+      v = local_vertex(m_points.intersection_point(ip, m_vertices[a].m_id,
+                                                   m_vertices[b].m_id, t));
+      add_split(ei, v);
+      add_split(fi, v);
+      return;
+    }
+
+  if(o1 == 0 && in_edge_interior(e, c)) add_split(ei, c);
+  if(o2 == 0 && in_edge_interior(e, d)) add_split(ei, d);
+  if(o3 == 0 && in_edge_interior(f, a)) add_split(fi, a);
+  if(o4 == 0 && in_edge_interior(f, b)) add_split(fi, b);
+}
+
+bool
+SweepTriangulatorPrivate::
+find_splits(void)
+{
+  /* sort-and-sweep along x; an edge starts at the x-coordinate
+     of its first vertex.
+   */
+  m_splits.clear();
+  m_edge_order.resize(m_edges.size());
+  for(unsigned int i = 0, endi = m_edges.size(); i < endi; ++i)
+    {
+      m_edge_order[i] = i;
+    }
+  std::sort(m_edge_order.begin(), m_edge_order.end(),
+            [this](unsigned int a, unsigned int b)
+            {
+              return pt(m_edges[a].m_v[0]).x() < pt(m_edges[b].m_v[0]).x();
+            });
+
+  for(unsigned int i = 0, endi = m_edge_order.size(); i < endi; ++i)
+    {
+      unsigned int e(m_edge_order[i]);
+      int64_t max_x, min_y, max_y;
+
+      max_x = pt(m_edges[e].m_v[1]).x();
+      min_y = fastuidraw::t_min(pt(m_edges[e].m_v[0]).y(), pt(m_edges[e].m_v[1]).y());
+      max_y = fastuidraw::t_max(pt(m_edges[e].m_v[0]).y(), pt(m_edges[e].m_v[1]).y());
+      for(unsigned int j = i + 1; j < endi && pt(m_edges[m_edge_order[j]].m_v[0]).x() <= max_x; ++j)
+        {
+          unsigned int f(m_edge_order[j]);
+          int64_t f_min_y, f_max_y;
+
+          f_min_y = fastuidraw::t_min(pt(m_edges[f].m_v[0]).y(), pt(m_edges[f].m_v[1]).y());
+          f_max_y = fastuidraw::t_max(pt(m_edges[f].m_v[0]).y(), pt(m_edges[f].m_v[1]).y());
+          if(f_min_y <= max_y && min_y <= f_max_y)
+            {
+              test_edge_pair(e, f);
+            }
+        }
+    }
+
+  return !m_splits.empty();
+}
+
+void
+SweepTriangulatorPrivate::
+apply_splits(void)
+{
+  std::sort(m_splits.begin(), m_splits.end());
+  for(unsigned int i = 0, endi = m_splits.size(); i < endi;)
+    {
+      unsigned int e(m_splits[i].m_edge), prev;
+      Edge E(m_edges[e]);
+
+      /* the edge is replaced by the chain through the split
+         points; the chain may zig-zag slightly because split
+         points are rounded, add_edge() handles that.
+       */
+      m_edges[e].m_winding = 0;
+      m_edges[e].m_domain = 0;
+      prev = E.m_v[0];
+      for(; i < endi && m_splits[i].m_edge == e; ++i)
+        {
+          if(m_splits[i].m_vertex != prev)
+            {
+              add_edge(prev, m_splits[i].m_vertex, E.m_winding, E.m_domain);
+              prev = m_splits[i].m_vertex;
+            }
+        }
+      add_edge(prev, E.m_v[1], E.m_winding, E.m_domain);
+    }
+}
+
+void
+SweepTriangulatorPrivate::
+prepare_sweep(void)
+{
+  std::vector<unsigned int> order(m_vertices.size()), rank(m_vertices.size());
+  std::vector<Vertex> sorted(m_vertices.size());
+
+  /* renumber the vertices in sweep order */
+  for(unsigned int i = 0, endi = order.size(); i < endi; ++i)
+    {
+      order[i] = i;
+    }
+  std::sort(order.begin(), order.end(),
+            [this](unsigned int a, unsigned int b)
+            {
+              return sweep_less(pt(a), pt(b));
+            });
+  for(unsigned int i = 0, endi = order.size(); i < endi; ++i)
+    {
+      rank[order[i]] = i;
+      sorted[i] = m_vertices[order[i]];
+    }
+  m_vertices.swap(sorted);
+
+  for(Edge &E : m_edges)
+    {
+      E.m_v = fastuidraw::uvec2(rank[E.m_v[0]], rank[E.m_v[1]]);
+      FASTUIDRAWassert(E.m_v[0] < E.m_v[1]);
+    }
+
+  /* sort the edges by first vertex and then from bottom to top */
+  std::sort(m_edges.begin(), m_edges.end(),
+            [this](const Edge &a, const Edge &b)
+            {
+              if(a.m_v[0] != b.m_v[0])
+                {
+                  return a.m_v[0] < b.m_v[0];
+                }
+              return orientation(pt(a.m_v[0]), pt(a.m_v[1]), pt(b.m_v[1])) > 0;
+            });
+
+  m_first_edge.assign(m_vertices.size() + 1, 0);
+  for(const Edge &E : m_edges)
+    {
+      ++m_first_edge[E.m_v[0] + 1];
+    }
+  for(unsigned int v = 0, endv = m_vertices.size(); v < endv; ++v)
+    {
+      m_first_edge[v + 1] += m_first_edge[v];
+    }
+}
+
+int
+SweepTriangulatorPrivate::
+allocate_funnel(int winding)
+{
+  int f;
+
+  if(m_free_funnels.empty())
+    {
+      f = m_funnels.size();
+      m_funnels.push_back(Funnel());
+    }
+  else
+    {
+      f = m_free_funnels.back();
+      m_free_funnels.pop_back();
+    }
+
+  m_funnels[f].m_stack.clear();
+  m_funnels[f].m_chain = no_chain;
+  m_funnels[f].m_dst = &m_out->indices(winding);
+  return f;
+}
+
+void
+SweepTriangulatorPrivate::
+release_funnel(int f)
+{
+  if(f >= 0)
+    {
+      m_free_funnels.push_back(f);
+    }
+}
+
+void
+SweepTriangulatorPrivate::
+emit_triangle(std::vector<unsigned int> &dst,
+              unsigned int a, unsigned int b, unsigned int c)
+{
+  point v(pt(b) - pt(a)), w(pt(c) - pt(a)), u(pt(c) - pt(b));
+  int64_t twice_area;
+  double two_area;
+
+  twice_area = fastuidraw::t_abs(v.x() * w.y() - v.y() * w.x());
+  if(twice_area == 0)
+    {
+      return;
+    }
+
+  /* the distance from an edge to the opposite vertex is twice
+     the area divided by the length of the edge.
+   */
+  two_area = static_cast<double>(twice_area);
+  if(two_area < m_min_height * fastuidraw::t_sqrt(static_cast<double>(dot(v, v)))
+     || two_area < m_min_height * fastuidraw::t_sqrt(static_cast<double>(dot(w, w)))
+     || two_area < m_min_height * fastuidraw::t_sqrt(static_cast<double>(dot(u, u))))
+    {
+      return;
+    }
+
+  dst.push_back(m_vertices[a].m_id);
+  dst.push_back(m_vertices[b].m_id);
+  dst.push_back(m_vertices[c].m_id);
+}
+
+void
+SweepTriangulatorPrivate::
+funnel_add(int f, unsigned int v, enum chain_t chain)
+{
+  Funnel &F(m_funnels[f]);
+  std::vector<unsigned int> &S(F.m_stack);
+
+  FASTUIDRAWassert(!S.empty());
+  if(F.m_chain == no_chain)
+    {
+      FASTUIDRAWassert(S.size() == 1);
+      S.push_back(v);
+      F.m_chain = chain;
+    }
+  else if(F.m_chain != chain)
+    {
+      unsigned int t;
+
+      /* v sees every vertex of the stack */
+      for(unsigned int i = 0, endi = S.size(); i + 1 < endi; ++i)
+        {
+          emit_triangle(*F.m_dst, S[i], S[i + 1], v);
+        }
+      t = S.back();
+      S.clear();
+      S.push_back(t);
+      S.push_back(v);
+      F.m_chain = chain;
+    }
+  else
+    {
+      unsigned int t;
+
+      /* pop while the diagonal from v to the vertex below the
+         top of the stack is inside, i.e. while the top of the
+         stack is a convex vertex of the chain.
+       */
+      t = S.back();
+      S.pop_back();
+      while(!S.empty())
+        {
+          int64_t o;
+          bool convex;
+
+          o = orientation(pt(S.back()), pt(t), pt(v));
+          convex = (chain == lower_chain) ? (o > 0) : (o < 0);
+          if(!convex)
+            {
+              break;
+            }
+          emit_triangle(*F.m_dst, S.back(), t, v);
+          t = S.back();
+          S.pop_back();
+        }
+      S.push_back(t);
+      S.push_back(v);
+    }
+}
+
+void
+SweepTriangulatorPrivate::
+funnel_close(int f, unsigned int v)
+{
+  if(f >= 0)
+    {
+      Funnel &F(m_funnels[f]);
+      for(unsigned int i = 0, endi = F.m_stack.size(); i + 1 < endi; ++i)
+        {
+          emit_triangle(*F.m_dst, F.m_stack[i], F.m_stack[i + 1], v);
+        }
+      release_funnel(f);
+    }
+}
+
+void
+SweepTriangulatorPrivate::
+make_region(Region &R, int winding, int domain, unsigned int v)
+{
+  R.m_winding = winding;
+  R.m_domain = domain;
+  R.m_upper_funnel = -1;
+  if(domain != 0)
+    {
+      R.m_funnel = allocate_funnel(winding);
+      m_funnels[R.m_funnel].m_stack.push_back(v);
+    }
+  else
+    {
+      R.m_funnel = -1;
+    }
+}
+
+void
+SweepTriangulatorPrivate::
+add_vertex(Region &R, unsigned int v, enum chain_t chain)
+{
+  if(R.m_funnel < 0)
+    {
+      return;
+    }
+
+  if(R.m_upper_funnel >= 0)
+    {
+      /* v is connected to the pending merge vertex, which closes
+         the Funnel on the side of the chain that v is on.
+       */
+      if(chain == lower_chain)
+        {
+          funnel_close(R.m_funnel, v);
+          R.m_funnel = R.m_upper_funnel;
+        }
+      else
+        {
+          funnel_close(R.m_upper_funnel, v);
+        }
+      R.m_upper_funnel = -1;
+    }
+  funnel_add(R.m_funnel, v, chain);
+}
+
+void
+SweepTriangulatorPrivate::
+split_region(const Region &R, unsigned int v, Region &low, Region &high)
+{
+  low = R;
+  high = R;
+  low.m_upper_funnel = high.m_upper_funnel = -1;
+
+  if(R.m_funnel < 0)
+    {
+      return;
+    }
+
+  if(R.m_upper_funnel >= 0)
+    {
+      /* connect v to the pending merge vertex */
+      funnel_add(R.m_funnel, v, upper_chain);
+      funnel_add(R.m_upper_funnel, v, lower_chain);
+      low.m_funnel = R.m_funnel;
+      high.m_funnel = R.m_upper_funnel;
+    }
+  else
+    {
+      unsigned int t;
+      enum chain_t chain;
+      int f;
+
+      /* connect v to the latest vertex t of the region; the
+         side of the Funnel's reflex chain continues the Funnel
+         and the other side starts a new Funnel of t and v.
+       */
+      t = m_funnels[R.m_funnel].m_stack.back();
+      chain = m_funnels[R.m_funnel].m_chain;
+      f = allocate_funnel(R.m_winding);
+      m_funnels[f].m_stack.push_back(t);
+      m_funnels[f].m_stack.push_back(v);
+      if(chain == lower_chain)
+        {
+          funnel_add(R.m_funnel, v, lower_chain);
+          m_funnels[f].m_chain = upper_chain;
+          high.m_funnel = R.m_funnel;
+          low.m_funnel = f;
+        }
+      else
+        {
+          funnel_add(R.m_funnel, v, upper_chain);
+          m_funnels[f].m_chain = lower_chain;
+          low.m_funnel = R.m_funnel;
+          high.m_funnel = f;
+        }
+    }
+}
+
+void
+SweepTriangulatorPrivate::
+close_region(Region &R, unsigned int v)
+{
+  funnel_close(R.m_funnel, v);
+  funnel_close(R.m_upper_funnel, v);
+  R.m_funnel = R.m_upper_funnel = -1;
+}
+
+void
+SweepTriangulatorPrivate::
+drop_region(Region &R)
+{
+  release_funnel(R.m_funnel);
+  release_funnel(R.m_upper_funnel);
+  R.m_funnel = R.m_upper_funnel = -1;
+}
+
+unsigned int
+SweepTriangulatorPrivate::
+find_ending_edges(unsigned int v, unsigned int &hi)
+{
+  unsigned int lo, count;
+
+  /* the active edges below v are before those that
+     end at v which are before those above v.
+   */
+  lo = 0;
+  count = m_status.size();
+  while(count > 0)
+    {
+      unsigned int step(count / 2), mid(lo + step);
+      const Edge &E(m_edges[m_status[mid].m_edge]);
+
+      if(E.m_v[1] != v && orientation(pt(E.m_v[0]), pt(E.m_v[1]), pt(v)) > 0)
+        {
+          lo = mid + 1;
+          count -= step + 1;
+        }
+      else
+        {
+          count = step;
+        }
+    }
+
+  for(hi = lo; hi < m_status.size() && m_edges[m_status[hi].m_edge].m_v[1] == v; ++hi)
+    {}
+
+  return lo;
+}
+
+void
+SweepTriangulatorPrivate::
+sweep(void)
+{
+  m_status.clear();
+  m_bottom = Region();
+
+  for(unsigned int v = 0, endv = m_vertices.size(); v < endv; ++v)
+    {
+      unsigned int lo, hi, first_edge, num_edges;
+      Region running;
+
+      lo = find_ending_edges(v, hi);
+
+      /* edges ending at v that are not where they should be can
+         only happen if crossings remain; remove them.
+       */
+      for(unsigned int i = 0; i < m_status.size();)
+        {
+          if((i < lo || i >= hi) && m_edges[m_status[i].m_edge].m_v[1] <= v)
+            {
+              m_failed = true;
+              drop_region(m_status[i].m_above);
+              m_status.erase(m_status.begin() + i);
+              lo = find_ending_edges(v, hi);
+              i = 0;
+            }
+          else
+            {
+              ++i;
+            }
+        }
+
+      first_edge = m_first_edge[v];
+      num_edges = m_first_edge[v + 1] - first_edge;
+      m_new_active.resize(num_edges);
+
+      if(lo == hi)
+        {
+          Region low, high;
+
+          if(num_edges == 0)
+            {
+              continue;
+            }
+
+          /* v is inside of the region below lo */
+          split_region(region_below(lo), v, low, high);
+          region_below(lo) = low;
+          running = low;
+          for(unsigned int i = 0; i + 1 < num_edges; ++i)
+            {
+              const Edge &E(m_edges[first_edge + i]);
+
+              m_new_active[i].m_edge = first_edge + i;
+              make_region(m_new_active[i].m_above,
+                          running.m_winding + E.m_winding,
+                          running.m_domain + E.m_domain, v);
+              running = m_new_active[i].m_above;
+            }
+          m_new_active[num_edges - 1].m_edge = first_edge + num_edges - 1;
+          m_new_active[num_edges - 1].m_above = high;
+          m_status.insert(m_status.begin() + lo, m_new_active.begin(), m_new_active.end());
+        }
+      else
+        {
+          Region B(m_status[hi - 1].m_above);
+
+          /* the regions between edges ending at v end at v */
+          for(unsigned int i = lo; i + 1 < hi; ++i)
+            {
+              close_region(m_status[i].m_above, v);
+            }
+
+          /* v ends the upper chain of the region below the edges
+             and the lower chain of the region above them.
+           */
+          add_vertex(region_below(lo), v, upper_chain);
+          add_vertex(B, v, lower_chain);
+
+          if(num_edges == 0)
+            {
+              Region &A(region_below(lo));
+
+              /* merge vertex */
+              if(A.m_funnel >= 0)
+                {
+                  A.m_upper_funnel = B.m_funnel;
+                }
+              else
+                {
+                  drop_region(B);
+                }
+              m_status.erase(m_status.begin() + lo, m_status.begin() + hi);
+            }
+          else
+            {
+              running = region_below(lo);
+              for(unsigned int i = 0; i + 1 < num_edges; ++i)
+                {
+                  const Edge &E(m_edges[first_edge + i]);
+
+                  m_new_active[i].m_edge = first_edge + i;
+                  make_region(m_new_active[i].m_above,
+                              running.m_winding + E.m_winding,
+                              running.m_domain + E.m_domain, v);
+                  running = m_new_active[i].m_above;
+                }
+              m_new_active[num_edges - 1].m_edge = first_edge + num_edges - 1;
+              m_new_active[num_edges - 1].m_above = B;
+              m_status.erase(m_status.begin() + lo, m_status.begin() + hi);
+              m_status.insert(m_status.begin() + lo, m_new_active.begin(), m_new_active.end());
+            }
+        }
+    }
+
+  if(!m_status.empty())
+    {
+      m_failed = true;
+      for(ActiveEdge &A : m_status)
+        {
+          drop_region(A.m_above);
+        }
+      m_status.clear();
+    }
+  drop_region(m_bottom);
+}
+
+bool
+SweepTriangulatorPrivate::
+triangulate(IndexSink &out, double min_height)
+{
+  unsigned int pass;
+
+  m_out = &out;
+  m_min_height = min_height;
+  m_failed = false;
+
+  merge_edges();
+  for(pass = 0; pass < max_number_split_passes && find_splits(); ++pass)
+    {
+      apply_splits();
+      merge_edges();
+    }
+
+  if(pass == max_number_split_passes)
+    {
+      m_failed = true;
+    }
+
+  prepare_sweep();
+  sweep();
+
+  m_out = nullptr;
+  return !m_failed;
+}
+
+//////////////////////////////////////////
+// fastuidraw::detail::SweepTriangulator methods
+fastuidraw::detail::SweepTriangulator::
+SweepTriangulator(PointSource &points)
+{
+  m_d = FASTUIDRAWnew SweepTriangulatorPrivate(points);
+}
+
+fastuidraw::detail::SweepTriangulator::
+~SweepTriangulator()
+{
+  SweepTriangulatorPrivate *d;
+  d = static_cast<SweepTriangulatorPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+void
+fastuidraw::detail::SweepTriangulator::
+add_contour(c_array<const unsigned int> contour)
+{
+  SweepTriangulatorPrivate *d;
+  d = static_cast<SweepTriangulatorPrivate*>(m_d);
+  d->add_contour(contour, 1, 0);
+}
+
+void
+fastuidraw::detail::SweepTriangulator::
+add_domain_contour(c_array<const unsigned int> contour)
+{
+  SweepTriangulatorPrivate *d;
+  d = static_cast<SweepTriangulatorPrivate*>(m_d);
+  d->add_contour(contour, 0, 1);
+}
+
+bool
+fastuidraw::detail::SweepTriangulator::
+triangulate(IndexSink &out, double min_height)
+{
+  SweepTriangulatorPrivate *d;
+  d = static_cast<SweepTriangulatorPrivate*>(m_d);
+  return d->triangulate(out, min_height);
+}
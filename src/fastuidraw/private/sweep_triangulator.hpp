@@ -0,0 +1,129 @@
+/*!
+ * \file sweep_triangulator.hpp
+ * \brief file sweep_triangulator.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/c_array.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* A SweepTriangulator triangulates the regions cut out by a set
+       of closed contours whose points have integer coordinates,
+       giving each region its winding number. It works in two stages:
+         1. the edges of the contours are split at every point where
+            they cross or touch another edge; crossing points are
+            rounded to integer coordinates, so splitting is repeated
+            until no two edges cross. Overlapping edges are merged.
+         2. a single sweep (in increasing x, then y) over the now
+            non-crossing edges decomposes each region into x-monotone
+            pieces and triangulates those pieces as the sweep passes,
+            writing the triangles of each winding number directly to
+            one index array.
+       All arithmetic on the coordinates of the points is exact, which
+       requires that the absolute value of each coordinate is less
+       than 2^30. Only the regions inside of the contours added with
+       add_domain_contour() are triangulated; this includes the regions
+       whose winding number is zero.
+     */
+    class SweepTriangulator:noncopyable
+    {
+    public:
+      /* Interface through which a SweepTriangulator fetches the
+         points referred to by a contour and creates the points
+         at which edges cross.
+       */
+      class PointSource
+      {
+      public:
+        virtual
+        ~PointSource()
+        {}
+
+        /* Return the position of the named point; two different
+           point indices must have different positions.
+         */
+        virtual
+        ivec2
+        position(unsigned int I) const = 0;
+
+        /* Return the index of the point at position p, creating
+           it if necessary; p is the point on the edge from the
+           point a to the point b at time t (with 0 < t < 1),
+           rounded to integer coordinates.
+         */
+        virtual
+        unsigned int
+        intersection_point(const ivec2 &p, unsigned int a,
+                           unsigned int b, double t) = 0;
+      };
+
+      /* Interface to which a SweepTriangulator writes triangles.
+       */
+      class IndexSink
+      {
+      public:
+        virtual
+        ~IndexSink()
+        {}
+
+        /* Return the array to which to append the indices of the
+           triangles whose winding number is w; the reference must
+           stay valid until SweepTriangulator::triangulate() returns.
+         */
+        virtual
+        std::vector<unsigned int>&
+        indices(int w) = 0;
+      };
+
+      explicit
+      SweepTriangulator(PointSource &points);
+
+      ~SweepTriangulator();
+
+      /* Add a closed contour; the edge from the last point to
+         the first point is implicit.
+       */
+      void
+      add_contour(c_array<const unsigned int> contour);
+
+      /* Add a closed contour that bounds the domain to
+         triangulate; it does not affect winding numbers.
+       */
+      void
+      add_domain_contour(c_array<const unsigned int> contour);
+
+      /* Triangulate the contours added; triangles that are too
+         thin, i.e. the distance from some vertex of the triangle
+         to the opposite edge is less than min_height, are dropped.
+         Returns false if not all edge crossings could be resolved,
+         in which case the triangulation may be missing triangles.
+       */
+      bool
+      triangulate(IndexSink &out, double min_height);
+
+    private:
+      void *m_d;
+    };
+  }
+}
@@ -0,0 +1,212 @@
+/*!
+ * \file task_queue.cpp
+ * \brief file task_queue.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <fastuidraw/util/math.hpp>
+#include "task_queue.hpp"
+
+class fastuidraw::detail::TaskGroup::State:
+  public fastuidraw::reference_counted<State>::default_base
+{
+public:
+  State(void):
+    m_running(0)
+  {}
+
+  /* runs the oldest task not yet started, if there is one;
+     M must be locked on m_mutex and is locked on return.
+   */
+  bool
+  run_one(std::unique_lock<std::mutex> &M);
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::deque<TaskQueue::Task> m_pending;
+  unsigned int m_running;
+};
+
+fastuidraw::detail::TaskQueue::
+TaskQueue(unsigned int number_threads):
+  m_number_threads(t_max(number_threads, 1u)),
+  m_stop(false)
+{
+}
+
+fastuidraw::detail::TaskQueue::
+~TaskQueue()
+{
+  std::deque<Entry> dropped;
+
+  {
+    std::lock_guard<std::mutex> M(m_mutex);
+    m_stop = true;
+    dropped.swap(m_tasks);
+  }
+  m_cond.notify_all();
+
+  /* the dropped tasks are canceled and destroyed without
+     m_mutex locked since destroying a task may release
+     objects whose destruction waits on a canceled task.
+   */
+  for(Entry &e : dropped)
+    {
+      if(e.m_cancel)
+        {
+          e.m_cancel();
+        }
+    }
+  dropped.clear();
+
+  for(unsigned int i = 0, endi = m_threads.size(); i < endi; ++i)
+    {
+      m_threads[i].join();
+    }
+}
+
+void
+fastuidraw::detail::TaskQueue::
+add(const Task &task, const Task &cancel)
+{
+  {
+    std::lock_guard<std::mutex> M(m_mutex);
+    if(m_threads.empty())
+      {
+        for(unsigned int i = 0; i < m_number_threads; ++i)
+          {
+            m_threads.push_back(std::thread(&TaskQueue::worker, this));
+          }
+      }
+    m_tasks.push_back(Entry());
+    m_tasks.back().m_task = task;
+    m_tasks.back().m_cancel = cancel;
+  }
+  m_cond.notify_one();
+}
+
+void
+fastuidraw::detail::TaskQueue::
+worker(void)
+{
+  for(;;)
+    {
+      Task task;
+      {
+        std::unique_lock<std::mutex> M(m_mutex);
+        while(!m_stop && m_tasks.empty())
+          {
+            m_cond.wait(M);
+          }
+        if(m_stop)
+          {
+            return;
+          }
+        task.swap(m_tasks.front().m_task);
+        m_tasks.pop_front();
+      }
+      task();
+    }
+}
+
+fastuidraw::detail::TaskQueue&
+fastuidraw::detail::TaskQueue::
+background(void)
+{
+  static TaskQueue R(t_max(std::thread::hardware_concurrency(), 2u) - 1u);
+  return R;
+}
+
+//////////////////////////////////////
+// fastuidraw::detail::TaskGroup::State methods
+bool
+fastuidraw::detail::TaskGroup::State::
+run_one(std::unique_lock<std::mutex> &M)
+{
+  TaskQueue::Task task;
+
+  if(m_pending.empty())
+    {
+      return false;
+    }
+
+  task.swap(m_pending.front());
+  m_pending.pop_front();
+  ++m_running;
+
+  M.unlock();
+  task();
+  M.lock();
+
+  --m_running;
+  m_cond.notify_all();
+  return true;
+}
+
+//////////////////////////////////////
+// fastuidraw::detail::TaskGroup methods
+fastuidraw::detail::TaskGroup::
+TaskGroup(TaskQueue &queue):
+  m_queue(queue)
+{
+  m_state = FASTUIDRAWnew State();
+}
+
+fastuidraw::detail::TaskGroup::
+~TaskGroup()
+{
+  wait();
+}
+
+void
+fastuidraw::detail::TaskGroup::
+add(const TaskQueue::Task &task)
+{
+  reference_counted_ptr<State> state(m_state);
+
+  {
+    std::lock_guard<std::mutex> M(m_state->m_mutex);
+    m_state->m_pending.push_back(task);
+  }
+  m_state->m_cond.notify_all();
+
+  /* the task added to m_queue might find that the
+     task it was made for was already run by wait().
+   */
+  m_queue.add([state]() {
+      std::unique_lock<std::mutex> M(state->m_mutex);
+      state->run_one(M);
+    });
+}
+
+void
+fastuidraw::detail::TaskGroup::
+wait(void)
+{
+  std::unique_lock<std::mutex> M(m_state->m_mutex);
+  for(;;)
+    {
+      if(m_state->run_one(M))
+        {
+          continue;
+        }
+
+      if(m_state->m_running == 0)
+        {
+          return;
+        }
+      m_state->m_cond.wait(M);
+    }
+}
@@ -0,0 +1,154 @@
+/*!
+ * \file task_queue.hpp
+ * \brief file task_queue.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/math.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    /* A TaskQueue runs tasks in FIFO order on a set of worker
+       threads. The threads are only started on the first call
+       to add(). Tasks that have not started when the TaskQueue
+       is destroyed are dropped (after their cancel functions,
+       see add(), are called), tasks that are running are
+       waited on; hence a task that references data whose
+       lifetime is not tied to the task must itself check
+       that the data is still alive.
+     */
+    class TaskQueue:fastuidraw::noncopyable
+    {
+    public:
+      typedef std::function<void ()> Task;
+
+      explicit
+      TaskQueue(unsigned int number_threads);
+
+      ~TaskQueue();
+
+      unsigned int
+      number_threads(void) const
+      {
+        return m_number_threads;
+      }
+
+      /* add a task; if cancel is non-empty it is called in
+         place of task when the TaskQueue is destroyed before
+         task started, so that anything waiting on the task
+         can be released. The cancel functions of all dropped
+         tasks are called before any dropped task is destroyed.
+       */
+      void
+      add(const Task &task, const Task &cancel = Task());
+
+      /* The TaskQueue used by fastuidraw for background work,
+         it has one fewer thread than the number of hardware
+         threads (but at least one).
+       */
+      static
+      TaskQueue&
+      background(void);
+
+    private:
+      class Entry
+      {
+      public:
+        Task m_task, m_cancel;
+      };
+
+      void
+      worker(void);
+
+      unsigned int m_number_threads;
+      std::mutex m_mutex;
+      std::condition_variable m_cond;
+      std::deque<Entry> m_tasks;
+      std::vector<std::thread> m_threads;
+      bool m_stop;
+    };
+
+    /* A TaskGroup hands tasks to a TaskQueue and waits for
+       them to complete; a task of a TaskGroup may add more
+       tasks to the same TaskGroup. While waiting, wait() runs
+       the tasks of the group that have not yet started on the
+       calling thread, so waiting never depends on a thread of
+       the TaskQueue being free and a task of a TaskQueue may
+       itself create and wait on a TaskGroup.
+     */
+    class TaskGroup:fastuidraw::noncopyable
+    {
+    public:
+      explicit
+      TaskGroup(TaskQueue &queue = TaskQueue::background());
+
+      /* waits for all tasks of the group */
+      ~TaskGroup();
+
+      void
+      add(const TaskQueue::Task &task);
+
+      void
+      wait(void);
+
+    private:
+      class State;
+
+      TaskQueue &m_queue;
+      reference_counted_ptr<State> m_state;
+    };
+
+    /* Calls f(begin, end) for consecutive ranges of at most
+       block_size elements covering [0, count). If parallel
+       is true, the ranges are run as the tasks of a TaskGroup
+       and the call returns once all of them have completed.
+       The ranges must not write to common data.
+     */
+    template<typename F>
+    void
+    for_each_block(unsigned int count, unsigned int block_size,
+                   bool parallel, const F &f)
+    {
+      if(!parallel || count <= block_size)
+        {
+          f(0u, count);
+          return;
+        }
+
+      TaskGroup group;
+      for(unsigned int begin = 0; begin < count; begin += block_size)
+        {
+          unsigned int end;
+
+          end = t_min(begin + block_size, count);
+          group.add([&f, begin, end]() { f(begin, end); });
+        }
+      group.wait();
+    }
+  }
+}
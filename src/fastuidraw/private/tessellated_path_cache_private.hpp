@@ -0,0 +1,80 @@
+/*!
+ * \file tessellated_path_cache_private.hpp
+ * \brief file tessellated_path_cache_private.hpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <list>
+#include <fastuidraw/tessellated_path.hpp>
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    class TessellatedPathCacheImplement;
+
+    /* A TessellatedPathCacheEntry is how a Path holds one of its
+       levels of detail that is in the TessellatedPathCache. The
+       Path holds a reference to the entry; the cache holds (a
+       plain pointer to) the entry while the entry holds the
+       TessellatedPath. Evicting an entry drops its TessellatedPath;
+       destroying an entry removes it from the cache.
+     */
+    class TessellatedPathCacheEntry:
+      public reference_counted<TessellatedPathCacheEntry>::default_base
+    {
+    public:
+      /* Add a TessellatedPath to the cache, counting as a miss;
+         may evict other entries to stay within budget.
+       */
+      static
+      reference_counted_ptr<TessellatedPathCacheEntry>
+      create(const reference_counted_ptr<const TessellatedPath> &path);
+
+      ~TessellatedPathCacheEntry();
+
+      /* Returns the TessellatedPath of the entry and marks it as
+         the most recently used, counting as a hit; returns nullptr
+         if the entry has been evicted.
+       */
+      reference_counted_ptr<const TessellatedPath>
+      fetch(void);
+
+      /* The value of TessellatedPath::effective_curve_distance_threshhold()
+         of the TessellatedPath, still available after eviction.
+       */
+      float
+      effective_curve_distance_threshhold(void) const
+      {
+        return m_thresh;
+      }
+
+    private:
+      friend class TessellatedPathCacheImplement;
+
+      explicit
+      TessellatedPathCacheEntry(const reference_counted_ptr<const TessellatedPath> &path);
+
+      reference_counted_ptr<const TessellatedPath> m_path;
+      float m_thresh;
+      size_t m_bytes;
+      bool m_in_cache;
+      std::list<TessellatedPathCacheEntry*>::iterator m_location;
+    };
+  }
+}
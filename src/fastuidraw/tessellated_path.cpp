@@ -17,23 +17,58 @@
  */
 
 
-#include <list>
 #include <vector>
+#include <algorithm>
+#include <atomic>
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
 #include <fastuidraw/painter/stroked_path.hpp>
 #include <fastuidraw/painter/filled_path.hpp>
+#include <fastuidraw/painter/painter_attribute_data.hpp>
 #include "private/util_private.hpp"
+#include "private/half_float.hpp"
 
 namespace
 {
+  class EdgeData
+  {
+  public:
+    float m_length;
+    float m_distance_from_contour_start;
+
+    /* derivatives of the edge are stored divided by
+       m_derivative_scale when using compact storage
+     */
+    float m_derivative_scale;
+  };
+
   class TessellatedPathPrivate
   {
   public:
     TessellatedPathPrivate(const fastuidraw::Path &input,
                            fastuidraw::TessellatedPath::TessellationParams TP);
 
+    void
+    add_edge_points(fastuidraw::c_array<const fastuidraw::TessellatedPath::point> pts,
+                    EdgeData &edge);
+
+    void
+    build_point_data(void);
+
     std::vector<std::vector<fastuidraw::range_type<unsigned int> > > m_edge_ranges;
+    std::vector<std::vector<EdgeData> > m_edge_data;
+    std::vector<float> m_open_contour_length, m_closed_contour_length;
+
+    /* if m_params.m_compact_storage is true, the point data
+       is stored in the following arrays and m_point_data is
+       only built on demand.
+     */
+    std::vector<fastuidraw::vec2> m_positions;
+    std::vector<uint32_t> m_derivatives;
+    std::vector<float> m_distances_from_edge_start;
+    fastuidraw::mutex m_point_data_mutex;
+    std::atomic<bool> m_point_data_ready;
+
     std::vector<fastuidraw::TessellatedPath::point> m_point_data;
     fastuidraw::vec2 m_box_min, m_box_max;
     fastuidraw::TessellatedPath::TessellationParams m_params;
@@ -42,6 +77,13 @@ namespace
     unsigned int m_max_segments;
     fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_stroked;
     fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_filled;
+
+    /* m_stroked and m_filled are created lazily; once the
+       flag is set, the value is never changed again and
+       can be read without locking the mutex.
+     */
+    fastuidraw::mutex m_stroked_mutex, m_filled_mutex;
+    std::atomic<bool> m_stroked_ready, m_filled_ready;
   };
 }
 
@@ -51,32 +93,36 @@ TessellatedPathPrivate::
 TessellatedPathPrivate(const fastuidraw::Path &input,
                        fastuidraw::TessellatedPath::TessellationParams TP):
   m_edge_ranges(input.number_contours()),
+  m_edge_data(input.number_contours()),
+  m_open_contour_length(input.number_contours(), 0.0f),
+  m_closed_contour_length(input.number_contours(), 0.0f),
+  m_point_data_ready(!TP.m_compact_storage),
   m_box_min(0.0f, 0.0f),
   m_box_max(0.0f, 0.0f),
   m_params(TP),
   m_effective_curve_distance_threshhold(0.0f),
   m_effective_curvature_threshhold(0.0f),
-  m_max_segments(0u)
+  m_max_segments(0u),
+  m_stroked_ready(false),
+  m_filled_ready(false)
 {
   if(input.number_contours() > 0)
     {
-      std::list<std::vector<fastuidraw::TessellatedPath::point> > temp;
       std::vector<fastuidraw::TessellatedPath::point> work_room(m_params.m_max_segments + 1);
-      std::list<std::vector<fastuidraw::TessellatedPath::point> >::const_iterator iter, end_iter;
 
       for(unsigned int loc = 0, o = 0, endo = input.number_contours(); o < endo; ++o)
         {
           fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
           float contour_length(0.0f), open_contour_length(0.0f), closed_contour_length(0.0f);
-          std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator start_contour;
+          unsigned int contour_start(loc);
 
           m_edge_ranges[o].resize(contour->number_points());
+          m_edge_data[o].resize(contour->number_points());
           for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
             {
               unsigned int needed;
               float thresh_dist(0.0f), thresh_curvature(0.0f);
 
-              temp.push_back(std::vector<fastuidraw::TessellatedPath::point>());
               needed = contour->interpolator(e)->produce_tessellation(m_params,
                                                                       fastuidraw::make_c_array(work_room),
                                                                       &thresh_dist,
@@ -108,15 +154,12 @@ TessellatedPathPrivate(const fastuidraw::Path &input,
                       m_box_max.y() = std::max(m_box_max.y(), pt.y());
                     }
                 }
-              std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator t;
-              t = temp.insert(temp.end(),
-                              std::vector<fastuidraw::TessellatedPath::point>(work_room.begin(), work_room.begin() + needed));
-              if(e == 0)
-                {
-                  start_contour = t;
-                }
 
-              contour_length = temp.back().back().m_distance_from_contour_start;
+              m_edge_data[o][e].m_length = work_room[needed - 1].m_distance_from_edge_start;
+              m_edge_data[o][e].m_distance_from_contour_start = contour_length;
+              add_edge_points(fastuidraw::make_c_array(work_room).sub_array(0, needed), m_edge_data[o][e]);
+
+              contour_length = work_room[needed - 1].m_distance_from_contour_start;
 
               if(e + 2 == ende)
                 {
@@ -126,43 +169,179 @@ TessellatedPathPrivate(const fastuidraw::Path &input,
                 {
                   closed_contour_length = contour_length;
                 }
-
-              for(unsigned int n = 0; n < needed; ++n)
-                {
-                  (*t)[n].m_edge_length = (*t)[needed - 1].m_distance_from_edge_start;
-                }
             }
 
-          for(std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator
-                t = start_contour, endt = temp.end(); t != endt; ++t)
+          m_open_contour_length[o] = open_contour_length;
+          m_closed_contour_length[o] = closed_contour_length;
+          for(unsigned int i = contour_start, endi = m_point_data.size(); i < endi; ++i)
             {
-              for(unsigned int e = 0, ende = t->size(); e < ende; ++e)
-                {
-                  (*t)[e].m_open_contour_length = open_contour_length;
-                  (*t)[e].m_closed_contour_length = closed_contour_length;
-                }
+              m_point_data[i].m_open_contour_length = open_contour_length;
+              m_point_data[i].m_closed_contour_length = closed_contour_length;
             }
         }
 
-      unsigned int total_needed;
+      m_point_data.shrink_to_fit();
+      m_positions.shrink_to_fit();
+      m_derivatives.shrink_to_fit();
+      m_distances_from_edge_start.shrink_to_fit();
+    }
+  else
+    {
+      m_box_min = m_box_max = fastuidraw::vec2(0.0f, 0.0f);
+    }
+}
 
-      total_needed = m_edge_ranges.back().back().m_end;
-      m_point_data.reserve(total_needed);
-      for(iter = temp.begin(), end_iter = temp.end(); iter != end_iter; ++iter)
+void
+TessellatedPathPrivate::
+add_edge_points(fastuidraw::c_array<const fastuidraw::TessellatedPath::point> pts,
+                EdgeData &edge)
+{
+  if(!m_params.m_compact_storage)
+    {
+      edge.m_derivative_scale = 1.0f;
+      for(const fastuidraw::TessellatedPath::point &pt : pts)
         {
-          std::copy(iter->begin(), iter->end(),
-                    std::back_insert_iterator<std::vector<fastuidraw::TessellatedPath::point> >(m_point_data));
+          m_point_data.push_back(pt);
+          m_point_data.back().m_edge_length = edge.m_length;
         }
-      FASTUIDRAWassert(total_needed == m_point_data.size());
+      return;
     }
-  else
+
+  /* the derivatives are stored relative to the largest
+     derivative component of the edge, so that the half
+     precision values neither overflow nor lose precision
+     for paths with large coordinates.
+   */
+  float scale(0.0f), inv_scale;
+  for(const fastuidraw::TessellatedPath::point &pt : pts)
     {
-      m_box_min = m_box_max = fastuidraw::vec2(0.0f, 0.0f);
+      scale = fastuidraw::t_max(scale, fastuidraw::t_abs(pt.m_p_t.x()));
+      scale = fastuidraw::t_max(scale, fastuidraw::t_abs(pt.m_p_t.y()));
+    }
+  scale = (scale > 0.0f) ? scale : 1.0f;
+  inv_scale = 1.0f / scale;
+  edge.m_derivative_scale = scale;
+
+  for(const fastuidraw::TessellatedPath::point &pt : pts)
+    {
+      m_positions.push_back(pt.m_p);
+      m_derivatives.push_back(fastuidraw::detail::pack_half2(inv_scale * pt.m_p_t));
+      m_distances_from_edge_start.push_back(pt.m_distance_from_edge_start);
+    }
+}
+
+void
+TessellatedPathPrivate::
+build_point_data(void)
+{
+  fastuidraw::autolock_mutex m(m_point_data_mutex);
+  if(m_point_data_ready.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+  m_point_data.reserve(m_positions.size());
+  for(unsigned int o = 0, endo = m_edge_ranges.size(); o < endo; ++o)
+    {
+      for(unsigned int e = 0, ende = m_edge_ranges[o].size(); e < ende; ++e)
+        {
+          const EdgeData &edge(m_edge_data[o][e]);
+          for(unsigned int I = m_edge_ranges[o][e].m_begin; I < m_edge_ranges[o][e].m_end; ++I)
+            {
+              fastuidraw::TessellatedPath::point pt;
+
+              pt.m_p = m_positions[I];
+              pt.m_p_t = edge.m_derivative_scale * fastuidraw::detail::unpack_half2(m_derivatives[I]);
+              pt.m_distance_from_edge_start = m_distances_from_edge_start[I];
+              pt.m_distance_from_contour_start = edge.m_distance_from_contour_start + pt.m_distance_from_edge_start;
+              pt.m_edge_length = edge.m_length;
+              pt.m_open_contour_length = m_open_contour_length[o];
+              pt.m_closed_contour_length = m_closed_contour_length[o];
+              m_point_data.push_back(pt);
+            }
+        }
     }
+  m_point_data_ready.store(true, std::memory_order_release);
+}
+
+namespace
+{
+  /* the chunks of a PainterAttributeData are usually sub-arrays of
+     the same array, possibly overlapping, so take the span of the
+     chunks instead of summing their sizes.
+   */
+  template<typename T>
+  size_t
+  chunks_span_bytes(fastuidraw::c_array<const fastuidraw::c_array<const T> > chunks)
+  {
+    const T *begin(nullptr), *end(nullptr);
+    for(const fastuidraw::c_array<const T> &chunk : chunks)
+      {
+        if(chunk.empty())
+          {
+            continue;
+          }
+        begin = (begin == nullptr) ? chunk.c_ptr() : std::min(begin, chunk.c_ptr());
+        end = (end == nullptr) ? chunk.c_ptr() + chunk.size() : std::max(end, chunk.c_ptr() + chunk.size());
+      }
+    return (end - begin) * sizeof(T);
+  }
+
+  size_t
+  attribute_data_bytes(const fastuidraw::PainterAttributeData &data)
+  {
+    return chunks_span_bytes(data.attribute_data_chunks())
+      + chunks_span_bytes(data.index_data_chunks());
+  }
 }
 
 //////////////////////////////////////
 // fastuidraw::TessellatedPath methods
+size_t
+fastuidraw::TessellatedPath::
+approximate_memory_usage(void) const
+{
+  TessellatedPathPrivate *d;
+  size_t return_value;
+
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+  return_value = sizeof(TessellatedPathPrivate)
+    + d->m_positions.capacity() * sizeof(vec2)
+    + d->m_derivatives.capacity() * sizeof(uint32_t)
+    + d->m_distances_from_edge_start.capacity() * sizeof(float);
+
+  /* with compact storage, m_point_data is built lazily by
+     build_point_data(), possibly by another thread; it is
+     only counted once m_point_data_ready says it is done
+     and no longer changes.
+   */
+  if(d->m_point_data_ready.load(std::memory_order_acquire))
+    {
+      return_value += d->m_point_data.capacity() * sizeof(TessellatedPath::point);
+    }
+
+  for(unsigned int o = 0, endo = d->m_edge_ranges.size(); o < endo; ++o)
+    {
+      return_value += d->m_edge_ranges[o].size() * (sizeof(range_type<unsigned int>) + sizeof(EdgeData));
+    }
+
+  /* the joins and caps of a StrokedPath are made lazily and are
+     not counted; the triangulation of a FilledPath is estimated
+     as one vertex and one triangle per point of the tessellation.
+   */
+  if(d->m_stroked_ready.load(std::memory_order_acquire))
+    {
+      return_value += attribute_data_bytes(d->m_stroked->edges());
+    }
+
+  if(d->m_filled_ready.load(std::memory_order_acquire))
+    {
+      return_value += number_points() * (sizeof(PainterAttribute) + 3 * sizeof(PainterIndex));
+    }
+
+  return return_value;
+}
+
 fastuidraw::TessellatedPath::
 TessellatedPath(const Path &input,
                 fastuidraw::TessellatedPath::TessellationParams TP)
@@ -182,12 +361,24 @@ fastuidraw::TessellatedPath::
 const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>&
 fastuidraw::TessellatedPath::
 stroked(void) const
+{
+  return stroked(false);
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>&
+fastuidraw::TessellatedPath::
+stroked(bool parallel_build) const
 {
   TessellatedPathPrivate *d;
   d = static_cast<TessellatedPathPrivate*>(m_d);
-  if(!d->m_stroked)
+  if(!d->m_stroked_ready.load(std::memory_order_acquire))
     {
-      d->m_stroked = FASTUIDRAWnew StrokedPath(*this);
+      autolock_mutex m(d->m_stroked_mutex);
+      if(!d->m_stroked)
+        {
+          d->m_stroked = FASTUIDRAWnew StrokedPath(*this, parallel_build);
+          d->m_stroked_ready.store(true, std::memory_order_release);
+        }
     }
   return d->m_stroked;
 }
@@ -195,12 +386,24 @@ stroked(void) const
 const fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath>&
 fastuidraw::TessellatedPath::
 filled(void) const
+{
+  return filled(false);
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath>&
+fastuidraw::TessellatedPath::
+filled(bool parallel_build) const
 {
   TessellatedPathPrivate *d;
   d = static_cast<TessellatedPathPrivate*>(m_d);
-  if(!d->m_filled)
+  if(!d->m_filled_ready.load(std::memory_order_acquire))
     {
-      d->m_filled = FASTUIDRAWnew FilledPath(*this);
+      autolock_mutex m(d->m_filled_mutex);
+      if(!d->m_filled)
+        {
+          d->m_filled = FASTUIDRAWnew FilledPath(*this, parallel_build);
+          d->m_filled_ready.store(true, std::memory_order_release);
+        }
     }
   return d->m_filled;
 }
@@ -249,9 +452,143 @@ point_data(void) const
   TessellatedPathPrivate *d;
   d = static_cast<TessellatedPathPrivate*>(m_d);
 
+  if(!d->m_point_data_ready.load(std::memory_order_acquire))
+    {
+      d->build_point_data();
+    }
   return make_c_array(d->m_point_data);
 }
 
+unsigned int
+fastuidraw::TessellatedPath::
+number_points(void) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return (d->m_params.m_compact_storage) ?
+    d->m_positions.size() :
+    d->m_point_data.size();
+}
+
+fastuidraw::vec2
+fastuidraw::TessellatedPath::
+point_position(unsigned int I) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return (d->m_params.m_compact_storage) ?
+    d->m_positions[I] :
+    d->m_point_data[I].m_p;
+}
+
+fastuidraw::vec2
+fastuidraw::TessellatedPath::
+point_derivative(unsigned int I) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  if(!d->m_params.m_compact_storage)
+    {
+      return d->m_point_data[I].m_p_t;
+    }
+
+  /* derivative is stored relative to the scale of its edge */
+  unsigned int o, e;
+  std::vector<std::vector<range_type<unsigned int> > >::const_iterator oiter;
+  std::vector<range_type<unsigned int> >::const_iterator eiter;
+
+  FASTUIDRAWassert(I < d->m_positions.size());
+  oiter = std::upper_bound(d->m_edge_ranges.begin(), d->m_edge_ranges.end(), I,
+                           [](unsigned int v, const std::vector<range_type<unsigned int> > &R)
+                           {
+                             return v < R.front().m_begin;
+                           });
+  FASTUIDRAWassert(oiter != d->m_edge_ranges.begin());
+  o = (oiter - d->m_edge_ranges.begin()) - 1;
+
+  eiter = std::upper_bound(d->m_edge_ranges[o].begin(), d->m_edge_ranges[o].end(), I,
+                           [](unsigned int v, const range_type<unsigned int> &R)
+                           {
+                             return v < R.m_begin;
+                           });
+  FASTUIDRAWassert(eiter != d->m_edge_ranges[o].begin());
+  e = (eiter - d->m_edge_ranges[o].begin()) - 1;
+
+  return d->m_edge_data[o][e].m_derivative_scale * detail::unpack_half2(d->m_derivatives[I]);
+}
+
+float
+fastuidraw::TessellatedPath::
+point_distance_from_edge_start(unsigned int I) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return (d->m_params.m_compact_storage) ?
+    d->m_distances_from_edge_start[I] :
+    d->m_point_data[I].m_distance_from_edge_start;
+}
+
+fastuidraw::TessellatedPath::point
+fastuidraw::TessellatedPath::
+point_value(unsigned int contour, unsigned int edge, unsigned int I) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  FASTUIDRAWassert(d->m_edge_ranges[contour][edge].m_begin <= I);
+  FASTUIDRAWassert(I < d->m_edge_ranges[contour][edge].m_end);
+  if(!d->m_params.m_compact_storage)
+    {
+      return d->m_point_data[I];
+    }
+
+  const EdgeData &E(d->m_edge_data[contour][edge]);
+  point return_value;
+
+  return_value.m_p = d->m_positions[I];
+  return_value.m_p_t = E.m_derivative_scale * detail::unpack_half2(d->m_derivatives[I]);
+  return_value.m_distance_from_edge_start = d->m_distances_from_edge_start[I];
+  return_value.m_distance_from_contour_start = E.m_distance_from_contour_start + return_value.m_distance_from_edge_start;
+  return_value.m_edge_length = E.m_length;
+  return_value.m_open_contour_length = d->m_open_contour_length[contour];
+  return_value.m_closed_contour_length = d->m_closed_contour_length[contour];
+  return return_value;
+}
+
+float
+fastuidraw::TessellatedPath::
+edge_length(unsigned int contour, unsigned int edge) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return d->m_edge_data[contour][edge].m_length;
+}
+
+float
+fastuidraw::TessellatedPath::
+open_contour_length(unsigned int contour) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return d->m_open_contour_length[contour];
+}
+
+float
+fastuidraw::TessellatedPath::
+closed_contour_length(unsigned int contour) const
+{
+  TessellatedPathPrivate *d;
+  d = static_cast<TessellatedPathPrivate*>(m_d);
+
+  return d->m_closed_contour_length[contour];
+}
+
 unsigned int
 fastuidraw::TessellatedPath::
 number_contours(void) const
@@ -295,20 +632,14 @@ fastuidraw::c_array<const fastuidraw::TessellatedPath::point>
 fastuidraw::TessellatedPath::
 contour_point_data(unsigned int contour) const
 {
-  TessellatedPathPrivate *d;
-  d = static_cast<TessellatedPathPrivate*>(m_d);
-
-  return make_c_array(d->m_point_data).sub_array(contour_range(contour));
+  return point_data().sub_array(contour_range(contour));
 }
 
 fastuidraw::c_array<const fastuidraw::TessellatedPath::point>
 fastuidraw::TessellatedPath::
 unclosed_contour_point_data(unsigned int contour) const
 {
-  TessellatedPathPrivate *d;
-  d = static_cast<TessellatedPathPrivate*>(m_d);
-
-  return make_c_array(d->m_point_data).sub_array(unclosed_contour_range(contour));
+  return point_data().sub_array(unclosed_contour_range(contour));
 }
 
 unsigned int
@@ -335,10 +666,7 @@ fastuidraw::c_array<const fastuidraw::TessellatedPath::point>
 fastuidraw::TessellatedPath::
 edge_point_data(unsigned int contour, unsigned int edge) const
 {
-  TessellatedPathPrivate *d;
-  d = static_cast<TessellatedPathPrivate*>(m_d);
-
-  return make_c_array(d->m_point_data).sub_array(edge_range(contour, edge));
+  return point_data().sub_array(edge_range(contour, edge));
 }
 
 fastuidraw::vec2
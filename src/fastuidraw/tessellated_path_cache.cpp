@@ -0,0 +1,344 @@
+/*!
+ * \file tessellated_path_cache.cpp
+ * \brief file tessellated_path_cache.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <fastuidraw/tessellated_path_cache.hpp>
+#include "private/tessellated_path_cache_private.hpp"
+#include "private/util_private.hpp"
+
+namespace fastuidraw
+{
+  namespace detail
+  {
+    class TessellatedPathCacheImplement:fastuidraw::noncopyable
+    {
+    public:
+      typedef reference_counted_ptr<const TessellatedPath> tessellated_path_ref;
+
+      static
+      TessellatedPathCacheImplement&
+      get(void)
+      {
+        /* never deleted: Path objects with static storage may
+           outlive any static object of this file.
+         */
+        static TessellatedPathCacheImplement *R = new TessellatedPathCacheImplement();
+        return *R;
+      }
+
+      void
+      add(TessellatedPathCacheEntry *entry);
+
+      tessellated_path_ref
+      fetch(TessellatedPathCacheEntry *entry);
+
+      void
+      remove(TessellatedPathCacheEntry *entry);
+
+      void
+      byte_budget(size_t v);
+
+      size_t
+      byte_budget(void);
+
+      TessellatedPathCache::statistics
+      current_statistics(void);
+
+      void
+      reset_statistics(void);
+
+      void
+      clear(void);
+
+    private:
+      TessellatedPathCacheImplement(void):
+        m_budget(0)
+      {}
+
+      void
+      unlink(TessellatedPathCacheEntry *entry);
+
+      /* evict from the back of m_lru until within budget, the
+         TessellatedPath objects are moved to dropped so that they
+         are released after m_mutex is unlocked; skips the entry
+         keep.
+       */
+      void
+      evict(std::vector<tessellated_path_ref> &dropped,
+            TessellatedPathCacheEntry *keep);
+
+      mutex m_mutex;
+      size_t m_budget;
+
+      /* most recently used entry is at the front */
+      std::list<TessellatedPathCacheEntry*> m_lru;
+      TessellatedPathCache::statistics m_stats;
+    };
+  }
+}
+
+///////////////////////////////////////////////
+// fastuidraw::detail::TessellatedPathCacheImplement methods
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+unlink(TessellatedPathCacheEntry *entry)
+{
+  FASTUIDRAWassert(entry->m_in_cache);
+  FASTUIDRAWassert(m_stats.m_bytes >= entry->m_bytes);
+  FASTUIDRAWassert(m_stats.m_number_entries > 0);
+
+  m_lru.erase(entry->m_location);
+  entry->m_in_cache = false;
+  m_stats.m_bytes -= entry->m_bytes;
+  --m_stats.m_number_entries;
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+evict(std::vector<tessellated_path_ref> &dropped,
+      TessellatedPathCacheEntry *keep)
+{
+  if(m_budget == 0)
+    {
+      return;
+    }
+
+  std::list<TessellatedPathCacheEntry*>::iterator iter(m_lru.end());
+  while(m_stats.m_bytes > m_budget && iter != m_lru.begin())
+    {
+      TessellatedPathCacheEntry *entry;
+
+      --iter;
+      entry = *iter;
+      if(entry == keep)
+        {
+          continue;
+        }
+
+      /* erasing entry invalidates only its own iterator */
+      ++iter;
+      unlink(entry);
+      dropped.push_back(entry->m_path);
+      entry->m_path = nullptr;
+      ++m_stats.m_evictions;
+    }
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+add(TessellatedPathCacheEntry *entry)
+{
+  std::vector<tessellated_path_ref> dropped;
+
+  {
+    autolock_mutex m(m_mutex);
+
+    FASTUIDRAWassert(!entry->m_in_cache);
+    m_lru.push_front(entry);
+    entry->m_location = m_lru.begin();
+    entry->m_in_cache = true;
+    m_stats.m_bytes += entry->m_bytes;
+    ++m_stats.m_number_entries;
+    ++m_stats.m_misses;
+    evict(dropped, entry);
+  }
+}
+
+fastuidraw::detail::TessellatedPathCacheImplement::tessellated_path_ref
+fastuidraw::detail::TessellatedPathCacheImplement::
+fetch(TessellatedPathCacheEntry *entry)
+{
+  std::vector<tessellated_path_ref> dropped;
+  tessellated_path_ref return_value;
+  size_t bytes(0);
+
+  {
+    autolock_mutex m(m_mutex);
+    if(!entry->m_in_cache)
+      {
+        return nullptr;
+      }
+    return_value = entry->m_path;
+  }
+
+  /* the StrokedPath or FilledPath of the TessellatedPath may have
+     been constructed since the entry was last measured; measure
+     without holding the lock of the cache.
+   */
+  bytes = return_value->approximate_memory_usage();
+
+  {
+    autolock_mutex m(m_mutex);
+    if(entry->m_in_cache)
+      {
+        m_lru.splice(m_lru.begin(), m_lru, entry->m_location);
+        m_stats.m_bytes = m_stats.m_bytes - entry->m_bytes + bytes;
+        entry->m_bytes = bytes;
+        ++m_stats.m_hits;
+        evict(dropped, entry);
+      }
+    else
+      {
+        return_value = nullptr;
+      }
+  }
+  return return_value;
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+remove(TessellatedPathCacheEntry *entry)
+{
+  autolock_mutex m(m_mutex);
+  if(entry->m_in_cache)
+    {
+      unlink(entry);
+    }
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+byte_budget(size_t v)
+{
+  std::vector<tessellated_path_ref> dropped;
+
+  {
+    autolock_mutex m(m_mutex);
+    m_budget = v;
+    evict(dropped, nullptr);
+  }
+}
+
+size_t
+fastuidraw::detail::TessellatedPathCacheImplement::
+byte_budget(void)
+{
+  autolock_mutex m(m_mutex);
+  return m_budget;
+}
+
+fastuidraw::TessellatedPathCache::statistics
+fastuidraw::detail::TessellatedPathCacheImplement::
+current_statistics(void)
+{
+  autolock_mutex m(m_mutex);
+  return m_stats;
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+reset_statistics(void)
+{
+  autolock_mutex m(m_mutex);
+  m_stats.m_hits = 0;
+  m_stats.m_misses = 0;
+  m_stats.m_evictions = 0;
+}
+
+void
+fastuidraw::detail::TessellatedPathCacheImplement::
+clear(void)
+{
+  std::vector<tessellated_path_ref> dropped;
+
+  {
+    autolock_mutex m(m_mutex);
+    while(!m_lru.empty())
+      {
+        TessellatedPathCacheEntry *entry(m_lru.back());
+
+        unlink(entry);
+        dropped.push_back(entry->m_path);
+        entry->m_path = nullptr;
+        ++m_stats.m_evictions;
+      }
+  }
+}
+
+///////////////////////////////////////////////
+// fastuidraw::detail::TessellatedPathCacheEntry methods
+fastuidraw::detail::TessellatedPathCacheEntry::
+TessellatedPathCacheEntry(const reference_counted_ptr<const TessellatedPath> &path):
+  m_path(path),
+  m_thresh(path->effective_curve_distance_threshhold()),
+  m_bytes(path->approximate_memory_usage()),
+  m_in_cache(false)
+{}
+
+fastuidraw::detail::TessellatedPathCacheEntry::
+~TessellatedPathCacheEntry()
+{
+  /* m_path is released after the lock of the cache is dropped */
+  TessellatedPathCacheImplement::get().remove(this);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::detail::TessellatedPathCacheEntry>
+fastuidraw::detail::TessellatedPathCacheEntry::
+create(const reference_counted_ptr<const TessellatedPath> &path)
+{
+  reference_counted_ptr<TessellatedPathCacheEntry> return_value;
+
+  FASTUIDRAWassert(path);
+  return_value = FASTUIDRAWnew TessellatedPathCacheEntry(path);
+  TessellatedPathCacheImplement::get().add(return_value.get());
+  return return_value;
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+fastuidraw::detail::TessellatedPathCacheEntry::
+fetch(void)
+{
+  return TessellatedPathCacheImplement::get().fetch(this);
+}
+
+///////////////////////////////////////////////
+// fastuidraw::TessellatedPathCache methods
+void
+fastuidraw::TessellatedPathCache::
+byte_budget(size_t v)
+{
+  detail::TessellatedPathCacheImplement::get().byte_budget(v);
+}
+
+size_t
+fastuidraw::TessellatedPathCache::
+byte_budget(void)
+{
+  return detail::TessellatedPathCacheImplement::get().byte_budget();
+}
+
+fastuidraw::TessellatedPathCache::statistics
+fastuidraw::TessellatedPathCache::
+current_statistics(void)
+{
+  return detail::TessellatedPathCacheImplement::get().current_statistics();
+}
+
+void
+fastuidraw::TessellatedPathCache::
+reset_statistics(void)
+{
+  detail::TessellatedPathCacheImplement::get().reset_statistics();
+}
+
+void
+fastuidraw::TessellatedPathCache::
+clear(void)
+{
+  detail::TessellatedPathCacheImplement::get().clear();
+}
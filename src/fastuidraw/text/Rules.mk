@@ -12,7 +12,7 @@ FASTUIDRAW_SOURCES += $(call filelist, glyph_atlas.cpp \
 	glyph_render_data_curve_pair.cpp \
 	glyph_render_data_distance_field.cpp \
 	glyph_render_data_coverage.cpp \
-	glyph_cache.cpp glyph_selector.cpp \
+	glyph_cache.cpp glyph_disk_cache.cpp glyph_selector.cpp \
 	freetype_face.cpp freetype_lib.cpp \
 	font_freetype.cpp font_properties.cpp)
 
@@ -17,6 +17,8 @@
  */
 
 #include <sstream>
+#include <vector>
+#include <string.h>
 #include <fastuidraw/text/font_freetype.hpp>
 #include <fastuidraw/text/glyph_layout_data.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
@@ -30,6 +32,7 @@
 
 #include <ft2build.h>
 #include FT_OUTLINE_H
+#include FT_TRUETYPE_TABLES_H
 
 namespace
 {
@@ -219,6 +222,17 @@ namespace
      */
     fastuidraw::vecN<fastuidraw::reference_counted_ptr<fastuidraw::FreeTypeFace>, 8> m_faces;
     bool m_all_faces_null;
+
+    /* value of FontFreeType::persistent_key(), computed on
+       first use with m_persistent_key_mutex locked
+     */
+    void
+    compute_persistent_key(void);
+
+    fastuidraw::mutex m_persistent_key_mutex;
+    bool m_persistent_key_computed;
+    bool m_has_persistent_key;
+    uint64_t m_persistent_key;
   };
 }
 
@@ -261,7 +275,10 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p,
   m_render_params(render_params),
   m_lib(lib),
   m_p(p),
-  m_all_faces_null(true)
+  m_all_faces_null(true),
+  m_persistent_key_computed(false),
+  m_has_persistent_key(false),
+  m_persistent_key(0u)
 {
   if(!m_lib)
     {
@@ -507,6 +524,67 @@ compute_rendering_data(uint32_t glyph_code,
                                     &output);
 }
 
+void
+FontFreeTypePrivate::
+compute_persistent_key(void)
+{
+  std::vector<FT_Byte> bytes;
+  FT_ULong length(0);
+  FT_Long face_index;
+
+  m_persistent_key_computed = true;
+
+  {
+    FaceGrabber p(this);
+    if(!p.m_p || !p.m_p->face())
+      {
+        return;
+      }
+
+    /* a tag of 0 loads the entire font file of an SFNT font */
+    FT_Face face(p.m_p->face());
+    if(FT_Load_Sfnt_Table(face, 0, 0, nullptr, &length) != 0 || length == 0)
+      {
+        return;
+      }
+
+    bytes.resize(length);
+    if(FT_Load_Sfnt_Table(face, 0, 0, &bytes[0], &length) != 0)
+      {
+        return;
+      }
+    face_index = face->face_index;
+  }
+
+  /* FNV-1a 64 over the font data followed by the values
+     that change the generated glyph data
+   */
+  uint64_t h(14695981039346656037ull);
+  uint32_t params[5];
+  float max_distance(m_render_params.distance_field_max_distance());
+
+  params[0] = static_cast<uint32_t>(face_index);
+  params[1] = m_render_params.distance_field_pixel_size();
+  memcpy(&params[2], &max_distance, sizeof(uint32_t));
+  params[3] = m_render_params.curve_pair_pixel_size();
+  params[4] = static_cast<uint32_t>(length);
+
+  for(FT_Byte b : bytes)
+    {
+      h = (h ^ b) * 1099511628211ull;
+    }
+  for(uint32_t v : params)
+    {
+      for(unsigned int i = 0; i < 4; ++i, v >>= 8u)
+        {
+          h = (h ^ (v & 0xFFu)) * 1099511628211ull;
+        }
+    }
+
+  m_persistent_key = h;
+  m_has_persistent_key = true;
+}
+
 /////////////////////////////////////////////
 // fastuidraw::FontFreeType::RenderParams methods
 fastuidraw::FontFreeType::RenderParams::
@@ -711,6 +789,22 @@ compute_rendering_data(GlyphRender render, uint32_t glyph_code,
     }
 }
 
+bool
+fastuidraw::FontFreeType::
+persistent_key(uint64_t *out_key) const
+{
+  FontFreeTypePrivate *d;
+  d = static_cast<FontFreeTypePrivate*>(m_d);
+
+  autolock_mutex m(d->m_persistent_key_mutex);
+  if(!d->m_persistent_key_computed)
+    {
+      d->compute_persistent_key();
+    }
+  *out_key = d->m_persistent_key;
+  return d->m_has_persistent_key;
+}
+
 const fastuidraw::FontFreeType::RenderParams&
 fastuidraw::FontFreeType::
 render_params(void) const
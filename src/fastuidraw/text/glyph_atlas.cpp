@@ -87,7 +87,9 @@ namespace
                       fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> pgeometry_store):
       m_texel_store(ptexel_store),
       m_geometry_store(pgeometry_store),
-      m_geometry_data_allocator(pgeometry_store->size())
+      m_geometry_data_allocator(pgeometry_store->size()),
+      m_bytes_uploaded(0),
+      m_frame(0)
     {
       FASTUIDRAWassert(m_texel_store);
       FASTUIDRAWassert(m_geometry_store);
@@ -113,6 +115,8 @@ namespace
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlasGeometryBackingStoreBase> m_geometry_store;
     std::vector<fastuidraw::reference_counted_ptr<rect_atlas_layer> > m_private_data;
     fastuidraw::interval_allocator m_geometry_data_allocator;
+    uint64_t m_bytes_uploaded;
+    uint64_t m_frame;
   };
 }
 
@@ -344,6 +348,7 @@ allocate(fastuidraw::ivec2 size, c_array<const uint8_t> pdata,
       return_value.m_opaque = r;
       d->m_texel_store->set_data(r->minX_minY().x(), r->minX_minY().y(), layer,
                                  size.x(), size.y(), pdata);
+      d->m_bytes_uploaded += pdata.size() * sizeof(uint8_t);
     }
 
   return return_value;
@@ -399,6 +404,7 @@ allocate_geometry_data(c_array<const generic_data> pdata)
     }
 
   d->m_geometry_store->set_values(return_value, pdata);
+  d->m_bytes_uploaded += pdata.size() * sizeof(generic_data);
   return return_value;
 }
 
@@ -450,6 +456,39 @@ flush(void) const
   d->m_geometry_store->flush();
 }
 
+uint64_t
+fastuidraw::GlyphAtlas::
+bytes_uploaded(void) const
+{
+  GlyphAtlasPrivate *d;
+  d = static_cast<GlyphAtlasPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_bytes_uploaded;
+}
+
+void
+fastuidraw::GlyphAtlas::
+advance_frame(void)
+{
+  GlyphAtlasPrivate *d;
+  d = static_cast<GlyphAtlasPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  ++d->m_frame;
+}
+
+uint64_t
+fastuidraw::GlyphAtlas::
+frame(void) const
+{
+  GlyphAtlasPrivate *d;
+  d = static_cast<GlyphAtlasPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_frame;
+}
+
 fastuidraw::reference_counted_ptr<const fastuidraw::GlyphAtlasTexelBackingStoreBase>
 fastuidraw::GlyphAtlas::
 texel_store(void) const
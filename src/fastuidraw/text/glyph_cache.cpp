@@ -17,11 +17,16 @@
  */
 
 
-#include <map>
+#include <algorithm>
 #include <vector>
+#include <atomic>
+#include <condition_variable>
+#include <stdint.h>
 #include <fastuidraw/text/glyph_cache.hpp>
+#include <fastuidraw/text/glyph_disk_cache.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
 #include "../private/util_private.hpp"
+#include "../private/task_queue.hpp"
 
 
 namespace
@@ -32,17 +37,33 @@ namespace
   class GlyphDataPrivate
   {
   public:
-    GlyphDataPrivate(GlyphCachePrivate *c, unsigned int I);
-
-    explicit
     GlyphDataPrivate(void);
 
     void
     clear(void);
 
+    /* free the regions of the atlas of the glyph, the
+       rendering data of the glyph is kept so that it can
+       be uploaded again.
+     */
+    void
+    remove_from_atlas(void);
+
     enum fastuidraw::return_code
     upload_to_atlas(void);
 
+    /* block until the rendering data of a glyph fetched with
+       GlyphCache::fetch_glyph_no_wait() is computed
+     */
+    void
+    wait_ready(void);
+
+    bool
+    ready(void) const
+    {
+      return m_ready.load(std::memory_order_acquire);
+    }
+
     /* owner
      */
     GlyphCachePrivate *m_cache;
@@ -51,6 +72,12 @@ namespace
      */
     unsigned int m_cache_location;
 
+    /* true if the glyph is an element of a slab of
+       GlyphCachePrivate::m_slabs instead of being
+       allocated alone (by Glyph::create_glyph())
+     */
+    bool m_in_slab;
+
     /* layout magicks
      */
     fastuidraw::GlyphLayoutData m_layout;
@@ -62,6 +89,13 @@ namespace
     int m_geometry_offset, m_geometry_length;
     bool m_uploaded_to_atlas;
 
+    /* the glyphs of a cache that are uploaded to the atlas
+       are in a list ordered by the frame of the atlas in
+       which they were last used, see GlyphCachePrivate::m_lru_head
+     */
+    GlyphDataPrivate *m_lru_prev, *m_lru_next;
+    uint64_t m_last_used_frame;
+
     /* Path of the glyph
      */
     fastuidraw::Path m_path;
@@ -69,6 +103,33 @@ namespace
     /* data to generate glyph data
      */
     fastuidraw::GlyphRenderData *m_glyph_data;
+
+    /* false while the rendering data (and m_layout, m_path
+       and m_glyph_data) of a glyph is computed, either by
+       a PendingGlyph for GlyphCache::fetch_glyph_no_wait()
+       or by the thread calling GlyphCache::fetch_glyph();
+       set to true by GlyphCachePrivate::publish_glyph() once
+       those fields are written.
+     */
+    std::atomic<bool> m_ready;
+
+    /* glyph to draw in place of the glyph until it is ready */
+    fastuidraw::Glyph m_fallback;
+  };
+
+  /* the glyphs of a GlyphCache are allocated in slabs so
+     that glyphs fetched together are near each other in
+     memory and a glyph does not cost an allocation
+   */
+  class GlyphSlab:fastuidraw::noncopyable
+  {
+  public:
+    enum
+      {
+        slab_size = 256
+      };
+
+    fastuidraw::vecN<GlyphDataPrivate, slab_size> m_glyphs;
   };
 
   class GlyphSource
@@ -86,11 +147,31 @@ namespace
     {}
 
     bool
-    operator<(const GlyphSource &rhs) const
+    operator==(const GlyphSource &rhs) const
+    {
+      return m_font == rhs.m_font
+        && m_glyph_code == rhs.m_glyph_code
+        && m_render == rhs.m_render;
+    }
+
+    uint64_t
+    hash(void) const
     {
-      return (m_font != rhs.m_font) ? m_font < rhs.m_font :
-        (m_glyph_code != rhs.m_glyph_code) ? m_glyph_code < rhs.m_glyph_code :
-        m_render < rhs.m_render;
+      uint64_t h;
+
+      /* mix the fields with the finalizer of MurmurHash3
+         so that both the low bits (slot in a shard) and the
+         high bits (the shard) of the hash are well spread.
+       */
+      h = reinterpret_cast<uintptr_t>(m_font.get());
+      h ^= (uint64_t(m_glyph_code) << 32u) ^ uint64_t(m_render.m_pixel_size);
+      h ^= uint64_t(m_render.m_type) << 24u;
+      h ^= h >> 33u;
+      h *= 0xff51afd7ed558ccdull;
+      h ^= h >> 33u;
+      h *= 0xc4ceb9fe1a85ec53ull;
+      h ^= h >> 33u;
+      return h;
     }
 
     fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
@@ -98,6 +179,66 @@ namespace
     fastuidraw::GlyphRender m_render;
   };
 
+  /* A GlyphTableShard is an open addressing hash table with
+     linear probing from GlyphSource to GlyphDataPrivate; the
+     table of GlyphCachePrivate is split into shards, each with
+     its own lock, so that threads fetching different glyphs
+     rarely contend.
+   */
+  class GlyphTableShard:fastuidraw::noncopyable
+  {
+  public:
+    GlyphTableShard(void):
+      m_size(0)
+    {}
+
+    GlyphDataPrivate*
+    find(const GlyphSource &src, uint64_t hash) const;
+
+    void
+    insert(const GlyphSource &src, uint64_t hash, GlyphDataPrivate *g);
+
+    void
+    erase(const GlyphSource &src, uint64_t hash);
+
+    void
+    clear(void);
+
+    fastuidraw::mutex m_mutex;
+
+  private:
+    class Entry
+    {
+    public:
+      Entry(void):
+        m_hash(0),
+        m_glyph(nullptr)
+      {}
+
+      GlyphSource m_src;
+      uint64_t m_hash;
+
+      /* nullptr marks an empty slot */
+      GlyphDataPrivate *m_glyph;
+    };
+
+    unsigned int
+    slot(uint64_t hash) const
+    {
+      return static_cast<unsigned int>(hash) & (m_entries.size() - 1u);
+    }
+
+    unsigned int
+    find_slot(const GlyphSource &src, uint64_t hash) const;
+
+    void
+    grow(void);
+
+    /* size is always zero or a power of 2 */
+    std::vector<Entry> m_entries;
+    unsigned int m_size;
+  };
+
   class GlyphCachePrivate
   {
   public:
@@ -113,66 +254,185 @@ namespace
         not have to regenerate data either.
      */
 
+    /* the shard of the source must be locked by the caller */
+    GlyphDataPrivate*
+    fetch_or_allocate_glyph(const GlyphSource &src, uint64_t hash);
+
+    /* fetch the rendering data of a glyph from the disk cache,
+       or compute it (and store it in the disk cache)
+     */
+    static
+    fastuidraw::GlyphRenderData*
+    compute_rendering_data(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> &disk_cache,
+                           const GlyphSource &src,
+                           fastuidraw::GlyphLayoutData &layout,
+                           fastuidraw::Path &path);
+
+    /* set the rendering data of a glyph that is not ready,
+       mark it ready and wake the threads waiting on it in
+       GlyphDataPrivate::wait_ready()
+     */
+    void
+    publish_glyph(GlyphDataPrivate *g,
+                  const fastuidraw::GlyphLayoutData &layout,
+                  fastuidraw::Path &path,
+                  fastuidraw::GlyphRenderData *data);
+
+    GlyphDataPrivate*
+    allocate_glyph(void);
+
+    void
+    release_glyph(GlyphDataPrivate *g);
+
+    /* find a glyph without allocating; the shard of the
+       source must be locked by the caller
+     */
     GlyphDataPrivate*
-    fetch_or_allocate_glyph(GlyphSource src);
+    find_glyph(const GlyphSource &src, uint64_t hash)
+    {
+      return shard(hash).find(src, hash);
+    }
+
+    /* mark the glyph as used in the named frame, moving
+       it to the front of the LRU list; if only_if_listed
+       is true, a glyph not on the list is left off it.
+     */
+    void
+    lru_touch(GlyphDataPrivate *g, uint64_t frame,
+              bool only_if_listed = false);
+
+    /* removes g from the LRU list, does nothing if g
+       is not on the list
+     */
+    void
+    lru_unlink(GlyphDataPrivate *g);
+
+    void
+    lru_reset(void);
+
+    /* lru_unlink() with m_lru_mutex already locked */
+    void
+    lru_unlink_locked(GlyphDataPrivate *g);
+
+    /* remove from the atlas up to count glyphs from the back
+       of the LRU list that are not pinned for the named frame,
+       returns the number of glyphs removed
+     */
+    unsigned int
+    evict(unsigned int count, uint64_t frame);
+
+    GlyphTableShard&
+    shard(uint64_t hash)
+    {
+      return m_shards[hash >> (64u - log2_number_shards)];
+    }
+
+    enum
+      {
+        log2_number_shards = 4,
+        number_shards = 1u << log2_number_shards
+      };
 
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_atlas;
-    std::map<GlyphSource, GlyphDataPrivate*> m_glyph_map;
+    fastuidraw::vecN<GlyphTableShard, number_shards> m_shards;
+
+    /* m_glyphs, m_free_slots and m_slabs are accessed
+       with m_allocation_mutex locked; m_slab_used is the
+       number of glyphs of m_slabs.back() in use.
+     */
+    fastuidraw::mutex m_allocation_mutex;
     std::vector<GlyphDataPrivate*> m_glyphs;
     std::vector<unsigned int> m_free_slots;
+    std::vector<GlyphSlab*> m_slabs;
+    unsigned int m_slab_used;
     fastuidraw::GlyphCache *m_p;
+
+    /* publish_glyph() sets GlyphDataPrivate::m_ready with
+       m_pending_mutex locked and signals m_pending_cond
+     */
+    fastuidraw::mutex m_pending_mutex;
+    std::condition_variable_any m_pending_cond;
+    std::atomic<unsigned int> m_number_pending;
+
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> m_disk_cache;
+
+    /* most recently used glyph is at the head; the list and
+       GlyphDataPrivate::m_last_used_frame are accessed with
+       m_lru_mutex locked since Glyph::mark_used() may be
+       called by several threads (for example by recording
+       streams of a Painter).
+     */
+    fastuidraw::mutex m_lru_mutex;
+    GlyphDataPrivate *m_lru_head, *m_lru_tail;
+    bool m_lru_eviction;
+    unsigned int m_pinned_frames;
+    unsigned int m_number_evictions;
+  };
+
+  /* A PendingGlyph is the task that computes on a background
+     thread the rendering data of a glyph requested by
+     GlyphCache::fetch_glyph_no_wait(); it holds a reference
+     to the GlyphCache so that the cache outlives the task.
+   */
+  class PendingGlyph:
+    public fastuidraw::reference_counted<PendingGlyph>::default_base
+  {
+  public:
+    PendingGlyph(GlyphDataPrivate *g, const GlyphSource &src,
+                 const fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> &disk_cache):
+      m_glyph(g),
+      m_src(src),
+      m_cache(g->m_cache->m_p),
+      m_disk_cache(disk_cache)
+    {}
+
+    void
+    run(void);
+
+    /* called in place of run() if the task is dropped,
+       publishes the glyph without rendering data so that
+       nothing waits on it forever.
+     */
+    void
+    cancel(void);
+
+  private:
+    GlyphDataPrivate *m_glyph;
+    GlyphSource m_src;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache> m_cache;
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> m_disk_cache;
   };
 }
 
 /////////////////////////////////////////////////////////
 // GlyphDataPrivate methods
-GlyphDataPrivate::
-GlyphDataPrivate(GlyphCachePrivate *c, unsigned int I):
-  m_cache(c),
-  m_cache_location(I),
-  m_geometry_offset(-1),
-  m_geometry_length(0),
-  m_uploaded_to_atlas(false),
-  m_glyph_data(nullptr)
-{}
-
 GlyphDataPrivate::
 GlyphDataPrivate(void):
   m_cache(nullptr),
   m_cache_location(~0u),
+  m_in_slab(false),
   m_geometry_offset(-1),
   m_geometry_length(0),
   m_uploaded_to_atlas(false),
-  m_glyph_data(nullptr)
+  m_lru_prev(nullptr),
+  m_lru_next(nullptr),
+  m_last_used_frame(0),
+  m_glyph_data(nullptr),
+  m_ready(true)
 {}
 
 void
 GlyphDataPrivate::
 clear(void)
 {
+  wait_ready();
+  m_fallback = fastuidraw::Glyph();
   m_render = fastuidraw::GlyphRender();
   FASTUIDRAWassert(!m_render.valid());
 
   if(m_cache)
     {
-      if(m_atlas_location[0].valid())
-        {
-          m_cache->m_atlas->deallocate(m_atlas_location[0]);
-          m_atlas_location[0] = fastuidraw::GlyphLocation();
-        }
-
-      if(m_atlas_location[1].valid())
-        {
-          m_cache->m_atlas->deallocate(m_atlas_location[1]);
-          m_atlas_location[1] = fastuidraw::GlyphLocation();
-        }
-
-      if(m_geometry_offset != -1)
-        {
-          m_cache->m_atlas->deallocate_geometry_data(m_geometry_offset, m_geometry_length);
-          m_geometry_offset = -1;
-          m_geometry_length = 0;
-        }
+      remove_from_atlas();
     }
 
   m_uploaded_to_atlas = false;
@@ -184,6 +444,37 @@ clear(void)
   m_path.clear();
 }
 
+void
+GlyphDataPrivate::
+remove_from_atlas(void)
+{
+  FASTUIDRAWassert(m_cache);
+  if(m_uploaded_to_atlas)
+    {
+      m_cache->lru_unlink(this);
+      m_uploaded_to_atlas = false;
+    }
+
+  if(m_atlas_location[0].valid())
+    {
+      m_cache->m_atlas->deallocate(m_atlas_location[0]);
+      m_atlas_location[0] = fastuidraw::GlyphLocation();
+    }
+
+  if(m_atlas_location[1].valid())
+    {
+      m_cache->m_atlas->deallocate(m_atlas_location[1]);
+      m_atlas_location[1] = fastuidraw::GlyphLocation();
+    }
+
+  if(m_geometry_offset != -1)
+    {
+      m_cache->m_atlas->deallocate_geometry_data(m_geometry_offset, m_geometry_length);
+      m_geometry_offset = -1;
+      m_geometry_length = 0;
+    }
+}
+
 enum fastuidraw::return_code
 GlyphDataPrivate::
 upload_to_atlas(void)
@@ -195,26 +486,59 @@ upload_to_atlas(void)
         at the same time).
    */
   enum fastuidraw::return_code return_value;
+  uint64_t frame;
 
-  if(m_uploaded_to_atlas)
+  if(!m_cache)
     {
-      return fastuidraw::routine_success;
+      return m_uploaded_to_atlas ?
+        fastuidraw::routine_success :
+        fastuidraw::routine_fail;
     }
 
-  if(!m_cache)
+  /* a glyph whose computation was canceled (see
+     PendingGlyph::cancel()) has no rendering data
+   */
+  if(!ready() || !m_glyph_data)
     {
       return fastuidraw::routine_fail;
     }
 
-  FASTUIDRAWassert(m_glyph_data);
+  frame = m_cache->m_atlas->frame();
+  if(m_uploaded_to_atlas)
+    {
+      m_cache->lru_touch(this, frame);
+      return fastuidraw::routine_success;
+    }
+
   return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
                                                m_atlas_location[0],
                                                m_atlas_location[1],
                                                m_geometry_offset,
                                                m_geometry_length);
+
+  /* if the atlas is full, free the regions of the least
+     recently used glyphs until this glyph fits; the number
+     of glyphs evicted doubles with each failed attempt so
+     that a large glyph does not need one attempt per glyph
+     evicted.
+   */
+  for(unsigned int count = 1;
+      return_value != fastuidraw::routine_success
+        && m_cache->m_lru_eviction
+        && m_cache->evict(count, frame) > 0;
+      count *= 2)
+    {
+      return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
+                                                   m_atlas_location[0],
+                                                   m_atlas_location[1],
+                                                   m_geometry_offset,
+                                                   m_geometry_length);
+    }
+
   if(return_value == fastuidraw::routine_success)
     {
       m_uploaded_to_atlas = true;
+      m_cache->lru_touch(this, frame);
     }
 
   return return_value;
@@ -222,13 +546,182 @@ upload_to_atlas(void)
 
 
 
+void
+GlyphDataPrivate::
+wait_ready(void)
+{
+  if(ready())
+    {
+      return;
+    }
+
+  FASTUIDRAWassert(m_cache);
+  std::unique_lock<fastuidraw::mutex> m(m_cache->m_pending_mutex);
+  m_cache->m_pending_cond.wait(m, [this]() { return ready(); });
+}
+
+//////////////////////////////////////////////
+// PendingGlyph methods
+void
+PendingGlyph::
+run(void)
+{
+  fastuidraw::GlyphLayoutData layout;
+  fastuidraw::Path path;
+  fastuidraw::GlyphRenderData *data;
+  GlyphCachePrivate *c(m_glyph->m_cache);
+
+  /* the fields of the glyph are not read until m_ready is
+     set, so the data is computed without holding a lock.
+   */
+  data = GlyphCachePrivate::compute_rendering_data(m_disk_cache, m_src, layout, path);
+  c->publish_glyph(m_glyph, layout, path, data);
+  --c->m_number_pending;
+}
+
+void
+PendingGlyph::
+cancel(void)
+{
+  fastuidraw::GlyphLayoutData layout;
+  fastuidraw::Path path;
+  GlyphCachePrivate *c(m_glyph->m_cache);
+
+  c->publish_glyph(m_glyph, layout, path, nullptr);
+  --c->m_number_pending;
+}
+
+/////////////////////////////////////////////////
+// GlyphTableShard methods
+unsigned int
+GlyphTableShard::
+find_slot(const GlyphSource &src, uint64_t hash) const
+{
+  unsigned int mask(m_entries.size() - 1u), I;
+
+  /* the table is never full, so the probe ends at
+     the entry of src or at an empty slot
+   */
+  for(I = slot(hash); m_entries[I].m_glyph; I = (I + 1u) & mask)
+    {
+      if(m_entries[I].m_hash == hash && m_entries[I].m_src == src)
+        {
+          break;
+        }
+    }
+  return I;
+}
+
+GlyphDataPrivate*
+GlyphTableShard::
+find(const GlyphSource &src, uint64_t hash) const
+{
+  if(m_size == 0)
+    {
+      return nullptr;
+    }
+  return m_entries[find_slot(src, hash)].m_glyph;
+}
+
+void
+GlyphTableShard::
+insert(const GlyphSource &src, uint64_t hash, GlyphDataPrivate *g)
+{
+  unsigned int I;
+
+  FASTUIDRAWassert(g);
+  /* keep the load factor at most 1/2 to keep probes short */
+  if(2u * (m_size + 1u) > m_entries.size())
+    {
+      grow();
+    }
+
+  I = find_slot(src, hash);
+  FASTUIDRAWassert(!m_entries[I].m_glyph);
+  m_entries[I].m_src = src;
+  m_entries[I].m_hash = hash;
+  m_entries[I].m_glyph = g;
+  ++m_size;
+}
+
+void
+GlyphTableShard::
+erase(const GlyphSource &src, uint64_t hash)
+{
+  unsigned int mask, I;
+
+  if(m_size == 0)
+    {
+      return;
+    }
+
+  I = find_slot(src, hash);
+  if(!m_entries[I].m_glyph)
+    {
+      return;
+    }
+
+  /* backward shift deletion: move each following entry
+     of the probe sequence into the hole if the hole lies
+     between the entry and its home slot, so that no
+     tombstones are needed.
+   */
+  mask = m_entries.size() - 1u;
+  for(unsigned int J = (I + 1u) & mask; m_entries[J].m_glyph; J = (J + 1u) & mask)
+    {
+      unsigned int H(slot(m_entries[J].m_hash));
+      if(((J - H) & mask) >= ((J - I) & mask))
+        {
+          m_entries[I] = m_entries[J];
+          I = J;
+        }
+    }
+  m_entries[I] = Entry();
+  --m_size;
+}
+
+void
+GlyphTableShard::
+grow(void)
+{
+  std::vector<Entry> old_entries;
+
+  old_entries.swap(m_entries);
+  m_entries.resize(std::max(size_t(16), 2u * old_entries.size()));
+  for(const Entry &e : old_entries)
+    {
+      if(e.m_glyph)
+        {
+          unsigned int mask(m_entries.size() - 1u), I;
+          for(I = slot(e.m_hash); m_entries[I].m_glyph; I = (I + 1u) & mask)
+            {}
+          m_entries[I] = e;
+        }
+    }
+}
+
+void
+GlyphTableShard::
+clear(void)
+{
+  m_entries.clear();
+  m_size = 0;
+}
+
 /////////////////////////////////////////////////
 // GlyphCachePrivate methods
 GlyphCachePrivate::
 GlyphCachePrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> patlas,
                   fastuidraw::GlyphCache *p):
   m_atlas(patlas),
-  m_p(p)
+  m_slab_used(GlyphSlab::slab_size),
+  m_p(p),
+  m_number_pending(0),
+  m_lru_head(nullptr),
+  m_lru_tail(nullptr),
+  m_lru_eviction(false),
+  m_pinned_frames(2),
+  m_number_evictions(0)
 {}
 
 GlyphCachePrivate::
@@ -237,42 +730,240 @@ GlyphCachePrivate::
   for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
     {
       m_glyphs[i]->clear();
-      FASTUIDRAWdelete(m_glyphs[i]);
+      if(!m_glyphs[i]->m_in_slab)
+        {
+          FASTUIDRAWdelete(m_glyphs[i]);
+        }
     }
-}
 
+  for(GlyphSlab *slab : m_slabs)
+    {
+      FASTUIDRAWdelete(slab);
+    }
+}
 
 GlyphDataPrivate*
 GlyphCachePrivate::
-fetch_or_allocate_glyph(GlyphSource src)
+fetch_or_allocate_glyph(const GlyphSource &src, uint64_t hash)
 {
-  std::map<GlyphSource, GlyphDataPrivate*>::iterator iter;
+  GlyphTableShard &S(shard(hash));
   GlyphDataPrivate *G;
 
-  iter = m_glyph_map.find(src);
-  if(iter != m_glyph_map.end())
+  G = S.find(src, hash);
+  if(!G)
     {
-      return iter->second;
+      G = allocate_glyph();
+      S.insert(src, hash, G);
     }
+  return G;
+}
 
+GlyphDataPrivate*
+GlyphCachePrivate::
+allocate_glyph(void)
+{
+  fastuidraw::autolock_mutex m(m_allocation_mutex);
+  GlyphDataPrivate *G;
 
-  if(m_free_slots.empty())
+  if(!m_free_slots.empty())
     {
-      G = FASTUIDRAWnew GlyphDataPrivate(this, m_glyphs.size());
-      m_glyphs.push_back(G);
-      FASTUIDRAWassert(!G->m_render.valid());
+      G = m_glyphs[m_free_slots.back()];
+      m_free_slots.pop_back();
     }
   else
     {
-      unsigned int v(m_free_slots.back());
-      m_free_slots.pop_back();
-      G = m_glyphs[v];
-      FASTUIDRAWassert(!G->m_render.valid());
+      if(m_slab_used == GlyphSlab::slab_size)
+        {
+          m_slabs.push_back(FASTUIDRAWnew GlyphSlab());
+          m_slab_used = 0;
+        }
+
+      G = &m_slabs.back()->m_glyphs[m_slab_used++];
+      G->m_cache = this;
+      G->m_cache_location = m_glyphs.size();
+      G->m_in_slab = true;
+      m_glyphs.push_back(G);
     }
-  m_glyph_map[src] = G;
+
+  FASTUIDRAWassert(!G->m_render.valid());
   return G;
 }
 
+fastuidraw::GlyphRenderData*
+GlyphCachePrivate::
+compute_rendering_data(const fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache> &disk_cache,
+                       const GlyphSource &src,
+                       fastuidraw::GlyphLayoutData &layout,
+                       fastuidraw::Path &path)
+{
+  fastuidraw::GlyphRenderData *data(nullptr);
+
+  if(disk_cache)
+    {
+      data = disk_cache->fetch(src.m_font, src.m_render, src.m_glyph_code, layout, path);
+      if(data)
+        {
+          return data;
+        }
+    }
+
+  data = src.m_font->compute_rendering_data(src.m_render, src.m_glyph_code, layout, path);
+  if(disk_cache && data)
+    {
+      disk_cache->store(src.m_font, src.m_render, src.m_glyph_code, data, layout, path);
+    }
+  return data;
+}
+
+void
+GlyphCachePrivate::
+publish_glyph(GlyphDataPrivate *g,
+              const fastuidraw::GlyphLayoutData &layout,
+              fastuidraw::Path &path,
+              fastuidraw::GlyphRenderData *data)
+{
+  fastuidraw::autolock_mutex m(m_pending_mutex);
+
+  FASTUIDRAWassert(!g->ready());
+  g->m_layout = layout;
+  g->m_path.swap(path);
+  g->m_glyph_data = data;
+  g->m_ready.store(true, std::memory_order_release);
+  m_pending_cond.notify_all();
+}
+
+void
+GlyphCachePrivate::
+release_glyph(GlyphDataPrivate *g)
+{
+  fastuidraw::autolock_mutex m(m_allocation_mutex);
+  m_free_slots.push_back(g->m_cache_location);
+}
+
+void
+GlyphCachePrivate::
+lru_unlink(GlyphDataPrivate *g)
+{
+  fastuidraw::autolock_mutex m(m_lru_mutex);
+  lru_unlink_locked(g);
+}
+
+void
+GlyphCachePrivate::
+lru_unlink_locked(GlyphDataPrivate *g)
+{
+  if(!g->m_lru_prev && m_lru_head != g)
+    {
+      return;
+    }
+
+  if(g->m_lru_prev)
+    {
+      g->m_lru_prev->m_lru_next = g->m_lru_next;
+    }
+  else
+    {
+      FASTUIDRAWassert(m_lru_head == g);
+      m_lru_head = g->m_lru_next;
+    }
+
+  if(g->m_lru_next)
+    {
+      g->m_lru_next->m_lru_prev = g->m_lru_prev;
+    }
+  else
+    {
+      FASTUIDRAWassert(m_lru_tail == g);
+      m_lru_tail = g->m_lru_prev;
+    }
+  g->m_lru_prev = g->m_lru_next = nullptr;
+}
+
+void
+GlyphCachePrivate::
+lru_touch(GlyphDataPrivate *g, uint64_t frame, bool only_if_listed)
+{
+  fastuidraw::autolock_mutex m(m_lru_mutex);
+  bool listed;
+
+  listed = (g->m_lru_prev || m_lru_head == g);
+  if(only_if_listed && !listed)
+    {
+      return;
+    }
+
+  g->m_last_used_frame = frame;
+  if(m_lru_head == g)
+    {
+      return;
+    }
+
+  /* g is in the list unless it was just uploaded */
+  if(listed)
+    {
+      lru_unlink_locked(g);
+    }
+
+  g->m_lru_next = m_lru_head;
+  if(m_lru_head)
+    {
+      m_lru_head->m_lru_prev = g;
+    }
+  m_lru_head = g;
+  if(!m_lru_tail)
+    {
+      m_lru_tail = g;
+    }
+}
+
+void
+GlyphCachePrivate::
+lru_reset(void)
+{
+  fastuidraw::autolock_mutex m(m_lru_mutex);
+  for(GlyphDataPrivate *g = m_lru_head, *next; g; g = next)
+    {
+      next = g->m_lru_next;
+      g->m_lru_prev = g->m_lru_next = nullptr;
+    }
+  m_lru_head = m_lru_tail = nullptr;
+}
+
+unsigned int
+GlyphCachePrivate::
+evict(unsigned int count, uint64_t frame)
+{
+  unsigned int return_value(0);
+
+  /* glyphs used within the last m_pinned_frames frames may
+     be referenced by data of the frames in flight and are
+     never evicted; the list is ordered by last use, so the
+     first pinned glyph from the back ends the search.
+   */
+  while(return_value < count)
+    {
+      GlyphDataPrivate *g;
+
+      /* take the glyph off the list with the lock held so
+         that it cannot be marked as used between the check
+         and its removal.
+       */
+      {
+        fastuidraw::autolock_mutex m(m_lru_mutex);
+        g = m_lru_tail;
+        if(!g || g->m_last_used_frame + m_pinned_frames > frame)
+          {
+            break;
+          }
+        lru_unlink_locked(g);
+      }
+      g->remove_from_atlas();
+      ++return_value;
+    }
+  m_number_evictions += return_value;
+  return return_value;
+}
+
 ///////////////////////////////////////////////////////
 // fastuidraw::Glyph methods
 enum fastuidraw::glyph_type
@@ -302,9 +993,30 @@ layout(void) const
   GlyphDataPrivate *p;
   p = static_cast<GlyphDataPrivate*>(m_opaque);
   FASTUIDRAWassert(p != nullptr && p->m_render.valid());
+  p->wait_ready();
   return p->m_layout;
 }
 
+bool
+fastuidraw::Glyph::
+ready(void) const
+{
+  GlyphDataPrivate *p;
+  p = static_cast<GlyphDataPrivate*>(m_opaque);
+  FASTUIDRAWassert(p != nullptr && p->m_render.valid());
+  return p->ready();
+}
+
+fastuidraw::Glyph
+fastuidraw::Glyph::
+fallback(void) const
+{
+  GlyphDataPrivate *p;
+  p = static_cast<GlyphDataPrivate*>(m_opaque);
+  FASTUIDRAWassert(p != nullptr && p->m_render.valid());
+  return p->ready() ? Glyph() : p->m_fallback;
+}
+
 fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache>
 fastuidraw::Glyph::
 cache(void) const
@@ -365,6 +1077,19 @@ upload_to_atlas(void) const
   return p->upload_to_atlas();
 }
 
+void
+fastuidraw::Glyph::
+mark_used(void) const
+{
+  GlyphDataPrivate *p;
+  p = static_cast<GlyphDataPrivate*>(m_opaque);
+  FASTUIDRAWassert(p != nullptr && p->m_render.valid());
+  if(p->m_cache)
+    {
+      p->m_cache->lru_touch(p, p->m_cache->m_atlas->frame(), true);
+    }
+}
+
 const fastuidraw::Path&
 fastuidraw::Glyph::
 path(void) const
@@ -372,6 +1097,7 @@ path(void) const
   GlyphDataPrivate *p;
   p = static_cast<GlyphDataPrivate*>(m_opaque);
   FASTUIDRAWassert(p != nullptr && p->m_render.valid());
+  p->wait_ready();
   return p->m_path;
 }
 
@@ -437,16 +1163,98 @@ fetch_glyph(GlyphRender render,
 
   GlyphDataPrivate *q;
   GlyphSource src(font, glyph_code, render);
+  uint64_t hash(src.hash());
+  bool compute;
+
+  {
+    fastuidraw::autolock_mutex m(d->shard(hash).m_mutex);
+
+    /* a new glyph is marked as not ready with the shard
+       locked; its rendering data is then computed without
+       the lock so that fetching other glyphs of the shard
+       does not wait on it, while a thread fetching the same
+       glyph waits in wait_ready() instead of computing it
+       again.
+     */
+    q = d->fetch_or_allocate_glyph(src, hash);
+    compute = !q->m_render.valid();
+    if(compute)
+      {
+        FASTUIDRAWassert(!q->m_glyph_data);
+        q->m_render = render;
+        q->m_ready.store(false, std::memory_order_release);
+      }
+  }
+
+  if(compute)
+    {
+      fastuidraw::GlyphLayoutData layout;
+      fastuidraw::Path path;
+      fastuidraw::GlyphRenderData *data;
+
+      data = GlyphCachePrivate::compute_rendering_data(d->m_disk_cache, src, layout, path);
+      d->publish_glyph(q, layout, path, data);
+    }
+  else
+    {
+      /* the glyph may be computed by another thread */
+      q->wait_ready();
+    }
+  return Glyph(q);
+}
+
+fastuidraw::Glyph
+fastuidraw::GlyphCache::
+fetch_glyph_no_wait(GlyphRender render,
+                    const reference_counted_ptr<const FontBase> &font,
+                    uint32_t glyph_code, GlyphRender fallback)
+{
+  if(!font || !font->can_create_rendering_data(render.m_type))
+    {
+      return Glyph();
+    }
+
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+
+  GlyphDataPrivate *q;
+  GlyphSource src(font, glyph_code, render);
+  uint64_t hash(src.hash());
+  Glyph fallback_glyph;
 
-  q = d->fetch_or_allocate_glyph(src);
+  {
+    fastuidraw::autolock_mutex m(d->shard(hash).m_mutex);
+    q = d->find_glyph(src, hash);
+    if(q && q->m_render.valid())
+      {
+        return Glyph(q);
+      }
+  }
+
+  /* fetch the fallback before locking the shard of the glyph
+     since the fallback may be on the same shard.
+   */
+  if(fallback.valid() && !(fallback == render))
+    {
+      fallback_glyph = fetch_glyph(fallback, font, glyph_code);
+    }
 
+  fastuidraw::autolock_mutex m(d->shard(hash).m_mutex);
+  q = d->fetch_or_allocate_glyph(src, hash);
   if(!q->m_render.valid())
     {
-      q->m_render = render;
+      reference_counted_ptr<PendingGlyph> pending;
+
       FASTUIDRAWassert(!q->m_glyph_data);
-      q->m_glyph_data = font->compute_rendering_data(q->m_render, glyph_code, q->m_layout, q->m_path);
-    }
+      q->m_render = render;
+      q->m_fallback = fallback_glyph;
+      q->m_ready.store(false, std::memory_order_release);
+      ++d->m_number_pending;
 
+      pending = FASTUIDRAWnew PendingGlyph(q, src, d->m_disk_cache);
+      detail::TaskQueue::background().add([pending]() { pending->run(); },
+                                          [pending]() { pending->cancel(); });
+    }
   return Glyph(q);
 }
 
@@ -468,14 +1276,23 @@ add_glyph(Glyph glyph)
 
   GlyphCachePrivate *d;
   d = static_cast<GlyphCachePrivate*>(m_d);
-  if(d->m_glyph_map.find(src) != d->m_glyph_map.end())
+
+  uint64_t hash(src.hash());
+  GlyphTableShard &S(d->shard(hash));
+  fastuidraw::autolock_mutex m(S.m_mutex);
+
+  if(S.find(src, hash))
     {
       return routine_fail;
     }
 
-  g->m_cache = d;
-  g->m_cache_location = d->m_glyphs.size();
-  d->m_glyphs.push_back(g);
+  {
+    fastuidraw::autolock_mutex ma(d->m_allocation_mutex);
+    g->m_cache = d;
+    g->m_cache_location = d->m_glyphs.size();
+    d->m_glyphs.push_back(g);
+  }
+  S.insert(src, hash, g);
 
   return routine_success;
 }
@@ -493,10 +1310,15 @@ delete_glyph(Glyph G)
   FASTUIDRAWassert(p->m_cache == d);
   FASTUIDRAWassert(p->m_render.valid());
 
+  p->wait_ready();
   GlyphSource src(p->m_layout.m_font, p->m_layout.m_glyph_code, p->m_render);
-  d->m_glyph_map.erase(src);
+  uint64_t hash(src.hash());
+  GlyphTableShard &S(d->shard(hash));
+  fastuidraw::autolock_mutex m(S.m_mutex);
+
+  S.erase(src, hash);
   p->clear();
-  d->m_free_slots.push_back(p->m_cache_location);
+  d->release_glyph(p);
 }
 
 void
@@ -507,6 +1329,7 @@ clear_atlas(void)
   d = static_cast<GlyphCachePrivate*>(m_d);
 
   d->m_atlas->clear();
+  d->lru_reset();
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
       d->m_glyphs[i]->m_uploaded_to_atlas = false;
@@ -525,8 +1348,15 @@ clear_cache(void)
   GlyphCachePrivate *d;
   d = static_cast<GlyphCachePrivate*>(m_d);
 
-  d->m_atlas->clear();
-  d->m_glyph_map.clear();
+  /* clear_atlas() marks the regions of the glyphs as
+     freed so that clearing the glyphs does not free
+     regions of the (already cleared) atlas.
+   */
+  clear_atlas();
+  for(GlyphTableShard &S : d->m_shards)
+    {
+      S.clear();
+    }
 
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
@@ -539,3 +1369,75 @@ clear_cache(void)
         }
     }
 }
+
+void
+fastuidraw::GlyphCache::
+lru_eviction(bool v)
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  d->m_lru_eviction = v;
+}
+
+bool
+fastuidraw::GlyphCache::
+lru_eviction(void) const
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  return d->m_lru_eviction;
+}
+
+void
+fastuidraw::GlyphCache::
+pinned_frames(unsigned int v)
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  d->m_pinned_frames = fastuidraw::t_max(2u, v);
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+pinned_frames(void) const
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  return d->m_pinned_frames;
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+number_evictions(void) const
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  return d->m_number_evictions;
+}
+
+void
+fastuidraw::GlyphCache::
+disk_cache(const reference_counted_ptr<GlyphDiskCache> &v)
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  d->m_disk_cache = v;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::GlyphDiskCache>&
+fastuidraw::GlyphCache::
+disk_cache(void) const
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  return d->m_disk_cache;
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+number_pending_glyphs(void) const
+{
+  GlyphCachePrivate *d;
+  d = static_cast<GlyphCachePrivate*>(m_d);
+  return d->m_number_pending.load();
+}
@@ -0,0 +1,960 @@
+/*!
+ * \file glyph_disk_cache.cpp
+ * \brief file glyph_disk_cache.cpp
+ *
+ * Copyright 2017 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <string>
+#include <string.h>
+#include <stdio.h>
+#include <fastuidraw/text/glyph_disk_cache.hpp>
+#include <fastuidraw/text/glyph_render_data_coverage.hpp>
+#include <fastuidraw/text/glyph_render_data_distance_field.hpp>
+#include <fastuidraw/text/glyph_render_data_curve_pair.hpp>
+#include "../private/util_private.hpp"
+
+#if defined(_WIN32)
+  #define FASTUIDRAW_GLYPH_DISK_CACHE_NO_MMAP
+#else
+  #include <sys/mman.h>
+  #include <sys/file.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+/* File layout: a header followed by records. Each record is
+   a uint32_t giving the size of its payload, a uint32_t
+   checksum (FNV-1a) of the payload and then the payload,
+   which begins with the key of the glyph. Values are stored
+   in the byte order of the machine. Records are appended
+   with an exclusive lock on the file held; reading stops at
+   the first record that is truncated or whose checksum does
+   not match (i.e. from a process that died while appending)
+   and the file is truncated to the records before it.
+ */
+
+namespace
+{
+  enum
+    {
+      file_version = 1,
+      byte_order_marker = 0x01020304,
+      record_header_size = 2 * sizeof(uint32_t)
+    };
+
+  const char file_magic[8] = { 'F', 'U', 'I', 'G', 'L', 'Y', 'P', 'H' };
+
+  enum path_element_type
+    {
+      path_element_flat,
+      path_element_bezier,
+      path_element_arc
+    };
+
+  class FileHeader
+  {
+  public:
+    FileHeader(void):
+      m_version(file_version),
+      m_byte_order(byte_order_marker)
+    {
+      memcpy(m_magic, file_magic, sizeof(m_magic));
+    }
+
+    bool
+    matches(const FileHeader &rhs) const
+    {
+      return memcmp(m_magic, rhs.m_magic, sizeof(m_magic)) == 0
+        && m_version == rhs.m_version
+        && m_byte_order == rhs.m_byte_order;
+    }
+
+    char m_magic[8];
+    uint32_t m_version;
+    uint32_t m_byte_order;
+  };
+
+  class EntryKey
+  {
+  public:
+    EntryKey(void):
+      m_font_key(0),
+      m_glyph_code(0),
+      m_type(0),
+      m_pixel_size(0)
+    {}
+
+    EntryKey(uint64_t font_key, fastuidraw::GlyphRender render, uint32_t glyph_code):
+      m_font_key(font_key),
+      m_glyph_code(glyph_code),
+      m_type(render.m_type),
+      m_pixel_size(render.m_pixel_size)
+    {}
+
+    bool
+    operator<(const EntryKey &rhs) const
+    {
+      return (m_font_key != rhs.m_font_key) ? m_font_key < rhs.m_font_key :
+        (m_glyph_code != rhs.m_glyph_code) ? m_glyph_code < rhs.m_glyph_code :
+        (m_type != rhs.m_type) ? m_type < rhs.m_type :
+        m_pixel_size < rhs.m_pixel_size;
+    }
+
+    uint64_t m_font_key;
+    uint32_t m_glyph_code;
+    int32_t m_type;
+    int32_t m_pixel_size;
+  };
+
+  enum
+    {
+      entry_key_size = sizeof(uint64_t) + 3 * sizeof(uint32_t)
+    };
+
+  inline
+  uint32_t
+  compute_checksum(fastuidraw::c_array<const uint8_t> bytes)
+  {
+    uint32_t h(2166136261u);
+    for(uint8_t b : bytes)
+      {
+        h = (h ^ b) * 16777619u;
+      }
+    return h;
+  }
+
+  class Writer
+  {
+  public:
+    template<typename T>
+    void
+    add(const T &v)
+    {
+      const uint8_t *p(reinterpret_cast<const uint8_t*>(&v));
+      m_bytes.insert(m_bytes.end(), p, p + sizeof(T));
+    }
+
+    void
+    add(const fastuidraw::vec2 &v)
+    {
+      add(v.x());
+      add(v.y());
+    }
+
+    void
+    add(const EntryKey &key)
+    {
+      add(key.m_font_key);
+      add(key.m_glyph_code);
+      add(key.m_type);
+      add(key.m_pixel_size);
+    }
+
+    template<typename T>
+    void
+    add_array(fastuidraw::c_array<const T> v)
+    {
+      add(static_cast<uint32_t>(v.size()));
+      if(!v.empty())
+        {
+          const uint8_t *p(reinterpret_cast<const uint8_t*>(v.c_ptr()));
+          m_bytes.insert(m_bytes.end(), p, p + sizeof(T) * v.size());
+        }
+    }
+
+    std::vector<uint8_t> m_bytes;
+  };
+
+  class Reader
+  {
+  public:
+    explicit
+    Reader(fastuidraw::c_array<const uint8_t> bytes):
+      m_bytes(bytes),
+      m_pos(0),
+      m_ok(true)
+    {}
+
+    template<typename T>
+    T
+    read(void)
+    {
+      T v;
+      if(m_pos + sizeof(T) > m_bytes.size())
+        {
+          m_ok = false;
+          return T();
+        }
+      memcpy(&v, m_bytes.c_ptr() + m_pos, sizeof(T));
+      m_pos += sizeof(T);
+      return v;
+    }
+
+    EntryKey
+    read_key(void)
+    {
+      EntryKey key;
+      key.m_font_key = read<uint64_t>();
+      key.m_glyph_code = read<uint32_t>();
+      key.m_type = read<int32_t>();
+      key.m_pixel_size = read<int32_t>();
+      return key;
+    }
+
+    fastuidraw::vec2
+    read_vec2(void)
+    {
+      fastuidraw::vec2 v;
+      v.x() = read<float>();
+      v.y() = read<float>();
+      return v;
+    }
+
+    /* reads an array written by Writer::add_array()
+       whose size must be dst.size()
+     */
+    template<typename T>
+    void
+    read_array(fastuidraw::c_array<T> dst)
+    {
+      uint32_t sz(read<uint32_t>());
+      if(!m_ok || sz != dst.size() || m_pos + sizeof(T) * sz > m_bytes.size())
+        {
+          m_ok = false;
+          return;
+        }
+      if(sz > 0)
+        {
+          memcpy(dst.c_ptr(), m_bytes.c_ptr() + m_pos, sizeof(T) * sz);
+          m_pos += sizeof(T) * sz;
+        }
+    }
+
+    fastuidraw::c_array<const uint8_t> m_bytes;
+    unsigned int m_pos;
+    bool m_ok;
+  };
+
+  void
+  write_per_curve(Writer &W, const fastuidraw::GlyphRenderDataCurvePair::per_curve &c)
+  {
+    W.add(c.m_m0);
+    W.add(c.m_m1);
+    W.add(c.m_q);
+    W.add(c.m_quad_coeff);
+  }
+
+  void
+  read_per_curve(Reader &R, fastuidraw::GlyphRenderDataCurvePair::per_curve &c)
+  {
+    c.m_m0 = R.read<float>();
+    c.m_m1 = R.read<float>();
+    c.m_q = R.read_vec2();
+    c.m_quad_coeff = R.read<float>();
+  }
+
+  bool
+  write_data(Writer &W, const fastuidraw::GlyphRenderData *data)
+  {
+    using namespace fastuidraw;
+
+    const GlyphRenderDataCoverage *coverage;
+    const GlyphRenderDataDistanceField *distance;
+    const GlyphRenderDataCurvePair *curve_pair;
+
+    if((coverage = dynamic_cast<const GlyphRenderDataCoverage*>(data)))
+      {
+        W.add(static_cast<uint32_t>(coverage_glyph));
+        W.add(coverage->resolution());
+        W.add_array(coverage->coverage_values());
+        return true;
+      }
+
+    if((distance = dynamic_cast<const GlyphRenderDataDistanceField*>(data)))
+      {
+        W.add(static_cast<uint32_t>(distance_field_glyph));
+        W.add(distance->resolution());
+        W.add_array(distance->distance_values());
+        return true;
+      }
+
+    if((curve_pair = dynamic_cast<const GlyphRenderDataCurvePair*>(data)))
+      {
+        c_array<const GlyphRenderDataCurvePair::entry> entries(curve_pair->geometry_data());
+
+        W.add(static_cast<uint32_t>(curve_pair_glyph));
+        W.add(curve_pair->resolution());
+        W.add_array(curve_pair->active_curve_pair());
+        W.add(static_cast<uint32_t>(entries.size()));
+        for(const GlyphRenderDataCurvePair::entry &e : entries)
+          {
+            W.add(e.m_p);
+            write_per_curve(W, e.m_curve0);
+            write_per_curve(W, e.m_curve1);
+            W.add(static_cast<uint32_t>(e.m_use_min));
+            W.add(e.m_zeta);
+            W.add(static_cast<uint32_t>(e.m_type));
+          }
+        return true;
+      }
+
+    return false;
+  }
+
+  fastuidraw::GlyphRenderData*
+  read_data(Reader &R)
+  {
+    using namespace fastuidraw;
+
+    uint32_t tp(R.read<uint32_t>());
+    ivec2 res;
+
+    res.x() = R.read<int>();
+    res.y() = R.read<int>();
+    if(!R.m_ok || res.x() < 0 || res.y() < 0)
+      {
+        return nullptr;
+      }
+
+    switch(tp)
+      {
+      case coverage_glyph:
+        {
+          GlyphRenderDataCoverage *data;
+          data = FASTUIDRAWnew GlyphRenderDataCoverage();
+          data->resize(res);
+          R.read_array(data->coverage_values());
+          if(!R.m_ok)
+            {
+              FASTUIDRAWdelete(data);
+              return nullptr;
+            }
+          return data;
+        }
+
+      case distance_field_glyph:
+        {
+          GlyphRenderDataDistanceField *data;
+          data = FASTUIDRAWnew GlyphRenderDataDistanceField();
+          data->resize(res);
+          R.read_array(data->distance_values());
+          if(!R.m_ok)
+            {
+              FASTUIDRAWdelete(data);
+              return nullptr;
+            }
+          return data;
+        }
+
+      case curve_pair_glyph:
+        {
+          GlyphRenderDataCurvePair *data;
+          uint32_t num_entries;
+
+          data = FASTUIDRAWnew GlyphRenderDataCurvePair();
+          data->resize_active_curve_pair(res);
+          R.read_array(data->active_curve_pair());
+          num_entries = R.read<uint32_t>();
+
+          /* each entry takes 15 values of 4 bytes */
+          if(!R.m_ok || num_entries > (R.m_bytes.size() - R.m_pos) / 60u)
+            {
+              FASTUIDRAWdelete(data);
+              return nullptr;
+            }
+
+          data->resize_geometry_data(num_entries);
+          for(GlyphRenderDataCurvePair::entry &e : data->geometry_data())
+            {
+              e.m_p = R.read_vec2();
+              read_per_curve(R, e.m_curve0);
+              read_per_curve(R, e.m_curve1);
+              e.m_use_min = (R.read<uint32_t>() != 0u);
+              e.m_zeta = R.read<float>();
+              e.m_type = static_cast<enum GlyphRenderDataCurvePair::entry_type>(R.read<uint32_t>());
+            }
+
+          if(!R.m_ok)
+            {
+              FASTUIDRAWdelete(data);
+              return nullptr;
+            }
+          return data;
+        }
+
+      default:
+        return nullptr;
+      }
+  }
+
+  bool
+  write_path(Writer &W, const fastuidraw::Path &path)
+  {
+    using namespace fastuidraw;
+
+    W.add(static_cast<uint32_t>(path.number_contours()));
+    for(unsigned int c = 0, endc = path.number_contours(); c < endc; ++c)
+      {
+        reference_counted_ptr<const PathContour> contour(path.contour(c));
+        unsigned int n(contour->number_points());
+
+        if(!contour->ended())
+          {
+            return false;
+          }
+
+        W.add(static_cast<uint32_t>(n));
+        if(n == 0)
+          {
+            continue;
+          }
+
+        W.add(contour->interpolator(0)->start_pt());
+        for(unsigned int i = 0; i < n; ++i)
+          {
+            const PathContour::interpolator_base *h(contour->interpolator(i).get());
+            c_array<const float> values;
+
+            /* the geometry values of a Bezier curve are its
+               control points (including the end points), those
+               of an arc are its angle; the last interpolator
+               ends at the start of the contour.
+             */
+            if(dynamic_cast<const PathContour::flat*>(h))
+              {
+                W.add(static_cast<uint32_t>(path_element_flat));
+              }
+            else if(dynamic_cast<const PathContour::bezier*>(h)
+                    && h->geometry_values(&values)
+                    && values.size() >= 4 && values.size() % 2 == 0)
+              {
+                c_array<const vec2> pts(values.reinterpret_pointer<const vec2>());
+
+                W.add(static_cast<uint32_t>(path_element_bezier));
+                W.add_array(pts.sub_array(1, pts.size() - 2));
+              }
+            else if(dynamic_cast<const PathContour::arc*>(h)
+                    && h->geometry_values(&values)
+                    && values.size() == 1)
+              {
+                W.add(static_cast<uint32_t>(path_element_arc));
+                W.add(values[0]);
+              }
+            else
+              {
+                return false;
+              }
+
+            if(i + 1 < n)
+              {
+                W.add(h->end_pt());
+              }
+          }
+      }
+    return true;
+  }
+
+  bool
+  read_path(Reader &R, fastuidraw::Path &path)
+  {
+    using namespace fastuidraw;
+
+    uint32_t num_contours(R.read<uint32_t>());
+    for(uint32_t c = 0; c < num_contours && R.m_ok; ++c)
+      {
+        uint32_t n(R.read<uint32_t>());
+        if(n == 0 || !R.m_ok)
+          {
+            continue;
+          }
+
+        path << R.read_vec2();
+        for(uint32_t i = 0; i < n && R.m_ok; ++i)
+          {
+            uint32_t tp(R.read<uint32_t>());
+            bool last(i + 1 == n);
+            float angle(0.0f);
+
+            switch(tp)
+              {
+              case path_element_flat:
+                break;
+
+              case path_element_bezier:
+                {
+                  uint32_t num_pts(R.read<uint32_t>());
+                  if(num_pts > (R.m_bytes.size() - R.m_pos) / sizeof(vec2))
+                    {
+                      return false;
+                    }
+                  for(uint32_t k = 0; k < num_pts; ++k)
+                    {
+                      path << Path::control_point(R.read_vec2());
+                    }
+                }
+                break;
+
+              case path_element_arc:
+                angle = R.read<float>();
+                break;
+
+              default:
+                return false;
+              }
+
+            if(last && tp == path_element_arc)
+              {
+                path << Path::contour_end_arc(angle);
+              }
+            else if(last)
+              {
+                path << Path::contour_end();
+              }
+            else if(tp == path_element_arc)
+              {
+                path << Path::arc(angle, R.read_vec2());
+              }
+            else
+              {
+                path << R.read_vec2();
+              }
+          }
+      }
+    return R.m_ok;
+  }
+
+  class GlyphDiskCachePrivate:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    GlyphDiskCachePrivate(const std::string &filename);
+
+    ~GlyphDiskCachePrivate();
+
+    void
+    open_file(void);
+
+    /* read the records after the header of [begin, end) into
+       m_entries, returns the offset of the end of the last good
+       record or 0 if the header does not match
+     */
+    size_t
+    read_file(const uint8_t *begin, const uint8_t *end);
+
+    enum fastuidraw::return_code
+    append(const std::vector<uint8_t> &record);
+
+    std::string m_filename;
+    bool m_open;
+
+    fastuidraw::mutex m_mutex;
+
+    /* payloads of the entries, in the mapped file or in
+       m_appended
+     */
+    std::map<EntryKey, fastuidraw::c_array<const uint8_t> > m_entries;
+    std::deque<std::vector<uint8_t> > m_appended;
+
+    #ifdef FASTUIDRAW_GLYPH_DISK_CACHE_NO_MMAP
+    std::vector<uint8_t> m_file_contents;
+    #else
+    void *m_mapped;
+    size_t m_mapped_size;
+    #endif
+  };
+}
+
+////////////////////////////////////////
+// GlyphDiskCachePrivate methods
+GlyphDiskCachePrivate::
+GlyphDiskCachePrivate(const std::string &filename):
+  m_filename(filename),
+  m_open(false)
+  #ifndef FASTUIDRAW_GLYPH_DISK_CACHE_NO_MMAP
+  , m_mapped(nullptr),
+  m_mapped_size(0)
+  #endif
+{
+  open_file();
+}
+
+GlyphDiskCachePrivate::
+~GlyphDiskCachePrivate()
+{
+  #ifndef FASTUIDRAW_GLYPH_DISK_CACHE_NO_MMAP
+  if(m_mapped)
+    {
+      munmap(m_mapped, m_mapped_size);
+    }
+  #endif
+}
+
+size_t
+GlyphDiskCachePrivate::
+read_file(const uint8_t *begin, const uint8_t *end)
+{
+  FileHeader expected, header;
+  const uint8_t *p;
+
+  if(end - begin < static_cast<ptrdiff_t>(sizeof(FileHeader)))
+    {
+      return 0;
+    }
+
+  memcpy(&header, begin, sizeof(FileHeader));
+  if(!header.matches(expected))
+    {
+      return 0;
+    }
+
+  p = begin + sizeof(FileHeader);
+  while(end - p >= static_cast<ptrdiff_t>(record_header_size))
+    {
+      uint32_t sz, checksum;
+      fastuidraw::c_array<const uint8_t> payload;
+
+      memcpy(&sz, p, sizeof(uint32_t));
+      memcpy(&checksum, p + sizeof(uint32_t), sizeof(uint32_t));
+      if(sz < entry_key_size || sz > static_cast<size_t>(end - p) - record_header_size)
+        {
+          break;
+        }
+
+      payload = fastuidraw::c_array<const uint8_t>(p + record_header_size, sz);
+      if(compute_checksum(payload) != checksum)
+        {
+          break;
+        }
+
+      Reader R(payload);
+      m_entries[R.read_key()] = payload;
+      p += record_header_size + sz;
+    }
+  return p - begin;
+}
+
+#ifdef FASTUIDRAW_GLYPH_DISK_CACHE_NO_MMAP
+
+void
+GlyphDiskCachePrivate::
+open_file(void)
+{
+  FILE *file;
+  size_t good_end;
+
+  file = fopen(m_filename.c_str(), "rb");
+  if(file)
+    {
+      uint8_t buffer[4096];
+      size_t n;
+
+      while((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+          m_file_contents.insert(m_file_contents.end(), buffer, buffer + n);
+        }
+      fclose(file);
+    }
+
+  good_end = m_file_contents.empty() ? 0 :
+    read_file(&m_file_contents[0], &m_file_contents[0] + m_file_contents.size());
+
+  if(good_end == m_file_contents.size() && good_end > 0)
+    {
+      m_open = true;
+      return;
+    }
+
+  /* rewrite the file with only its good records */
+  file = fopen(m_filename.c_str(), "wb");
+  if(file)
+    {
+      FileHeader header;
+
+      if(good_end > 0)
+        {
+          m_open = (fwrite(&m_file_contents[0], 1, good_end, file) == good_end);
+        }
+      else
+        {
+          m_open = (fwrite(&header, sizeof(FileHeader), 1, file) == 1);
+        }
+      fclose(file);
+    }
+}
+
+enum fastuidraw::return_code
+GlyphDiskCachePrivate::
+append(const std::vector<uint8_t> &record)
+{
+  FILE *file;
+  bool ok;
+
+  file = fopen(m_filename.c_str(), "ab");
+  if(!file)
+    {
+      return fastuidraw::routine_fail;
+    }
+
+  ok = (fwrite(&record[0], 1, record.size(), file) == record.size());
+  ok = (fclose(file) == 0) && ok;
+  return ok ? fastuidraw::routine_success : fastuidraw::routine_fail;
+}
+
+#else
+
+void
+GlyphDiskCachePrivate::
+open_file(void)
+{
+  struct stat st;
+  size_t good_end(0);
+  int fd;
+
+  fd = ::open(m_filename.c_str(), O_RDWR | O_CREAT, 0644);
+  if(fd == -1)
+    {
+      return;
+    }
+
+  /* the exclusive lock keeps other processes from appending
+     while the file is read and possibly truncated
+   */
+  flock(fd, LOCK_EX);
+  if(fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+      void *p;
+
+      p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if(p != MAP_FAILED)
+        {
+          m_mapped = p;
+          m_mapped_size = st.st_size;
+          good_end = read_file(static_cast<const uint8_t*>(p),
+                               static_cast<const uint8_t*>(p) + m_mapped_size);
+        }
+    }
+
+  if(good_end > 0)
+    {
+      /* drop a partially written record at the end of the file;
+         no process reads past good_end, so truncating does not
+         affect the mappings of other processes.
+       */
+      m_open = (good_end == m_mapped_size || ftruncate(fd, good_end) == 0);
+    }
+  else
+    {
+      int new_fd;
+
+      /* a file of a different format (or an empty one): replace
+         it by a new file instead of truncating it because other
+         processes may have it mapped.
+       */
+      m_entries.clear();
+      unlink(m_filename.c_str());
+      new_fd = ::open(m_filename.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+      if(new_fd != -1)
+        {
+          FileHeader header;
+
+          flock(new_fd, LOCK_EX);
+          m_open = (write(new_fd, &header, sizeof(FileHeader)) == sizeof(FileHeader));
+          flock(new_fd, LOCK_UN);
+          ::close(new_fd);
+        }
+    }
+
+  flock(fd, LOCK_UN);
+  ::close(fd);
+}
+
+enum fastuidraw::return_code
+GlyphDiskCachePrivate::
+append(const std::vector<uint8_t> &record)
+{
+  ssize_t written;
+  int fd;
+
+  fd = ::open(m_filename.c_str(), O_WRONLY | O_APPEND);
+  if(fd == -1)
+    {
+      return fastuidraw::routine_fail;
+    }
+
+  flock(fd, LOCK_EX);
+  written = write(fd, &record[0], record.size());
+  flock(fd, LOCK_UN);
+  ::close(fd);
+
+  return (written == static_cast<ssize_t>(record.size())) ?
+    fastuidraw::routine_success :
+    fastuidraw::routine_fail;
+}
+
+#endif
+
+/////////////////////////////////////////
+// fastuidraw::GlyphDiskCache methods
+fastuidraw::GlyphDiskCache::
+GlyphDiskCache(c_string filename)
+{
+  m_d = FASTUIDRAWnew GlyphDiskCachePrivate(filename ? filename : "");
+}
+
+fastuidraw::GlyphDiskCache::
+~GlyphDiskCache()
+{
+  GlyphDiskCachePrivate *d;
+  d = static_cast<GlyphDiskCachePrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = nullptr;
+}
+
+bool
+fastuidraw::GlyphDiskCache::
+is_open(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = static_cast<GlyphDiskCachePrivate*>(m_d);
+  return d->m_open;
+}
+
+unsigned int
+fastuidraw::GlyphDiskCache::
+number_entries(void) const
+{
+  GlyphDiskCachePrivate *d;
+  d = static_cast<GlyphDiskCachePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_entries.size();
+}
+
+fastuidraw::GlyphRenderData*
+fastuidraw::GlyphDiskCache::
+fetch(const reference_counted_ptr<const FontBase> &font,
+      GlyphRender render, uint32_t glyph_code,
+      GlyphLayoutData &layout, Path &path) const
+{
+  GlyphDiskCachePrivate *d;
+  d = static_cast<GlyphDiskCachePrivate*>(m_d);
+
+  uint64_t font_key;
+  if(!d->m_open || !font || !font->persistent_key(&font_key))
+    {
+      return nullptr;
+    }
+
+  c_array<const uint8_t> payload;
+  {
+    autolock_mutex m(d->m_mutex);
+    std::map<EntryKey, c_array<const uint8_t> >::const_iterator iter;
+
+    iter = d->m_entries.find(EntryKey(font_key, render, glyph_code));
+    if(iter == d->m_entries.end())
+      {
+        return nullptr;
+      }
+    payload = iter->second;
+  }
+
+  /* the payload is never freed or modified while d lives */
+  Reader R(payload);
+  GlyphLayoutData L;
+  GlyphRenderData *data;
+  Path P;
+
+  R.read_key();
+  L.m_horizontal_layout_offset = R.read_vec2();
+  L.m_vertical_layout_offset = R.read_vec2();
+  L.m_size = R.read_vec2();
+  L.m_advance = R.read_vec2();
+  L.m_units_per_EM = R.read<float>();
+  L.m_glyph_code = glyph_code;
+  L.m_font = font;
+
+  data = read_data(R);
+  if(!data)
+    {
+      return nullptr;
+    }
+
+  if(!read_path(R, P))
+    {
+      FASTUIDRAWdelete(data);
+      return nullptr;
+    }
+
+  layout = L;
+  path.swap(P);
+  return data;
+}
+
+enum fastuidraw::return_code
+fastuidraw::GlyphDiskCache::
+store(const reference_counted_ptr<const FontBase> &font,
+      GlyphRender render, uint32_t glyph_code,
+      const GlyphRenderData *data,
+      const GlyphLayoutData &layout, const Path &path)
+{
+  GlyphDiskCachePrivate *d;
+  d = static_cast<GlyphDiskCachePrivate*>(m_d);
+
+  uint64_t font_key;
+  if(!d->m_open || !data || !font || !font->persistent_key(&font_key))
+    {
+      return routine_fail;
+    }
+
+  EntryKey key(font_key, render, glyph_code);
+  Writer W;
+
+  W.add(key);
+  W.add(layout.m_horizontal_layout_offset);
+  W.add(layout.m_vertical_layout_offset);
+  W.add(layout.m_size);
+  W.add(layout.m_advance);
+  W.add(layout.m_units_per_EM);
+  if(!write_data(W, data) || !write_path(W, path))
+    {
+      return routine_fail;
+    }
+
+  std::vector<uint8_t> record(record_header_size);
+  uint32_t sz, checksum;
+
+  sz = W.m_bytes.size();
+  checksum = compute_checksum(make_c_array(W.m_bytes));
+  memcpy(&record[0], &sz, sizeof(uint32_t));
+  memcpy(&record[sizeof(uint32_t)], &checksum, sizeof(uint32_t));
+  record.insert(record.end(), W.m_bytes.begin(), W.m_bytes.end());
+
+  autolock_mutex m(d->m_mutex);
+  if(d->m_entries.find(key) != d->m_entries.end()
+     || d->append(record) != routine_success)
+    {
+      return routine_fail;
+    }
+
+  d->m_appended.push_back(std::vector<uint8_t>());
+  d->m_appended.back().swap(W.m_bytes);
+  d->m_entries[key] = make_c_array(d->m_appended.back());
+  return routine_success;
+}